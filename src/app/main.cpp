@@ -6,6 +6,9 @@
 #include <QDir>
 #include <QLibraryInfo>
 
+#include <cstdio>
+
+#include "ui/image_export.h"
 #include "ui/main_window.h"
 #include "core/settings.h"
 #include "utils/logger.h"
@@ -47,6 +50,19 @@ int main(int argc, char* argv[]) {
     LOG_INFO(QString::fromUtf8("Запуск приложения Incline3D v") +
              QApplication::applicationVersion());
 
+    // Пакетный экспорт изображений без показа главного окна
+    QString arguments_error;
+    const auto batch_options = incline3d::ui::BatchImageExport::parseArguments(app.arguments(),
+                                                                               &arguments_error);
+    if (!arguments_error.isEmpty()) {
+        LOG_ERROR(arguments_error);
+        fprintf(stderr, "%s\n", qPrintable(arguments_error));
+        return 2;
+    }
+    if (batch_options) {
+        return incline3d::ui::BatchImageExport(*batch_options).run();
+    }
+
     // Загрузка настроек
     auto& settings = incline3d::core::Settings::instance();
     Q_UNUSED(settings)
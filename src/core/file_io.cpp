@@ -7,6 +7,8 @@
 #include <QProcess>
 #include <QTemporaryFile>
 
+#include "utils/parse_arena.h"
+
 namespace incline3d::core {
 
 FileFormat FileIO::detectFormat(const QString& path) {
@@ -126,41 +128,47 @@ WellLoadResult FileIO::parseWsFile(const QString& path) {
     in.setEncoding(QStringConverter::Utf8);
 
     QString current_section;
-    QStringList headers;
+    bool has_headers = false;
+
+    // Поля строки — представления в буфер строки, список полей — в арене
+    utils::ParseArena arena;
+    QString buffer;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
+    while (in.readLineInto(&buffer)) {
+        arena.reset();
+        const QStringView line = QStringView(buffer).trimmed();
 
         // Пропуск пустых строк и комментариев
-        if (line.isEmpty() || line.startsWith('#') || line.startsWith(';')) {
+        if (line.isEmpty() || line.startsWith(u'#') || line.startsWith(u';')) {
             continue;
         }
 
         // Определение секции
-        if (line.startsWith('[') && line.endsWith(']')) {
-            current_section = line.mid(1, line.length() - 2).toLower();
-            headers.clear();
+        if (line.startsWith(u'[') && line.endsWith(u']')) {
+            current_section = line.sliced(1, line.size() - 2).toString().toLower();
+            has_headers = false;
             continue;
         }
 
-        // Парсинг заголовков (первая строка после секции)
-        if (headers.isEmpty() && !current_section.isEmpty()) {
-            headers = line.split('\t', Qt::KeepEmptyParts);
+        // Пропуск заголовков (первая строка после секции)
+        if (!has_headers && !current_section.isEmpty()) {
+            has_headers = true;
             continue;
         }
 
-        QStringList values = line.split('\t', Qt::KeepEmptyParts);
+        const auto values = utils::split_line(line, u'\t', arena.resource());
+        const auto count = values.size();
 
         // Секция intervals (исходные замеры)
         if (current_section == "intervals") {
-            if (values.size() >= 3) {
+            if (count >= 3) {
                 models::MeasuredPoint point;
                 bool ok1, ok2;
                 point.measured_depth_m = values[0].toDouble(&ok1);
                 point.inclination_deg = values[1].toDouble(&ok2);
 
                 if (ok1 && ok2) {
-                    if (values.size() >= 4 && !values[2].isEmpty()) {
+                    if (count >= 4 && !values[2].isEmpty()) {
                         bool ok3;
                         double azim = values[2].toDouble(&ok3);
                         if (ok3) {
@@ -173,7 +181,7 @@ WellLoadResult FileIO::parseWsFile(const QString& path) {
         }
         // Секция results (результаты расчёта)
         else if (current_section == "results") {
-            if (values.size() >= 7) {
+            if (count >= 7) {
                 models::ProcessedPoint point;
                 point.measured_depth_m = values[0].toDouble();
                 point.inclination_deg = values[1].toDouble();
@@ -185,13 +193,13 @@ WellLoadResult FileIO::parseWsFile(const QString& path) {
                 point.east_m = values[5].toDouble();
                 point.tvd_m = values[6].toDouble();
 
-                if (values.size() >= 11) {
+                if (count >= 11) {
                     point.dogleg_angle_deg = values[7].toDouble();
                     point.intensity_10m = values[8].toDouble();
                     point.intensity_L = values[9].toDouble();
                 }
 
-                if (values.size() >= 15) {
+                if (count >= 15) {
                     point.mistake_x = values[10].toDouble();
                     point.mistake_y = values[11].toDouble();
                     point.mistake_z = values[12].toDouble();
@@ -203,9 +211,9 @@ WellLoadResult FileIO::parseWsFile(const QString& path) {
         }
         // Секция metadata
         else if (current_section == "metadata" || current_section == "well") {
-            if (values.size() >= 2) {
-                QString key = values[0].toLower();
-                QString value = values[1];
+            if (count >= 2) {
+                const QString key = values[0].toString().toLower();
+                const QString value = values[1].toString();
                 if (key == "well_name" || key == "name") {
                     result.well->metadata.well_name = value.toStdString();
                 } else if (key == "field" || key == "field_name") {
@@ -221,28 +229,14 @@ WellLoadResult FileIO::parseWsFile(const QString& path) {
 
     // Вычисление сводных данных
     if (!result.well->results.empty()) {
-        double max_incl = 0.0;
-        double max_int = 0.0;
-        double max_int_depth = 0.0;
-
-        for (const auto& pt : result.well->results) {
-            if (pt.inclination_deg > max_incl) {
-                max_incl = pt.inclination_deg;
-            }
-            if (pt.intensity_10m > max_int) {
-                max_int = pt.intensity_10m;
-                max_int_depth = pt.measured_depth_m;
-            }
-        }
-
-        result.well->max_inclination_deg = max_incl;
-        result.well->max_intensity_10m = max_int;
-        result.well->max_intensity_10m_depth = max_int_depth;
-
-        const auto& last = result.well->results.back();
-        result.well->total_depth = last.measured_depth_m;
-        result.well->horizontal_displacement = std::sqrt(
-            last.north_m * last.north_m + last.east_m * last.east_m);
+        const auto geometry = result.well->results.geometry();
+        result.well->max_inclination_deg = geometry.max_inclination_deg;
+        result.well->max_intensity_10m = geometry.max_intensity_10m;
+        result.well->max_intensity_10m_depth = geometry.max_intensity_10m_depth;
+        result.well->max_intensity_L = geometry.max_intensity_L;
+        result.well->max_intensity_L_depth = geometry.max_intensity_L_depth;
+        result.well->total_depth = geometry.md_end;
+        result.well->horizontal_displacement = geometry.horizontalDisplacement();
     } else if (!result.well->measurements.empty()) {
         result.well->total_depth = result.well->measurements.back().measured_depth_m;
     }
@@ -276,28 +270,32 @@ WellLoadResult FileIO::parseCsvMeasurements(const QString& path) {
     bool first_line = true;
     int depth_col = -1, incl_col = -1, azim_col = -1;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
+    utils::ParseArena arena;
+    QString buffer;
+
+    while (in.readLineInto(&buffer)) {
+        arena.reset();
+        const QStringView line = QStringView(buffer).trimmed();
 
-        if (line.isEmpty() || line.startsWith('#')) {
+        if (line.isEmpty() || line.startsWith(u'#')) {
             continue;
         }
 
         // Разделитель: точка с запятой или табуляция
-        QStringList values;
-        if (line.contains(';')) {
-            values = line.split(';', Qt::KeepEmptyParts);
-        } else if (line.contains('\t')) {
-            values = line.split('\t', Qt::KeepEmptyParts);
-        } else {
-            values = line.split(',', Qt::KeepEmptyParts);
+        QChar separator = u',';
+        if (line.contains(u';')) {
+            separator = u';';
+        } else if (line.contains(u'\t')) {
+            separator = u'\t';
         }
+        const auto values = utils::split_line(line, separator, arena.resource());
+        const int count = static_cast<int>(values.size());
 
         // Определение колонок из заголовка
         if (first_line) {
             first_line = false;
-            for (int i = 0; i < values.size(); ++i) {
-                QString h = values[i].toLower().trimmed();
+            for (int i = 0; i < count; ++i) {
+                QString h = values[i].toString().toLower().trimmed();
                 if (h.contains("глубина") || h.contains("depth") || h == "md") {
                     depth_col = i;
                 } else if (h.contains("угол") || h.contains("incl") || h.contains("angle")) {
@@ -311,19 +309,19 @@ WellLoadResult FileIO::parseCsvMeasurements(const QString& path) {
             if (depth_col < 0 || incl_col < 0) {
                 // Пробуем парсить как данные
                 bool ok1, ok2;
-                if (values.size() >= 2) {
+                if (count >= 2) {
                     values[0].toDouble(&ok1);
                     values[1].toDouble(&ok2);
                     if (ok1 && ok2) {
                         // Это данные, не заголовок
                         depth_col = 0;
                         incl_col = 1;
-                        azim_col = values.size() >= 3 ? 2 : -1;
+                        azim_col = count >= 3 ? 2 : -1;
                         // Не пропускаем эту строку - она содержит данные
                     } else {
                         depth_col = 0;
                         incl_col = 1;
-                        azim_col = values.size() >= 3 ? 2 : -1;
+                        azim_col = count >= 3 ? 2 : -1;
                         continue;
                     }
                 }
@@ -333,22 +331,22 @@ WellLoadResult FileIO::parseCsvMeasurements(const QString& path) {
         }
 
         if (depth_col < 0 || incl_col < 0 ||
-            depth_col >= values.size() || incl_col >= values.size()) {
+            depth_col >= count || incl_col >= count) {
             continue;
         }
 
         models::MeasuredPoint point;
         bool ok1, ok2;
-        point.measured_depth_m = values[depth_col].trimmed().toDouble(&ok1);
-        point.inclination_deg = values[incl_col].trimmed().toDouble(&ok2);
+        point.measured_depth_m = utils::parse_number(values[depth_col], &ok1);
+        point.inclination_deg = utils::parse_number(values[incl_col], &ok2);
 
         if (!ok1 || !ok2) {
             continue;
         }
 
-        if (azim_col >= 0 && azim_col < values.size() && !values[azim_col].trimmed().isEmpty()) {
+        if (azim_col >= 0 && azim_col < count && !values[azim_col].trimmed().isEmpty()) {
             bool ok3;
-            double azim = values[azim_col].trimmed().toDouble(&ok3);
+            double azim = utils::parse_number(values[azim_col], &ok3);
             if (ok3) {
                 point.azimuth_deg = azim;
             }
@@ -446,23 +444,24 @@ std::vector<models::ProjectPoint> FileIO::loadProjectPoints(const QString& path)
     QTextStream in(&file);
     bool first_line = true;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty() || line.startsWith('#')) {
+    utils::ParseArena arena;
+    QString buffer;
+
+    while (in.readLineInto(&buffer)) {
+        arena.reset();
+        const QStringView line = QStringView(buffer).trimmed();
+        if (line.isEmpty() || line.startsWith(u'#')) {
             continue;
         }
 
-        QStringList values = line.split('\t', Qt::KeepEmptyParts);
-        if (values.isEmpty()) {
-            values = line.split(';', Qt::KeepEmptyParts);
-        }
+        const auto values = utils::split_line(line, u'\t', arena.resource());
 
         if (first_line) {
             first_line = false;
             // Пропускаем заголовок если он есть
             bool is_header = false;
-            for (const auto& v : values) {
-                if (v.toLower().contains("пласт") || v.toLower().contains("name")) {
+            for (const auto v : values) {
+                if (v.contains(u"пласт", Qt::CaseInsensitive) || v.contains(u"name", Qt::CaseInsensitive)) {
                     is_header = true;
                     break;
                 }
@@ -472,7 +471,7 @@ std::vector<models::ProjectPoint> FileIO::loadProjectPoints(const QString& path)
 
         if (values.size() >= 5) {
             models::ProjectPoint pt;
-            pt.name = values[0].toStdString();
+            pt.name = values[0].toString().toStdString();
             pt.azimuth_geogr_deg = values[1].toDouble();
             pt.shift_m = values[2].toDouble();
             pt.depth_m = values[3].toDouble();
@@ -519,24 +518,26 @@ std::vector<models::ShotPoint> FileIO::loadShotPoints(const QString& path) {
     QTextStream in(&file);
     bool first_line = true;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty() || line.startsWith('#')) {
+    utils::ParseArena arena;
+    QString buffer;
+
+    while (in.readLineInto(&buffer)) {
+        arena.reset();
+        const QStringView line = QStringView(buffer).trimmed();
+        if (line.isEmpty() || line.startsWith(u'#')) {
             continue;
         }
 
-        QStringList values = line.split('\t', Qt::KeepEmptyParts);
-        if (values.isEmpty()) {
-            values = line.split(';', Qt::KeepEmptyParts);
-        }
+        const auto values = utils::split_line(line, u'\t', arena.resource());
 
         if (first_line) {
             first_line = false;
             bool is_header = false;
-            for (const auto& v : values) {
-                QString lower = v.toLower();
-                if (lower.contains("name") || lower.contains("название") ||
-                    lower == "x" || lower == "y") {
+            for (const auto v : values) {
+                if (v.contains(u"name", Qt::CaseInsensitive) ||
+                    v.contains(u"название", Qt::CaseInsensitive) ||
+                    v.compare(u"x", Qt::CaseInsensitive) == 0 ||
+                    v.compare(u"y", Qt::CaseInsensitive) == 0) {
                     is_header = true;
                     break;
                 }
@@ -546,7 +547,7 @@ std::vector<models::ShotPoint> FileIO::loadShotPoints(const QString& path) {
 
         if (values.size() >= 4) {
             models::ShotPoint pt;
-            pt.name = values[0].toStdString();
+            pt.name = values[0].toString().toStdString();
             pt.x_m = values[1].toDouble();
             pt.y_m = values[2].toDouble();
             pt.z_m = values[3].toDouble();
@@ -0,0 +1,164 @@
+#include "core/memory_tracker.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "core/project_manager.h"
+
+namespace incline3d::core {
+
+// --- WellMemoryUsage / MemoryReport ---
+
+std::size_t WellMemoryUsage::totalBytes() const {
+    return measurements_bytes + results_bytes + render_bytes;
+}
+
+std::size_t MemoryReport::wellsBytes() const {
+    std::size_t bytes = 0;
+    for (const auto& well : wells) {
+        bytes += well.totalBytes();
+    }
+    return bytes;
+}
+
+std::size_t MemoryReport::totalBytes() const {
+    std::size_t bytes = wellsBytes();
+    for (const auto& subsystem : subsystems) {
+        bytes += subsystem.bytes;
+    }
+    return bytes;
+}
+
+bool MemoryReport::overBudget() const {
+    return soft_budget_bytes > 0 && totalBytes() > soft_budget_bytes;
+}
+
+WellMemoryUsage* MemoryReport::findWell(models::WellId id) {
+    for (auto& well : wells) {
+        if (well.id == id) {
+            return &well;
+        }
+    }
+    return nullptr;
+}
+
+QJsonObject MemoryReport::toJson() const {
+    QJsonArray wells_array;
+    for (const auto& well : wells) {
+        QJsonObject obj;
+        obj["id"] = static_cast<qint64>(well.id.value);
+        obj["name"] = well.name;
+        obj["measurements_bytes"] = static_cast<qint64>(well.measurements_bytes);
+        obj["results_bytes"] = static_cast<qint64>(well.results_bytes);
+        obj["render_bytes"] = static_cast<qint64>(well.render_bytes);
+        obj["total_bytes"] = static_cast<qint64>(well.totalBytes());
+        wells_array.append(obj);
+    }
+
+    QJsonArray subsystems_array;
+    for (const auto& subsystem : subsystems) {
+        QJsonObject obj;
+        obj["name"] = subsystem.name;
+        obj["bytes"] = static_cast<qint64>(subsystem.bytes);
+        obj["items"] = subsystem.item_count;
+        obj["evictable"] = subsystem.evictable;
+        subsystems_array.append(obj);
+    }
+
+    QJsonObject root;
+    root["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["total_bytes"] = static_cast<qint64>(totalBytes());
+    root["wells_bytes"] = static_cast<qint64>(wellsBytes());
+    root["soft_budget_bytes"] = static_cast<qint64>(soft_budget_bytes);
+    root["wells"] = wells_array;
+    root["subsystems"] = subsystems_array;
+    return root;
+}
+
+// --- MemoryTracker ---
+
+MemoryTracker::MemoryTracker(const ProjectManager* manager, QObject* parent)
+    : QObject(parent)
+    , manager_(manager) {
+}
+
+void MemoryTracker::addCollector(Collector collector) {
+    collectors_.push_back(std::move(collector));
+}
+
+void MemoryTracker::addEvictor(Evictor evictor) {
+    evictors_.push_back(std::move(evictor));
+}
+
+void MemoryTracker::setSoftBudget(std::size_t bytes) {
+    soft_budget_ = bytes;
+}
+
+std::size_t MemoryTracker::softBudget() const {
+    return soft_budget_;
+}
+
+MemoryReport MemoryTracker::collect() const {
+    MemoryReport report;
+    report.soft_budget_bytes = soft_budget_;
+
+    if (manager_) {
+        const auto& wells = manager_->wells();
+        report.wells.reserve(wells.size());
+        for (const auto& well : wells) {
+            WellMemoryUsage usage;
+            usage.id = well->id;
+            usage.name = QString::fromStdString(well->metadata.well_name);
+            usage.measurements_bytes = well->measurements.memoryUsage();
+            usage.results_bytes = well->results.memoryUsage();
+            report.wells.push_back(usage);
+        }
+    }
+
+    for (const auto& collector : collectors_) {
+        collector(report);
+    }
+    return report;
+}
+
+MemoryReport MemoryTracker::enforceBudget() {
+    MemoryReport report = collect();
+    if (!report.overBudget()) {
+        return report;
+    }
+
+    const std::size_t total = report.totalBytes();
+    emit budgetExceeded(total, soft_budget_);
+
+    const std::size_t excess = total - soft_budget_;
+    std::size_t freed = 0;
+    for (const auto& evictor : evictors_) {
+        if (freed >= excess) {
+            break;
+        }
+        freed += evictor(excess - freed);
+    }
+
+    if (freed > 0) {
+        emit evicted(freed);
+        report = collect();
+    }
+    return report;
+}
+
+bool MemoryTracker::dumpJson(const QString& path, const QJsonObject& extra) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QJsonObject root = collect().toJson();
+    for (auto it = extra.begin(); it != extra.end(); ++it) {
+        root[it.key()] = it.value();
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+}  // namespace incline3d::core
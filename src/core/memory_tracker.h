@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "models/well_data.h"
+
+namespace incline3d::core {
+
+class ProjectManager;
+
+/// Память, занимаемая одной скважиной
+struct WellMemoryUsage {
+    models::WellId id;
+    QString name;
+    std::size_t measurements_bytes{0};
+    std::size_t results_bytes{0};
+    std::size_t render_bytes{0};        ///< Буферы 3D-вида (заполняет сборщик вида)
+
+    std::size_t totalBytes() const;
+};
+
+/// Память подсистемы (сцены видов, кэши, история отмены)
+struct SubsystemMemoryUsage {
+    QString name;
+    std::size_t bytes{0};               ///< Оценка объёма
+    int item_count{0};                  ///< Элементы сцены / записи кэша
+    bool evictable{false};              ///< Данные восстанавливаются по требованию
+};
+
+/// Срез потребления памяти проектом
+struct MemoryReport {
+    std::vector<WellMemoryUsage> wells;
+    std::vector<SubsystemMemoryUsage> subsystems;
+    std::size_t soft_budget_bytes{0};   ///< 0 — бюджет не задан
+
+    std::size_t wellsBytes() const;
+    std::size_t totalBytes() const;
+    bool overBudget() const;
+
+    /// Запись скважины (nullptr, если не найдена)
+    WellMemoryUsage* findWell(models::WellId id);
+
+    QJsonObject toJson() const;
+};
+
+/// Учёт памяти по скважинам и подсистемам
+///
+/// Объём данных скважин считается по хранилищам проекта, остальные
+/// подсистемы (виды, кэши) регистрируют сборщики. При превышении мягкого
+/// бюджета enforceBudget() вызывает зарегистрированные вытеснители —
+/// они освобождают данные, которые можно восстановить позже (например,
+/// сцены скрытых видов).
+class MemoryTracker : public QObject {
+    Q_OBJECT
+
+public:
+    /// Дополняет отчёт сведениями подсистемы
+    using Collector = std::function<void(MemoryReport& report)>;
+
+    /// Освобождает до bytes байт; возвращает фактически освобождённый объём
+    using Evictor = std::function<std::size_t(std::size_t bytes)>;
+
+    explicit MemoryTracker(const ProjectManager* manager, QObject* parent = nullptr);
+
+    void addCollector(Collector collector);
+    void addEvictor(Evictor evictor);
+
+    /// Мягкий бюджет памяти, байт (0 — без ограничения)
+    void setSoftBudget(std::size_t bytes);
+    std::size_t softBudget() const;
+
+    /// Собрать отчёт
+    MemoryReport collect() const;
+
+    /// Собрать отчёт и при превышении бюджета вытеснить перезагружаемые данные
+    /// @return отчёт после вытеснения
+    MemoryReport enforceBudget();
+
+    /// Записать отчёт в JSON-файл
+    /// @param extra дополнительные разделы верхнего уровня (например, статистика отрисовки)
+    bool dumpJson(const QString& path, const QJsonObject& extra = {}) const;
+
+signals:
+    /// Бюджет превышен (до вытеснения)
+    void budgetExceeded(std::size_t total_bytes, std::size_t budget_bytes);
+
+    /// Вытеснено freed_bytes байт
+    void evicted(std::size_t freed_bytes);
+
+private:
+    QPointer<const ProjectManager> manager_;
+    std::vector<Collector> collectors_;
+    std::vector<Evictor> evictors_;
+    std::size_t soft_budget_{0};
+};
+
+}  // namespace incline3d::core
@@ -8,6 +8,8 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include <algorithm>
+
 #include "core/file_io.h"
 
 namespace incline3d::core {
@@ -21,6 +23,8 @@ void ProjectManager::newProject() {
     data_.created_date = QDateTime::currentDateTime().toString(Qt::ISODate);
     data_.modified_date = data_.created_date;
     wells_.clear();
+    snapshots_.clear();
+    removed_versions_.clear();
     project_file_path_.clear();
     dirty_ = false;
 
@@ -80,8 +84,7 @@ bool ProjectManager::exportProject(const QString& directory) {
     FileIO io;
 
     // Экспорт всех скважин
-    for (size_t i = 0; i < wells_.size(); ++i) {
-        const auto& well = wells_[i];
+    for (const auto& well : wells_.wells()) {
         QString filename = QString::fromStdString(well->metadata.well_name) + ".ws";
         QString filepath = dir.filePath(filename);
         auto result = io.saveWell(filepath, *well, FileFormat::kWs);
@@ -131,7 +134,11 @@ const ProjectData& ProjectManager::projectData() const {
 }
 
 void ProjectManager::addWell(std::shared_ptr<models::WellData> well) {
-    wells_.push_back(well);
+    if (!well) {
+        return;
+    }
+    const int index = wells_.size();
+    publishWell(wells_.append(well));
 
     // Добавляем запись в данные проекта
     ProjectData::WellEntry entry;
@@ -143,31 +150,118 @@ void ProjectManager::addWell(std::shared_ptr<models::WellData> well) {
     data_.well_entries.push_back(entry);
 
     setDirty(true);
+    emit wellInserted(index);
+    emit wellsChanged();
+}
+
+void ProjectManager::insertWell(int index, std::shared_ptr<models::WellData> well,
+                                const ProjectData::WellEntry& entry) {
+    if (!well) {
+        return;
+    }
+    index = std::clamp(index, 0, wells_.size());
+    publishWell(wells_.insert(index, std::move(well)));
+
+    int entry_index = std::min(index, static_cast<int>(data_.well_entries.size()));
+    data_.well_entries.insert(data_.well_entries.begin() + entry_index, entry);
+
+    setDirty(true);
+    emit wellInserted(index);
     emit wellsChanged();
 }
 
 void ProjectManager::removeWell(int index) {
-    if (index < 0 || index >= static_cast<int>(wells_.size())) {
+    if (index < 0 || index >= wells_.size()) {
         return;
     }
 
-    wells_.erase(wells_.begin() + index);
+    const models::WellId id = wells_.idAt(index);
+    wells_.removeAt(index);
+    if (auto it = snapshots_.find(id); it != snapshots_.end()) {
+        // Отмена удаления вернёт скважину с тем же идентификатором — её версии
+        // должны продолжить нумерацию, иначе ключ (id, version) повторится
+        removed_versions_[id] = it->second->version();
+        snapshots_.erase(it);
+    }
     if (index < static_cast<int>(data_.well_entries.size())) {
         data_.well_entries.erase(data_.well_entries.begin() + index);
     }
 
     setDirty(true);
+    emit wellRemoved(index, id);
     emit wellsChanged();
 }
 
-std::vector<std::shared_ptr<models::WellData>>& ProjectManager::wells() {
-    return wells_;
+void ProjectManager::removeWell(models::WellId id) {
+    int index = wells_.rowOf(id);
+    if (index >= 0) {
+        removeWell(index);
+    }
+}
+
+bool ProjectManager::replaceWell(int index, std::shared_ptr<models::WellData> well) {
+    if (!well || index < 0 || index >= wells_.size()) {
+        return false;
+    }
+
+    // Пользовательские настройки живут в проекте, а не в файле данных
+    const auto old_well = wells_.at(index);
+    well->visible = old_well->visible;
+    well->display_color = old_well->display_color;
+    well->line_width = old_well->line_width;
+    well->params = old_well->params;
+
+    // Читатели, удерживающие старый указатель, продолжают работать со старыми данными;
+    // идентификатор скважины сохраняется
+    wells_.replace(index, std::move(well));
+    publishWell(wells_.idAt(index));
+
+    emit wellReplaced(index);
+    return true;
 }
 
 const std::vector<std::shared_ptr<models::WellData>>& ProjectManager::wells() const {
+    return wells_.wells();
+}
+
+std::shared_ptr<models::WellData> ProjectManager::well(models::WellId id) const {
+    return wells_.find(id);
+}
+
+int ProjectManager::indexOf(models::WellId id) const {
+    return wells_.rowOf(id);
+}
+
+const models::WellRegistry& ProjectManager::registry() const {
     return wells_;
 }
 
+models::WellRegistry& ProjectManager::registry() {
+    return wells_;
+}
+
+models::WellSnapshotPtr ProjectManager::snapshot(models::WellId id) const {
+    auto it = snapshots_.find(id);
+    return it != snapshots_.end() ? it->second->load() : nullptr;
+}
+
+void ProjectManager::publishWell(models::WellId id) {
+    auto well = wells_.find(id);
+    if (!well) {
+        return;
+    }
+    auto& slot = snapshots_[id];
+    if (!slot) {
+        std::uint64_t base_version = 0;
+        if (auto it = removed_versions_.find(id); it != removed_versions_.end()) {
+            base_version = it->second;
+            removed_versions_.erase(it);
+        }
+        slot = std::make_shared<models::WellSnapshotSlot>(base_version);
+    }
+    slot->publish(*well);
+}
+
 QString ProjectManager::getProjectFileFilter() {
     return QObject::tr(
         "Проекты Incline3D (*.inclproj);;"
@@ -295,6 +389,8 @@ bool ProjectManager::readProjectJson(const QString& path) {
     // Очистка текущих данных
     data_ = ProjectData{};
     wells_.clear();
+    snapshots_.clear();
+    removed_versions_.clear();
 
     // Основные поля
     data_.version = root["version"].toInt(1);
@@ -331,7 +427,7 @@ bool ProjectManager::readProjectJson(const QString& path) {
                 result.well->visible = entry.visible;
                 result.well->display_color = entry.color;
                 result.well->line_width = entry.line_width;
-                wells_.push_back(result.well);
+                publishWell(wells_.append(result.well));
             }
         }
     }
@@ -2,10 +2,14 @@
 
 #include <QObject>
 #include <QString>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "models/well_data.h"
+#include "models/well_registry.h"
+#include "models/well_snapshot.h"
 #include "models/project_point.h"
 #include "models/shot_point.h"
 
@@ -111,13 +115,46 @@ public:
     /// Добавить скважину в проект
     void addWell(std::shared_ptr<models::WellData> well);
 
+    /// Вставить скважину в заданную позицию с готовой записью проекта
+    /// (используется при отмене удаления)
+    void insertWell(int index, std::shared_ptr<models::WellData> well,
+                    const ProjectData::WellEntry& entry);
+
     /// Удалить скважину из проекта
     void removeWell(int index);
+    void removeWell(models::WellId id);
+
+    /// Заменить данные скважины (перечитанные с диска) без перестроения списка
+    /// @note Визуальные настройки и параметры расчёта переносятся со старой скважины
+    bool replaceWell(int index, std::shared_ptr<models::WellData> well);
 
-    /// Получить список загруженных скважин
-    std::vector<std::shared_ptr<models::WellData>>& wells();
+    /// Получить список загруженных скважин (порядок строк таблицы)
     const std::vector<std::shared_ptr<models::WellData>>& wells() const;
 
+    /// Скважина по идентификатору (nullptr, если не найдена)
+    std::shared_ptr<models::WellData> well(models::WellId id) const;
+
+    /// Позиция скважины в проекте (-1, если не найдена)
+    int indexOf(models::WellId id) const;
+
+    /// Реестр скважин с поиском по идентификатору, имени и UWI
+    const models::WellRegistry& registry() const;
+
+    /// Реестр для WellTableModel, которая читает скважины из него же и
+    /// переиндексирует имя и UWI после правок; порядок скважин меняет
+    /// только ProjectManager
+    models::WellRegistry& registry();
+
+    /// Последняя опубликованная неизменяемая версия скважины
+    /// @note Снимок можно передавать в фоновые потоки: он не меняется при правках
+    models::WellSnapshotPtr snapshot(models::WellId id) const;
+
+    /// Опубликовать текущее состояние скважины как новую версию
+    /// (вызывается после каждой завершённой правки)
+    /// @note Номера версий удалённой скважины не переиспользуются: после отмены
+    ///       удаления нумерация продолжается с последней опубликованной версии
+    void publishWell(models::WellId id);
+
     /// Получить фильтр файлов проекта
     static QString getProjectFileFilter();
 
@@ -140,12 +177,23 @@ signals:
     /// Сигнал об изменении списка скважин
     void wellsChanged();
 
+    /// Скважина вставлена в позицию index (перед wellsChanged)
+    void wellInserted(int index);
+
+    /// Скважина удалена из позиции index (перед wellsChanged)
+    void wellRemoved(int index, models::WellId id);
+
+    /// Сигнал о замене данных одной скважины (список не меняется)
+    void wellReplaced(int index);
+
 private:
     bool writeProjectJson(const QString& path);
     bool readProjectJson(const QString& path);
 
     ProjectData data_;
-    std::vector<std::shared_ptr<models::WellData>> wells_;
+    models::WellRegistry wells_;
+    std::unordered_map<models::WellId, models::WellSnapshotSlotPtr> snapshots_;
+    std::unordered_map<models::WellId, std::uint64_t> removed_versions_;  ///< Последние версии удалённых скважин
     QString project_file_path_;
     bool dirty_{false};
 };
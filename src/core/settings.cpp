@@ -72,6 +72,12 @@ void Settings::load() {
     auto_save_enabled_ = s.value("autoSave/enabled", true).toBool();
     auto_save_interval_minutes_ = s.value("autoSave/intervalMinutes", 5).toInt();
 
+    // История отмены
+    undo_limit_ = s.value("undo/limit", 200).toInt();
+
+    // Память
+    memory_soft_budget_mb_ = s.value("memory/softBudgetMb", 2048).toInt();
+
     // Единицы углов
     int unit = s.value("display/angleUnit", 0).toInt();
     angle_display_unit_ = static_cast<models::AngleUnit>(unit);
@@ -139,6 +145,12 @@ void Settings::save() {
     s.setValue("autoSave/enabled", auto_save_enabled_);
     s.setValue("autoSave/intervalMinutes", auto_save_interval_minutes_);
 
+    // История отмены
+    s.setValue("undo/limit", undo_limit_);
+
+    // Память
+    s.setValue("memory/softBudgetMb", memory_soft_budget_mb_);
+
     // Единицы углов
     s.setValue("display/angleUnit", static_cast<int>(angle_display_unit_));
 
@@ -222,6 +234,12 @@ void Settings::setAutoSaveEnabled(bool enabled) { auto_save_enabled_ = enabled;
 int Settings::autoSaveIntervalMinutes() const { return auto_save_interval_minutes_; }
 void Settings::setAutoSaveIntervalMinutes(int minutes) { auto_save_interval_minutes_ = minutes; }
 
+int Settings::undoLimit() const { return undo_limit_; }
+void Settings::setUndoLimit(int limit) { undo_limit_ = limit; }
+
+int Settings::memorySoftBudgetMb() const { return memory_soft_budget_mb_; }
+void Settings::setMemorySoftBudgetMb(int megabytes) { memory_soft_budget_mb_ = megabytes; }
+
 models::AngleUnit Settings::angleDisplayUnit() const { return angle_display_unit_; }
 void Settings::setAngleDisplayUnit(models::AngleUnit unit) { angle_display_unit_ = unit; }
 
@@ -85,6 +85,14 @@ public:
     int autoSaveIntervalMinutes() const;
     void setAutoSaveIntervalMinutes(int minutes);
 
+    // --- История отмены ---
+    int undoLimit() const;              ///< Макс. число шагов отмены (0 — без ограничения)
+    void setUndoLimit(int limit);
+
+    // --- Память ---
+    int memorySoftBudgetMb() const;     ///< Мягкий бюджет памяти, МБ (0 — без ограничения)
+    void setMemorySoftBudgetMb(int megabytes);
+
     // --- Единицы углов ---
     models::AngleUnit angleDisplayUnit() const;
     void setAngleDisplayUnit(models::AngleUnit unit);
@@ -133,6 +141,10 @@ private:
     bool auto_save_enabled_{true};
     int auto_save_interval_minutes_{5};
 
+    int undo_limit_{200};
+
+    int memory_soft_budget_mb_{2048};
+
     models::AngleUnit angle_display_unit_{models::AngleUnit::kDecimalDegrees};
 
     QString last_session_project_;
@@ -0,0 +1,225 @@
+#include "core/well_file_watcher.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "core/project_manager.h"
+
+namespace incline3d::core {
+
+namespace {
+constexpr int DEFAULT_DEBOUNCE_MS = 500;
+}
+
+WellFileWatcher::WellFileWatcher(ProjectManager* manager, QObject* parent)
+    : QObject(parent), manager_(manager) {
+    watcher_ = new QFileSystemWatcher(this);
+    connect(watcher_, &QFileSystemWatcher::fileChanged,
+            this, &WellFileWatcher::onFileChanged);
+
+    debounce_timer_ = new QTimer(this);
+    debounce_timer_->setSingleShot(true);
+    debounce_timer_->setInterval(DEFAULT_DEBOUNCE_MS);
+    connect(debounce_timer_, &QTimer::timeout,
+            this, &WellFileWatcher::onDebounceTimeout);
+
+    if (manager_) {
+        connect(manager_, &ProjectManager::wellsChanged,
+                this, &WellFileWatcher::syncWatchedFiles);
+    }
+}
+
+WellFileWatcher::~WellFileWatcher() = default;
+
+void WellFileWatcher::setDebounceInterval(int msec) {
+    debounce_timer_->setInterval(std::max(0, msec));
+}
+
+int WellFileWatcher::debounceInterval() const {
+    return debounce_timer_->interval();
+}
+
+void WellFileWatcher::setEnabled(bool enabled) {
+    if (enabled_ == enabled) {
+        return;
+    }
+    enabled_ = enabled;
+    if (!enabled_) {
+        debounce_timer_->stop();
+        pending_.clear();
+    }
+    syncWatchedFiles();
+}
+
+bool WellFileWatcher::isEnabled() const {
+    return enabled_;
+}
+
+QStringList WellFileWatcher::watchedFiles() const {
+    return watcher_->files();
+}
+
+void WellFileWatcher::setReplaceHandler(ReplaceHandler handler) {
+    replace_handler_ = std::move(handler);
+}
+
+QString WellFileWatcher::resolvePath(const QString& path) const {
+    if (path.isEmpty()) {
+        return {};
+    }
+    QFileInfo info(path);
+    if (info.isRelative() && manager_ && !manager_->projectFilePath().isEmpty()) {
+        QDir project_dir = QFileInfo(manager_->projectFilePath()).absoluteDir();
+        info = QFileInfo(project_dir.filePath(path));
+    }
+    return info.absoluteFilePath();
+}
+
+void WellFileWatcher::syncWatchedFiles() {
+    QHash<QString, FileFormat> wanted;
+    if (enabled_ && manager_) {
+        for (const auto& entry : manager_->projectData().well_entries) {
+            QString path = resolvePath(entry.file_path);
+            if (path.isEmpty()) {
+                continue;
+            }
+            FileFormat format = FileIO::stringToFormat(entry.format);
+            if (format == FileFormat::kUnknown) {
+                format = FileIO::detectFormat(path);
+            }
+            wanted.insert(path, format);
+        }
+    }
+
+    // Снимаем наблюдение с путей, которых больше нет в проекте
+    QStringList to_remove;
+    for (const auto& path : watcher_->files()) {
+        if (!wanted.contains(path)) {
+            to_remove << path;
+        }
+    }
+    if (!to_remove.isEmpty()) {
+        watcher_->removePaths(to_remove);
+    }
+
+    // Добавляем новые пути (существующие повторно не добавляются)
+    QStringList to_add;
+    const QStringList current = watcher_->files();
+    for (auto it = wanted.cbegin(); it != wanted.cend(); ++it) {
+        if (!current.contains(it.key()) && QFileInfo::exists(it.key())) {
+            to_add << it.key();
+        }
+    }
+    if (!to_add.isEmpty()) {
+        watcher_->addPaths(to_add);
+    }
+
+    formats_ = std::move(wanted);
+}
+
+void WellFileWatcher::onFileChanged(const QString& path) {
+    if (!enabled_ || !formats_.contains(path)) {
+        return;
+    }
+
+    // Атомарная запись (запись во временный файл + переименование) снимает
+    // путь с наблюдения — возвращаем его, если файл снова существует
+    if (!watcher_->files().contains(path) && QFileInfo::exists(path)) {
+        watcher_->addPath(path);
+    }
+
+    pending_.insert(path);
+    debounce_timer_->start();
+}
+
+void WellFileWatcher::onDebounceTimeout() {
+    const QSet<QString> paths = std::exchange(pending_, {});
+    for (const auto& path : paths) {
+        if (!QFileInfo::exists(path)) {
+            // Файл удалён или ещё переименовывается — ждём следующего события
+            continue;
+        }
+        if (!watcher_->files().contains(path)) {
+            watcher_->addPath(path);
+        }
+        if (in_flight_.contains(path)) {
+            dirty_in_flight_.insert(path);
+            continue;
+        }
+        startReload(path);
+    }
+}
+
+void WellFileWatcher::startReload(const QString& path) {
+    in_flight_.insert(path);
+    const FileFormat format = formats_.value(path, FileFormat::kUnknown);
+
+    auto* future_watcher = new QFutureWatcher<WellLoadResult>(this);
+    connect(future_watcher, &QFutureWatcher<WellLoadResult>::finished,
+            this, [this, future_watcher, path]() {
+                applyReload(path, future_watcher->result());
+                future_watcher->deleteLater();
+            });
+
+    // Разбор выполняется в пуле потоков; FileIO не имеет общего состояния
+    future_watcher->setFuture(QtConcurrent::run([path, format]() {
+        FileIO io;
+        return io.loadWell(path, format);
+    }));
+}
+
+void WellFileWatcher::applyReload(const QString& path, const WellLoadResult& result) {
+    in_flight_.remove(path);
+
+    if (dirty_in_flight_.remove(path)) {
+        // Файл изменился во время разбора — результат устарел
+        pending_.insert(path);
+        debounce_timer_->start();
+        return;
+    }
+
+    if (!result.success || !result.well) {
+        emit reloadFailed(path, result.error_message);
+        return;
+    }
+
+    if (!manager_) {
+        return;
+    }
+
+    // Один файл может быть подключён к нескольким скважинам проекта
+    std::vector<int> targets;
+    const auto& wells = manager_->wells();
+    for (size_t i = 0; i < wells.size(); ++i) {
+        const auto& well = wells[i];
+        if (!well || resolvePath(QString::fromStdString(well->source_file_path)) != path) {
+            continue;
+        }
+        // Несохранённые правки пользователя не перетираем
+        if (well->modified) {
+            emit reloadFailed(path, tr("Скважина изменена в программе, файл не перечитан"));
+            continue;
+        }
+        targets.push_back(static_cast<int>(i));
+    }
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        auto reloaded = (i + 1 == targets.size())
+                            ? result.well
+                            : std::make_shared<models::WellData>(*result.well);
+        const bool replaced = replace_handler_
+                                  ? replace_handler_(targets[i], std::move(reloaded))
+                                  : manager_->replaceWell(targets[i], std::move(reloaded));
+        if (replaced) {
+            emit wellReloaded(targets[i]);
+        }
+    }
+}
+
+}  // namespace incline3d::core
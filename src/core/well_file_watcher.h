@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <functional>
+#include <memory>
+
+#include "core/file_io.h"
+
+namespace incline3d::core {
+
+class ProjectManager;
+
+/// Наблюдатель за исходными файлами скважин проекта
+///
+/// Полевое ПО перезаписывает файлы замеров, пока GUI открыт. Наблюдатель
+/// объединяет пачки событий изменения (debounce), перечитывает в фоне только
+/// изменённые файлы и подменяет скважины через ProjectManager::replaceWell,
+/// не вызывая полного перестроения списка скважин.
+class WellFileWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    /// Подмена скважины в строке row перечитанной версией; true — подменена
+    using ReplaceHandler =
+        std::function<bool(int row, std::shared_ptr<models::WellData> well)>;
+
+    explicit WellFileWatcher(ProjectManager* manager, QObject* parent = nullptr);
+    ~WellFileWatcher() override;
+
+    /// Задержка объединения событий, мс
+    void setDebounceInterval(int msec);
+    int debounceInterval() const;
+
+    /// Включить/выключить наблюдение
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /// Список наблюдаемых файлов
+    QStringList watchedFiles() const;
+
+    /// Способ подмены скважины (по умолчанию — ProjectManager::replaceWell)
+    void setReplaceHandler(ReplaceHandler handler);
+
+public slots:
+    /// Синхронизировать список наблюдаемых файлов с записями проекта
+    void syncWatchedFiles();
+
+signals:
+    /// Скважина перечитана с диска и подменена в проекте
+    void wellReloaded(int index);
+
+    /// Не удалось перечитать файл
+    void reloadFailed(const QString& path, const QString& error);
+
+private slots:
+    void onFileChanged(const QString& path);
+    void onDebounceTimeout();
+
+private:
+    /// Запуск фонового перечитывания одного файла
+    void startReload(const QString& path);
+
+    /// Применение результата перечитывания в GUI-потоке
+    void applyReload(const QString& path, const WellLoadResult& result);
+
+    /// Абсолютный путь записи проекта
+    QString resolvePath(const QString& path) const;
+
+    ProjectManager* manager_{nullptr};
+    QFileSystemWatcher* watcher_{nullptr};
+    QTimer* debounce_timer_{nullptr};
+
+    /// Наблюдаемый путь → формат файла
+    QHash<QString, FileFormat> formats_;
+
+    /// Пути, изменившиеся с момента последнего срабатывания таймера
+    QSet<QString> pending_;
+
+    /// Пути, перечитываемые в данный момент
+    QSet<QString> in_flight_;
+
+    /// Пути, изменившиеся повторно во время перечитывания
+    QSet<QString> dirty_in_flight_;
+
+    ReplaceHandler replace_handler_;
+
+    bool enabled_{true};
+};
+
+}  // namespace incline3d::core
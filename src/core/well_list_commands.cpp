@@ -0,0 +1,129 @@
+#include "core/well_list_commands.h"
+
+namespace incline3d::core {
+
+namespace {
+
+QString wellName(const std::shared_ptr<models::WellData>& well) {
+    return well ? QString::fromStdString(well->metadata.well_name) : QString();
+}
+
+}  // namespace
+
+// --- AddWellCommand ---
+
+AddWellCommand::AddWellCommand(ProjectManager* manager, std::shared_ptr<models::WellData> well,
+                               QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , manager_(manager)
+    , well_(std::move(well)) {
+    setText(QObject::tr("Добавление скважины %1").arg(wellName(well_)));
+}
+
+void AddWellCommand::redo() {
+    if (!manager_ || !well_) {
+        return;
+    }
+    if (!entry_captured_) {
+        // Первое выполнение: запись проекта формирует сам ProjectManager
+        manager_->addWell(well_);
+        index_ = static_cast<int>(manager_->wells().size()) - 1;
+        const auto& entries = manager_->projectData().well_entries;
+        if (index_ >= 0 && index_ < static_cast<int>(entries.size())) {
+            entry_ = entries[index_];
+        }
+        entry_captured_ = true;
+        return;
+    }
+    manager_->insertWell(index_, well_, entry_);
+}
+
+void AddWellCommand::undo() {
+    if (!manager_ || !well_) {
+        return;
+    }
+    int index = manager_->indexOf(well_->id);
+    if (index < 0) {
+        return;
+    }
+    // Запись могла измениться (сохранение в другой файл) — сохраняем актуальную
+    const auto& entries = manager_->projectData().well_entries;
+    if (index < static_cast<int>(entries.size())) {
+        entry_ = entries[index];
+    }
+    index_ = index;
+    manager_->removeWell(index);
+}
+
+// --- RemoveWellCommand ---
+
+RemoveWellCommand::RemoveWellCommand(ProjectManager* manager, models::WellId id,
+                                     QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , manager_(manager)
+    , index_(manager ? manager->indexOf(id) : -1) {
+    if (manager_ && index_ >= 0) {
+        well_ = manager_->well(id);
+        const auto& entries = manager_->projectData().well_entries;
+        if (index_ < static_cast<int>(entries.size())) {
+            entry_ = entries[index_];
+        }
+    }
+    setText(QObject::tr("Удаление скважины %1").arg(wellName(well_)));
+}
+
+void RemoveWellCommand::redo() {
+    if (!manager_ || !well_) {
+        return;
+    }
+    int index = manager_->indexOf(well_->id);
+    if (index < 0) {
+        return;
+    }
+    const auto& entries = manager_->projectData().well_entries;
+    if (index < static_cast<int>(entries.size())) {
+        entry_ = entries[index];
+    }
+    index_ = index;
+    manager_->removeWell(index);
+}
+
+void RemoveWellCommand::undo() {
+    if (!manager_ || !well_) {
+        return;
+    }
+    manager_->insertWell(index_, well_, entry_);
+}
+
+// --- ReplaceWellCommand ---
+
+ReplaceWellCommand::ReplaceWellCommand(ProjectManager* manager, models::WellId id,
+                                       std::shared_ptr<models::WellData> well,
+                                       QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , manager_(manager)
+    , id_(id)
+    , before_(manager ? manager->well(id) : nullptr)
+    , after_(std::move(well)) {
+    setText(QObject::tr("Перечитывание скважины %1").arg(wellName(before_)));
+}
+
+void ReplaceWellCommand::redo() {
+    replaceWith(after_);
+}
+
+void ReplaceWellCommand::undo() {
+    replaceWith(before_);
+}
+
+void ReplaceWellCommand::replaceWith(const std::shared_ptr<models::WellData>& well) {
+    if (!manager_ || !well) {
+        return;
+    }
+    const int index = manager_->indexOf(id_);
+    if (index >= 0) {
+        manager_->replaceWell(index, well);
+    }
+}
+
+}  // namespace incline3d::core
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QPointer>
+#include <QUndoCommand>
+#include <memory>
+
+#include "core/project_manager.h"
+
+namespace incline3d::core {
+
+/// Команда добавления скважины в проект
+///
+/// Добавление выполняется в redo(), поэтому команду достаточно поместить
+/// в QUndoStack вместо прямого вызова ProjectManager::addWell.
+class AddWellCommand : public QUndoCommand {
+public:
+    AddWellCommand(ProjectManager* manager, std::shared_ptr<models::WellData> well,
+                   QUndoCommand* parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    QPointer<ProjectManager> manager_;
+    std::shared_ptr<models::WellData> well_;
+    ProjectData::WellEntry entry_;
+    int index_{-1};
+    bool entry_captured_{false};
+};
+
+/// Команда удаления скважины из проекта
+///
+/// Удалённая скважина и её запись проекта удерживаются командой,
+/// отмена возвращает скважину на прежнюю позицию.
+class RemoveWellCommand : public QUndoCommand {
+public:
+    RemoveWellCommand(ProjectManager* manager, models::WellId id,
+                      QUndoCommand* parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    QPointer<ProjectManager> manager_;
+    std::shared_ptr<models::WellData> well_;
+    ProjectData::WellEntry entry_;
+    int index_;
+};
+
+/// Команда подмены скважины перечитанной с диска версией
+///
+/// Команды истории удерживают объект скважины, поэтому перечитывание тоже
+/// попадает в историю: отмена возвращает прежний объект, и более ранние
+/// команды снова работают с тем объектом, который находится в проекте.
+class ReplaceWellCommand : public QUndoCommand {
+public:
+    ReplaceWellCommand(ProjectManager* manager, models::WellId id,
+                       std::shared_ptr<models::WellData> well,
+                       QUndoCommand* parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    void replaceWith(const std::shared_ptr<models::WellData>& well);
+
+    QPointer<ProjectManager> manager_;
+    models::WellId id_;
+    std::shared_ptr<models::WellData> before_;
+    std::shared_ptr<models::WellData> after_;
+};
+
+}  // namespace incline3d::core
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace incline3d::models {
+
+/// Массив с разбиением на блоки и разделяемым хранением (copy-on-write)
+///
+/// Копия массива копирует только указатели на блоки, поэтому хранение
+/// нескольких версий (например, в истории отмены) стоит O(число блоков),
+/// а неизменённые блоки разделяются между версиями. Изменение элемента
+/// копирует только содержащий его блок, если тот разделён с другой версией.
+///
+/// Доступ на чтение совместим с std::vector (size, operator[], front/back,
+/// range-for). Итераторы только константные: запись выполняется через
+/// set()/mutableAt() и модифицирующие операции контейнера.
+template <typename T, std::size_t ChunkSize = 256>
+class ChunkedArray {
+    static_assert(ChunkSize > 0, "ChunkSize должен быть положительным");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using const_reference = const T&;
+
+    /// Константный итератор произвольного доступа
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return (*owner_->chunks_[chunk_])[pos_]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator& operator++() {
+            if (++pos_ >= owner_->chunks_[chunk_]->size()) {
+                ++chunk_;
+                pos_ = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator& operator--() {
+            if (pos_ == 0) {
+                --chunk_;
+                pos_ = owner_->chunks_[chunk_]->size() - 1;
+            } else {
+                --pos_;
+            }
+            return *this;
+        }
+        const_iterator operator--(int) {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        const_iterator& operator+=(difference_type n) {
+            *this = owner_->iteratorAt(static_cast<size_type>(
+                static_cast<difference_type>(index()) + n));
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.index()) - static_cast<difference_type>(b.index());
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            return a.chunk_ == b.chunk_ && a.pos_ == b.pos_;
+        }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+        friend bool operator<(const const_iterator& a, const const_iterator& b) { return a.index() < b.index(); }
+        friend bool operator>(const const_iterator& a, const const_iterator& b) { return b < a; }
+        friend bool operator<=(const const_iterator& a, const const_iterator& b) { return !(b < a); }
+        friend bool operator>=(const const_iterator& a, const const_iterator& b) { return !(a < b); }
+
+        /// Позиция итератора в массиве
+        size_type index() const {
+            return chunk_ < owner_->chunks_.size() ? owner_->offsets_[chunk_] + pos_ : owner_->size_;
+        }
+
+    private:
+        friend class ChunkedArray;
+
+        const_iterator(const ChunkedArray* owner, size_type chunk, size_type pos)
+            : owner_(owner), chunk_(chunk), pos_(pos) {}
+
+        const ChunkedArray* owner_{nullptr};
+        size_type chunk_{0};
+        size_type pos_{0};
+    };
+
+    using iterator = const_iterator;
+
+    ChunkedArray() = default;
+
+    ChunkedArray(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+
+    explicit ChunkedArray(const std::vector<T>& values) {
+        assign(values.begin(), values.end());
+    }
+
+    // --- Чтение ---
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T& operator[](size_type index) const {
+        auto [chunk, pos] = locate(index);
+        return (*chunks_[chunk])[pos];
+    }
+
+    const T& at(size_type index) const {
+        if (index >= size_) {
+            throw std::out_of_range("ChunkedArray::at");
+        }
+        return (*this)[index];
+    }
+
+    const T& front() const { return chunks_.front()->front(); }
+    const T& back() const { return chunks_.back()->back(); }
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, chunks_.size(), 0); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /// Копия содержимого в непрерывный вектор
+    std::vector<T> toVector() const {
+        std::vector<T> result;
+        result.reserve(size_);
+        for (const auto& chunk : chunks_) {
+            result.insert(result.end(), chunk->begin(), chunk->end());
+        }
+        return result;
+    }
+
+    // --- Запись ---
+
+    void push_back(const T& value) {
+        if (chunks_.empty() || chunks_.back()->size() >= ChunkSize) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(ChunkSize);
+            chunks_.push_back(std::move(chunk));
+            offsets_.push_back(size_);
+        }
+        mutableChunk(chunks_.size() - 1).push_back(value);
+        ++size_;
+    }
+
+    const_iterator insert(const_iterator where, const T& value) {
+        const size_type index = where.index();
+        if (index >= size_) {
+            push_back(value);
+            return iteratorAt(index);
+        }
+
+        auto [chunk, pos] = locate(index);
+        auto& data = mutableChunk(chunk);
+        data.insert(data.begin() + static_cast<difference_type>(pos), value);
+        ++size_;
+
+        // Разбиваем переполненный блок, чтобы копирование при записи оставалось дешёвым
+        if (data.size() > 2 * ChunkSize) {
+            const auto half = static_cast<difference_type>(data.size() / 2);
+            auto tail = std::make_shared<Chunk>(data.begin() + half, data.end());
+            data.erase(data.begin() + half, data.end());
+            chunks_.insert(chunks_.begin() + static_cast<difference_type>(chunk) + 1, std::move(tail));
+        }
+        rebuildOffsets(chunk);
+        return iteratorAt(index);
+    }
+
+    const_iterator erase(const_iterator where) {
+        const size_type index = where.index();
+        if (index >= size_) {
+            return end();
+        }
+
+        auto [chunk, pos] = locate(index);
+        if (chunks_[chunk]->size() == 1) {
+            chunks_.erase(chunks_.begin() + static_cast<difference_type>(chunk));
+        } else {
+            auto& data = mutableChunk(chunk);
+            data.erase(data.begin() + static_cast<difference_type>(pos));
+        }
+        --size_;
+        rebuildOffsets(chunk);
+        return iteratorAt(index);
+    }
+
+    const_iterator erase(const_iterator first, const_iterator last) {
+        const size_type index = first.index();
+        for (auto count = last - first; count > 0; --count) {
+            erase(iteratorAt(index));
+        }
+        return iteratorAt(index);
+    }
+
+    void clear() {
+        chunks_.clear();
+        offsets_.clear();
+        size_ = 0;
+    }
+
+    /// Совместимость с std::vector; блоки выделяются по мере заполнения
+    void reserve(size_type) {}
+
+    /// Заменить элемент
+    void set(size_type index, const T& value) {
+        mutableAt(index) = value;
+    }
+
+    /// Ссылка на элемент для изменения (блок отделяется от других версий)
+    /// @note Ссылка действительна до следующей модифицирующей операции
+    T& mutableAt(size_type index) {
+        if (index >= size_) {
+            throw std::out_of_range("ChunkedArray::mutableAt");
+        }
+        auto [chunk, pos] = locate(index);
+        return mutableChunk(chunk)[pos];
+    }
+
+    /// Обратить порядок элементов
+    void reverse() {
+        std::vector<T> values = toVector();
+        std::reverse(values.begin(), values.end());
+        clear();
+        assign(values.begin(), values.end());
+    }
+
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // --- Диагностика разделения ---
+
+    /// Число блоков хранения
+    size_type chunkCount() const { return chunks_.size(); }
+
+    /// Объём памяти под данные, байт (разделяемые блоки учитываются полностью)
+    size_type memoryUsage() const {
+        size_type bytes = chunks_.capacity() * sizeof(std::shared_ptr<Chunk>) +
+                          offsets_.capacity() * sizeof(size_type);
+        for (const auto& chunk : chunks_) {
+            bytes += sizeof(Chunk) + chunk->capacity() * sizeof(T);
+        }
+        return bytes;
+    }
+
+    /// Число блоков, разделяемых с другой версией массива
+    size_type sharedChunkCount(const ChunkedArray& other) const {
+        std::unordered_set<const Chunk*> other_chunks;
+        other_chunks.reserve(other.chunks_.size());
+        for (const auto& chunk : other.chunks_) {
+            other_chunks.insert(chunk.get());
+        }
+        return static_cast<size_type>(std::count_if(
+            chunks_.begin(), chunks_.end(),
+            [&](const auto& chunk) { return other_chunks.count(chunk.get()) > 0; }));
+    }
+
+private:
+    using Chunk = std::vector<T>;
+
+    /// Номер блока и позиция в нём для индекса элемента
+    std::pair<size_type, size_type> locate(size_type index) const {
+        auto it = std::upper_bound(offsets_.begin(), offsets_.end(), index);
+        const auto chunk = static_cast<size_type>(std::distance(offsets_.begin(), it)) - 1;
+        return {chunk, index - offsets_[chunk]};
+    }
+
+    const_iterator iteratorAt(size_type index) const {
+        if (index >= size_) {
+            return end();
+        }
+        auto [chunk, pos] = locate(index);
+        return const_iterator(this, chunk, pos);
+    }
+
+    /// Блок для записи: если блок разделён с другой версией, он копируется
+    /// @note use_count() == 1 означает, что других владельцев нет и блок
+    ///       недоступен другим потокам; иначе пишем в собственную копию
+    Chunk& mutableChunk(size_type chunk) {
+        if (chunks_[chunk].use_count() > 1) {
+            chunks_[chunk] = std::make_shared<Chunk>(*chunks_[chunk]);
+        }
+        return *chunks_[chunk];
+    }
+
+    /// Пересчёт начальных индексов блоков начиная с заданного
+    void rebuildOffsets(size_type from) {
+        offsets_.resize(chunks_.size());
+        from = std::min(from, chunks_.size());
+        size_type offset = from == 0 ? 0 : offsets_[from - 1] + chunks_[from - 1]->size();
+        for (size_type i = from; i < chunks_.size(); ++i) {
+            offsets_[i] = offset;
+            offset += chunks_[i]->size();
+        }
+    }
+
+    /// Блоки хранения; разделяемый блок никогда не изменяется на месте
+    std::vector<std::shared_ptr<Chunk>> chunks_;
+
+    /// Индекс первого элемента каждого блока
+    std::vector<size_type> offsets_;
+
+    size_type size_{0};
+};
+
+}  // namespace incline3d::models
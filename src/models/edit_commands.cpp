@@ -0,0 +1,105 @@
+#include "models/edit_commands.h"
+
+#include "models/project_points_model.h"
+
+namespace incline3d::models {
+
+WellEditState WellEditState::capture(const WellData& well) {
+    WellEditState state;
+    state.metadata = well.metadata;
+    state.measurements = well.measurements;
+    state.results = well.results;
+    state.params = well.params;
+    state.max_inclination_deg = well.max_inclination_deg;
+    state.max_intensity_10m = well.max_intensity_10m;
+    state.max_intensity_10m_depth = well.max_intensity_10m_depth;
+    state.max_intensity_L = well.max_intensity_L;
+    state.max_intensity_L_depth = well.max_intensity_L_depth;
+    state.total_depth = well.total_depth;
+    state.horizontal_displacement = well.horizontal_displacement;
+    state.modified = well.modified;
+    return state;
+}
+
+void WellEditState::applyTo(WellData& well) const {
+    well.metadata = metadata;
+    well.measurements = measurements;
+    well.results = results;
+    well.params = params;
+    well.max_inclination_deg = max_inclination_deg;
+    well.max_intensity_10m = max_intensity_10m;
+    well.max_intensity_10m_depth = max_intensity_10m_depth;
+    well.max_intensity_L = max_intensity_L;
+    well.max_intensity_L_depth = max_intensity_L_depth;
+    well.total_depth = total_depth;
+    well.horizontal_displacement = horizontal_displacement;
+    well.modified = modified;
+}
+
+// --- WellEditCommand ---
+
+WellEditCommand::WellEditCommand(std::shared_ptr<WellData> well,
+                                 WellEditState before,
+                                 WellEditState after,
+                                 const QString& text,
+                                 AppliedCallback on_applied,
+                                 QUndoCommand* parent)
+    : QUndoCommand(text, parent)
+    , well_(std::move(well))
+    , before_(std::move(before))
+    , after_(std::move(after))
+    , on_applied_(std::move(on_applied)) {
+}
+
+void WellEditCommand::undo() {
+    apply(before_);
+}
+
+void WellEditCommand::redo() {
+    if (first_redo_) {
+        first_redo_ = false;
+        return;
+    }
+    apply(after_);
+}
+
+void WellEditCommand::apply(const WellEditState& state) {
+    if (!well_) {
+        return;
+    }
+    state.applyTo(*well_);
+    if (on_applied_) {
+        on_applied_(well_);
+    }
+}
+
+// --- ProjectPointEditCommand ---
+
+ProjectPointEditCommand::ProjectPointEditCommand(ProjectPointsModel* model, int row,
+                                                 ProjectPoint before, ProjectPoint after,
+                                                 const QString& text,
+                                                 QUndoCommand* parent)
+    : QUndoCommand(text, parent)
+    , model_(model)
+    , row_(row)
+    , before_(std::move(before))
+    , after_(std::move(after)) {
+}
+
+void ProjectPointEditCommand::undo() {
+    if (model_) {
+        model_->setPointAt(row_, before_);
+    }
+}
+
+void ProjectPointEditCommand::redo() {
+    if (first_redo_) {
+        first_redo_ = false;
+        return;
+    }
+    if (model_) {
+        model_->setPointAt(row_, after_);
+    }
+}
+
+}  // namespace incline3d::models
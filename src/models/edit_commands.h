@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QPointer>
+#include <QUndoCommand>
+#include <functional>
+#include <memory>
+
+#include "models/project_point.h"
+#include "models/well_data.h"
+
+namespace incline3d::models {
+
+class ProjectPointsModel;
+
+/// Редактируемое состояние скважины для истории отмены
+///
+/// Замеры хранятся блоками с разделением, результаты — колонками с общим
+/// хранилищем, поэтому снимок стоит O(число блоков), а соседние версии
+/// в истории разделяют все неизменённые данные.
+struct WellEditState {
+    WellMetadata metadata;
+    ChunkedArray<MeasuredPoint> measurements;
+    TrajectoryColumns results;
+    CalculationParams params;
+
+    double max_inclination_deg{0.0};
+    double max_intensity_10m{0.0};
+    double max_intensity_10m_depth{0.0};
+    double max_intensity_L{0.0};
+    double max_intensity_L_depth{0.0};
+    double total_depth{0.0};
+    double horizontal_displacement{0.0};
+
+    bool modified{false};
+
+    /// Снять состояние со скважины
+    static WellEditState capture(const WellData& well);
+
+    /// Записать состояние в скважину
+    void applyTo(WellData& well) const;
+};
+
+/// Команда изменения данных скважины (замеры, параметры, результаты)
+///
+/// Изменение выполняется до создания команды, поэтому первый redo(),
+/// вызываемый QUndoStack::push, пропускается.
+class WellEditCommand : public QUndoCommand {
+public:
+    /// Вызывается после undo/redo для обновления представлений
+    using AppliedCallback = std::function<void(const std::shared_ptr<WellData>&)>;
+
+    WellEditCommand(std::shared_ptr<WellData> well,
+                    WellEditState before,
+                    WellEditState after,
+                    const QString& text,
+                    AppliedCallback on_applied = {},
+                    QUndoCommand* parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    void apply(const WellEditState& state);
+
+    std::shared_ptr<WellData> well_;
+    WellEditState before_;
+    WellEditState after_;
+    AppliedCallback on_applied_;
+    bool first_redo_{true};
+};
+
+/// Команда изменения проектной точки
+class ProjectPointEditCommand : public QUndoCommand {
+public:
+    ProjectPointEditCommand(ProjectPointsModel* model, int row,
+                            ProjectPoint before, ProjectPoint after,
+                            const QString& text,
+                            QUndoCommand* parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    QPointer<ProjectPointsModel> model_;
+    int row_;
+    ProjectPoint before_;
+    ProjectPoint after_;
+    bool first_redo_{true};
+};
+
+}  // namespace incline3d::models
@@ -0,0 +1,103 @@
+#include "models/interned_string.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace incline3d::models {
+
+namespace {
+
+/// Хеш с поиском по string_view без создания временной std::string
+struct TransparentHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view value) const noexcept {
+        return std::hash<std::string_view>{}(value);
+    }
+};
+
+/// Узлы unordered_set не перемещаются при росте таблицы,
+/// поэтому указатели на значения остаются действительными
+struct PoolState {
+    mutable std::shared_mutex mutex;
+    std::unordered_set<std::string, TransparentHash, std::equal_to<>> values;
+    std::size_t bytes{0};
+};
+
+PoolState& poolState() {
+    static PoolState state;
+    return state;
+}
+
+const std::string& emptyString() {
+    static const std::string empty;
+    return empty;
+}
+
+}  // namespace
+
+// --- InternedString ---
+
+InternedString::InternedString(std::string_view value)
+    : value_(StringPool::instance().intern(value)) {
+}
+
+InternedString::InternedString(const std::string& value)
+    : InternedString(std::string_view(value)) {
+}
+
+InternedString::InternedString(const char* value)
+    : InternedString(value ? std::string_view(value) : std::string_view()) {
+}
+
+const std::string& InternedString::str() const {
+    return value_ ? *value_ : emptyString();
+}
+
+// --- StringPool ---
+
+StringPool& StringPool::instance() {
+    static StringPool pool;
+    return pool;
+}
+
+const std::string* StringPool::intern(std::string_view value) {
+    if (value.empty()) {
+        return nullptr;
+    }
+
+    auto& state = poolState();
+    {
+        std::shared_lock lock(state.mutex);
+        auto it = state.values.find(value);
+        if (it != state.values.end()) {
+            return &*it;
+        }
+    }
+
+    std::unique_lock lock(state.mutex);
+    auto [it, inserted] = state.values.emplace(value);
+    if (inserted) {
+        // Узел таблицы: строка, указатель на следующий узел и кэш хеша
+        state.bytes += sizeof(std::string) + 2 * sizeof(void*);
+        if (it->capacity() > std::string().capacity()) {   // Не помещается в SSO-буфер
+            state.bytes += it->capacity() + 1;
+        }
+    }
+    return &*it;
+}
+
+std::size_t StringPool::size() const {
+    auto& state = poolState();
+    std::shared_lock lock(state.mutex);
+    return state.values.size();
+}
+
+std::size_t StringPool::memoryUsage() const {
+    auto& state = poolState();
+    std::shared_lock lock(state.mutex);
+    return state.bytes + state.values.bucket_count() * sizeof(void*);
+}
+
+}  // namespace incline3d::models
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace incline3d::models {
+
+/// Строка из общего пула повторяющихся значений
+///
+/// Хранит только указатель на единственный экземпляр строки в StringPool,
+/// поэтому тысячи скважин одного месторождения или подрядчика делят одну
+/// копию значения, а сравнение на равенство сводится к сравнению указателей.
+/// Неявно приводится к const std::string&, так что существующий код
+/// (QString::fromStdString, empty(), сравнение с литералом) работает без
+/// изменений. Значения в пуле неизменяемы и не освобождаются до выхода.
+class InternedString {
+public:
+    InternedString() = default;
+    InternedString(std::string_view value);
+    InternedString(const std::string& value);
+    InternedString(const char* value);
+
+    const std::string& str() const;
+    operator const std::string&() const { return str(); }
+
+    const char* c_str() const { return str().c_str(); }
+    std::size_t size() const { return str().size(); }
+    bool empty() const { return value_ == nullptr; }
+
+    /// Адрес значения в пуле — одинаков для равных строк
+    const void* handle() const { return value_; }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) {
+        return a.value_ == b.value_;
+    }
+    friend bool operator==(const InternedString& a, const std::string& b) {
+        return a.str() == b;
+    }
+    friend bool operator==(const InternedString& a, std::string_view b) {
+        return std::string_view(a.str()) == b;
+    }
+    friend bool operator==(const InternedString& a, const char* b) {
+        return std::string_view(a.str()) == std::string_view(b);
+    }
+
+    /// Лексикографический порядок (для сортировки и упорядоченных контейнеров)
+    friend bool operator<(const InternedString& a, const InternedString& b) {
+        return a.value_ != b.value_ && a.str() < b.str();
+    }
+
+private:
+    const std::string* value_{nullptr};     ///< nullptr — пустая строка
+};
+
+/// Потокобезопасный пул уникальных строк
+class StringPool {
+public:
+    /// Общий пул приложения
+    static StringPool& instance();
+
+    /// Единственный экземпляр значения (nullptr для пустой строки)
+    const std::string* intern(std::string_view value);
+
+    /// Число уникальных строк
+    std::size_t size() const;
+
+    /// Оценка занимаемой памяти, байт
+    std::size_t memoryUsage() const;
+
+private:
+    StringPool() = default;
+};
+
+}  // namespace incline3d::models
+
+template <>
+struct std::hash<incline3d::models::InternedString> {
+    std::size_t operator()(const incline3d::models::InternedString& s) const noexcept {
+        return std::hash<const void*>{}(s.handle());
+    }
+};
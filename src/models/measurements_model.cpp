@@ -1,5 +1,8 @@
 #include "models/measurements_model.h"
 
+#include <QPointer>
+#include <QUndoStack>
+
 namespace incline3d::models {
 
 MeasurementsModel::MeasurementsModel(QObject* parent)
@@ -102,7 +105,16 @@ bool MeasurementsModel::setData(const QModelIndex& index, const QVariant& value,
         return false;
     }
 
-    auto& point = well_->measurements[index.row()];
+    auto before = beginEdit();
+    if (!applyData(index, value, role)) {
+        return false;
+    }
+    commitEdit(std::move(before), tr("Изменение замера"));
+    return true;
+}
+
+bool MeasurementsModel::applyData(const QModelIndex& index, const QVariant& value, int role) {
+    auto& point = well_->measurements.mutableAt(index.row());
     bool ok = false;
 
     switch (index.column()) {
@@ -185,11 +197,13 @@ void MeasurementsModel::addPoint(const MeasuredPoint& point) {
     if (!well_) {
         return;
     }
+    auto before = beginEdit();
     int row = static_cast<int>(well_->measurements.size());
     beginInsertRows(QModelIndex(), row, row);
     well_->measurements.push_back(point);
     well_->modified = true;
     endInsertRows();
+    commitEdit(std::move(before), tr("Добавление замера"));
     emit dataModified();
 }
 
@@ -197,10 +211,12 @@ void MeasurementsModel::removePoint(int index) {
     if (!well_ || index < 0 || index >= static_cast<int>(well_->measurements.size())) {
         return;
     }
+    auto before = beginEdit();
     beginRemoveRows(QModelIndex(), index, index);
     well_->measurements.erase(well_->measurements.begin() + index);
     well_->modified = true;
     endRemoveRows();
+    commitEdit(std::move(before), tr("Удаление замера"));
     emit dataModified();
 }
 
@@ -214,10 +230,12 @@ void MeasurementsModel::insertPoint(int index, const MeasuredPoint& point) {
     if (index > static_cast<int>(well_->measurements.size())) {
         index = static_cast<int>(well_->measurements.size());
     }
+    auto before = beginEdit();
     beginInsertRows(QModelIndex(), index, index);
     well_->measurements.insert(well_->measurements.begin() + index, point);
     well_->modified = true;
     endInsertRows();
+    commitEdit(std::move(before), tr("Вставка замера"));
     emit dataModified();
 }
 
@@ -234,4 +252,45 @@ void MeasurementsModel::refresh() {
     endResetModel();
 }
 
+void MeasurementsModel::setUndoStack(QUndoStack* stack) {
+    undo_stack_ = stack;
+}
+
+void MeasurementsModel::setEditAppliedCallback(WellEditCommand::AppliedCallback callback) {
+    edit_applied_ = std::move(callback);
+}
+
+std::optional<WellEditState> MeasurementsModel::beginEdit() const {
+    if (!undo_stack_ || !well_) {
+        return std::nullopt;
+    }
+    // Снимок разделяет блоки с текущими данными; копируется только изменяемый блок
+    return WellEditState::capture(*well_);
+}
+
+void MeasurementsModel::commitEdit(std::optional<WellEditState> before, const QString& text) {
+    if (!undo_stack_ || !before || !well_) {
+        return;
+    }
+    WellEditCommand::AppliedCallback on_applied = edit_applied_;
+    if (!on_applied) {
+        QPointer<MeasurementsModel> self(this);
+        on_applied = [self](const std::shared_ptr<WellData>& well) {
+            if (self) {
+                self->onEditApplied(well);
+            }
+        };
+    }
+    undo_stack_->push(new WellEditCommand(
+        well_, std::move(*before), WellEditState::capture(*well_), text,
+        std::move(on_applied)));
+}
+
+void MeasurementsModel::onEditApplied(const std::shared_ptr<WellData>& well) {
+    if (well == well_) {
+        refresh();
+    }
+    emit dataModified();
+}
+
 }  // namespace incline3d::models
@@ -2,9 +2,13 @@
 
 #include <QAbstractTableModel>
 #include <memory>
+#include <optional>
 
+#include "models/edit_commands.h"
 #include "models/well_data.h"
 
+class QUndoStack;
+
 namespace incline3d::models {
 
 /// Qt-модель для таблицы исходных замеров (ИНТЕРВАЛЫ_ИНКЛ / ЗНАЧЕНИЯ)
@@ -44,6 +48,13 @@ public:
     /// Обновить представление модели
     void refresh();
 
+    /// Стек отмены для правок (nullptr — правки без истории)
+    void setUndoStack(QUndoStack* stack);
+
+    /// Обработчик отмены/повтора правки; получает изменённую скважину,
+    /// которая к этому моменту может уже не быть текущей в модели
+    void setEditAppliedCallback(WellEditCommand::AppliedCallback callback);
+
     // Доступ к данным
     std::shared_ptr<WellData> well() const;
     bool hasWell() const;
@@ -52,7 +63,21 @@ signals:
     void dataModified();
 
 private:
+    /// Применение правки ячейки без записи в историю
+    bool applyData(const QModelIndex& index, const QVariant& value, int role);
+
+    /// Снимок состояния до правки (только если ведётся история)
+    std::optional<WellEditState> beginEdit() const;
+
+    /// Запись выполненной правки в стек отмены
+    void commitEdit(std::optional<WellEditState> before, const QString& text);
+
+    /// Обновление после отмены/повтора команды
+    void onEditApplied(const std::shared_ptr<WellData>& well);
+
     std::shared_ptr<WellData> well_;
+    QUndoStack* undo_stack_{nullptr};
+    WellEditCommand::AppliedCallback edit_applied_;
 };
 
 }  // namespace incline3d::models
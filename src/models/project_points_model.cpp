@@ -1,6 +1,9 @@
 #include "models/project_points_model.h"
 
 #include <QBrush>
+#include <QUndoStack>
+
+#include "models/edit_commands.h"
 
 namespace incline3d::models {
 
@@ -149,6 +152,19 @@ bool ProjectPointsModel::setData(const QModelIndex& index, const QVariant& value
         return false;
     }
 
+    ProjectPoint before = points_[index.row()];
+    if (!applyData(index, value, role)) {
+        return false;
+    }
+    if (undo_stack_) {
+        undo_stack_->push(new ProjectPointEditCommand(
+            this, index.row(), std::move(before), points_[index.row()],
+            tr("Изменение проектной точки")));
+    }
+    return true;
+}
+
+bool ProjectPointsModel::applyData(const QModelIndex& index, const QVariant& value, int role) {
     auto& point = points_[index.row()];
 
     if (role == Qt::CheckStateRole && index.column() == kColumnVisible) {
@@ -220,6 +236,23 @@ bool ProjectPointsModel::setData(const QModelIndex& index, const QVariant& value
     return false;
 }
 
+void ProjectPointsModel::setPointAt(int index, const ProjectPoint& point) {
+    if (index < 0 || index >= static_cast<int>(points_.size())) {
+        return;
+    }
+    const bool visibility_changed = points_[index].visible != point.visible;
+    points_[index] = point;
+    emit dataChanged(createIndex(index, 0), createIndex(index, kColumnCount - 1));
+    if (visibility_changed) {
+        emit pointVisibilityChanged(index, point.visible);
+    }
+    emit pointDataChanged(index);
+}
+
+void ProjectPointsModel::setUndoStack(QUndoStack* stack) {
+    undo_stack_ = stack;
+}
+
 void ProjectPointsModel::addPoint(const ProjectPoint& point) {
     int row = static_cast<int>(points_.size());
     beginInsertRows(QModelIndex(), row, row);
@@ -5,6 +5,8 @@
 
 #include "models/project_point.h"
 
+class QUndoStack;
+
 namespace incline3d::models {
 
 /// Qt-модель для таблицы проектных точек
@@ -43,6 +45,12 @@ public:
     void clear();
     void setPoints(const std::vector<ProjectPoint>& points);
 
+    /// Заменить точку целиком (используется командами отмены)
+    void setPointAt(int index, const ProjectPoint& point);
+
+    /// Стек отмены для правок ячеек (nullptr — правки без истории)
+    void setUndoStack(QUndoStack* stack);
+
     ProjectPoint& pointAt(int index);
     const ProjectPoint& pointAt(int index) const;
     int pointCount() const;
@@ -57,7 +65,11 @@ signals:
     void pointDataChanged(int index);
 
 private:
+    /// Применение правки ячейки без записи в историю
+    bool applyData(const QModelIndex& index, const QVariant& value, int role);
+
     std::vector<ProjectPoint> points_;
+    QUndoStack* undo_stack_{nullptr};
 };
 
 }  // namespace incline3d::models
@@ -4,6 +4,46 @@
 
 namespace incline3d::models {
 
+namespace {
+
+/// Колонка хранилища результатов для колонки таблицы
+TrajectoryColumns::Column sourceColumn(int column) {
+    using Column = TrajectoryColumns::Column;
+    switch (column) {
+        case ResultsModel::kColumnDepth:          return Column::kMeasuredDepth;
+        case ResultsModel::kColumnInclination:    return Column::kInclination;
+        case ResultsModel::kColumnAzimuth:        return Column::kAzimuth;
+        case ResultsModel::kColumnAppliedAzimuth: return Column::kAppliedAzimuth;
+        case ResultsModel::kColumnNorth:          return Column::kNorth;
+        case ResultsModel::kColumnEast:           return Column::kEast;
+        case ResultsModel::kColumnTvd:            return Column::kTvd;
+        case ResultsModel::kColumnDogleg:         return Column::kDogleg;
+        case ResultsModel::kColumnIntensity10:    return Column::kIntensity10m;
+        case ResultsModel::kColumnIntensityL:     return Column::kIntensityL;
+        case ResultsModel::kColumnMistakeX:       return Column::kMistakeX;
+        case ResultsModel::kColumnMistakeY:       return Column::kMistakeY;
+        case ResultsModel::kColumnMistakeZ:       return Column::kMistakeZ;
+        case ResultsModel::kColumnMistakeAbsg:    return Column::kMistakeAbsg;
+    }
+    return Column::kMeasuredDepth;
+}
+
+/// Число знаков после запятой для колонки таблицы
+int decimals(int column) {
+    switch (column) {
+        case ResultsModel::kColumnDogleg:
+        case ResultsModel::kColumnMistakeX:
+        case ResultsModel::kColumnMistakeY:
+        case ResultsModel::kColumnMistakeZ:
+        case ResultsModel::kColumnMistakeAbsg:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+}  // namespace
+
 ResultsModel::ResultsModel(QObject* parent)
     : QAbstractTableModel(parent) {
 }
@@ -28,42 +68,15 @@ QVariant ResultsModel::data(const QModelIndex& index, int role) const {
         return {};
     }
 
-    const auto& point = well_->results[index.row()];
+    const auto& results = well_->results;
+    const auto row = static_cast<size_t>(index.row());
 
     if (role == Qt::DisplayRole) {
-        switch (index.column()) {
-            case kColumnDepth:
-                return QString::number(point.measured_depth_m, 'f', 2);
-            case kColumnInclination:
-                return QString::number(point.inclination_deg, 'f', 2);
-            case kColumnAzimuth:
-                if (point.azimuth_deg.has_value()) {
-                    return QString::number(point.azimuth_deg.value(), 'f', 2);
-                }
-                return QString("-");
-            case kColumnAppliedAzimuth:
-                return QString::number(point.applied_azimuth_deg, 'f', 2);
-            case kColumnNorth:
-                return QString::number(point.north_m, 'f', 2);
-            case kColumnEast:
-                return QString::number(point.east_m, 'f', 2);
-            case kColumnTvd:
-                return QString::number(point.tvd_m, 'f', 2);
-            case kColumnDogleg:
-                return QString::number(point.dogleg_angle_deg, 'f', 3);
-            case kColumnIntensity10:
-                return QString::number(point.intensity_10m, 'f', 2);
-            case kColumnIntensityL:
-                return QString::number(point.intensity_L, 'f', 2);
-            case kColumnMistakeX:
-                return QString::number(point.mistake_x, 'f', 3);
-            case kColumnMistakeY:
-                return QString::number(point.mistake_y, 'f', 3);
-            case kColumnMistakeZ:
-                return QString::number(point.mistake_z, 'f', 3);
-            case kColumnMistakeAbsg:
-                return QString::number(point.mistake_absg, 'f', 3);
+        const auto column = sourceColumn(index.column());
+        if (!results.hasValue(column, row)) {
+            return QString("-");
         }
+        return QString::number(results.value(column, row), 'f', decimals(index.column()));
     }
 
     if (role == Qt::ToolTipRole) {
@@ -107,9 +120,7 @@ QVariant ResultsModel::data(const QModelIndex& index, int role) const {
     if (role == Qt::BackgroundRole) {
         if (index.column() == kColumnIntensity10 || index.column() == kColumnIntensityL) {
             double threshold = well_->params.intensity_threshold_deg;
-            double value = (index.column() == kColumnIntensity10)
-                               ? point.intensity_10m
-                               : point.intensity_L;
+            double value = results.value(sourceColumn(index.column()), row);
             if (threshold > 0 && value > threshold) {
                 return QBrush(QColor(255, 200, 200));  // Светло-красный
             }
@@ -0,0 +1,400 @@
+#include "models/segment_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "models/trajectory_columns.h"
+
+namespace incline3d::models {
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+/// Глубина стека обхода: дерево сбалансировано, 64 уровня хватает на 2^64 сегментов
+constexpr int kMaxStackDepth = 64;
+
+double dot(const Vec3& a, const Vec3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/// Расстояние вдоль луча до входа в бокс, расширенный на допуск луча
+/// @return бесконечность, если луч проходит мимо
+template <typename T>
+double boxEntry(const PickRay& ray, const Vec3& origin, const std::array<T, 3>& min,
+                const std::array<T, 3>& max) {
+    // Допуск берётся на самой дальней точке бокса — расширение с запасом
+    double center_distance2 = 0.0;
+    double half_diagonal2 = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        const double center = 0.5 * (static_cast<double>(min[axis]) + max[axis]) - origin[axis];
+        const double half = 0.5 * (static_cast<double>(max[axis]) - min[axis]);
+        center_distance2 += center * center;
+        half_diagonal2 += half * half;
+    }
+    const double expand = ray.radiusAt(std::sqrt(center_distance2) + std::sqrt(half_diagonal2));
+
+    double t_enter = 0.0;
+    double t_exit = std::numeric_limits<double>::infinity();
+    for (int axis = 0; axis < 3; ++axis) {
+        const double lo = min[axis] - expand - origin[axis];
+        const double hi = max[axis] + expand - origin[axis];
+        const double d = ray.direction[axis];
+        if (std::abs(d) < 1e-12) {
+            // Луч параллелен граням: начало должно лежать между ними
+            if (lo > 0.0 || hi < 0.0) {
+                return std::numeric_limits<double>::infinity();
+            }
+            continue;
+        }
+        double t0 = lo / d;
+        double t1 = hi / d;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        t_enter = std::max(t_enter, t0);
+        t_exit = std::min(t_exit, t1);
+        if (t_enter > t_exit) {
+            return std::numeric_limits<double>::infinity();
+        }
+    }
+    return t_enter;
+}
+
+/// Ближайшие точки луча (t ≥ 0) и отрезка [a, b] (Эриксон, «Real-Time Collision Detection», 5.1.9)
+void closestPoints(const Vec3& origin, const Vec3& direction, const Vec3& a, const Vec3& b,
+                   double& ray_t, double& segment_s, double& distance) {
+    const Vec3 u = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const Vec3 r = {a[0] - origin[0], a[1] - origin[1], a[2] - origin[2]};
+    const double uu = dot(u, u);
+    const double f = dot(direction, r);
+
+    double s = 0.0;
+    double t = 0.0;
+    if (uu <= 1e-18) {
+        t = std::max(0.0, f);
+    } else {
+        const double c = dot(u, r);
+        const double ud = dot(u, direction);
+        const double denom = uu - ud * ud;
+        if (denom > 1e-12 * uu) {
+            s = std::clamp((ud * f - c) / denom, 0.0, 1.0);
+        }
+        t = ud * s + f;
+        if (t < 0.0) {
+            t = 0.0;
+            s = std::clamp(-c / uu, 0.0, 1.0);
+        }
+    }
+
+    const Vec3 diff = {a[0] + s * u[0] - origin[0] - t * direction[0],
+                       a[1] + s * u[1] - origin[1] - t * direction[1],
+                       a[2] + s * u[2] - origin[2] - t * direction[2]};
+    ray_t = t;
+    segment_s = s;
+    distance = std::sqrt(dot(diff, diff));
+}
+
+/// Линейная интерполяция азимута по кратчайшей дуге
+double interpolateAzimuth(double from, double to, double fraction) {
+    const double delta = std::remainder(to - from, 360.0);
+    double result = std::fmod(from + fraction * delta, 360.0);
+    if (result < 0.0) {
+        result += 360.0;
+    }
+    return result;
+}
+
+}  // namespace
+
+SegmentBvh SegmentBvh::build(std::span<const double> east,
+                             std::span<const double> north,
+                             std::span<const double> tvd) {
+    if (east.size() != north.size() || east.size() != tvd.size()) {
+        throw std::invalid_argument("SegmentBvh: колонки координат разной длины");
+    }
+
+    SegmentBvh bvh;
+    if (east.size() < 2) {
+        return bvh;
+    }
+
+    bvh.origin_ = {east[0], north[0], tvd[0]};
+    bvh.points_.resize(east.size());
+    for (std::size_t i = 0; i < east.size(); ++i) {
+        bvh.points_[i] = {static_cast<float>(east[i] - bvh.origin_[0]),
+                          static_cast<float>(north[i] - bvh.origin_[1]),
+                          static_cast<float>(tvd[i] - bvh.origin_[2])};
+    }
+
+    const auto segments = static_cast<std::uint32_t>(east.size() - 1);
+    bvh.nodes_.reserve(2 * ((segments + kLeafSize - 1) / kLeafSize));
+    bvh.buildNode(0, segments);
+    return bvh;
+}
+
+std::uint32_t SegmentBvh::buildNode(std::uint32_t first, std::uint32_t count) {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({});
+
+    if (count <= kLeafSize) {
+        Node node{};
+        node.min = points_[first];
+        node.max = points_[first];
+        for (std::uint32_t p = first + 1; p <= first + count; ++p) {
+            for (int axis = 0; axis < 3; ++axis) {
+                node.min[axis] = std::min(node.min[axis], points_[p][axis]);
+                node.max[axis] = std::max(node.max[axis], points_[p][axis]);
+            }
+        }
+        node.first = first;
+        node.count = count;
+        nodes_[index] = node;
+        return index;
+    }
+
+    // Глубина рекурсии — log2(n / kLeafSize)
+    const std::uint32_t half = count / 2;
+    const std::uint32_t left = buildNode(first, half);
+    const std::uint32_t right = buildNode(first + half, count - half);
+
+    Node node{};
+    for (int axis = 0; axis < 3; ++axis) {
+        node.min[axis] = std::min(nodes_[left].min[axis], nodes_[right].min[axis]);
+        node.max[axis] = std::max(nodes_[left].max[axis], nodes_[right].max[axis]);
+    }
+    node.first = right;
+    node.count = 0;
+    nodes_[index] = node;
+    return index;
+}
+
+std::size_t SegmentBvh::segmentCount() const {
+    return points_.empty() ? 0 : points_.size() - 1;
+}
+
+std::optional<SegmentHit> SegmentBvh::pick(const PickRay& ray) const {
+    if (nodes_.empty()) {
+        return std::nullopt;
+    }
+
+    // Луч в системе координат дерева
+    const Vec3 origin = {ray.origin[0] - origin_[0], ray.origin[1] - origin_[1],
+                         ray.origin[2] - origin_[2]};
+
+    std::optional<SegmentHit> best;
+    double best_distance = std::numeric_limits<double>::infinity();
+
+    struct Entry {
+        std::uint32_t node;
+        double t_enter;
+    };
+    Entry stack[kMaxStackDepth];
+    int depth = 0;
+
+    const double root_enter = boxEntry(ray, origin, nodes_[0].min, nodes_[0].max);
+    if (std::isinf(root_enter)) {
+        return std::nullopt;
+    }
+    stack[depth++] = {0, root_enter};
+
+    while (depth > 0) {
+        const Entry entry = stack[--depth];
+        if (entry.t_enter > best_distance) {
+            continue;
+        }
+        const Node& node = nodes_[entry.node];
+
+        if (node.count > 0) {
+            for (std::uint32_t s = node.first; s < node.first + node.count; ++s) {
+                const Vec3 a = {points_[s][0], points_[s][1], points_[s][2]};
+                const Vec3 b = {points_[s + 1][0], points_[s + 1][1], points_[s + 1][2]};
+                double t = 0.0;
+                double fraction = 0.0;
+                double miss = 0.0;
+                closestPoints(origin, ray.direction, a, b, t, fraction, miss);
+                if (miss <= ray.radiusAt(t) && t < best_distance) {
+                    best_distance = t;
+                    best = SegmentHit{s, fraction, t, miss};
+                }
+            }
+            continue;
+        }
+
+        // Ближний потомок кладётся последним и обходится первым
+        const std::uint32_t left = entry.node + 1;
+        const std::uint32_t right = node.first;
+        const double left_enter = boxEntry(ray, origin, nodes_[left].min, nodes_[left].max);
+        const double right_enter = boxEntry(ray, origin, nodes_[right].min, nodes_[right].max);
+        const bool left_first = left_enter <= right_enter;
+        const Entry near{left_first ? left : right, left_first ? left_enter : right_enter};
+        const Entry far{left_first ? right : left, left_first ? right_enter : left_enter};
+        // Промах (бесконечность) и узлы не ближе найденного попадания не обходятся
+        if (far.t_enter < best_distance) {
+            stack[depth++] = far;
+        }
+        if (near.t_enter < best_distance) {
+            stack[depth++] = near;
+        }
+    }
+
+    return best;
+}
+
+std::size_t SegmentBvh::memoryUsage() const {
+    return points_.capacity() * sizeof(points_[0]) + nodes_.capacity() * sizeof(Node);
+}
+
+// --- TrajectoryBvh ---
+
+TrajectoryBvh TrajectoryBvh::build(std::span<const Bounds> bounds) {
+    TrajectoryBvh bvh;
+    if (bounds.empty()) {
+        return bvh;
+    }
+    const auto count = static_cast<std::uint32_t>(bounds.size());
+    bvh.items_.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        bvh.items_[i] = i;
+    }
+    bvh.nodes_.reserve(2 * ((count + kLeafSize - 1) / kLeafSize));
+    bvh.buildNode(bounds, 0, count);
+    return bvh;
+}
+
+std::uint32_t TrajectoryBvh::buildNode(std::span<const Bounds> bounds, std::uint32_t first,
+                                       std::uint32_t count) {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({});
+
+    Node node{};
+    node.min = bounds[items_[first]].min;
+    node.max = bounds[items_[first]].max;
+    Vec3 center_min = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                       std::numeric_limits<double>::infinity()};
+    Vec3 center_max = {-center_min[0], -center_min[1], -center_min[2]};
+    for (std::uint32_t i = first; i < first + count; ++i) {
+        const Bounds& box = bounds[items_[i]];
+        for (int axis = 0; axis < 3; ++axis) {
+            node.min[axis] = std::min(node.min[axis], box.min[axis]);
+            node.max[axis] = std::max(node.max[axis], box.max[axis]);
+            const double center = 0.5 * (box.min[axis] + box.max[axis]);
+            center_min[axis] = std::min(center_min[axis], center);
+            center_max[axis] = std::max(center_max[axis], center);
+        }
+    }
+
+    if (count <= kLeafSize) {
+        node.first = first;
+        node.count = count;
+        nodes_[index] = node;
+        return index;
+    }
+
+    // Деление по медиане: глубина — log2(n / kLeafSize) при любом расположении кустов
+    int axis = 0;
+    for (int a = 1; a < 3; ++a) {
+        if (center_max[a] - center_min[a] > center_max[axis] - center_min[axis]) {
+            axis = a;
+        }
+    }
+    const std::uint32_t half = count / 2;
+    std::nth_element(items_.begin() + first, items_.begin() + first + half, items_.begin() + first + count,
+                     [&bounds, axis](std::uint32_t a, std::uint32_t b) {
+                         return bounds[a].min[axis] + bounds[a].max[axis] <
+                                bounds[b].min[axis] + bounds[b].max[axis];
+                     });
+    buildNode(bounds, first, half);
+    node.first = buildNode(bounds, first + half, count - half);
+    node.count = 0;
+    nodes_[index] = node;
+    return index;
+}
+
+std::optional<TrajectoryBvh::Hit> TrajectoryBvh::pick(const PickRay& ray, const ItemPick& pick_item) const {
+    if (nodes_.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<Hit> best;
+    double best_distance = std::numeric_limits<double>::infinity();
+
+    struct Entry {
+        std::uint32_t node;
+        double t_enter;
+    };
+    Entry stack[kMaxStackDepth];
+    int depth = 0;
+
+    const double root_enter = boxEntry(ray, ray.origin, nodes_[0].min, nodes_[0].max);
+    if (std::isinf(root_enter)) {
+        return std::nullopt;
+    }
+    stack[depth++] = {0, root_enter};
+
+    while (depth > 0) {
+        const Entry entry = stack[--depth];
+        if (entry.t_enter > best_distance) {
+            continue;
+        }
+        const Node& node = nodes_[entry.node];
+
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const auto hit = pick_item(items_[i]);
+                if (hit && hit->ray_distance < best_distance) {
+                    best_distance = hit->ray_distance;
+                    best = Hit{items_[i], *hit};
+                }
+            }
+            continue;
+        }
+
+        const std::uint32_t left = entry.node + 1;
+        const std::uint32_t right = node.first;
+        const double left_enter = boxEntry(ray, ray.origin, nodes_[left].min, nodes_[left].max);
+        const double right_enter = boxEntry(ray, ray.origin, nodes_[right].min, nodes_[right].max);
+        const bool left_first = left_enter <= right_enter;
+        const Entry near{left_first ? left : right, left_first ? left_enter : right_enter};
+        const Entry far{left_first ? right : left, left_first ? right_enter : left_enter};
+        // Промах (бесконечность) и узлы не ближе найденного попадания не обходятся
+        if (far.t_enter < best_distance) {
+            stack[depth++] = far;
+        }
+        if (near.t_enter < best_distance) {
+            stack[depth++] = near;
+        }
+    }
+
+    return best;
+}
+
+StationSample sample_station(const TrajectoryColumns& columns, const SegmentHit& hit) {
+    using Column = TrajectoryColumns::Column;
+
+    const std::size_t i = hit.segment;
+    const std::size_t j = std::min<std::size_t>(i + 1, columns.size() - 1);
+    const double s = hit.fraction;
+    const auto lerp = [&](Column column) {
+        const double a = columns.value(column, i);
+        return a + s * (columns.value(column, j) - a);
+    };
+
+    StationSample sample;
+    sample.md_m = lerp(Column::kMeasuredDepth);
+    sample.tvd_m = lerp(Column::kTvd);
+    sample.inclination_deg = lerp(Column::kInclination);
+    sample.north_m = lerp(Column::kNorth);
+    sample.east_m = lerp(Column::kEast);
+
+    const auto azimuth_from = columns.optionalValue(Column::kAzimuth, i);
+    const auto azimuth_to = columns.optionalValue(Column::kAzimuth, j);
+    if (azimuth_from && azimuth_to) {
+        sample.azimuth_deg = interpolateAzimuth(*azimuth_from, *azimuth_to, s);
+    }
+    return sample;
+}
+
+}  // namespace incline3d::models
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace incline3d::models {
+
+class TrajectoryColumns;
+
+/// Луч выбора с допуском, растущим вдоль луча (конус вокруг луча)
+///
+/// Координаты — (восток, север, TVD), как в результатах расчёта. Для
+/// перспективной камеры допуск в N пикселей растёт пропорционально
+/// расстоянию от камеры.
+struct PickRay {
+    std::array<double, 3> origin{};     ///< Начало луча
+    std::array<double, 3> direction{};  ///< Единичное направление
+    double radius_m{0.0};               ///< Допуск в начале луча, м
+    double radius_per_m{0.0};           ///< Прирост допуска на метр вдоль луча
+
+    double radiusAt(double distance) const { return radius_m + radius_per_m * distance; }
+};
+
+/// Попадание луча в траекторию
+struct SegmentHit {
+    std::uint32_t segment{0};       ///< Сегмент между точками segment и segment + 1
+    double fraction{0.0};           ///< Положение на сегменте, 0..1
+    double ray_distance{0.0};       ///< Расстояние от начала луча, м
+    double miss_distance{0.0};      ///< Расстояние от луча до траектории, м
+};
+
+/// Значения траектории в точке попадания
+struct StationSample {
+    double md_m{0.0};
+    double tvd_m{0.0};
+    double inclination_deg{0.0};
+    std::optional<double> azimuth_deg;  ///< Нет, если азимут не задан на концах сегмента
+    double north_m{0.0};
+    double east_m{0.0};
+};
+
+/// Иерархия ограничивающих боксов над сегментами траектории
+///
+/// Точки идут вдоль ствола, поэтому сегменты с близкими номерами близки и в
+/// пространстве: дерево строится делением диапазона номеров пополам, без
+/// сортировки, за O(n), а боксы узлов получаются плотными. Запрос обходит
+/// ближний к лучу потомок первым и отбрасывает узлы дальше найденного
+/// попадания — O(log n) на траекторию.
+///
+/// Координаты хранятся в float относительно первой точки (миллиметровая
+/// точность на десятках километров при вдвое меньшей памяти).
+///
+/// Дерево кэшируется вместе с результатами (TrajectoryColumns::segmentBvh()),
+/// поэтому при изменении одной скважины перестраивается только её дерево.
+class SegmentBvh {
+public:
+    /// Наибольшее число сегментов в листе
+    static constexpr std::uint32_t kLeafSize = 4;
+
+    /// Построить дерево по координатам точек траектории
+    static SegmentBvh build(std::span<const double> east,
+                            std::span<const double> north,
+                            std::span<const double> tvd);
+
+    bool empty() const { return nodes_.empty(); }
+
+    /// Число сегментов (точек минус один)
+    std::size_t segmentCount() const;
+
+    /// Ближайшее к началу луча попадание в пределах допуска
+    std::optional<SegmentHit> pick(const PickRay& ray) const;
+
+    /// Объём памяти под узлы и точки, байт
+    std::size_t memoryUsage() const;
+
+private:
+    /// Узел в порядке обхода «корень, левый, правый»: левый потомок следует сразу за узлом
+    struct Node {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+        std::uint32_t first;    ///< Лист: первый сегмент; внутренний узел: номер правого потомка
+        std::uint32_t count;    ///< Лист: число сегментов; внутренний узел: 0
+    };
+
+    std::uint32_t buildNode(std::uint32_t first, std::uint32_t count);
+
+    std::array<double, 3> origin_{};
+    std::vector<std::array<float, 3>> points_;  ///< Относительно origin_
+    std::vector<Node> nodes_;
+};
+
+/// Верхний уровень выбора: иерархия боксов над траекториями
+///
+/// Строится по габаритам траекторий делением по медиане центров вдоль самой
+/// длинной оси (O(n log n), скважин — сотни и тысячи). Запрос обходит
+/// траектории, чьи боксы с допуском луча пересекает луч, начиная с ближнего
+/// потомка, и проверяет каждую по её SegmentBvh; узлы дальше найденного
+/// попадания отбрасываются, поэтому скважины за пределами луча не
+/// просматриваются вовсе.
+class TrajectoryBvh {
+public:
+    /// Наибольшее число траекторий в листе
+    static constexpr std::uint32_t kLeafSize = 2;
+
+    /// Габариты траектории (восток, север, TVD)
+    struct Bounds {
+        std::array<double, 3> min{};
+        std::array<double, 3> max{};
+    };
+
+    /// Попадание в траекторию с номером item (позиция в bounds при построении)
+    struct Hit {
+        std::uint32_t item{0};
+        SegmentHit hit;
+    };
+
+    /// Попадание луча в траекторию с номером item
+    using ItemPick = std::function<std::optional<SegmentHit>(std::uint32_t item)>;
+
+    static TrajectoryBvh build(std::span<const Bounds> bounds);
+
+    bool empty() const { return nodes_.empty(); }
+    std::size_t size() const { return items_.size(); }
+
+    /// Ближайшее к началу луча попадание среди траекторий
+    std::optional<Hit> pick(const PickRay& ray, const ItemPick& pick_item) const;
+
+private:
+    /// Узел в порядке «корень, левый, правый» (как в SegmentBvh)
+    struct Node {
+        std::array<double, 3> min;
+        std::array<double, 3> max;
+        std::uint32_t first;    ///< Лист: первая позиция в items_; внутренний узел: номер правого потомка
+        std::uint32_t count;    ///< Лист: число траекторий; внутренний узел: 0
+    };
+
+    std::uint32_t buildNode(std::span<const Bounds> bounds, std::uint32_t first, std::uint32_t count);
+
+    std::vector<std::uint32_t> items_;  ///< Номера траекторий в порядке листьев
+    std::vector<Node> nodes_;
+};
+
+/// Значения траектории в точке попадания (линейная интерполяция по сегменту)
+StationSample sample_station(const TrajectoryColumns& columns, const SegmentHit& hit);
+
+}  // namespace incline3d::models
@@ -0,0 +1,417 @@
+#include "models/trajectory_columns.h"
+
+#include <stdexcept>
+
+#include "models/well_data.h"
+
+namespace incline3d::models {
+
+namespace {
+
+using Column = TrajectoryColumns::Column;
+
+/// Колонки, создаваемые только при появлении непустого значения
+bool isSparse(int column) {
+    switch (static_cast<Column>(column)) {
+        case Column::kMeasuredDepth:
+        case Column::kInclination:
+        case Column::kAppliedAzimuth:
+        case Column::kNorth:
+        case Column::kEast:
+        case Column::kTvd:
+        case Column::kDogleg:
+        case Column::kIntensity10m:
+        case Column::kIntensityL:
+            return false;
+        default:
+            return true;
+    }
+}
+
+double fromOptional(const std::optional<double>& value, bool& present) {
+    present = value.has_value();
+    return value.value_or(0.0);
+}
+
+/// Значение поля точки и признак его наличия
+double fieldValue(const ProcessedPoint& pt, int column, bool& present) {
+    present = true;
+    switch (static_cast<Column>(column)) {
+        case Column::kMeasuredDepth:        return pt.measured_depth_m;
+        case Column::kInclination:          return pt.inclination_deg;
+        case Column::kAzimuth:              return fromOptional(pt.azimuth_deg, present);
+        case Column::kAppliedAzimuth:       return pt.applied_azimuth_deg;
+        case Column::kNorth:                return pt.north_m;
+        case Column::kEast:                 return pt.east_m;
+        case Column::kTvd:                  return pt.tvd_m;
+        case Column::kTvdBgl:               return fromOptional(pt.tvd_bgl_m, present);
+        case Column::kTvdBml:               return fromOptional(pt.tvd_bml_m, present);
+        case Column::kAbsoluteElevation:    return fromOptional(pt.absolute_elevation_m, present);
+        case Column::kDogleg:               return pt.dogleg_angle_deg;
+        case Column::kIntensity10m:         return pt.intensity_10m;
+        case Column::kIntensityL:           return pt.intensity_L;
+        case Column::kSmoothedIntensity10m: return pt.smoothed_intensity_10m;
+        case Column::kSmoothedIntensityL:   return pt.smoothed_intensity_L;
+        case Column::kMistakeX:             return pt.mistake_x;
+        case Column::kMistakeY:             return pt.mistake_y;
+        case Column::kMistakeZ:             return pt.mistake_z;
+        case Column::kMistakeAbsg:          return pt.mistake_absg;
+        case Column::kMistakeIntensity:     return pt.mistake_intensity;
+    }
+    return 0.0;
+}
+
+void setField(ProcessedPoint& pt, int column, double value, bool present) {
+    const std::optional<double> optional =
+        present ? std::optional<double>(value) : std::nullopt;
+    switch (static_cast<Column>(column)) {
+        case Column::kMeasuredDepth:        pt.measured_depth_m = value; break;
+        case Column::kInclination:          pt.inclination_deg = value; break;
+        case Column::kAzimuth:              pt.azimuth_deg = optional; break;
+        case Column::kAppliedAzimuth:       pt.applied_azimuth_deg = value; break;
+        case Column::kNorth:                pt.north_m = value; break;
+        case Column::kEast:                 pt.east_m = value; break;
+        case Column::kTvd:                  pt.tvd_m = value; break;
+        case Column::kTvdBgl:               pt.tvd_bgl_m = optional; break;
+        case Column::kTvdBml:               pt.tvd_bml_m = optional; break;
+        case Column::kAbsoluteElevation:    pt.absolute_elevation_m = optional; break;
+        case Column::kDogleg:               pt.dogleg_angle_deg = value; break;
+        case Column::kIntensity10m:         pt.intensity_10m = value; break;
+        case Column::kIntensityL:           pt.intensity_L = value; break;
+        case Column::kSmoothedIntensity10m: pt.smoothed_intensity_10m = value; break;
+        case Column::kSmoothedIntensityL:   pt.smoothed_intensity_L = value; break;
+        case Column::kMistakeX:             pt.mistake_x = value; break;
+        case Column::kMistakeY:             pt.mistake_y = value; break;
+        case Column::kMistakeZ:             pt.mistake_z = value; break;
+        case Column::kMistakeAbsg:          pt.mistake_absg = value; break;
+        case Column::kMistakeIntensity:     pt.mistake_intensity = value; break;
+    }
+}
+
+constexpr std::size_t kBitsPerWord = 64;
+
+}  // namespace
+
+// --- const_iterator ---
+
+ProcessedPoint TrajectoryColumns::const_iterator::operator*() const {
+    return (*owner_)[index_];
+}
+
+ProcessedPoint TrajectoryColumns::const_iterator::operator[](difference_type n) const {
+    return (*owner_)[index_ + n];
+}
+
+// --- TrajectoryColumns ---
+
+TrajectoryColumns::Storage::Storage(const Storage& other)
+    : size(other.size)
+    , columns(other.columns) {
+}
+
+std::size_t TrajectoryColumns::size() const {
+    return d_ ? d_->size : 0;
+}
+
+bool TrajectoryColumns::empty() const {
+    return size() == 0;
+}
+
+void TrajectoryColumns::clear() {
+    d_.reset();
+}
+
+void TrajectoryColumns::reserve(std::size_t count) {
+    Storage& storage = detach();
+    for (int c = 0; c < kColumnCount; ++c) {
+        if (!isSparse(c)) {
+            detachColumn(storage, c).values.reserve(count);
+        }
+    }
+}
+
+void TrajectoryColumns::push_back(const ProcessedPoint& point) {
+    Storage& storage = detach();
+    for (int c = 0; c < kColumnCount; ++c) {
+        bool present = true;
+        const double value = fieldValue(point, c, present);
+        writeCell(storage, c, storage.size, value, present, true);
+    }
+    ++storage.size;
+}
+
+void TrajectoryColumns::set(std::size_t index, const ProcessedPoint& point) {
+    if (index >= size()) {
+        throw std::out_of_range("TrajectoryColumns::set");
+    }
+    Storage& storage = detach();
+    for (int c = 0; c < kColumnCount; ++c) {
+        bool present = true;
+        const double value = fieldValue(point, c, present);
+        writeCell(storage, c, index, value, present, false);
+    }
+}
+
+ProcessedPoint TrajectoryColumns::operator[](std::size_t index) const {
+    ProcessedPoint point;
+    for (int c = 0; c < kColumnCount; ++c) {
+        const auto column = static_cast<Column>(c);
+        setField(point, c, value(column, index), hasValue(column, index));
+    }
+    return point;
+}
+
+ProcessedPoint TrajectoryColumns::at(std::size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("TrajectoryColumns::at");
+    }
+    return (*this)[index];
+}
+
+ProcessedPoint TrajectoryColumns::front() const {
+    return at(0);
+}
+
+ProcessedPoint TrajectoryColumns::back() const {
+    return at(size() - 1);
+}
+
+std::span<const double> TrajectoryColumns::column(Column column) const {
+    if (!d_ || !d_->columns[static_cast<int>(column)]) {
+        return {};
+    }
+    return d_->columns[static_cast<int>(column)]->values;
+}
+
+double TrajectoryColumns::value(Column column, std::size_t index) const {
+    const auto values = this->column(column);
+    return values.empty() ? 0.0 : values[index];
+}
+
+bool TrajectoryColumns::hasValue(Column column, std::size_t index) const {
+    if (!isOptional(column)) {
+        return true;
+    }
+    if (!d_ || !d_->columns[static_cast<int>(column)]) {
+        return false;
+    }
+    const auto& bits = d_->columns[static_cast<int>(column)]->validity;
+    const std::size_t word = index / kBitsPerWord;
+    return word < bits.size() && (bits[word] >> (index % kBitsPerWord)) & 1u;
+}
+
+std::optional<double> TrajectoryColumns::optionalValue(Column column, std::size_t index) const {
+    if (!hasValue(column, index)) {
+        return std::nullopt;
+    }
+    return value(column, index);
+}
+
+bool TrajectoryColumns::isOptional(Column column) {
+    switch (column) {
+        case Column::kAzimuth:
+        case Column::kTvdBgl:
+        case Column::kTvdBml:
+        case Column::kAbsoluteElevation:
+            return true;
+        default:
+            return false;
+    }
+}
+
+WellGeometrySummary TrajectoryColumns::geometry() const {
+    if (!d_) {
+        return {};
+    }
+    auto cached = d_->geometry.load();
+    if (!cached) {
+        // Одновременный расчёт в двух потоках даёт одинаковый результат
+        cached = std::make_shared<const WellGeometrySummary>(WellGeometrySummary::compute(*this));
+        d_->geometry.store(cached);
+    }
+    return *cached;
+}
+
+std::shared_ptr<const TrajectoryLod> TrajectoryColumns::lod() const {
+    if (!d_ || d_->size == 0) {
+        return nullptr;
+    }
+    auto cached = d_->lod.load();
+    if (!cached) {
+        cached = std::make_shared<const TrajectoryLod>(TrajectoryLod::build(
+            column(Column::kEast), column(Column::kNorth), column(Column::kTvd)));
+        d_->lod.store(cached);
+    }
+    return cached;
+}
+
+std::shared_ptr<const SegmentBvh> TrajectoryColumns::segmentBvh() const {
+    if (!d_ || d_->size < 2) {
+        return nullptr;
+    }
+    auto cached = d_->segment_bvh.load();
+    if (!cached) {
+        cached = std::make_shared<const SegmentBvh>(SegmentBvh::build(
+            column(Column::kEast), column(Column::kNorth), column(Column::kTvd)));
+        d_->segment_bvh.store(cached);
+    }
+    return cached;
+}
+
+std::uint64_t TrajectoryColumns::revision() const {
+    if (!d_) {
+        return 0;
+    }
+    std::uint64_t current = d_->revision.load();
+    if (current == 0) {
+        static std::atomic<std::uint64_t> next_revision{1};
+        const std::uint64_t assigned = next_revision.fetch_add(1);
+        // При гонке остаётся номер, назначенный первым
+        if (d_->revision.compare_exchange_strong(current, assigned)) {
+            current = assigned;
+        }
+    }
+    return current;
+}
+
+std::size_t TrajectoryColumns::memoryUsage() const {
+    if (!d_) {
+        return 0;
+    }
+    std::size_t bytes = sizeof(Storage);
+    for (const auto& column : d_->columns) {
+        if (column) {
+            bytes += sizeof(ColumnData);
+            bytes += column->values.capacity() * sizeof(double);
+            bytes += column->validity.capacity() * sizeof(std::uint64_t);
+        }
+    }
+    return bytes;
+}
+
+std::size_t TrajectoryColumns::cacheMemoryUsage() const {
+    if (!d_) {
+        return 0;
+    }
+    std::size_t bytes = 0;
+    if (const auto lod = d_->lod.load()) {
+        bytes += lod->memoryUsage();
+    }
+    if (const auto bvh = d_->segment_bvh.load()) {
+        bytes += bvh->memoryUsage();
+    }
+    return bytes;
+}
+
+std::size_t TrajectoryColumns::releaseDerivedCaches() const {
+    if (!d_) {
+        return 0;
+    }
+    std::size_t bytes = 0;
+    if (const auto lod = d_->lod.exchange(nullptr)) {
+        bytes += lod->memoryUsage();
+    }
+    if (const auto bvh = d_->segment_bvh.exchange(nullptr)) {
+        bytes += bvh->memoryUsage();
+    }
+    return bytes;
+}
+
+bool TrajectoryColumns::sharesStorageWith(const TrajectoryColumns& other) const {
+    return d_ && d_ == other.d_;
+}
+
+int TrajectoryColumns::sharedColumnCount(const TrajectoryColumns& other) const {
+    if (!d_ || !other.d_) {
+        return 0;
+    }
+    int count = 0;
+    for (int c = 0; c < kColumnCount; ++c) {
+        if (d_->columns[c] && d_->columns[c] == other.d_->columns[c]) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+TrajectoryColumns::Storage& TrajectoryColumns::detach() {
+    if (!d_) {
+        d_ = std::make_shared<Storage>();
+    } else if (d_.use_count() > 1) {
+        // Копируются только указатели на колонки (см. detachColumn)
+        d_ = std::make_shared<Storage>(*d_);
+    } else {
+        d_->geometry.store(nullptr);
+        d_->lod.store(nullptr);
+        d_->segment_bvh.store(nullptr);
+        d_->revision.store(0);
+    }
+    return *d_;
+}
+
+TrajectoryColumns::ColumnData& TrajectoryColumns::detachColumn(Storage& storage, int column) {
+    auto& data = storage.columns[column];
+    if (!data) {
+        data = std::make_shared<ColumnData>();
+    } else if (data.use_count() > 1) {
+        data = std::make_shared<ColumnData>(*data);
+    }
+    return *data;
+}
+
+void TrajectoryColumns::materialize(Storage& storage, int column) {
+    auto data = std::make_shared<ColumnData>();
+    data->values.assign(storage.size, 0.0);
+    if (isOptional(static_cast<Column>(column))) {
+        data->validity.assign((storage.size + kBitsPerWord - 1) / kBitsPerWord, 0);
+    }
+    storage.columns[column] = std::move(data);
+}
+
+void TrajectoryColumns::writeCell(Storage& storage, int column, std::size_t index,
+                                  double value, bool present, bool append) {
+    const bool optional = isOptional(static_cast<Column>(column));
+    if (!present) {
+        value = 0.0;
+    }
+
+    const auto& shared = storage.columns[column];
+    if (!shared) {
+        // Значение по умолчанию в несозданной редкой колонке хранить не нужно
+        if (isSparse(column) && (optional ? !present : value == 0.0)) {
+            return;
+        }
+        materialize(storage, column);
+    } else if (!append) {
+        // Неизменённая ячейка не отделяет колонку от других версий
+        const bool was_present = !optional ||
+            ((index / kBitsPerWord) < shared->validity.size() &&
+             (shared->validity[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1u);
+        if (shared->values[index] == value && was_present == present) {
+            return;
+        }
+    }
+
+    ColumnData& data = detachColumn(storage, column);
+    if (append) {
+        data.values.push_back(value);
+    } else {
+        data.values[index] = value;
+    }
+
+    if (optional) {
+        auto& bits = data.validity;
+        const std::size_t word = index / kBitsPerWord;
+        if (bits.size() <= word) {
+            bits.resize(word + 1, 0);
+        }
+        const std::uint64_t mask = std::uint64_t{1} << (index % kBitsPerWord);
+        if (present) {
+            bits[word] |= mask;
+        } else {
+            bits[word] &= ~mask;
+        }
+    }
+}
+
+}  // namespace incline3d::models
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "models/segment_bvh.h"
+#include "models/trajectory_lod.h"
+#include "models/well_geometry.h"
+
+namespace incline3d::models {
+
+struct ProcessedPoint;
+
+/// Колоночное хранение результатов расчёта траектории
+///
+/// Каждое поле ProcessedPoint хранится в отдельном непрерывном массиве,
+/// поэтому потребители, которым нужны 2–3 поля (виды — восток/север/TVD,
+/// таблицы — угол/интенсивность), читают память последовательно.
+/// Поля std::optional хранятся как значение + битовая маска наличия.
+///
+/// Редко заполняемые колонки (исходный азимут, отметки, сглаженные
+/// интенсивности, погрешности) создаются только при появлении первого
+/// значения, отличного от значения по умолчанию; до этого column()
+/// возвращает пустой диапазон, а value() — 0.
+///
+/// Хранилище разделяется между копиями (copy-on-write): копия объекта
+/// (снимок истории отмены, WellSnapshot) стоит O(1). Запись отделяет
+/// хранилище, но колонки копируются по отдельности — только те, значения
+/// которых действительно меняются; остальные по-прежнему разделяются.
+///
+/// Для существующего кода доступно построчное чтение через operator[] и
+/// итераторы, собирающие ProcessedPoint по значению.
+class TrajectoryColumns {
+public:
+    /// Колонки (поля ProcessedPoint)
+    enum class Column : int {
+        kMeasuredDepth,
+        kInclination,
+        kAzimuth,               ///< optional
+        kAppliedAzimuth,
+        kNorth,
+        kEast,
+        kTvd,
+        kTvdBgl,                ///< optional
+        kTvdBml,                ///< optional
+        kAbsoluteElevation,     ///< optional
+        kDogleg,
+        kIntensity10m,
+        kIntensityL,
+        kSmoothedIntensity10m,
+        kSmoothedIntensityL,
+        kMistakeX,
+        kMistakeY,
+        kMistakeZ,
+        kMistakeAbsg,
+        kMistakeIntensity
+    };
+    static constexpr int kColumnCount = 20;
+
+    /// Итератор построчного чтения (разыменование собирает ProcessedPoint)
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ProcessedPoint;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ProcessedPoint;
+
+        const_iterator() = default;
+        const_iterator(const TrajectoryColumns* owner, std::size_t index)
+            : owner_(owner), index_(index) {}
+
+        ProcessedPoint operator*() const;
+        ProcessedPoint operator[](difference_type n) const;
+
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { auto tmp = *this; ++index_; return tmp; }
+        const_iterator& operator--() { --index_; return *this; }
+        const_iterator operator--(int) { auto tmp = *this; --index_; return tmp; }
+        const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return {owner_, index_ + n}; }
+        const_iterator operator-(difference_type n) const { return {owner_, index_ - n}; }
+        friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+        bool operator<(const const_iterator& other) const { return index_ < other.index_; }
+        bool operator>(const const_iterator& other) const { return index_ > other.index_; }
+        bool operator<=(const const_iterator& other) const { return index_ <= other.index_; }
+        bool operator>=(const const_iterator& other) const { return index_ >= other.index_; }
+
+    private:
+        const TrajectoryColumns* owner_{nullptr};
+        std::size_t index_{0};
+    };
+
+    TrajectoryColumns() = default;
+
+    // --- Размер ---
+
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+    void reserve(std::size_t count);
+
+    // --- Построчный доступ (совместимость с vector<ProcessedPoint>) ---
+
+    void push_back(const ProcessedPoint& point);
+    void set(std::size_t index, const ProcessedPoint& point);
+
+    ProcessedPoint operator[](std::size_t index) const;
+    ProcessedPoint at(std::size_t index) const;
+    ProcessedPoint front() const;
+    ProcessedPoint back() const;
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+
+    // --- Колоночный доступ ---
+
+    /// Непрерывный массив значений колонки
+    /// @note Пусто, если редкая колонка ещё не создана (все значения по умолчанию)
+    std::span<const double> column(Column column) const;
+
+    /// Значение ячейки (0 для отсутствующего optional или несозданной колонки)
+    double value(Column column, std::size_t index) const;
+
+    /// Есть ли значение в ячейке (для не-optional колонок всегда true)
+    bool hasValue(Column column, std::size_t index) const;
+
+    /// Значение optional-колонки
+    std::optional<double> optionalValue(Column column, std::size_t index) const;
+
+    static bool isOptional(Column column);
+
+    // --- Сводная геометрия ---
+
+    /// Габариты, экстремумы, устье и забой траектории
+    /// @note Вычисляется при первом обращении и кэшируется до изменения данных;
+    ///       безопасно вызывать из нескольких потоков
+    WellGeometrySummary geometry() const;
+
+    /// Пирамида уровней детализации по координатам (восток, север, TVD)
+    /// @note Строится при первом обращении и кэшируется до изменения данных;
+    ///       nullptr для пустых результатов
+    std::shared_ptr<const TrajectoryLod> lod() const;
+
+    /// Иерархия боксов над сегментами для выбора лучом
+    /// @note Строится при первом обращении и кэшируется до изменения данных;
+    ///       nullptr, если точек меньше двух
+    std::shared_ptr<const SegmentBvh> segmentBvh() const;
+
+    /// Номер содержимого для кэшей вне модели (буферы видеокарты и т.п.)
+    /// @note Меняется при каждом изменении данных, совпадает у копий,
+    ///       разделяющих хранилище; 0 — результаты ни разу не заполнялись
+    std::uint64_t revision() const;
+
+    // --- Диагностика ---
+
+    /// Объём памяти под данные, байт (без кэшей LOD и BVH)
+    std::size_t memoryUsage() const;
+
+    /// Объём памяти под кэши производных данных (LOD, BVH), байт
+    std::size_t cacheMemoryUsage() const;
+
+    /// Освободить кэши LOD и BVH; они строятся заново при следующем обращении
+    /// @note Читатели, уже получившие кэш, продолжают с ним работать
+    /// @return освобождённый объём, байт
+    std::size_t releaseDerivedCaches() const;
+
+    /// Разделяет ли объект хранилище с другим (copy-on-write)
+    bool sharesStorageWith(const TrajectoryColumns& other) const;
+
+    /// Число созданных колонок, разделяемых с другой версией результатов
+    int sharedColumnCount(const TrajectoryColumns& other) const;
+
+private:
+    /// Данные одной колонки; разделяются между версиями хранилища
+    struct ColumnData {
+        std::vector<double> values;
+        std::vector<std::uint64_t> validity;    ///< Только для optional
+    };
+
+    struct Storage {
+        Storage() = default;
+        Storage(const Storage& other);      ///< Разделяет колонки, кэши не копирует
+
+        std::size_t size{0};
+        std::array<std::shared_ptr<ColumnData>, kColumnCount> columns;  ///< nullptr — колонка не создана
+
+        // Кэши производных данных (сбрасываются при записи)
+        mutable std::atomic<std::shared_ptr<const WellGeometrySummary>> geometry;
+        mutable std::atomic<std::shared_ptr<const TrajectoryLod>> lod;
+        mutable std::atomic<std::shared_ptr<const SegmentBvh>> segment_bvh;
+        mutable std::atomic<std::uint64_t> revision{0};     ///< 0 — ещё не назначен
+    };
+
+    /// Хранилище для записи (создаёт или отделяет разделяемое)
+    Storage& detach();
+
+    /// Колонка для записи (отделяет разделяемую с другой версией)
+    static ColumnData& detachColumn(Storage& storage, int column);
+
+    /// Создать колонку, заполнив существующие строки значениями по умолчанию
+    static void materialize(Storage& storage, int column);
+
+    static void writeCell(Storage& storage, int column, std::size_t index,
+                          double value, bool present, bool append);
+
+    std::shared_ptr<Storage> d_;
+};
+
+}  // namespace incline3d::models
@@ -0,0 +1,152 @@
+#include "models/trajectory_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace incline3d::models {
+
+namespace {
+
+/// Предельное число уровней (допуск растёт вдвое: 0.05 м · 2^30 заведомо больше любой траектории)
+constexpr int kMaxLevels = 32;
+
+struct Span {
+    std::size_t first;
+    std::size_t last;
+    double parent_importance;
+};
+
+/// Расстояние от точки p до отрезка [a, b] в 3D
+double distanceToSegment(const double p[3], const double a[3], const double b[3]) {
+    const double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    const double len2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+
+    double t = 0.0;
+    if (len2 > 0.0) {
+        t = std::clamp((ap[0] * ab[0] + ap[1] * ab[1] + ap[2] * ab[2]) / len2, 0.0, 1.0);
+    }
+    const double d[3] = {ap[0] - t * ab[0], ap[1] - t * ab[1], ap[2] - t * ab[2]};
+    return std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+}
+
+/// Значимость точек по Дугласу–Пекеру
+///
+/// Значимость точки — наибольший допуск, при котором она ещё сохраняется:
+/// её отклонение от хорды, ограниченное значимостью точек-предков (точка
+/// не может пережить упрощение, при котором уже отброшен её отрезок).
+std::vector<double> computeImportance(std::span<const double> east,
+                                      std::span<const double> north,
+                                      std::span<const double> tvd) {
+    const std::size_t count = east.size();
+    std::vector<double> importance(count, 0.0);
+    importance.front() = std::numeric_limits<double>::infinity();
+    importance.back() = std::numeric_limits<double>::infinity();
+
+    // Явный стек вместо рекурсии: глубина на длинных прямых участках достигает n
+    std::vector<Span> stack;
+    stack.push_back({0, count - 1, std::numeric_limits<double>::infinity()});
+
+    while (!stack.empty()) {
+        const Span span = stack.back();
+        stack.pop_back();
+        if (span.last <= span.first + 1) {
+            continue;
+        }
+
+        const double a[3] = {east[span.first], north[span.first], tvd[span.first]};
+        const double b[3] = {east[span.last], north[span.last], tvd[span.last]};
+
+        std::size_t split = span.first + 1;
+        double max_distance = -1.0;
+        for (std::size_t i = span.first + 1; i < span.last; ++i) {
+            const double p[3] = {east[i], north[i], tvd[i]};
+            const double distance = distanceToSegment(p, a, b);
+            if (distance > max_distance) {
+                max_distance = distance;
+                split = i;
+            }
+        }
+
+        const double value = std::min(max_distance, span.parent_importance);
+        importance[split] = value;
+        stack.push_back({span.first, split, value});
+        stack.push_back({split, span.last, value});
+    }
+
+    return importance;
+}
+
+}  // namespace
+
+TrajectoryLod TrajectoryLod::build(std::span<const double> east,
+                                   std::span<const double> north,
+                                   std::span<const double> tvd,
+                                   double base_tolerance) {
+    TrajectoryLod lod;
+    const std::size_t count = std::min({east.size(), north.size(), tvd.size()});
+    if (count == 0) {
+        return lod;
+    }
+
+    Level full;
+    full.indices.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        full.indices[i] = static_cast<std::uint32_t>(i);
+    }
+    lod.levels_.push_back(std::move(full));
+    if (count <= 2) {
+        return lod;
+    }
+
+    const auto importance = computeImportance(east.first(count), north.first(count), tvd.first(count));
+
+    double tolerance = base_tolerance;
+    for (int l = 1; l < kMaxLevels && lod.levels_.back().indices.size() > 2; ++l) {
+        Level level;
+        level.tolerance_m = tolerance;
+        for (std::uint32_t index : lod.levels_.back().indices) {
+            if (importance[index] > tolerance) {
+                level.indices.push_back(index);
+            }
+        }
+
+        // Уровень, совпадающий с предыдущим, не нужен
+        if (level.indices.size() < lod.levels_.back().indices.size()) {
+            lod.levels_.push_back(std::move(level));
+        }
+        tolerance *= 2.0;
+    }
+
+    return lod;
+}
+
+int TrajectoryLod::levelIndexFor(double max_error_m) const {
+    if (levels_.empty()) {
+        throw std::out_of_range("TrajectoryLod::levelIndexFor");
+    }
+    int result = 0;
+    for (int i = 1; i < levelCount(); ++i) {
+        if (levels_[i].tolerance_m > max_error_m) {
+            break;
+        }
+        result = i;
+    }
+    return result;
+}
+
+const TrajectoryLod::Level& TrajectoryLod::levelFor(double max_error_m) const {
+    return levels_.at(levelIndexFor(max_error_m));
+}
+
+std::size_t TrajectoryLod::memoryUsage() const {
+    std::size_t bytes = levels_.capacity() * sizeof(Level);
+    for (const auto& level : levels_) {
+        bytes += level.indices.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+}  // namespace incline3d::models
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace incline3d::models {
+
+/// Пирамида уровней детализации траектории
+///
+/// Уровни строятся упрощением ломаной в 3D по Дугласу–Пекеру с растущим
+/// допуском: каждый следующий уровень отклоняется от исходной траектории не
+/// более чем на вдвое больший допуск. Значимость точек вычисляется за один
+/// проход алгоритма, поэтому все уровни вложены друг в друга и строятся
+/// без повторного упрощения.
+///
+/// Ортогональная проекция не увеличивает расстояний, поэтому допуск в 3D
+/// ограничивает и ошибку в плане и на вертикальной проекции. Вид выбирает
+/// уровень, допуск которого не превышает размер пикселя в метрах.
+///
+/// Пирамида кэшируется вместе с результатами (TrajectoryColumns::lod()).
+class TrajectoryLod {
+public:
+    /// Уровень детализации
+    struct Level {
+        double tolerance_m{0.0};                ///< Максимальное отклонение от исходной линии, м
+        std::vector<std::uint32_t> indices;     ///< Номера сохранённых точек (по возрастанию)
+    };
+
+    /// Допуск первого упрощённого уровня, м
+    static constexpr double kBaseTolerance = 0.05;
+
+    /// Построить пирамиду по координатам точек
+    /// @note Уровень 0 — все точки; последний уровень — устье и забой
+    static TrajectoryLod build(std::span<const double> east,
+                               std::span<const double> north,
+                               std::span<const double> tvd,
+                               double base_tolerance = kBaseTolerance);
+
+    bool empty() const { return levels_.empty(); }
+    int levelCount() const { return static_cast<int>(levels_.size()); }
+    const Level& level(int index) const { return levels_.at(index); }
+
+    /// Номер самого грубого уровня с отклонением не больше max_error_m
+    int levelIndexFor(double max_error_m) const;
+
+    /// Самый грубый уровень с отклонением не больше max_error_m
+    const Level& levelFor(double max_error_m) const;
+
+    /// Объём памяти под индексы, байт
+    std::size_t memoryUsage() const;
+
+private:
+    std::vector<Level> levels_;
+};
+
+}  // namespace incline3d::models
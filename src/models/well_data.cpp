@@ -1,10 +1,16 @@
 #include "models/well_data.h"
 
 #include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 namespace incline3d::models {
 
+WellId WellId::generate() {
+    static std::atomic<std::uint64_t> counter{0};
+    return WellId{++counter};
+}
+
 std::string method_to_string(CalculationMethod method) {
     switch (method) {
         case CalculationMethod::kAverageAngle:
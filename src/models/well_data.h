@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
 #include <QColor>
 
+#include "models/chunked_array.h"
+#include "models/interned_string.h"
+#include "models/trajectory_columns.h"
+
 namespace incline3d::models {
 
 /// Единицы измерения углов для ввода/отображения
@@ -96,19 +102,22 @@ struct CalculationParams {
 };
 
 /// Метаданные скважины (соответствует полям ИНТЕРВАЛЫ_ИНКЛ в PrimeINCL)
+///
+/// Значения, общие для многих скважин (месторождение, куст, прибор,
+/// организации и исполнители), хранятся в пуле строк (InternedString).
 struct WellMetadata {
     // Идентификация скважины
     std::string uwi;                        ///< Уникальный идентификатор (UWI)
     std::string well_name;                  ///< Название скважины
-    std::string field_name;                 ///< Месторождение
-    std::string area;                       ///< Площадь
-    std::string well_pad;                   ///< Куст
-    std::string region;                     ///< Регион
+    InternedString field_name;              ///< Месторождение
+    InternedString area;                    ///< Площадь
+    InternedString well_pad;                ///< Куст
+    InternedString region;                  ///< Регион
     std::string measurement_number;         ///< Номер измерения
     std::string file_name;                  ///< Имя файла
 
     // Прибор
-    std::string device;                     ///< Тип прибора
+    InternedString device;                  ///< Тип прибора
     std::string device_number;              ///< Номер прибора
     std::string device_calibration_date;    ///< Дата поверки прибора
 
@@ -141,25 +150,42 @@ struct WellMetadata {
 
     // Организационные данные
     std::string research_date;              ///< Дата исследования
-    std::string conditions;                 ///< Условия исследования
-    std::string research_type;              ///< Характер исследования (вид)
-    std::string quality;                    ///< Качество измерения
-    std::string lbt;                        ///< ЛБТ
-    std::string ubt;                        ///< УБТ
-    std::string customer_rep;               ///< Представитель заказчика
-    std::string customer;                   ///< Заказчик
-    std::string contractor;                 ///< Подрядчик
-    std::string interpreter;                ///< Интерпретатор
-    std::string party_chief;                ///< Начальник партии
+    InternedString conditions;              ///< Условия исследования
+    InternedString research_type;           ///< Характер исследования (вид)
+    InternedString quality;                 ///< Качество измерения
+    InternedString lbt;                     ///< ЛБТ
+    InternedString ubt;                     ///< УБТ
+    InternedString customer_rep;            ///< Представитель заказчика
+    InternedString customer;                ///< Заказчик
+    InternedString contractor;              ///< Подрядчик
+    InternedString interpreter;             ///< Интерпретатор
+    InternedString party_chief;             ///< Начальник партии
 
     std::string comment;                    ///< Комментарий
 };
 
+/// Стабильный идентификатор скважины в пределах сеанса
+///
+/// В отличие от позиции в списке не меняется при добавлении/удалении
+/// других скважин и переживает перечитывание файла (replaceWell).
+struct WellId {
+    std::uint64_t value{0};
+
+    bool isValid() const { return value != 0; }
+
+    /// Новый уникальный идентификатор
+    static WellId generate();
+
+    friend bool operator==(WellId a, WellId b) { return a.value == b.value; }
+    friend bool operator!=(WellId a, WellId b) { return a.value != b.value; }
+};
+
 /// Полные данные скважины (исходные и результаты)
 struct WellData {
+    WellId id;                              ///< Назначается реестром при добавлении
     WellMetadata metadata;
-    std::vector<MeasuredPoint> measurements;
-    std::vector<ProcessedPoint> results;
+    ChunkedArray<MeasuredPoint> measurements;   ///< Блочное хранение: версии разделяют неизменённые блоки
+    TrajectoryColumns results;                  ///< Колоночное хранение, копия разделяет данные
     CalculationParams params;
 
     // Сводные данные (заполняются после расчёта)
@@ -197,3 +223,10 @@ std::string azimuth_type_to_string(AzimuthType type);
 AzimuthType string_to_azimuth_type(const std::string& str);
 
 }  // namespace incline3d::models
+
+template <>
+struct std::hash<incline3d::models::WellId> {
+    std::size_t operator()(incline3d::models::WellId id) const noexcept {
+        return std::hash<std::uint64_t>{}(id.value);
+    }
+};
@@ -0,0 +1,99 @@
+#include "models/well_geometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+
+namespace incline3d::models {
+
+namespace {
+
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+}  // namespace
+
+double WellGeometrySummary::horizontalDisplacement() const {
+    return std::sqrt(td_north * td_north + td_east * td_east);
+}
+
+double WellGeometrySummary::headToTdAzimuth() const {
+    double azimuth = std::atan2(td_east - head_east, td_north - head_north) / kDegToRad;
+    if (azimuth < 0.0) {
+        azimuth += 360.0;
+    }
+    return azimuth;
+}
+
+std::pair<double, double> WellGeometrySummary::profileRange(double azimuth_deg) const {
+    const double dir_e = std::sin(azimuth_deg * kDegToRad);
+    const double dir_n = std::cos(azimuth_deg * kDegToRad);
+
+    // Проекция линейна, поэтому экстремумы — по независимому выбору углов
+    const double e_lo = dir_e >= 0.0 ? min_east : max_east;
+    const double e_hi = dir_e >= 0.0 ? max_east : min_east;
+    const double n_lo = dir_n >= 0.0 ? min_north : max_north;
+    const double n_hi = dir_n >= 0.0 ? max_north : min_north;
+    return {e_lo * dir_e + n_lo * dir_n, e_hi * dir_e + n_hi * dir_n};
+}
+
+WellGeometrySummary WellGeometrySummary::compute(const TrajectoryColumns& results) {
+    WellGeometrySummary summary;
+    if (results.empty()) {
+        return summary;
+    }
+
+    using Column = TrajectoryColumns::Column;
+    const auto depth = results.column(Column::kMeasuredDepth);
+    const auto inclination = results.column(Column::kInclination);
+    const auto intensity_10m = results.column(Column::kIntensity10m);
+    const auto intensity_L = results.column(Column::kIntensityL);
+    const auto east = results.column(Column::kEast);
+    const auto north = results.column(Column::kNorth);
+    const auto tvd = results.column(Column::kTvd);
+
+    const std::size_t count = depth.size();
+    summary.valid = true;
+    summary.station_count = count;
+
+    summary.min_east = summary.max_east = east[0];
+    summary.min_north = summary.max_north = north[0];
+    summary.min_tvd = summary.max_tvd = tvd[0];
+
+    for (std::size_t i = 0; i < count; ++i) {
+        summary.min_east = std::min(summary.min_east, east[i]);
+        summary.max_east = std::max(summary.max_east, east[i]);
+        summary.min_north = std::min(summary.min_north, north[i]);
+        summary.max_north = std::max(summary.max_north, north[i]);
+        summary.min_tvd = std::min(summary.min_tvd, tvd[i]);
+        summary.max_tvd = std::max(summary.max_tvd, tvd[i]);
+
+        if (inclination[i] > summary.max_inclination_deg) {
+            summary.max_inclination_deg = inclination[i];
+            summary.max_inclination_depth = depth[i];
+        }
+        if (intensity_10m[i] > summary.max_intensity_10m) {
+            summary.max_intensity_10m = intensity_10m[i];
+            summary.max_intensity_10m_depth = depth[i];
+        }
+        if (intensity_L[i] > summary.max_intensity_L) {
+            summary.max_intensity_L = intensity_L[i];
+            summary.max_intensity_L_depth = depth[i];
+        }
+    }
+
+    summary.md_start = depth.front();
+    summary.md_end = depth.back();
+
+    summary.head_east = east.front();
+    summary.head_north = north.front();
+    summary.head_tvd = tvd.front();
+
+    summary.td_east = east.back();
+    summary.td_north = north.back();
+    summary.td_tvd = tvd.back();
+
+    return summary;
+}
+
+}  // namespace incline3d::models
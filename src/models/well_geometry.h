@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace incline3d::models {
+
+class TrajectoryColumns;
+
+/// Сводная геометрия траектории
+///
+/// Вычисляется за один проход по колонкам результатов и кэшируется в их
+/// хранилище до следующего изменения (см. TrajectoryColumns::geometry()),
+/// поэтому подгонка видов и сводки по тысячам скважин стоят O(скважин),
+/// а не O(точек). Координаты: восток, север, TVD (вниз).
+struct WellGeometrySummary {
+    bool valid{false};                      ///< false — результатов нет
+    std::size_t station_count{0};           ///< Число точек
+
+    // Габаритный параллелепипед (AABB)
+    double min_east{0.0};
+    double max_east{0.0};
+    double min_north{0.0};
+    double max_north{0.0};
+    double min_tvd{0.0};
+    double max_tvd{0.0};
+
+    // Интервал глубин по стволу
+    double md_start{0.0};
+    double md_end{0.0};
+
+    // Экстремумы с глубиной по стволу
+    double max_inclination_deg{0.0};
+    double max_inclination_depth{0.0};
+    double max_intensity_10m{0.0};
+    double max_intensity_10m_depth{0.0};
+    double max_intensity_L{0.0};
+    double max_intensity_L_depth{0.0};
+
+    // Устье (первая точка)
+    double head_east{0.0};
+    double head_north{0.0};
+    double head_tvd{0.0};
+
+    // Забой (последняя точка)
+    double td_east{0.0};
+    double td_north{0.0};
+    double td_tvd{0.0};
+
+    /// Горизонтальное смещение забоя от начала координат, м
+    double horizontalDisplacement() const;
+
+    /// Азимут от устья к забою, градусы [0, 360)
+    double headToTdAzimuth() const;
+
+    /// Диапазон проекции AABB на профиль с азимутом azimuth_deg
+    /// @note Оценка сверху: проецируются углы параллелепипеда
+    std::pair<double, double> profileRange(double azimuth_deg) const;
+
+    /// Однопроходный расчёт по колонкам результатов
+    static WellGeometrySummary compute(const TrajectoryColumns& results);
+};
+
+}  // namespace incline3d::models
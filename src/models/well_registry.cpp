@@ -0,0 +1,245 @@
+#include "models/well_registry.h"
+
+#include <algorithm>
+
+namespace incline3d::models {
+
+WellId WellRegistry::append(WellPtr well) {
+    return insert(size(), std::move(well));
+}
+
+WellId WellRegistry::insert(int row, WellPtr well) {
+    if (!well) {
+        return {};
+    }
+    row = std::clamp(row, 0, size());
+
+    // Копия скважины несёт идентификатор оригинала — это другая скважина
+    if (!well->id.isValid() || entries_.count(well->id) > 0) {
+        well->id = WellId::generate();
+    }
+    const WellId id = well->id;
+
+    wells_.insert(wells_.begin() + row, well);
+    ids_.insert(ids_.begin() + row, id);
+
+    Entry entry;
+    entry.well = std::move(well);
+    indexKeys(id, entry);
+    Entry& inserted = entries_.emplace(id, std::move(entry)).first->second;
+
+    // Сдвиг не относится к самой вставленной скважине
+    recordShift(row, +1);
+    inserted.row = row;
+    inserted.row_shift = shifts_base_ + shifts_.size();
+    return id;
+}
+
+WellRegistry::WellPtr WellRegistry::removeAt(int row) {
+    if (row < 0 || row >= size()) {
+        return nullptr;
+    }
+
+    const WellId id = ids_[row];
+    auto it = entries_.find(id);
+    WellPtr well = wells_[row];
+    if (it != entries_.end()) {
+        unindexKeys(id, it->second);
+        entries_.erase(it);
+    }
+
+    wells_.erase(wells_.begin() + row);
+    ids_.erase(ids_.begin() + row);
+    recordShift(row, -1);
+    return well;
+}
+
+bool WellRegistry::remove(WellId id) {
+    int row = rowOf(id);
+    if (row < 0) {
+        return false;
+    }
+    removeAt(row);
+    return true;
+}
+
+bool WellRegistry::replace(int row, WellPtr well) {
+    if (!well || row < 0 || row >= size()) {
+        return false;
+    }
+
+    const WellId id = ids_[row];
+    auto& entry = entries_.at(id);
+    unindexKeys(id, entry);
+
+    well->id = id;
+    wells_[row] = well;
+    entry.well = std::move(well);
+    indexKeys(id, entry);
+    return true;
+}
+
+void WellRegistry::clear() {
+    wells_.clear();
+    ids_.clear();
+    entries_.clear();
+    by_name_.clear();
+    by_uwi_.clear();
+    shifts_.clear();
+    shifts_base_ = 0;
+}
+
+void WellRegistry::refreshKeys(int row) {
+    if (row < 0 || row >= size()) {
+        return;
+    }
+    const WellId id = ids_[row];
+    auto& entry = entries_.at(id);
+    if (entry.name_key == entry.well->metadata.well_name &&
+        entry.uwi_key == entry.well->metadata.uwi) {
+        return;
+    }
+    unindexKeys(id, entry);
+    indexKeys(id, entry);
+}
+
+int WellRegistry::size() const {
+    return static_cast<int>(wells_.size());
+}
+
+bool WellRegistry::empty() const {
+    return wells_.empty();
+}
+
+const std::vector<WellRegistry::WellPtr>& WellRegistry::wells() const {
+    return wells_;
+}
+
+WellRegistry::WellPtr WellRegistry::at(int row) const {
+    if (row < 0 || row >= size()) {
+        return nullptr;
+    }
+    return wells_[row];
+}
+
+WellId WellRegistry::idAt(int row) const {
+    if (row < 0 || row >= size()) {
+        return {};
+    }
+    return ids_[row];
+}
+
+bool WellRegistry::contains(WellId id) const {
+    return entries_.count(id) > 0;
+}
+
+WellRegistry::WellPtr WellRegistry::find(WellId id) const {
+    auto it = entries_.find(id);
+    return it != entries_.end() ? it->second.well : nullptr;
+}
+
+int WellRegistry::rowOf(WellId id) const {
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return -1;
+    }
+    const Entry& entry = it->second;
+    const std::uint64_t current = shifts_base_ + shifts_.size();
+    if (entry.row_shift != current) {
+        // Журнал сворачивается полной перенумерацией, поэтому номер записи не старше его начала
+        for (std::size_t i = entry.row_shift - shifts_base_; i < shifts_.size(); ++i) {
+            const RowShift& shift = shifts_[i];
+            if (shift.delta > 0 ? entry.row >= shift.row : entry.row > shift.row) {
+                entry.row += shift.delta;
+            }
+        }
+        entry.row_shift = current;
+    }
+    return entry.row;
+}
+
+WellId WellRegistry::findByName(const std::string& name) const {
+    return firstByRow(by_name_, name);
+}
+
+std::vector<WellId> WellRegistry::findAllByName(const std::string& name) const {
+    std::vector<WellId> result;
+    auto [begin, end] = by_name_.equal_range(name);
+    for (auto it = begin; it != end; ++it) {
+        result.push_back(it->second);
+    }
+    std::sort(result.begin(), result.end(),
+              [this](WellId a, WellId b) { return rowOf(a) < rowOf(b); });
+    return result;
+}
+
+WellId WellRegistry::findByUwi(const std::string& uwi) const {
+    if (uwi.empty()) {
+        return {};
+    }
+    return firstByRow(by_uwi_, uwi);
+}
+
+void WellRegistry::indexKeys(WellId id, Entry& entry) {
+    entry.name_key = entry.well->metadata.well_name;
+    entry.uwi_key = entry.well->metadata.uwi;
+    by_name_.emplace(entry.name_key, id);
+    if (!entry.uwi_key.empty()) {
+        by_uwi_.emplace(entry.uwi_key, id);
+    }
+}
+
+void WellRegistry::unindexKeys(WellId id, const Entry& entry) {
+    eraseKey(by_name_, entry.name_key, id);
+    if (!entry.uwi_key.empty()) {
+        eraseKey(by_uwi_, entry.uwi_key, id);
+    }
+}
+
+void WellRegistry::eraseKey(KeyIndex& index, const std::string& key, WellId id) {
+    auto [begin, end] = index.equal_range(key);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == id) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
+void WellRegistry::recordShift(int row, int delta) {
+    // Добавление и удаление последней строки не сдвигают другие
+    if ((delta > 0 && row == size() - 1) || (delta < 0 && row == size())) {
+        return;
+    }
+    if (shifts_.size() >= kMaxPendingShifts) {
+        renumberRows();
+        return;
+    }
+    shifts_.push_back({row, delta});
+}
+
+void WellRegistry::renumberRows() {
+    shifts_base_ += shifts_.size();
+    shifts_.clear();
+    for (int row = 0; row < size(); ++row) {
+        Entry& entry = entries_.at(ids_[row]);
+        entry.row = row;
+        entry.row_shift = shifts_base_;
+    }
+}
+
+WellId WellRegistry::firstByRow(const KeyIndex& index, const std::string& key) const {
+    auto [begin, end] = index.equal_range(key);
+    WellId best;
+    int best_row = -1;
+    for (auto it = begin; it != end; ++it) {
+        int row = rowOf(it->second);
+        if (best_row < 0 || row < best_row) {
+            best = it->second;
+            best_row = row;
+        }
+    }
+    return best;
+}
+
+}  // namespace incline3d::models
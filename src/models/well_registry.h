@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "models/well_data.h"
+
+namespace incline3d::models {
+
+/// Упорядоченный реестр скважин с хеш-индексами
+///
+/// Хранит порядок скважин (строки таблицы) и обеспечивает O(1) поиск по
+/// WellId, имени и UWI. Индексы обновляются инкрементально: вставка и
+/// удаление меняют только записи затронутой скважины.
+///
+/// Номера строк сдвинутых скважин не пересчитываются: вставка или удаление
+/// не в конце записывает сдвиг в журнал, а rowOf() применяет к номеру
+/// скважины сдвиги, записанные после его последнего уточнения, — не более
+/// kMaxPendingShifts. Переполненный журнал сворачивается полной
+/// перенумерацией за O(n) при очередной вставке или удалении (которые и так
+/// сдвигают O(n) элементов массива), поэтому rowOf() не бывает дороже
+/// O(kMaxPendingShifts).
+class WellRegistry {
+public:
+    using WellPtr = std::shared_ptr<WellData>;
+
+    /// Наибольшее число сдвигов строк между полными перенумерациями
+    static constexpr std::size_t kMaxPendingShifts = 64;
+
+    /// Добавить скважину в конец; возвращает её идентификатор
+    WellId append(WellPtr well);
+
+    /// Вставить скважину в позицию row (ограничивается размером реестра)
+    /// @note Скважине без идентификатора или с уже занятым назначается новый
+    WellId insert(int row, WellPtr well);
+
+    /// Удалить скважину по позиции; возвращает удалённую скважину
+    WellPtr removeAt(int row);
+
+    /// Удалить скважину по идентификатору
+    bool remove(WellId id);
+
+    /// Заменить объект скважины в позиции, сохранив её идентификатор
+    bool replace(int row, WellPtr well);
+
+    /// Удалить все скважины
+    void clear();
+
+    /// Переиндексировать имя и UWI после изменения метаданных
+    void refreshKeys(int row);
+
+    // --- Доступ по позиции ---
+
+    int size() const;
+    bool empty() const;
+    const std::vector<WellPtr>& wells() const;
+    WellPtr at(int row) const;
+    WellId idAt(int row) const;
+
+    // --- Поиск ---
+
+    bool contains(WellId id) const;
+    WellPtr find(WellId id) const;
+
+    /// Позиция скважины (-1, если не найдена)
+    int rowOf(WellId id) const;
+
+    /// Скважина с заданным именем (при совпадениях — с меньшей позицией)
+    WellId findByName(const std::string& name) const;
+
+    /// Все скважины с заданным именем
+    std::vector<WellId> findAllByName(const std::string& name) const;
+
+    /// Скважина с заданным UWI
+    WellId findByUwi(const std::string& uwi) const;
+
+private:
+    struct Entry {
+        WellPtr well;
+        mutable int row{0};                 ///< Позиция после сдвига номер row_shift
+        mutable std::uint64_t row_shift{0}; ///< Число сдвигов, учтённых в row
+        std::string name_key;               ///< Проиндексированное имя
+        std::string uwi_key;                ///< Проиндексированный UWI
+    };
+
+    /// Вставка (+1) или удаление (-1) строки row
+    struct RowShift {
+        int row;
+        int delta;
+    };
+
+    using KeyIndex = std::unordered_multimap<std::string, WellId>;
+
+    void indexKeys(WellId id, Entry& entry);
+    void unindexKeys(WellId id, const Entry& entry);
+    static void eraseKey(KeyIndex& index, const std::string& key, WellId id);
+
+    /// Записать сдвиг строк за row (вызывается после изменения массивов)
+    void recordShift(int row, int delta);
+
+    /// Пронумеровать все строки заново и очистить журнал сдвигов
+    void renumberRows();
+
+    /// Кандидат с наименьшей позицией
+    WellId firstByRow(const KeyIndex& index, const std::string& key) const;
+
+    std::vector<WellPtr> wells_;
+    std::vector<WellId> ids_;
+    std::unordered_map<WellId, Entry> entries_;
+    KeyIndex by_name_;
+    KeyIndex by_uwi_;
+    std::vector<RowShift> shifts_;      ///< Сдвиги с номерами shifts_base_ ..
+    std::uint64_t shifts_base_{0};      ///< Сдвигов до начала журнала
+};
+
+}  // namespace incline3d::models
@@ -0,0 +1,32 @@
+#include "models/well_snapshot.h"
+
+namespace incline3d::models {
+
+WellSnapshotPtr WellSnapshotSlot::publish(const WellData& well) {
+    WellSnapshotPtr expected = current_.load(std::memory_order_acquire);
+    for (;;) {
+        auto next = std::make_shared<WellSnapshot>();
+        next->id = well.id;
+        next->version = (expected ? expected->version : base_version_) + 1;
+        next->data = well;
+
+        WellSnapshotPtr published = std::move(next);
+        // Версии строго возрастают даже при одновременной публикации
+        if (current_.compare_exchange_weak(expected, published,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+            return published;
+        }
+    }
+}
+
+WellSnapshotPtr WellSnapshotSlot::load() const {
+    return current_.load(std::memory_order_acquire);
+}
+
+std::uint64_t WellSnapshotSlot::version() const {
+    auto snapshot = load();
+    return snapshot ? snapshot->version : base_version_;
+}
+
+}  // namespace incline3d::models
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "models/well_data.h"
+
+namespace incline3d::models {
+
+/// Неизменяемая версия данных скважины
+///
+/// Снимок создаётся копированием WellData: замеры (ChunkedArray) разделяют
+/// блоки с оригиналом, результаты (TrajectoryColumns) — хранилище колонок до
+/// следующей записи, поэтому публикация версии не копирует сами точки. Пара
+/// (id, version) однозначно определяет содержимое и подходит в качестве ключа
+/// кэшей.
+struct WellSnapshot {
+    WellId id;
+    std::uint64_t version{0};   ///< Возрастает при каждой публикации
+    WellData data;
+};
+
+using WellSnapshotPtr = std::shared_ptr<const WellSnapshot>;
+
+/// Ячейка с последней опубликованной версией скважины
+///
+/// Писатель (поток GUI) публикует новую версию атомарной заменой указателя,
+/// читатели из любых потоков получают текущий снимок без блокировок и могут
+/// удерживать его сколь угодно долго — последующие публикации его не меняют.
+class WellSnapshotSlot {
+public:
+    WellSnapshotSlot() = default;
+
+    /// Ячейка, продолжающая нумерацию версий после base_version
+    /// (скважина возвращена в проект с тем же идентификатором)
+    explicit WellSnapshotSlot(std::uint64_t base_version)
+        : base_version_(base_version) {}
+
+    WellSnapshotSlot(const WellSnapshotSlot&) = delete;
+    WellSnapshotSlot& operator=(const WellSnapshotSlot&) = delete;
+
+    /// Опубликовать текущее состояние скважины как новую версию
+    WellSnapshotPtr publish(const WellData& well);
+
+    /// Последняя опубликованная версия (nullptr до первой публикации)
+    WellSnapshotPtr load() const;
+
+    /// Номер последней версии (base_version до первой публикации)
+    std::uint64_t version() const;
+
+private:
+    std::atomic<WellSnapshotPtr> current_;
+    std::uint64_t base_version_{0};
+};
+
+using WellSnapshotSlotPtr = std::shared_ptr<WellSnapshotSlot>;
+
+}  // namespace incline3d::models
@@ -3,17 +3,35 @@
 #include <QBrush>
 #include <QFont>
 
+#include <algorithm>
+
 namespace incline3d::models {
 
 WellTableModel::WellTableModel(QObject* parent)
     : QAbstractTableModel(parent) {
 }
 
+void WellTableModel::setRegistry(WellRegistry* registry) {
+    own_wells_.clear();
+    wells_ = registry ? registry : &own_wells_;
+    resetRows();
+}
+
+bool WellTableModel::hasExternalRegistry() const {
+    return wells_ != &own_wells_;
+}
+
+void WellTableModel::resetRows() {
+    beginResetModel();
+    row_count_ = wells_->size();
+    endResetModel();
+}
+
 int WellTableModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) {
         return 0;
     }
-    return static_cast<int>(wells_.size());
+    return row_count_;
 }
 
 int WellTableModel::columnCount(const QModelIndex& parent) const {
@@ -24,11 +42,11 @@ int WellTableModel::columnCount(const QModelIndex& parent) const {
 }
 
 QVariant WellTableModel::data(const QModelIndex& index, int role) const {
-    if (!index.isValid() || index.row() >= static_cast<int>(wells_.size())) {
+    if (!index.isValid() || index.row() >= std::min(row_count_, wells_->size())) {
         return {};
     }
 
-    const auto& well = wells_[index.row()];
+    const auto well = wells_->at(index.row());
 
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
         switch (index.column()) {
@@ -40,20 +58,30 @@ QVariant WellTableModel::data(const QModelIndex& index, int role) const {
                 return QString::fromStdString(well->metadata.field_name);
             case kColumnCluster:
                 return QString::fromStdString(well->metadata.well_pad);
-            case kColumnDepth:
-                return well->total_depth > 0 ? QString::number(well->total_depth, 'f', 1) : QString();
-            case kColumnMaxAngle:
-                return well->max_inclination_deg > 0
-                           ? QString::number(well->max_inclination_deg, 'f', 2)
-                           : QString();
-            case kColumnMaxIntensity:
-                return well->max_intensity_10m > 0
-                           ? QString::number(well->max_intensity_10m, 'f', 2)
-                           : QString();
-            case kColumnDisplacement:
-                return well->horizontal_displacement > 0
-                           ? QString::number(well->horizontal_displacement, 'f', 1)
-                           : QString();
+            case kColumnDepth: {
+                // Сводка по результатам кэшируется, поэтому не устаревает после пересчёта
+                const auto geometry = well->results.geometry();
+                const double depth = geometry.valid ? geometry.md_end : well->total_depth;
+                return depth > 0 ? QString::number(depth, 'f', 1) : QString();
+            }
+            case kColumnMaxAngle: {
+                const auto geometry = well->results.geometry();
+                const double angle = geometry.valid ? geometry.max_inclination_deg
+                                                    : well->max_inclination_deg;
+                return angle > 0 ? QString::number(angle, 'f', 2) : QString();
+            }
+            case kColumnMaxIntensity: {
+                const auto geometry = well->results.geometry();
+                const double intensity = geometry.valid ? geometry.max_intensity_10m
+                                                        : well->max_intensity_10m;
+                return intensity > 0 ? QString::number(intensity, 'f', 2) : QString();
+            }
+            case kColumnDisplacement: {
+                const auto geometry = well->results.geometry();
+                const double displacement = geometry.valid ? geometry.horizontalDisplacement()
+                                                           : well->horizontal_displacement;
+                return displacement > 0 ? QString::number(displacement, 'f', 1) : QString();
+            }
             case kColumnColor:
                 return {};  // Цвет отображается через DecorationRole
         }
@@ -143,11 +171,11 @@ Qt::ItemFlags WellTableModel::flags(const QModelIndex& index) const {
 }
 
 bool WellTableModel::setData(const QModelIndex& index, const QVariant& value, int role) {
-    if (!index.isValid() || index.row() >= static_cast<int>(wells_.size())) {
+    if (!index.isValid() || index.row() >= std::min(row_count_, wells_->size())) {
         return false;
     }
 
-    auto& well = wells_[index.row()];
+    auto well = wells_->at(index.row());
 
     if (role == Qt::CheckStateRole && index.column() == kColumnVisible) {
         well->visible = (value.toInt() == Qt::Checked);
@@ -161,6 +189,7 @@ bool WellTableModel::setData(const QModelIndex& index, const QVariant& value, in
             case kColumnName:
                 well->metadata.well_name = value.toString().toStdString();
                 well->modified = true;
+                wells_->refreshKeys(index.row());
                 emit dataChanged(index, index, {role});
                 emit wellDataChanged(index.row());
                 return true;
@@ -179,64 +208,105 @@ bool WellTableModel::setData(const QModelIndex& index, const QVariant& value, in
 }
 
 void WellTableModel::addWell(std::shared_ptr<WellData> well) {
-    int row = static_cast<int>(wells_.size());
-    beginInsertRows(QModelIndex(), row, row);
-    wells_.push_back(std::move(well));
+    insertWell(row_count_, std::move(well));
+}
+
+void WellTableModel::insertWell(int index, std::shared_ptr<WellData> well) {
+    if (!well) {
+        return;
+    }
+    index = std::clamp(index, 0, row_count_);
+    beginInsertRows(QModelIndex(), index, index);
+    if (!hasExternalRegistry()) {
+        wells_->insert(index, std::move(well));
+    }
+    ++row_count_;
     endInsertRows();
 }
 
 void WellTableModel::removeWell(int index) {
-    if (index < 0 || index >= static_cast<int>(wells_.size())) {
+    if (index < 0 || index >= row_count_) {
         return;
     }
     beginRemoveRows(QModelIndex(), index, index);
-    wells_.erase(wells_.begin() + index);
+    if (!hasExternalRegistry()) {
+        wells_->removeAt(index);
+    }
+    --row_count_;
     endRemoveRows();
 }
 
+void WellTableModel::removeWell(WellId id) {
+    removeWell(wells_->rowOf(id));
+}
+
 void WellTableModel::clear() {
-    if (wells_.empty()) {
-        return;
+    if (!hasExternalRegistry()) {
+        if (wells_->empty()) {
+            return;
+        }
+        wells_->clear();
     }
-    beginResetModel();
-    wells_.clear();
-    endResetModel();
+    resetRows();
 }
 
-std::shared_ptr<WellData> WellTableModel::wellAt(int index) const {
-    if (index < 0 || index >= static_cast<int>(wells_.size())) {
-        return nullptr;
+void WellTableModel::setWells(const std::vector<std::shared_ptr<WellData>>& wells) {
+    if (!hasExternalRegistry()) {
+        wells_->clear();
+        for (const auto& well : wells) {
+            wells_->append(well);
+        }
     }
-    return wells_[index];
+    resetRows();
 }
 
-int WellTableModel::wellCount() const {
-    return static_cast<int>(wells_.size());
+std::shared_ptr<WellData> WellTableModel::wellAt(int index) const {
+    return wells_->at(index);
 }
 
-std::vector<std::shared_ptr<WellData>>& WellTableModel::wells() {
-    return wells_;
+int WellTableModel::wellCount() const {
+    return row_count_;
 }
 
 const std::vector<std::shared_ptr<WellData>>& WellTableModel::wells() const {
-    return wells_;
+    return wells_->wells();
+}
+
+std::shared_ptr<WellData> WellTableModel::wellById(WellId id) const {
+    return wells_->find(id);
+}
+
+WellId WellTableModel::wellIdAt(int index) const {
+    return wells_->idAt(index);
+}
+
+int WellTableModel::rowOf(WellId id) const {
+    return wells_->rowOf(id);
 }
 
 int WellTableModel::findWellByName(const std::string& name) const {
-    for (size_t i = 0; i < wells_.size(); ++i) {
-        if (wells_[i]->metadata.well_name == name) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
+    return wells_->rowOf(wells_->findByName(name));
+}
+
+int WellTableModel::findWellByUwi(const std::string& uwi) const {
+    return wells_->rowOf(wells_->findByUwi(uwi));
 }
 
 void WellTableModel::updateWell(int index) {
-    if (index < 0 || index >= static_cast<int>(wells_.size())) {
+    if (index < 0 || index >= std::min(row_count_, wells_->size())) {
         return;
     }
+    // Имя или UWI могли измениться (ручной ввод, отмена правки)
+    wells_->refreshKeys(index);
     emit dataChanged(createIndex(index, 0), createIndex(index, kColumnCount - 1));
     emit wellDataChanged(index);
 }
 
+void WellTableModel::replaceWell(int index, std::shared_ptr<WellData> well) {
+    if (!hasExternalRegistry() && !wells_->replace(index, std::move(well))) {
+        return;
+    }
+    updateWell(index);
+}
+
 }  // namespace incline3d::models
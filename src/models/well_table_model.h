@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "models/well_data.h"
+#include "models/well_registry.h"
 
 namespace incline3d::models {
 
@@ -28,6 +29,15 @@ public:
 
     explicit WellTableModel(QObject* parent = nullptr);
 
+    /// Читать скважины из внешнего реестра (реестр ProjectManager)
+    ///
+    /// Модель не держит собственной копии списка: вставки, удаления и замены
+    /// выполняет владелец реестра, а insertWell/removeWell/replaceWell/setWells
+    /// модели только уведомляют представления (удаление — по позиции).
+    /// Переименования через модель переиндексируются в том же реестре.
+    /// nullptr — вернуться к собственному реестру модели.
+    void setRegistry(WellRegistry* registry);
+
     // QAbstractTableModel interface
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -40,27 +50,51 @@ public:
 
     // Управление данными
     void addWell(std::shared_ptr<WellData> well);
+    void insertWell(int index, std::shared_ptr<WellData> well);
     void removeWell(int index);
+    void removeWell(WellId id);
     void clear();
 
+    /// Заменить список целиком (загрузка проекта)
+    void setWells(const std::vector<std::shared_ptr<WellData>>& wells);
+
     std::shared_ptr<WellData> wellAt(int index) const;
     int wellCount() const;
-    std::vector<std::shared_ptr<WellData>>& wells();
     const std::vector<std::shared_ptr<WellData>>& wells() const;
 
-    // Поиск скважины по имени
+    // Доступ по стабильному идентификатору
+    std::shared_ptr<WellData> wellById(WellId id) const;
+    WellId wellIdAt(int index) const;
+    int rowOf(WellId id) const;
+
+    // Поиск скважины по имени и UWI (хеш-индекс реестра)
     int findWellByName(const std::string& name) const;
+    int findWellByUwi(const std::string& uwi) const;
 
     // Обновление данных скважины (вызывает dataChanged)
     void updateWell(int index);
 
+    // Замена данных скважины в строке (например, после перечитывания файла)
+    void replaceWell(int index, std::shared_ptr<WellData> well);
+
 signals:
     void wellVisibilityChanged(int index, bool visible);
     void wellColorChanged(int index, const QColor& color);
     void wellDataChanged(int index);
 
 private:
-    std::vector<std::shared_ptr<WellData>> wells_;
+    /// Реестр принадлежит другому объекту
+    bool hasExternalRegistry() const;
+
+    /// Перечитать число строк из реестра со сбросом модели
+    void resetRows();
+
+    WellRegistry own_wells_;
+    WellRegistry* wells_{&own_wells_};
+
+    /// Число строк, о котором знают представления; при внешнем реестре
+    /// расходится с его размером до уведомления об изменении
+    int row_count_{0};
 };
 
 }  // namespace incline3d::models
@@ -385,30 +385,29 @@ void ConclusionDialog::updateSummary() {
     summary += tr("Дата: %1\n\n").arg(date_edit_->date().toString("dd.MM.yyyy"));
 
     if (!well_->results.empty()) {
-        const auto& first = well_->results.front();
-        const auto& last = well_->results.back();
+        const auto geometry = well_->results.geometry();
 
         summary += tr("Интервал измерений: %.2f - %.2f м\n")
-            .arg(first.measured_depth_m)
-            .arg(last.measured_depth_m);
+            .arg(geometry.md_start)
+            .arg(geometry.md_end);
         summary += tr("Количество точек: %1\n\n").arg(well_->results.size());
 
         summary += tr("Забойные координаты:\n");
-        summary += tr("  TVD: %.2f м\n").arg(last.tvd_m);
-        summary += tr("  Север: %.2f м\n").arg(last.north_m);
-        summary += tr("  Восток: %.2f м\n").arg(last.east_m);
+        summary += tr("  TVD: %.2f м\n").arg(geometry.td_tvd);
+        summary += tr("  Север: %.2f м\n").arg(geometry.td_north);
+        summary += tr("  Восток: %.2f м\n").arg(geometry.td_east);
         summary += tr("  Горизонтальное смещение: %.2f м\n\n")
-            .arg(std::sqrt(last.north_m * last.north_m + last.east_m * last.east_m));
+            .arg(geometry.horizontalDisplacement());
 
         summary += tr("Максимальный угол: %.2f° (на глубине %.2f м)\n")
-            .arg(well_->max_inclination_deg)
-            .arg(well_->total_depth);
+            .arg(geometry.max_inclination_deg)
+            .arg(geometry.max_inclination_depth);
         summary += tr("Максимальная интенсивность (10м): %.2f°/10м (на глубине %.2f м)\n")
-            .arg(well_->max_intensity_10m)
-            .arg(well_->max_intensity_10m_depth);
+            .arg(geometry.max_intensity_10m)
+            .arg(geometry.max_intensity_10m_depth);
         summary += tr("Максимальная интенсивность (L): %.2f°/L (на глубине %.2f м)\n\n")
-            .arg(well_->max_intensity_L)
-            .arg(well_->max_intensity_L_depth);
+            .arg(geometry.max_intensity_L)
+            .arg(geometry.max_intensity_L_depth);
     }
 
     if (!project_points_.empty()) {
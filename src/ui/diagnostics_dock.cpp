@@ -0,0 +1,155 @@
+#include "ui/diagnostics_dock.h"
+#include "core/memory_tracker.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace incline3d::ui {
+
+namespace {
+
+enum Column {
+    kColumnName = 0,
+    kColumnBytes,
+    kColumnItems,
+    kColumnCount
+};
+
+enum FrameColumn {
+    kFrameColumnView = 0,
+    kFrameColumnCpu,
+    kFrameColumnGpu,
+    kFrameColumnBuild,
+    kFrameColumnDrawCalls,
+    kFrameColumnVertices,
+    kFrameColumnItems,
+    kFrameColumnCount
+};
+
+/// Время в мс или прочерк, если не измерялось
+QString formatMs(double ms) {
+    return ms < 0.0 ? QStringLiteral("—") : QString::number(ms, 'f', 1);
+}
+
+}  // namespace
+
+DiagnosticsDock::DiagnosticsDock(QWidget* parent)
+    : QDockWidget(tr("Диагностика"), parent) {
+    auto* widget = new QWidget(this);
+    auto* layout = new QVBoxLayout(widget);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    total_label_ = new QLabel(widget);
+    layout->addWidget(total_label_);
+
+    tree_ = new QTreeWidget(widget);
+    tree_->setColumnCount(kColumnCount);
+    tree_->setHeaderLabels({tr("Объект"), tr("Память"), tr("Элементы")});
+    tree_->setAlternatingRowColors(true);
+    tree_->header()->setSectionResizeMode(kColumnName, QHeaderView::Stretch);
+    layout->addWidget(tree_);
+
+    frames_tree_ = new QTreeWidget(widget);
+    frames_tree_->setColumnCount(kFrameColumnCount);
+    frames_tree_->setHeaderLabels({tr("Вид"), tr("Кадр p50/p95/p99, мс"), tr("GPU p50/p95, мс"),
+                                   tr("Построение, мс"), tr("Вызовы"), tr("Вершины"), tr("Элементы")});
+    frames_tree_->setRootIsDecorated(false);
+    frames_tree_->setAlternatingRowColors(true);
+    frames_tree_->setMaximumHeight(110);
+    layout->addWidget(frames_tree_);
+
+    auto* buttons = new QHBoxLayout();
+    auto* refresh_btn = new QPushButton(tr("Обновить"), widget);
+    connect(refresh_btn, &QPushButton::clicked, this, &DiagnosticsDock::refreshRequested);
+    buttons->addWidget(refresh_btn);
+    auto* dump_btn = new QPushButton(tr("Сохранить JSON..."), widget);
+    connect(dump_btn, &QPushButton::clicked, this, &DiagnosticsDock::dumpRequested);
+    buttons->addWidget(dump_btn);
+    buttons->addStretch();
+    layout->addLayout(buttons);
+
+    setWidget(widget);
+}
+
+void DiagnosticsDock::setReport(const core::MemoryReport& report) {
+    QString total = tr("Всего: %1").arg(formatBytes(report.totalBytes()));
+    if (report.soft_budget_bytes > 0) {
+        total += tr(" из %1").arg(formatBytes(report.soft_budget_bytes));
+    }
+    total_label_->setText(total);
+    total_label_->setStyleSheet(report.overBudget() ? "color: red" : QString());
+
+    tree_->clear();
+
+    auto* wells_item = new QTreeWidgetItem(tree_, {tr("Скважины (%1)").arg(report.wells.size()),
+                                                   formatBytes(report.wellsBytes())});
+    for (const auto& well : report.wells) {
+        auto* item = new QTreeWidgetItem(wells_item, {well.name, formatBytes(well.totalBytes())});
+        item->setToolTip(kColumnBytes, tr("Замеры: %1\nРезультаты: %2\nВизуализация: %3")
+            .arg(formatBytes(well.measurements_bytes))
+            .arg(formatBytes(well.results_bytes))
+            .arg(formatBytes(well.render_bytes)));
+    }
+
+    auto* subsystems_item = new QTreeWidgetItem(tree_, {tr("Подсистемы")});
+    for (const auto& subsystem : report.subsystems) {
+        QString name = subsystem.name;
+        if (subsystem.evictable) {
+            name += tr(" (вытесняемо)");
+        }
+        new QTreeWidgetItem(subsystems_item, {name, formatBytes(subsystem.bytes),
+                                              QString::number(subsystem.item_count)});
+    }
+
+    tree_->expandAll();
+    for (int c = kColumnBytes; c < kColumnCount; ++c) {
+        tree_->resizeColumnToContents(c);
+    }
+}
+
+void DiagnosticsDock::setFrameStats(const std::vector<std::pair<QString, views::FrameStatsSummary>>& views) {
+    frames_tree_->clear();
+    for (const auto& [name, summary] : views) {
+        auto* item = new QTreeWidgetItem(frames_tree_);
+        item->setText(kFrameColumnView, name);
+        if (summary.frames > 0) {
+            item->setText(kFrameColumnCpu, QString("%1 / %2 / %3")
+                                               .arg(formatMs(summary.cpu_p50_ms), formatMs(summary.cpu_p95_ms),
+                                                    formatMs(summary.cpu_p99_ms)));
+            item->setToolTip(kFrameColumnCpu, tr("Кадров в окне: %1, максимум %2 мс")
+                                                  .arg(summary.frames)
+                                                  .arg(formatMs(summary.cpu_max_ms)));
+        }
+        if (summary.gpu_p50_ms >= 0.0) {
+            item->setText(kFrameColumnGpu, QString("%1 / %2")
+                                               .arg(formatMs(summary.gpu_p50_ms), formatMs(summary.gpu_p95_ms)));
+        }
+        item->setText(kFrameColumnBuild, formatMs(summary.build_ms));
+        item->setToolTip(kFrameColumnBuild, tr("Максимум за окно: %1 мс").arg(formatMs(summary.build_max_ms)));
+        item->setText(kFrameColumnDrawCalls, QString::number(summary.draw_calls));
+        item->setText(kFrameColumnVertices, QString::number(static_cast<qulonglong>(summary.vertices)));
+        item->setText(kFrameColumnItems, QString::number(summary.items));
+    }
+    for (int c = kFrameColumnView; c < kFrameColumnCount; ++c) {
+        frames_tree_->resizeColumnToContents(c);
+    }
+}
+
+QString DiagnosticsDock::formatBytes(std::size_t bytes) {
+    const double value = static_cast<double>(bytes);
+    if (bytes >= (std::size_t{1} << 30)) {
+        return tr("%1 ГБ").arg(value / (1 << 30), 0, 'f', 2);
+    }
+    if (bytes >= (std::size_t{1} << 20)) {
+        return tr("%1 МБ").arg(value / (1 << 20), 0, 'f', 1);
+    }
+    if (bytes >= (std::size_t{1} << 10)) {
+        return tr("%1 КБ").arg(value / (1 << 10), 0, 'f', 1);
+    }
+    return tr("%1 Б").arg(bytes);
+}
+
+}  // namespace incline3d::ui
@@ -0,0 +1,41 @@
+#pragma once
+#include <QDockWidget>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "views/frame_stats.h"
+
+class QLabel;
+class QTreeWidget;
+
+namespace incline3d::core { struct MemoryReport; }
+
+namespace incline3d::ui {
+
+/// Док диагностики: потребление памяти по скважинам и подсистемам, время кадров видов
+class DiagnosticsDock : public QDockWidget {
+    Q_OBJECT
+public:
+    explicit DiagnosticsDock(QWidget* parent = nullptr);
+
+    /// Показать отчёт о памяти
+    void setReport(const core::MemoryReport& report);
+
+    /// Показать статистику кадров по видам (название вида, сводка)
+    void setFrameStats(const std::vector<std::pair<QString, views::FrameStatsSummary>>& views);
+
+    /// Размер в удобных единицах (Б, КБ, МБ, ГБ)
+    static QString formatBytes(std::size_t bytes);
+
+signals:
+    void refreshRequested();
+    void dumpRequested();
+
+private:
+    QTreeWidget* tree_{nullptr};
+    QLabel* total_label_{nullptr};
+    QTreeWidget* frames_tree_{nullptr};
+};
+
+}  // namespace incline3d::ui
@@ -15,6 +15,7 @@
 #include <QSpinBox>
 #include <QVBoxLayout>
 
+#include "ui/image_export.h"
 #include "utils/logger.h"
 
 namespace incline3d::ui {
@@ -35,14 +36,14 @@ void ExportImageDialog::setupUi() {
 
     size_layout->addWidget(new QLabel(tr("Ширина:"), this), 0, 0);
     width_spin_ = new QSpinBox(this);
-    width_spin_->setRange(100, 10000);
+    width_spin_->setRange(100, 50000);
     width_spin_->setValue(1920);
     width_spin_->setSuffix(tr(" пикс."));
     size_layout->addWidget(width_spin_, 0, 1);
 
     size_layout->addWidget(new QLabel(tr("Высота:"), this), 1, 0);
     height_spin_ = new QSpinBox(this);
-    height_spin_->setRange(100, 10000);
+    height_spin_->setRange(100, 50000);
     height_spin_->setValue(1080);
     height_spin_->setSuffix(tr(" пикс."));
     size_layout->addWidget(height_spin_, 1, 1);
@@ -197,7 +198,26 @@ void ExportImageDialog::onExportToFile() {
         return;
     }
 
-    result_image_ = captureView();
+    QString format = format_combo_->currentData().toString();
+    int quality = (format == "jpg") ? quality_spin_->value() : -1;
+    const QSize size(width_spin_->value(), height_spin_->value());
+
+    // Слишком большое изображение сохраняется плитками
+    if (static_cast<qint64>(size.width()) * size.height() > kMaxSingleImagePixels) {
+        const int files = saveViewImage(capture_widget_, size, path_edit_->text(), quality);
+        if (files > 0) {
+            exported_to_file_ = true;
+            QMessageBox::information(this, tr("Экспорт"),
+                                     tr("Изображение сохранено плитками: %1 файлов").arg(files));
+            accept();
+        } else {
+            QMessageBox::critical(this, tr("Ошибка"),
+                                  tr("Не удалось сохранить изображение"));
+        }
+        return;
+    }
+
+    result_image_ = captureView(size);
 
     if (result_image_.isNull()) {
         QMessageBox::critical(this, tr("Ошибка"),
@@ -205,17 +225,6 @@ void ExportImageDialog::onExportToFile() {
         return;
     }
 
-    // Масштабирование если нужно
-    if (result_image_.width() != width_spin_->value() ||
-        result_image_.height() != height_spin_->value()) {
-        result_image_ = result_image_.scaled(
-            width_spin_->value(), height_spin_->value(),
-            Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-    }
-
-    QString format = format_combo_->currentData().toString();
-    int quality = (format == "jpg") ? quality_spin_->value() : -1;
-
     if (result_image_.save(path_edit_->text(), format.toUpper().toLatin1().constData(), quality)) {
         exported_to_file_ = true;
         LOG_INFO(tr("Изображение сохранено: %1").arg(path_edit_->text()));
@@ -227,7 +236,14 @@ void ExportImageDialog::onExportToFile() {
 }
 
 void ExportImageDialog::onCopyToClipboard() {
-    result_image_ = captureView();
+    const QSize size(width_spin_->value(), height_spin_->value());
+    if (static_cast<qint64>(size.width()) * size.height() > kMaxSingleImagePixels) {
+        QMessageBox::warning(this, tr("Экспорт"),
+                             tr("Изображение слишком велико для буфера обмена"));
+        return;
+    }
+
+    result_image_ = captureView(size);
 
     if (result_image_.isNull()) {
         QMessageBox::critical(this, tr("Ошибка"),
@@ -235,14 +251,6 @@ void ExportImageDialog::onCopyToClipboard() {
         return;
     }
 
-    // Масштабирование если нужно
-    if (result_image_.width() != width_spin_->value() ||
-        result_image_.height() != height_spin_->value()) {
-        result_image_ = result_image_.scaled(
-            width_spin_->value(), height_spin_->value(),
-            Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-    }
-
     QApplication::clipboard()->setImage(result_image_);
     copied_to_clipboard_ = true;
 
@@ -253,23 +261,31 @@ void ExportImageDialog::onCopyToClipboard() {
 }
 
 void ExportImageDialog::updatePreview() {
-    QImage preview = captureView();
+    // Предпросмотр отрисовывается сразу в размере метки с пропорциями изображения
+    const QSize size = QSize(width_spin_->value(), height_spin_->value())
+                           .scaled(preview_label_->size() - QSize(10, 10), Qt::KeepAspectRatio);
+    const QImage preview = captureView(size);
 
     if (!preview.isNull()) {
-        // Масштабирование для предпросмотра
-        preview = preview.scaled(preview_label_->size() - QSize(10, 10),
-                                 Qt::KeepAspectRatio, Qt::SmoothTransformation);
         preview_label_->setPixmap(QPixmap::fromImage(preview));
     }
 }
 
-QImage ExportImageDialog::captureView() {
-    if (!capture_widget_) {
+QImage ExportImageDialog::captureView(const QSize& size) {
+    if (!capture_widget_ || size.isEmpty()) {
         return QImage();
     }
 
-    // Захват содержимого виджета
-    return capture_widget_->grab().toImage();
+    // Вид отрисовывается заново в нужном размере, без масштабирования снимка экрана
+    QImage image = renderViewImage(capture_widget_, size);
+    if (image.isNull()) {
+        // Захват содержимого виджета
+        image = capture_widget_->grab().toImage();
+        if (!image.isNull() && image.size() != size) {
+            image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+    return image;
 }
 
 }  // namespace incline3d::ui
@@ -53,7 +53,8 @@ private slots:
 
 private:
     void setupUi();
-    QImage captureView();
+    /// Отрисовать вид в заданном размере
+    QImage captureView(const QSize& size);
 
     QWidget* capture_widget_{nullptr};
 
@@ -0,0 +1,267 @@
+#include "ui/image_export.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "core/project_manager.h"
+#include "models/project_points_model.h"
+#include "models/shot_points_model.h"
+#include "models/well_table_model.h"
+#include "utils/logger.h"
+#include "views/image_tiles.h"
+#include "views/plan_view.h"
+#include "views/vertical_view.h"
+#include "views/view3d_widget.h"
+
+namespace incline3d::ui {
+
+namespace {
+
+/// Имя файла без недопустимых символов
+QString safeFileName(const QString& name) {
+    static const QRegularExpression kForbidden(R"([\\/:*?"<>|\s]+)");
+    QString result = name.trimmed();
+    result.replace(kForbidden, "_");
+    return result.isEmpty() ? QStringLiteral("_") : result;
+}
+
+}  // namespace
+
+QImage renderViewImage(QWidget* view, const QSize& size, const QRect& tile, bool fit_content) {
+    if (auto* view3d = qobject_cast<views::View3DWidget*>(view)) {
+        return view3d->renderImage(size, tile);
+    }
+    if (auto* plan = qobject_cast<views::PlanView*>(view)) {
+        return plan->renderImage(size, tile, fit_content);
+    }
+    if (auto* vertical = qobject_cast<views::VerticalView*>(view)) {
+        return vertical->renderImage(size, tile, fit_content);
+    }
+    return {};
+}
+
+int saveViewImage(QWidget* view, const QSize& size, const QString& path, int quality, bool fit_content) {
+    if (static_cast<qint64>(size.width()) * size.height() <= kMaxSingleImagePixels) {
+        const QImage image = renderViewImage(view, size, {}, fit_content);
+        if (image.isNull() || !image.save(path, nullptr, quality)) {
+            LOG_ERROR(QString::fromUtf8("Не удалось сохранить изображение: %1").arg(path));
+            return 0;
+        }
+        return 1;
+    }
+
+    // Плитки отрисовываются и сохраняются по одной — в памяти не больше одной плитки
+    const QFileInfo info(path);
+    const auto tiles = views::splitIntoTiles(size, kExportTileSize);
+    int saved = 0;
+    for (const QRect& tile : tiles) {
+        const QString tile_path = info.dir().filePath(QString("%1_%2_%3.%4")
+                                                          .arg(info.completeBaseName())
+                                                          .arg(tile.top() / kExportTileSize)
+                                                          .arg(tile.left() / kExportTileSize)
+                                                          .arg(info.suffix()));
+        const QImage image = renderViewImage(view, size, tile, fit_content);
+        if (image.isNull() || !image.save(tile_path, nullptr, quality)) {
+            LOG_ERROR(QString::fromUtf8("Не удалось сохранить плитку изображения: %1").arg(tile_path));
+            return 0;
+        }
+        ++saved;
+    }
+    LOG_INFO(QString::fromUtf8("Изображение %1×%2 сохранено плитками: %3 файлов")
+                 .arg(size.width())
+                 .arg(size.height())
+                 .arg(saved));
+    return saved;
+}
+
+BatchImageExport::BatchImageExport(BatchExportOptions options)
+    : options_(std::move(options)) {}
+
+std::optional<BatchExportOptions> BatchImageExport::parseArguments(const QStringList& arguments,
+                                                                   QString* error) {
+    QCommandLineParser parser;
+    const QCommandLineOption export_option("export-images", tr("Сохранить изображения в каталог и выйти"),
+                                           tr("каталог"));
+    const QCommandLineOption view_option("view", tr("Вид: 3d, plan, vertical"), tr("вид"), "plan");
+    const QCommandLineOption group_option("group", tr("Изображение на скважину (well) или куст (pad)"),
+                                          tr("группа"), "well");
+    const QCommandLineOption size_option("size", tr("Размер изображения ШxВ"), tr("размер"), "1920x1080");
+    const QCommandLineOption format_option("format", tr("Формат файла: png, jpg, bmp, tiff"), tr("формат"),
+                                           "png");
+    parser.addOptions({export_option, view_option, group_option, size_option, format_option});
+    parser.addPositionalArgument("file", tr("Файл проекта или скважины"));
+
+    // Без --export-images разбор не мешает обычному запуску с файлом в аргументах
+    const bool requested = std::any_of(arguments.begin(), arguments.end(), [](const QString& argument) {
+        return argument.startsWith("--export-images");
+    });
+    if (!requested) {
+        return std::nullopt;
+    }
+    if (!parser.parse(arguments)) {
+        if (error) *error = parser.errorText();
+        return std::nullopt;
+    }
+
+    const auto fail = [error](const QString& message) -> std::optional<BatchExportOptions> {
+        if (error) *error = message;
+        return std::nullopt;
+    };
+
+    BatchExportOptions options;
+    options.output_dir = parser.value(export_option);
+    if (parser.positionalArguments().isEmpty()) {
+        return fail(tr("Не указан файл проекта"));
+    }
+    options.project_path = parser.positionalArguments().constFirst();
+
+    const QString view = parser.value(view_option).toLower();
+    if (view == "3d") {
+        options.view = BatchExportOptions::View::k3D;
+    } else if (view == "plan") {
+        options.view = BatchExportOptions::View::kPlan;
+    } else if (view == "vertical") {
+        options.view = BatchExportOptions::View::kVertical;
+    } else {
+        return fail(tr("Неизвестный вид: %1").arg(view));
+    }
+
+    const QString group = parser.value(group_option).toLower();
+    if (group == "well") {
+        options.grouping = BatchExportOptions::Grouping::kPerWell;
+    } else if (group == "pad") {
+        options.grouping = BatchExportOptions::Grouping::kPerPad;
+    } else {
+        return fail(tr("Неизвестная группировка: %1").arg(group));
+    }
+
+    const QStringList size = parser.value(size_option).toLower().split('x');
+    bool width_ok = false;
+    bool height_ok = false;
+    if (size.size() == 2) {
+        options.size = QSize(size[0].toInt(&width_ok), size[1].toInt(&height_ok));
+    }
+    if (!width_ok || !height_ok || options.size.isEmpty()) {
+        return fail(tr("Неверный размер изображения: %1").arg(parser.value(size_option)));
+    }
+
+    options.format = parser.value(format_option).toLower();
+    return options;
+}
+
+int BatchImageExport::run() {
+    core::ProjectManager project;
+    if (!project.loadProject(options_.project_path)) {
+        LOG_ERROR(tr("Не удалось загрузить проект: %1").arg(options_.project_path));
+        return 1;
+    }
+    if (!QDir().mkpath(options_.output_dir)) {
+        LOG_ERROR(tr("Не удалось создать каталог: %1").arg(options_.output_dir));
+        return 1;
+    }
+
+    models::WellTableModel well_model;
+    well_model.setWells(project.wells());
+    models::ProjectPointsModel project_points;
+    project_points.setPoints(project.projectData().project_points);
+    models::ShotPointsModel shot_points;
+    shot_points.setPoints(project.projectData().shot_points);
+
+    // Вид создаётся без показа на экране
+    std::unique_ptr<QWidget> view;
+    views::View3DWidget* view3d = nullptr;
+    views::PlanView* plan = nullptr;
+    views::VerticalView* vertical = nullptr;
+    switch (options_.view) {
+        case BatchExportOptions::View::k3D:
+            view3d = new views::View3DWidget();
+            view3d->setWellModel(&well_model);
+            view3d->setProjectPointsModel(&project_points);
+            view3d->setShotPointsModel(&shot_points);
+            view.reset(view3d);
+            break;
+        case BatchExportOptions::View::kPlan:
+            plan = new views::PlanView();
+            plan->setWellModel(&well_model);
+            plan->setProjectPointsModel(&project_points);
+            plan->setShotPointsModel(&shot_points);
+            view.reset(plan);
+            break;
+        case BatchExportOptions::View::kVertical:
+            vertical = new views::VerticalView();
+            vertical->setWellModel(&well_model);
+            vertical->setProjectPointsModel(&project_points);
+            view.reset(vertical);
+            break;
+    }
+
+    // Группы скважин в порядке проекта: по одной скважине или по кусту
+    std::vector<std::pair<QString, std::vector<models::WellData*>>> groups;
+    std::map<QString, std::size_t> pad_groups;
+    for (const auto& well : well_model.wells()) {
+        if (!well || well->results.empty()) {
+            LOG_WARNING(tr("Скважина без результатов расчёта пропущена: %1")
+                            .arg(well ? QString::fromStdString(well->metadata.well_name) : QString()));
+            continue;
+        }
+        if (options_.grouping == BatchExportOptions::Grouping::kPerWell) {
+            groups.push_back({QString::fromStdString(well->metadata.well_name), {well.get()}});
+            continue;
+        }
+        QString pad = QString::fromStdString(well->metadata.well_pad.str());
+        if (pad.isEmpty()) {
+            pad = tr("без куста");
+        }
+        const auto [it, inserted] = pad_groups.emplace(pad, groups.size());
+        if (inserted) {
+            groups.push_back({pad, {}});
+        }
+        groups[it->second].second.push_back(well.get());
+    }
+
+    const QDir output(options_.output_dir);
+    std::set<QString> used_names;
+    int failed = 0;
+    for (const auto& [name, members] : groups) {
+        for (const auto& well : well_model.wells()) {
+            well->visible = std::find(members.begin(), members.end(), well.get()) != members.end();
+        }
+        if (view3d) {
+            view3d->fitToContent();
+        } else if (plan) {
+            plan->refresh();
+        } else if (vertical) {
+            vertical->autoFitAzimuth();
+            vertical->refresh();
+        }
+
+        // Совпадающие имена различаются номером
+        QString base = safeFileName(name);
+        for (int n = 2; used_names.count(base); ++n) {
+            base = safeFileName(name) + QString("_%1").arg(n);
+        }
+        used_names.insert(base);
+
+        const QString path = output.filePath(base + "." + options_.format);
+        if (saveViewImage(view.get(), options_.size, path, -1, true) > 0) {
+            LOG_INFO(tr("Изображение сохранено: %1").arg(path));
+        } else {
+            ++failed;
+        }
+    }
+
+    LOG_INFO(tr("Пакетный экспорт завершён: %1 изображений, ошибок: %2")
+                 .arg(static_cast<int>(groups.size()) - failed)
+                 .arg(failed));
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace incline3d::ui
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QCoreApplication>
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+class QWidget;
+
+namespace incline3d::ui {
+
+/// Наибольшее изображение, сохраняемое одним файлом, пикселей (≈ 400 МБ в памяти)
+constexpr qint64 kMaxSingleImagePixels = 100'000'000;
+
+/// Сторона плитки при сохранении по частям, пиксели
+constexpr int kExportTileSize = 8192;
+
+/// Отрисовать вид (3D, план или профиль) без окна в изображение заданного размера
+/// @param tile часть изображения (пустой — всё изображение)
+/// @param fit_content вписать всё содержимое (2D) вместо области, видимой в окне
+/// @return пустое изображение, если виджет не вид или OpenGL недоступен
+QImage renderViewImage(QWidget* view, const QSize& size, const QRect& tile = {}, bool fit_content = false);
+
+/// Сохранить изображение вида заданного размера
+///
+/// Изображение больше kMaxSingleImagePixels не собирается в памяти целиком:
+/// оно сохраняется плитками kExportTileSize в файлы `<имя>_<строка>_<столбец>.<расширение>`.
+/// Формат определяется по расширению пути.
+/// @return число сохранённых файлов; 0 — ошибка (подробности в журнале)
+int saveViewImage(QWidget* view, const QSize& size, const QString& path, int quality = -1,
+                  bool fit_content = false);
+
+/// Параметры пакетного экспорта изображений
+struct BatchExportOptions {
+    /// Какой вид сохраняется
+    enum class View { k3D, kPlan, kVertical };
+
+    /// Что попадает на одно изображение
+    enum class Grouping { kPerWell, kPerPad };
+
+    QString project_path;
+    QString output_dir;
+    View view{View::kPlan};
+    Grouping grouping{Grouping::kPerWell};
+    QSize size{1920, 1080};
+    QString format{"png"};
+};
+
+/// Пакетный экспорт изображений проекта без главного окна
+///
+/// Проект загружается в собственные модели, вид создаётся без показа на
+/// экране и отрисовывается через renderViewImage: 3D — в кадровый буфер
+/// вне экрана, план и профиль — через QPainter в QImage. На каждую скважину
+/// (или куст) видимыми оставляются только её траектории, вид вписывается
+/// в содержимое.
+class BatchImageExport {
+    Q_DECLARE_TR_FUNCTIONS(BatchImageExport)
+
+public:
+    explicit BatchImageExport(BatchExportOptions options);
+
+    /// Разобрать аргументы командной строки
+    /// @param error текст ошибки разбора (пустой — ошибки нет)
+    /// @return nullopt — пакетный режим не запрошен или аргументы неверны
+    static std::optional<BatchExportOptions> parseArguments(const QStringList& arguments, QString* error);
+
+    /// Загрузить проект и сохранить изображения
+    /// @return код завершения процесса: 0 — все изображения сохранены
+    int run();
+
+private:
+    BatchExportOptions options_;
+};
+
+}  // namespace incline3d::ui
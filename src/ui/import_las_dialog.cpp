@@ -20,6 +20,7 @@
 
 #include "utils/angle_utils.h"
 #include "utils/logger.h"
+#include "utils/parse_arena.h"
 
 namespace incline3d::ui {
 
@@ -171,8 +172,12 @@ void ImportLasDialog::parseLasFile() {
     int curve_count = 0;
     bool in_data_section = false;
 
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
+    utils::ParseArena arena;
+    QString buffer;
+
+    while (in.readLineInto(&buffer)) {
+        arena.reset();
+        const QString line = buffer.trimmed();
 
         // Пропуск комментариев и пустых строк
         if (line.isEmpty() || line.startsWith('#')) {
@@ -190,7 +195,7 @@ void ImportLasDialog::parseLasFile() {
         // Парсинг секций
         if (current_section == "W") {
             // Well Information Section
-            QRegularExpression re(R"(^(\w+)\s*\.\s*[^:]*:\s*(.*)$)");
+            static const QRegularExpression re(R"(^(\w+)\s*\.\s*[^:]*:\s*(.*)$)");
             auto match = re.match(line);
             if (match.hasMatch()) {
                 QString mnemonic = match.captured(1).toUpper();
@@ -215,7 +220,7 @@ void ImportLasDialog::parseLasFile() {
             }
         } else if (current_section == "C") {
             // Curve Information Section
-            QRegularExpression re(R"(^(\w+)\s*\.)");
+            static const QRegularExpression re(R"(^(\w+)\s*\.)");
             auto match = re.match(line);
             if (match.hasMatch()) {
                 QString mnemonic = match.captured(1).toUpper();
@@ -224,7 +229,7 @@ void ImportLasDialog::parseLasFile() {
             }
         } else if (in_data_section) {
             // ASCII Data Section
-            QStringList values = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+            const auto values = utils::split_line_any(line, u" ", arena.resource());
 
             // Инициализация массивов данных при первой строке
             if (las_data_.curve_data.isEmpty()) {
@@ -232,9 +237,10 @@ void ImportLasDialog::parseLasFile() {
             }
 
             // Чтение значений
-            for (int i = 0; i < values.size() && i < curve_count; ++i) {
+            const int count = static_cast<int>(values.size());
+            for (int i = 0; i < count && i < curve_count; ++i) {
                 bool ok;
-                double val = values[i].toDouble(&ok);
+                double val = utils::parse_number(values[i], &ok);
                 if (ok) {
                     las_data_.curve_data[i].append(val);
                 } else {
@@ -20,9 +20,23 @@
 
 #include "utils/angle_utils.h"
 #include "utils/logger.h"
+#include "utils/parse_arena.h"
 
 namespace incline3d::ui {
 
+namespace {
+
+/// Поля строки: пробел означает любую последовательность пробельных символов
+utils::TokenList splitFields(QStringView line, const QString& separator,
+                             std::pmr::memory_resource* arena) {
+    if (separator == " " || separator.isEmpty()) {
+        return utils::split_line_any(line, u" ", arena);
+    }
+    return utils::split_line(line, separator.front(), arena, Qt::SkipEmptyParts);
+}
+
+}  // namespace
+
 ImportZakDialog::ImportZakDialog(const QString& file_path, QWidget* parent)
     : QDialog(parent)
     , file_path_(file_path) {
@@ -238,41 +252,30 @@ void ImportZakDialog::updatePreview() {
 
     int valid_count = 0;
     int max_preview = 100;
-    QRegularExpression split_re;
-
-    if (separator == " ") {
-        split_re = QRegularExpression("\\s+");
-    } else {
-        split_re = QRegularExpression(QRegularExpression::escape(separator));
-    }
+    const bool comma_decimal = decimal_sep == ",";
+    utils::ParseArena arena;
 
     for (int i = skip_lines; i < file_lines_.size() && preview_table_->rowCount() < max_preview; ++i) {
-        QString line = file_lines_[i].trimmed();
-        if (line.isEmpty() || line.startsWith('#') || line.startsWith("//")) {
+        arena.reset();
+        const QStringView line = QStringView(file_lines_[i]).trimmed();
+        if (line.isEmpty() || line.startsWith(u'#') || line.startsWith(u"//")) {
             continue;
         }
 
-        QStringList parts = line.split(split_re, Qt::SkipEmptyParts);
+        const auto parts = splitFields(line, separator, arena.resource());
+        const int count = static_cast<int>(parts.size());
 
-        if (parts.size() <= depth_col || parts.size() <= angle_col) {
+        if (count <= depth_col || count <= angle_col) {
             continue;
         }
 
-        // Получение значений с заменой десятичного разделителя
-        QString depth_str = parts[depth_col];
-        QString angle_str = parts[angle_col];
-        QString azimuth_str = (azimuth_col >= 0 && azimuth_col < parts.size()) ? parts[azimuth_col] : QString();
-
-        if (decimal_sep == ",") {
-            depth_str.replace(',', '.');
-            angle_str.replace(',', '.');
-            azimuth_str.replace(',', '.');
-        }
+        // Получение значений с учётом десятичного разделителя
+        const QStringView azimuth_str = (azimuth_col >= 0 && azimuth_col < count) ? parts[azimuth_col] : QStringView();
 
-        bool ok_depth, ok_angle, ok_azimuth;
-        double depth = depth_str.toDouble(&ok_depth);
-        double angle = angle_str.toDouble(&ok_angle);
-        double azimuth = azimuth_str.isEmpty() ? 0.0 : azimuth_str.toDouble(&ok_azimuth);
+        bool ok_depth, ok_angle, ok_azimuth = false;
+        double depth = utils::parse_number(parts[depth_col], &ok_depth, comma_decimal);
+        double angle = utils::parse_number(parts[angle_col], &ok_angle, comma_decimal);
+        double azimuth = azimuth_str.isEmpty() ? 0.0 : utils::parse_number(azimuth_str, &ok_azimuth, comma_decimal);
         bool has_azimuth = !azimuth_str.isEmpty() && ok_azimuth;
 
         if (!ok_depth || !ok_angle) {
@@ -340,43 +343,33 @@ void ImportZakDialog::onImport() {
     bool angle_degmin = angle_degmin_check_->isChecked();
     bool azimuth_degmin = azimuth_degmin_check_->isChecked();
 
-    QRegularExpression split_re;
-    if (separator == " ") {
-        split_re = QRegularExpression("\\s+");
-    } else {
-        split_re = QRegularExpression(QRegularExpression::escape(separator));
-    }
+    const bool comma_decimal = decimal_sep == ",";
+    utils::ParseArena arena;
 
     int imported = 0;
     int skipped = 0;
 
     for (int i = skip_lines; i < file_lines_.size(); ++i) {
-        QString line = file_lines_[i].trimmed();
-        if (line.isEmpty() || line.startsWith('#') || line.startsWith("//")) {
+        arena.reset();
+        const QStringView line = QStringView(file_lines_[i]).trimmed();
+        if (line.isEmpty() || line.startsWith(u'#') || line.startsWith(u"//")) {
             continue;
         }
 
-        QStringList parts = line.split(split_re, Qt::SkipEmptyParts);
+        const auto parts = splitFields(line, separator, arena.resource());
+        const int count = static_cast<int>(parts.size());
 
-        if (parts.size() <= depth_col || parts.size() <= angle_col) {
+        if (count <= depth_col || count <= angle_col) {
             ++skipped;
             continue;
         }
 
-        QString depth_str = parts[depth_col];
-        QString angle_str = parts[angle_col];
-        QString azimuth_str = (azimuth_col >= 0 && azimuth_col < parts.size()) ? parts[azimuth_col] : QString();
-
-        if (decimal_sep == ",") {
-            depth_str.replace(',', '.');
-            angle_str.replace(',', '.');
-            azimuth_str.replace(',', '.');
-        }
+        const QStringView azimuth_str = (azimuth_col >= 0 && azimuth_col < count) ? parts[azimuth_col] : QStringView();
 
-        bool ok_depth, ok_angle, ok_azimuth;
-        double depth = depth_str.toDouble(&ok_depth);
-        double angle = angle_str.toDouble(&ok_angle);
-        double azimuth = azimuth_str.isEmpty() ? 0.0 : azimuth_str.toDouble(&ok_azimuth);
+        bool ok_depth, ok_angle, ok_azimuth = false;
+        double depth = utils::parse_number(parts[depth_col], &ok_depth, comma_decimal);
+        double angle = utils::parse_number(parts[angle_col], &ok_angle, comma_decimal);
+        double azimuth = azimuth_str.isEmpty() ? 0.0 : utils::parse_number(azimuth_str, &ok_azimuth, comma_decimal);
         bool has_azimuth = !azimuth_str.isEmpty() && ok_azimuth;
 
         if (!ok_depth || !ok_angle) {
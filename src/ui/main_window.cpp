@@ -7,6 +7,8 @@
 #include <QDir>
 #include <QDockWidget>
 #include <QFileDialog>
+#include <QFutureWatcher>
+#include <QJsonObject>
 #include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
@@ -15,11 +17,20 @@
 #include <QStatusBar>
 #include <QTabWidget>
 #include <QToolBar>
+#include <QUndoStack>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <iterator>
 
 #include "core/file_io.h"
 #include "core/incline_process_runner.h"
+#include "core/memory_tracker.h"
 #include "core/project_manager.h"
 #include "core/settings.h"
+#include "core/well_file_watcher.h"
+#include "core/well_list_commands.h"
+#include "models/edit_commands.h"
 #include "models/measurements_model.h"
 #include "models/project_points_model.h"
 #include "models/results_model.h"
@@ -30,6 +41,7 @@
 #include "ui/shot_points_dock.h"
 #include "ui/measurements_dock.h"
 #include "ui/results_dock.h"
+#include "ui/diagnostics_dock.h"
 #include "ui/settings_dialog.h"
 #include "ui/about_dialog.h"
 #include "ui/process_dialog.h"
@@ -56,6 +68,7 @@ MainWindow::MainWindow(QWidget* parent)
     project_manager_ = std::make_unique<core::ProjectManager>(this);
     process_runner_ = std::make_unique<core::InclineProcessRunner>(this);
     file_io_ = std::make_unique<core::FileIO>();
+    well_file_watcher_ = std::make_unique<core::WellFileWatcher>(project_manager_.get(), this);
 
     // Инициализация моделей
     well_model_ = std::make_unique<models::WellTableModel>(this);
@@ -63,6 +76,17 @@ MainWindow::MainWindow(QWidget* parent)
     shot_points_model_ = std::make_unique<models::ShotPointsModel>(this);
     measurements_model_ = std::make_unique<models::MeasurementsModel>(this);
     results_model_ = std::make_unique<models::ResultsModel>(this);
+    // Таблица скважин читает реестр проекта, а не держит его копию
+    well_model_->setRegistry(&project_manager_->registry());
+
+    // История отмены: правки в таблицах попадают в общий стек
+    undo_stack_ = new QUndoStack(this);
+    undo_stack_->setUndoLimit(core::Settings::instance().undoLimit());
+    measurements_model_->setUndoStack(undo_stack_);
+    // Отмена правки замеров может прийти, когда выбрана уже другая скважина
+    measurements_model_->setEditAppliedCallback(
+        [this](const std::shared_ptr<models::WellData>& edited) { onWellEditApplied(edited); });
+    project_points_model_->setUndoStack(undo_stack_);
 
     setupUi();
     loadSettings();
@@ -72,20 +96,82 @@ MainWindow::MainWindow(QWidget* parent)
             this, &MainWindow::updateWindowTitle);
     connect(project_manager_.get(), &core::ProjectManager::projectLoaded,
             this, &MainWindow::updateWindowTitle);
+
+    // История правок относится к одному проекту
+    connect(project_manager_.get(), &core::ProjectManager::projectCreated,
+            undo_stack_, &QUndoStack::clear);
+    connect(project_manager_.get(), &core::ProjectManager::projectLoaded,
+            undo_stack_, &QUndoStack::clear);
+    connect(measurements_model_.get(), &models::MeasurementsModel::dataModified,
+            this, [this]() {
+                project_manager_->setDirty(true);
+                project_manager_->publishWell(current_well_id_);
+            });
+
+    // Каждая завершённая правка скважины публикуется как новая неизменяемая версия
+    auto publish_row = [this](int row) {
+        project_manager_->publishWell(well_model_->wellIdAt(row));
+    };
+    connect(well_model_.get(), &models::WellTableModel::wellDataChanged, this, publish_row);
+    connect(well_model_.get(), &models::WellTableModel::wellVisibilityChanged,
+            this, [publish_row](int row, bool) { publish_row(row); });
+    connect(well_model_.get(), &models::WellTableModel::wellColorChanged,
+            this, [publish_row](int row, const QColor&) { publish_row(row); });
     connect(project_manager_.get(), &core::ProjectManager::projectSaved,
             this, &MainWindow::updateWindowTitle);
     connect(project_manager_.get(), &core::ProjectManager::dirtyChanged,
             this, &MainWindow::updateWindowTitle);
+    // Синхронизация таблицы скважин: поштучно при правках, целиком при загрузке проекта
+    connect(project_manager_.get(), &core::ProjectManager::wellInserted,
+            this, [this](int index) {
+                well_model_->insertWell(index, project_manager_->wells().at(index));
+            });
+    connect(project_manager_.get(), &core::ProjectManager::wellRemoved,
+            this, [this](int index, models::WellId id) {
+                well_model_->removeWell(index);
+                if (id == current_well_id_) {
+                    current_well_id_ = {};
+                    measurements_model_->clearWell();
+                    results_model_->clearWell();
+                }
+            });
+    auto resync_wells = [this]() {
+        well_model_->setWells(project_manager_->wells());
+        current_well_id_ = {};
+        measurements_model_->clearWell();
+        results_model_->clearWell();
+    };
+    connect(project_manager_.get(), &core::ProjectManager::projectCreated, this, resync_wells);
+    connect(project_manager_.get(), &core::ProjectManager::projectLoaded, this, resync_wells);
     connect(project_manager_.get(), &core::ProjectManager::wellsChanged,
             this, [this]() {
-                // Синхронизация моделей с проектом
-                well_model_->clear();
-                for (const auto& well : project_manager_->wells()) {
-                    well_model_->addWell(well);
+                updateActions();
+                invalidateViews(views::UpdateScheduler::kGeometry);
+            });
+
+    // Перечитывание изменённых на диске файлов — точечная замена без перестроения списка
+    connect(project_manager_.get(), &core::ProjectManager::wellReplaced,
+            this, &MainWindow::onWellReplaced);
+    // Команды истории удерживают объект скважины, поэтому подмена тоже идёт через историю
+    well_file_watcher_->setReplaceHandler(
+        [this](int row, std::shared_ptr<models::WellData> well) {
+            const auto id = project_manager_->registry().idAt(row);
+            const auto* reloaded = well.get();
+            undo_stack_->push(new core::ReplaceWellCommand(
+                project_manager_.get(), id, std::move(well)));
+            return project_manager_->well(id).get() == reloaded;
+        });
+    connect(well_file_watcher_.get(), &core::WellFileWatcher::wellReloaded,
+            this, [this](int index) {
+                const auto& wells = project_manager_->wells();
+                if (index >= 0 && index < static_cast<int>(wells.size())) {
+                    status_label_->setText(tr("Скважина перечитана с диска: %1")
+                        .arg(QString::fromStdString(wells[index]->metadata.well_name)));
                 }
-                if (view3d_) view3d_->update();
-                if (plan_view_) plan_view_->update();
-                if (vertical_view_) vertical_view_->update();
+            });
+    connect(well_file_watcher_.get(), &core::WellFileWatcher::reloadFailed,
+            this, [this](const QString& path, const QString& error) {
+                LOG_WARNING(tr("Не удалось перечитать %1: %2").arg(path, error));
             });
 
     // Подключение сигналов процесса
@@ -102,6 +188,8 @@ MainWindow::MainWindow(QWidget* parent)
         auto_save_timer_->start(settings.autoSaveIntervalMinutes() * 60 * 1000);
     }
 
+    setupMemoryTracking();
+
     // Создание нового проекта
     project_manager_->newProject();
 
@@ -166,6 +254,12 @@ void MainWindow::createActions() {
     connect(action_exit_, &QAction::triggered, this, &QMainWindow::close);
 
     // Редактирование
+    action_undo_ = undo_stack_->createUndoAction(this, tr("Отменить"));
+    action_undo_->setShortcut(QKeySequence::Undo);
+
+    action_redo_ = undo_stack_->createRedoAction(this, tr("Повторить"));
+    action_redo_->setShortcut(QKeySequence::Redo);
+
     action_add_well_ = new QAction(tr("Добавить скважину..."), this);
     connect(action_add_well_, &QAction::triggered, this, &MainWindow::onAddWell);
 
@@ -254,12 +348,26 @@ void MainWindow::createActions() {
     action_vertical_settings_ = new QAction(tr("Настройки вертикальной проекции..."), this);
     connect(action_vertical_settings_, &QAction::triggered, this, &MainWindow::onVerticalSettings);
 
+    action_frame_stats_ = new QAction(tr("Статистика кадров"), this);
+    action_frame_stats_->setCheckable(true);
+    action_frame_stats_->setStatusTip(tr("Показать время кадров, вызовы отрисовки и число элементов поверх видов"));
+    connect(action_frame_stats_, &QAction::toggled, this, [this](bool show) {
+        view3d_->setShowFrameStats(show);
+        plan_view_->setShowFrameStats(show);
+        vertical_view_->setShowFrameStats(show);
+    });
+
     // Настройки
     action_settings_ = new QAction(tr("Настройки..."), this);
     connect(action_settings_, &QAction::triggered, this, &MainWindow::onSettings);
 
     action_about_ = new QAction(tr("О программе..."), this);
     connect(action_about_, &QAction::triggered, this, &MainWindow::onAbout);
+
+    // Диагностика
+    action_memory_dump_ = new QAction(tr("Сохранить отчёт о памяти..."), this);
+    action_memory_dump_->setStatusTip(tr("Записать потребление памяти в JSON"));
+    connect(action_memory_dump_, &QAction::triggered, this, &MainWindow::onMemoryDump);
 }
 
 void MainWindow::createMenus() {
@@ -285,6 +393,9 @@ void MainWindow::createMenus() {
 
     // Меню Редактирование
     edit_menu_ = menuBar()->addMenu(tr("&Редактирование"));
+    edit_menu_->addAction(action_undo_);
+    edit_menu_->addAction(action_redo_);
+    edit_menu_->addSeparator();
     edit_menu_->addAction(action_add_well_);
     edit_menu_->addAction(action_remove_well_);
     edit_menu_->addSeparator();
@@ -318,6 +429,7 @@ void MainWindow::createMenus() {
     view_menu_->addAction(action_reset_view_);
     view_menu_->addAction(action_view_options_);
     view_menu_->addAction(action_vertical_settings_);
+    view_menu_->addAction(action_frame_stats_);
     view_menu_->addSeparator();
     view_menu_->addAction(action_export_image_);
     view_menu_->addAction(action_copy_to_clipboard_);
@@ -332,6 +444,7 @@ void MainWindow::createMenus() {
     // Меню Справка
     help_menu_ = menuBar()->addMenu(tr("&Справка"));
     help_menu_->addAction(action_settings_);
+    help_menu_->addAction(action_memory_dump_);
     help_menu_->addSeparator();
     help_menu_->addAction(action_about_);
 }
@@ -388,8 +501,24 @@ void MainWindow::createDockWidgets() {
     results_dock_->setObjectName("ResultsDock");
     addDockWidget(Qt::RightDockWidgetArea, results_dock_);
 
+    // Док диагностики памяти (по умолчанию скрыт)
+    diagnostics_dock_ = new DiagnosticsDock(this);
+    diagnostics_dock_->setObjectName("DiagnosticsDock");
+    addDockWidget(Qt::RightDockWidgetArea, diagnostics_dock_);
+    diagnostics_dock_->hide();
+
+    connect(diagnostics_dock_, &DiagnosticsDock::refreshRequested,
+            this, &MainWindow::onMemoryCheck);
+    connect(diagnostics_dock_, &DiagnosticsDock::dumpRequested,
+            this, &MainWindow::onMemoryDump);
+    connect(diagnostics_dock_, &QDockWidget::visibilityChanged,
+            this, [this](bool visible) {
+                if (visible) onMemoryCheck();
+            });
+
     // Таблификация правых доков
     tabifyDockWidget(measurements_dock_, results_dock_);
+    tabifyDockWidget(results_dock_, diagnostics_dock_);
     measurements_dock_->raise();
 
     // Добавление в меню Вид
@@ -399,6 +528,7 @@ void MainWindow::createDockWidgets() {
     view_menu_->addAction(shot_points_dock_->toggleViewAction());
     view_menu_->addAction(measurements_dock_->toggleViewAction());
     view_menu_->addAction(results_dock_->toggleViewAction());
+    view_menu_->addAction(diagnostics_dock_->toggleViewAction());
 }
 
 void MainWindow::createCentralWidget() {
@@ -515,7 +645,7 @@ void MainWindow::updateWindowTitle() {
 
 void MainWindow::updateActions() {
     bool has_wells = well_model_->wellCount() > 0;
-    bool has_selected_well = current_well_index_ >= 0;
+    bool has_selected_well = current_well_id_.isValid();
 
     action_remove_well_->setEnabled(has_selected_well);
     action_save_file_->setEnabled(has_selected_well);
@@ -538,7 +668,7 @@ void MainWindow::onNewProject() {
     shot_points_model_->clear();
     measurements_model_->clearWell();
     results_model_->clearWell();
-    current_well_index_ = -1;
+    current_well_id_ = {};
 
     updateActions();
     status_label_->setText(tr("Создан новый проект"));
@@ -568,7 +698,7 @@ void MainWindow::onOpenProject() {
         project_points_model_->setPoints(project_manager_->projectData().project_points);
         shot_points_model_->setPoints(project_manager_->projectData().shot_points);
 
-        current_well_index_ = -1;
+        current_well_id_ = {};
         updateActions();
         status_label_->setText(tr("Проект загружен: %1").arg(path));
     } else {
@@ -635,8 +765,7 @@ void MainWindow::onOpenFile() {
         result.well->line_width = settings.defaultLineWidth();
         result.well->params = settings.defaultCalculationParams();
 
-        project_manager_->addWell(result.well);
-        well_model_->addWell(result.well);
+        undo_stack_->push(new core::AddWellCommand(project_manager_.get(), result.well));
 
         settings.setLastOpenDirectory(QFileInfo(path).absolutePath());
         settings.addRecentFile(path);
@@ -648,9 +777,7 @@ void MainWindow::onOpenFile() {
         updateActions();
 
         // Обновление видов
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
     } else {
         QMessageBox::critical(this, tr("Ошибка"),
                               tr("Не удалось загрузить файл:\n%1").arg(result.error_message));
@@ -658,11 +785,11 @@ void MainWindow::onOpenFile() {
 }
 
 void MainWindow::onSaveFile() {
-    if (current_well_index_ < 0) {
+    if (!current_well_id_.isValid()) {
         return;
     }
 
-    auto well = well_model_->wellAt(current_well_index_);
+    auto well = well_model_->wellById(current_well_id_);
     if (!well) {
         return;
     }
@@ -681,7 +808,17 @@ void MainWindow::onSaveFile() {
     if (result.success) {
         well->source_file_path = path.toStdString();
         well->modified = false;
-        well_model_->updateWell(current_well_index_);
+        well_model_->updateWell(well_model_->rowOf(current_well_id_));
+
+        // Запись проекта теперь ссылается на новый файл — наблюдаем за ним
+        auto& entries = project_manager_->projectData().well_entries;
+        const int entry_index = project_manager_->indexOf(current_well_id_);
+        if (entry_index >= 0 && entry_index < static_cast<int>(entries.size())) {
+            entries[entry_index].file_path = path;
+            entries[entry_index].format =
+                core::FileIO::formatToString(core::FileIO::detectFormat(path));
+        }
+        well_file_watcher_->syncWatchedFiles();
         status_label_->setText(tr("Данные сохранены: %1").arg(path));
     } else {
         QMessageBox::critical(this, tr("Ошибка"),
@@ -717,13 +854,10 @@ void MainWindow::onRecentFileTriggered() {
         result.well->display_color = settings.defaultWellColor();
         result.well->params = settings.defaultCalculationParams();
 
-        project_manager_->addWell(result.well);
-        well_model_->addWell(result.well);
+        undo_stack_->push(new core::AddWellCommand(project_manager_.get(), result.well));
         updateActions();
 
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
     }
 }
 
@@ -737,7 +871,7 @@ void MainWindow::onRecentProjectTriggered() {
     if (project_manager_->loadProject(path)) {
         project_points_model_->setPoints(project_manager_->projectData().project_points);
         shot_points_model_->setPoints(project_manager_->projectData().shot_points);
-        current_well_index_ = -1;
+        current_well_id_ = {};
         updateActions();
     }
 }
@@ -771,11 +905,11 @@ void MainWindow::onAddWell() {
 }
 
 void MainWindow::onRemoveWell() {
-    if (current_well_index_ < 0) {
+    if (!current_well_id_.isValid()) {
         return;
     }
 
-    auto well = well_model_->wellAt(current_well_index_);
+    auto well = well_model_->wellById(current_well_id_);
     if (!well) return;
 
     QMessageBox::StandardButton ret = QMessageBox::question(
@@ -785,16 +919,13 @@ void MainWindow::onRemoveWell() {
         QMessageBox::Yes | QMessageBox::No);
 
     if (ret == QMessageBox::Yes) {
-        project_manager_->removeWell(current_well_index_);
-        well_model_->removeWell(current_well_index_);
-        current_well_index_ = -1;
+        undo_stack_->push(new core::RemoveWellCommand(project_manager_.get(), current_well_id_));
+        current_well_id_ = {};
         measurements_model_->clearWell();
         results_model_->clearWell();
         updateActions();
 
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
     }
 }
 
@@ -804,8 +935,7 @@ void MainWindow::onAddProjectPoint() {
     project_points_model_->addPoint(pt);
     project_manager_->setDirty(true);
 
-    if (view3d_) view3d_->update();
-    if (plan_view_) plan_view_->update();
+    invalidateViews(views::UpdateScheduler::kGeometry);
 }
 
 void MainWindow::onRemoveProjectPoint() {
@@ -818,8 +948,7 @@ void MainWindow::onAddShotPoint() {
     shot_points_model_->addPoint(pt);
     project_manager_->setDirty(true);
 
-    if (view3d_) view3d_->update();
-    if (plan_view_) plan_view_->update();
+    invalidateViews(views::UpdateScheduler::kGeometry);
 }
 
 void MainWindow::onRemoveShotPoint() {
@@ -829,28 +958,32 @@ void MainWindow::onRemoveShotPoint() {
 // --- Слоты обработки ---
 
 void MainWindow::onProcessWell() {
-    if (current_well_index_ < 0) {
+    if (!current_well_id_.isValid()) {
         QMessageBox::information(this, tr("Обработка"),
                                  tr("Выберите скважину для обработки"));
         return;
     }
 
-    auto well = well_model_->wellAt(current_well_index_);
+    auto well = well_model_->wellById(current_well_id_);
     if (!well || well->measurements.empty()) {
         QMessageBox::warning(this, tr("Обработка"),
                              tr("У скважины нет исходных данных для обработки"));
         return;
     }
 
+    auto before = models::WellEditState::capture(*well);
     ProcessDialog dialog(well, process_runner_.get(), this);
     if (dialog.exec() == QDialog::Accepted) {
-        well_model_->updateWell(current_well_index_);
+        undo_stack_->push(new models::WellEditCommand(
+            well, std::move(before), models::WellEditState::capture(*well),
+            tr("Обработка скважины %1").arg(QString::fromStdString(well->metadata.well_name)),
+            [this](const std::shared_ptr<models::WellData>& edited) { onWellEditApplied(edited); }));
+
+        well_model_->updateWell(well_model_->rowOf(current_well_id_));
         results_model_->refresh();
         project_manager_->setDirty(true);
 
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
 
         status_label_->setText(tr("Обработка завершена"));
     }
@@ -922,6 +1055,16 @@ void MainWindow::onViewOptions() {
     ViewOptions opts;
     opts.show_grid = view3d_ ? view3d_->showGrid() : true;
     opts.show_labels = view3d_ ? view3d_->showLabels() : true;
+    if (view3d_) {
+        opts.show_tubes = view3d_->showTubes();
+        opts.tube_coloring = view3d_->tubeColoring();
+        opts.tube_radius = view3d_->tubeRadius();
+        opts.show_uncertainty = view3d_->showUncertainty();
+        opts.uncertainty_step = view3d_->uncertaintyStep();
+        opts.show_horizons = view3d_->showHorizons();
+        opts.horizon_grid_step = view3d_->horizonGridStep();
+        opts.depth_label_step = view3d_->depthLabelStep();
+    }
     // Можно расширить для других настроек
     dialog.setOptions(opts);
 
@@ -931,19 +1074,24 @@ void MainWindow::onViewOptions() {
                 if (view3d_) {
                     view3d_->setShowGrid(opts.show_grid);
                     view3d_->setShowLabels(opts.show_labels);
-                    view3d_->update();
+                    view3d_->setShowTubes(opts.show_tubes);
+                    view3d_->setTubeColoring(opts.tube_coloring);
+                    view3d_->setTubeRadius(opts.tube_radius);
+                    view3d_->setShowUncertainty(opts.show_uncertainty);
+                    view3d_->setUncertaintyStep(opts.uncertainty_step);
+                    view3d_->setShowHorizons(opts.show_horizons);
+                    view3d_->setHorizonGridStep(opts.horizon_grid_step);
+                    view3d_->setDepthLabelStep(opts.depth_label_step);
                 }
                 if (plan_view_) {
                     plan_view_->setShowGrid(opts.show_grid);
                     plan_view_->setShowLabels(opts.show_labels);
                     plan_view_->setGridStep(opts.grid_step);
-                    plan_view_->refresh();
                 }
                 if (vertical_view_) {
                     vertical_view_->setShowGrid(opts.show_grid);
                     vertical_view_->setShowLabels(opts.show_labels);
                     vertical_view_->setGridStep(opts.grid_step);
-                    vertical_view_->refresh();
                 }
             });
 
@@ -987,8 +1135,8 @@ void MainWindow::onEditReportHeader() {
     }
 
     // Если есть выбранная скважина, заполняем из неё
-    if (current_well_index_ >= 0) {
-        auto well = well_model_->wellAt(current_well_index_);
+    if (current_well_id_.isValid()) {
+        auto well = well_model_->wellById(current_well_id_);
         if (well) {
             header.field_name = QString::fromStdString(well->metadata.field_name);
             header.well_pad = QString::fromStdString(well->metadata.well_pad);
@@ -1007,13 +1155,13 @@ void MainWindow::onEditReportHeader() {
 }
 
 void MainWindow::onExportReport() {
-    if (current_well_index_ < 0) {
+    if (!current_well_id_.isValid()) {
         QMessageBox::information(this, tr("Экспорт отчёта"),
                                  tr("Выберите скважину для экспорта отчёта"));
         return;
     }
 
-    auto well = well_model_->wellAt(current_well_index_);
+    auto well = well_model_->wellById(current_well_id_);
     if (!well || well->results.empty()) {
         QMessageBox::warning(this, tr("Экспорт отчёта"),
                              tr("У выбранной скважины нет результатов обработки"));
@@ -1027,14 +1175,30 @@ void MainWindow::onExportReport() {
 
     if (path.isEmpty()) return;
 
-    // Экспорт результатов в CSV
-    auto result = file_io_->saveWell(path, *well);
-    if (result.success) {
-        status_label_->setText(tr("Отчёт экспортирован: %1").arg(path));
-    } else {
-        QMessageBox::critical(this, tr("Ошибка"),
-                              tr("Не удалось экспортировать отчёт:\n%1").arg(result.error_message));
-    }
+    // Отчёт пишется в пуле потоков из неизменяемого снимка: правки скважины,
+    // сделанные во время записи, в отчёт не попадают и не ждут его окончания
+    auto snapshot = project_manager_->snapshot(current_well_id_);
+    if (!snapshot) {
+        project_manager_->publishWell(current_well_id_);
+        snapshot = project_manager_->snapshot(current_well_id_);
+    }
+
+    status_label_->setText(tr("Экспорт отчёта: %1").arg(path));
+    auto* watcher = new QFutureWatcher<core::LoadResult>(this);
+    connect(watcher, &QFutureWatcher<core::LoadResult>::finished, this, [this, watcher, path]() {
+        watcher->deleteLater();
+        const auto result = watcher->result();
+        if (result.success) {
+            status_label_->setText(tr("Отчёт экспортирован: %1").arg(path));
+        } else {
+            QMessageBox::critical(this, tr("Ошибка"),
+                                  tr("Не удалось экспортировать отчёт:\n%1").arg(result.error_message));
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([snapshot, path]() {
+        core::FileIO io;
+        return io.saveWell(path, snapshot->data);
+    }));
 }
 
 // --- Исходные данные ---
@@ -1049,8 +1213,7 @@ void MainWindow::onManualInput() {
 
     ManualInputDialog dialog(well, this);
     if (dialog.exec() == QDialog::Accepted) {
-        project_manager_->addWell(well);
-        well_model_->addWell(well);
+        undo_stack_->push(new core::AddWellCommand(project_manager_.get(), well));
         project_manager_->setDirty(true);
 
         status_label_->setText(tr("Добавлена скважина: %1")
@@ -1058,9 +1221,7 @@ void MainWindow::onManualInput() {
 
         updateActions();
 
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
     }
 }
 
@@ -1084,8 +1245,7 @@ void MainWindow::onImportLas() {
             well->params = settings.defaultCalculationParams();
             well->source_file_path = path.toStdString();
 
-            project_manager_->addWell(well);
-            well_model_->addWell(well);
+            undo_stack_->push(new core::AddWellCommand(project_manager_.get(), well));
             project_manager_->setDirty(true);
 
             settings.setLastOpenDirectory(QFileInfo(path).absolutePath());
@@ -1097,9 +1257,7 @@ void MainWindow::onImportLas() {
 
             updateActions();
 
-            if (view3d_) view3d_->update();
-            if (plan_view_) plan_view_->update();
-            if (vertical_view_) vertical_view_->update();
+            invalidateViews(views::UpdateScheduler::kGeometry);
         }
     }
 }
@@ -1124,8 +1282,7 @@ void MainWindow::onImportZak() {
             well->params = settings.defaultCalculationParams();
             well->source_file_path = path.toStdString();
 
-            project_manager_->addWell(well);
-            well_model_->addWell(well);
+            undo_stack_->push(new core::AddWellCommand(project_manager_.get(), well));
             project_manager_->setDirty(true);
 
             settings.setLastOpenDirectory(QFileInfo(path).absolutePath());
@@ -1137,9 +1294,7 @@ void MainWindow::onImportZak() {
 
             updateActions();
 
-            if (view3d_) view3d_->update();
-            if (plan_view_) plan_view_->update();
-            if (vertical_view_) vertical_view_->update();
+            invalidateViews(views::UpdateScheduler::kGeometry);
         }
     }
 }
@@ -1147,13 +1302,13 @@ void MainWindow::onImportZak() {
 // --- Заключение ---
 
 void MainWindow::onConclusion() {
-    if (current_well_index_ < 0) {
+    if (!current_well_id_.isValid()) {
         QMessageBox::information(this, tr("Заключение"),
                                  tr("Выберите скважину для формирования заключения"));
         return;
     }
 
-    auto well = well_model_->wellAt(current_well_index_);
+    auto well = well_model_->wellById(current_well_id_);
     if (!well) {
         return;
     }
@@ -1197,7 +1352,7 @@ void MainWindow::onVerticalSettings() {
                     vertical_view_->setShowLabels(s.show_depth_labels);
                     vertical_view_->setGridStep(s.grid_step);
                     // Применение остальных настроек
-                    vertical_view_->refresh();
+                    vertical_view_->invalidate(views::UpdateScheduler::kGeometry);
                 }
             });
 
@@ -1250,6 +1405,10 @@ void MainWindow::onSettings() {
         } else {
             auto_save_timer_->stop();
         }
+
+        memory_tracker_->setSoftBudget(
+            static_cast<std::size_t>(settings.memorySoftBudgetMb()) << 20);
+        onMemoryCheck();
     }
 }
 
@@ -1258,10 +1417,150 @@ void MainWindow::onAbout() {
     dialog.exec();
 }
 
+// --- Диагностика ---
+
+void MainWindow::setupMemoryTracking() {
+    memory_tracker_ = std::make_unique<core::MemoryTracker>(project_manager_.get(), this);
+    memory_tracker_->setSoftBudget(
+        static_cast<std::size_t>(core::Settings::instance().memorySoftBudgetMb()) << 20);
+
+    memory_tracker_->addCollector([this](core::MemoryReport& report) {
+        if (view3d_) {
+            for (auto& well : report.wells) {
+                well.render_bytes = view3d_->wellRenderMemory(well.id);
+            }
+        }
+        // Производные кэши восстанавливаются по требованию и учитываются отдельно от данных
+        std::size_t trajectory_cache_bytes = 0;
+        int trajectory_cache_count = 0;
+        for (const auto& well : project_manager_->wells()) {
+            if (const std::size_t bytes = well->results.cacheMemoryUsage()) {
+                trajectory_cache_bytes += bytes;
+                ++trajectory_cache_count;
+            }
+        }
+        report.subsystems.push_back({tr("Кэши траекторий (LOD, BVH)"), trajectory_cache_bytes,
+                                     trajectory_cache_count, true});
+        if (view3d_) {
+            report.subsystems.push_back({tr("Сетки трубок 3D-вида"), view3d_->tubeMeshMemory(),
+                                         view3d_->tubeMeshCount(), true});
+        }
+        if (plan_view_) {
+            report.subsystems.push_back({tr("Сцена «План»"), plan_view_->sceneMemoryEstimate(),
+                                         plan_view_->sceneItemCount(), true});
+        }
+        if (vertical_view_) {
+            report.subsystems.push_back({tr("Сцена «Вертикальная проекция»"),
+                                         vertical_view_->sceneMemoryEstimate(),
+                                         vertical_view_->sceneItemCount(), true});
+        }
+        // Шаги истории разделяют блоки данных со скважинами, поэтому учитывается только их число
+        report.subsystems.push_back({tr("История отмены"), 0, undo_stack_->count(), false});
+
+        const auto& pool = models::StringPool::instance();
+        report.subsystems.push_back({tr("Пул строк метаданных"), pool.memoryUsage(),
+                                     static_cast<int>(pool.size()), false});
+    });
+
+    // Сцены скрытых видов перестраиваются при следующем показе
+    memory_tracker_->addEvictor([this](std::size_t) {
+        std::size_t freed = 0;
+        if (plan_view_ && !plan_view_->isVisible() && !plan_view_->isSceneReleased()) {
+            freed += plan_view_->releaseScene();
+        }
+        if (vertical_view_ && !vertical_view_->isVisible() && !vertical_view_->isSceneReleased()) {
+            freed += vertical_view_->releaseScene();
+        }
+        return freed;
+    });
+
+    // Кэши скважин, которые сейчас нигде не рисуются, строятся заново при обращении
+    memory_tracker_->addEvictor([this](std::size_t) {
+        std::size_t freed = view3d_ ? view3d_->releaseCaches() : 0;
+        const bool any_view_shown = (view3d_ && view3d_->isVisible()) ||
+                                    (plan_view_ && plan_view_->isVisible()) ||
+                                    (vertical_view_ && vertical_view_->isVisible());
+        for (const auto& well : project_manager_->wells()) {
+            if (!well->visible || !any_view_shown) {
+                freed += well->results.releaseDerivedCaches();
+            }
+        }
+        return freed;
+    });
+
+    connect(memory_tracker_.get(), &core::MemoryTracker::evicted,
+            this, [this](std::size_t bytes) {
+                LOG_INFO(tr("Превышен бюджет памяти, освобождено %1")
+                    .arg(DiagnosticsDock::formatBytes(bytes)));
+            });
+
+    memory_timer_ = new QTimer(this);
+    connect(memory_timer_, &QTimer::timeout, this, &MainWindow::onMemoryCheck);
+    memory_timer_->start(10 * 1000);
+}
+
+void MainWindow::onMemoryCheck() {
+    if (!memory_tracker_) {
+        return;
+    }
+    const auto report = memory_tracker_->enforceBudget();
+    if (diagnostics_dock_ && diagnostics_dock_->isVisible()) {
+        diagnostics_dock_->setReport(report);
+        diagnostics_dock_->setFrameStats(frameStatsByView());
+    }
+}
+
+void MainWindow::invalidateViews(views::UpdateScheduler::Changes changes) {
+    if (view3d_) view3d_->invalidate(changes);
+    if (plan_view_) plan_view_->invalidate(changes);
+    if (vertical_view_) vertical_view_->invalidate(changes);
+}
+
+std::vector<std::pair<QString, views::FrameStatsSummary>> MainWindow::frameStatsByView() const {
+    std::vector<std::pair<QString, views::FrameStatsSummary>> stats;
+    if (view3d_) {
+        stats.emplace_back(tr("3D"), view3d_->frameStats().summary());
+    }
+    if (plan_view_) {
+        stats.emplace_back(tr("План"), plan_view_->frameStats().summary());
+    }
+    if (vertical_view_) {
+        stats.emplace_back(tr("Вертикальная проекция"), vertical_view_->frameStats().summary());
+    }
+    return stats;
+}
+
+void MainWindow::onMemoryDump() {
+    QString path = QFileDialog::getSaveFileName(
+        this, tr("Сохранить отчёт о памяти"),
+        QDir(core::Settings::instance().lastProjectDirectory()).filePath("memory.json"),
+        tr("JSON (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+
+    // Статистика кадров видов — отдельным разделом отчёта
+    QJsonObject render;
+    const char* const keys[] = {"view3d", "plan", "vertical"};
+    const auto stats = frameStatsByView();
+    for (std::size_t i = 0; i < stats.size() && i < std::size(keys); ++i) {
+        QJsonObject view = stats[i].second.toJson();
+        view["name"] = stats[i].first;
+        render[keys[i]] = view;
+    }
+
+    if (memory_tracker_->dumpJson(path, {{"render", render}})) {
+        status_label_->setText(tr("Отчёт о памяти сохранён: %1").arg(path));
+    } else {
+        QMessageBox::warning(this, tr("Ошибка"),
+                             tr("Не удалось записать файл: %1").arg(path));
+    }
+}
+
 // --- Внутренние слоты ---
 
 void MainWindow::onWellSelected(int index) {
-    current_well_index_ = index;
+    current_well_id_ = well_model_->wellIdAt(index);
     updateActions();
 
     auto well = well_model_->wellAt(index);
@@ -1276,6 +1575,38 @@ void MainWindow::onWellSelected(int index) {
     }
 }
 
+void MainWindow::onWellReplaced(int index) {
+    const auto& wells = project_manager_->wells();
+    if (index < 0 || index >= static_cast<int>(wells.size())) {
+        return;
+    }
+
+    auto well = wells[index];
+    well_model_->replaceWell(index, well);
+
+    if (well->id == current_well_id_) {
+        measurements_model_->setWell(well);
+        results_model_->setWell(well);
+    }
+
+    invalidateViews(views::UpdateScheduler::kGeometry);
+}
+
+void MainWindow::onWellEditApplied(const std::shared_ptr<models::WellData>& well) {
+    const int row = well_model_->rowOf(well->id);
+    if (row >= 0) {
+        well_model_->updateWell(row);
+    }
+
+    if (measurements_model_->well() == well) {
+        measurements_model_->refresh();
+        results_model_->refresh();
+    }
+    project_manager_->setDirty(true);
+
+    invalidateViews(views::UpdateScheduler::kGeometry);
+}
+
 void MainWindow::onProcessFinished(bool success, const QString& message) {
     progress_bar_->setVisible(false);
 
@@ -1329,7 +1660,7 @@ void MainWindow::openProject(const QString& path) {
         project_points_model_->setPoints(project_manager_->projectData().project_points);
         shot_points_model_->setPoints(project_manager_->projectData().shot_points);
 
-        current_well_index_ = -1;
+        current_well_id_ = {};
         updateActions();
         status_label_->setText(tr("Проект загружен: %1").arg(path));
 
@@ -1350,8 +1681,7 @@ void MainWindow::openWellFile(const QString& path) {
         result.well->line_width = settings.defaultLineWidth();
         result.well->params = settings.defaultCalculationParams();
 
-        project_manager_->addWell(result.well);
-        well_model_->addWell(result.well);
+        undo_stack_->push(new core::AddWellCommand(project_manager_.get(), result.well));
 
         settings.setLastOpenDirectory(QFileInfo(path).absolutePath());
         settings.addRecentFile(path);
@@ -1362,9 +1692,7 @@ void MainWindow::openWellFile(const QString& path) {
 
         updateActions();
 
-        if (view3d_) view3d_->update();
-        if (plan_view_) plan_view_->update();
-        if (vertical_view_) vertical_view_->update();
+        invalidateViews(views::UpdateScheduler::kGeometry);
 
         LOG_INFO(tr("Файл открыт из командной строки: %1").arg(path));
     } else {
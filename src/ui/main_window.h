@@ -3,6 +3,12 @@
 #include <QMainWindow>
 #include <QTimer>
 #include <memory>
+#include <utility>
+#include <vector>
+
+#include "models/well_data.h"
+#include "views/frame_stats.h"
+#include "views/update_scheduler.h"
 
 // Forward declarations
 class QTabWidget;
@@ -12,6 +18,7 @@ class QProgressBar;
 class QMenu;
 class QAction;
 class QToolBar;
+class QUndoStack;
 
 namespace incline3d {
 
@@ -19,6 +26,8 @@ namespace core {
 class ProjectManager;
 class InclineProcessRunner;
 class FileIO;
+class WellFileWatcher;
+class MemoryTracker;
 }  // namespace core
 
 namespace models {
@@ -42,6 +51,7 @@ class ProjectPointsDock;
 class ShotPointsDock;
 class MeasurementsDock;
 class ResultsDock;
+class DiagnosticsDock;
 
 /// Главное окно приложения Incline3D
 class MainWindow : public QMainWindow {
@@ -113,8 +123,13 @@ private slots:
     void onSettings();
     void onAbout();
 
+    // Диагностика
+    void onMemoryCheck();
+    void onMemoryDump();
+
     // Внутренние
     void onWellSelected(int index);
+    void onWellReplaced(int index);
     void onProcessFinished(bool success, const QString& message);
     void onAutoSave();
     void updateWindowTitle();
@@ -136,10 +151,24 @@ private:
     bool maybeSave();
     void updateActions();
 
+    /// Отметить изменения во всех видах (скрытые обработают их при показе)
+    void invalidateViews(views::UpdateScheduler::Changes changes);
+
+    /// Учёт памяти: сборщики подсистем, вытеснение и периодическая проверка бюджета
+    void setupMemoryTracking();
+
+    /// Сводки статистики кадров всех видов (для дока диагностики)
+    std::vector<std::pair<QString, views::FrameStatsSummary>> frameStatsByView() const;
+
+    /// Обновление моделей и видов после отмены/повтора правки скважины
+    void onWellEditApplied(const std::shared_ptr<models::WellData>& well);
+
     // Компоненты ядра
     std::unique_ptr<core::ProjectManager> project_manager_;
     std::unique_ptr<core::InclineProcessRunner> process_runner_;
     std::unique_ptr<core::FileIO> file_io_;
+    std::unique_ptr<core::WellFileWatcher> well_file_watcher_;
+    std::unique_ptr<core::MemoryTracker> memory_tracker_;
 
     // Модели данных
     std::unique_ptr<models::WellTableModel> well_model_;
@@ -148,6 +177,9 @@ private:
     std::unique_ptr<models::MeasurementsModel> measurements_model_;
     std::unique_ptr<models::ResultsModel> results_model_;
 
+    // История отмены правок
+    QUndoStack* undo_stack_{nullptr};
+
     // Виды визуализации
     views::View3DWidget* view3d_{nullptr};
     views::PlanView* plan_view_{nullptr};
@@ -159,6 +191,7 @@ private:
     ShotPointsDock* shot_points_dock_{nullptr};
     MeasurementsDock* measurements_dock_{nullptr};
     ResultsDock* results_dock_{nullptr};
+    DiagnosticsDock* diagnostics_dock_{nullptr};
 
     // Центральный виджет
     QTabWidget* central_tabs_{nullptr};
@@ -192,6 +225,8 @@ private:
     QAction* action_exit_{nullptr};
 
     // Действия - Редактирование
+    QAction* action_undo_{nullptr};
+    QAction* action_redo_{nullptr};
     QAction* action_add_well_{nullptr};
     QAction* action_remove_well_{nullptr};
     QAction* action_add_project_point_{nullptr};
@@ -226,16 +261,21 @@ private:
 
     // Действия - Вид (дополнительные)
     QAction* action_vertical_settings_{nullptr};
+    QAction* action_frame_stats_{nullptr};
 
     // Действия - Настройки
     QAction* action_settings_{nullptr};
     QAction* action_about_{nullptr};
+    QAction* action_memory_dump_{nullptr};
 
     // Таймер автосохранения
     QTimer* auto_save_timer_{nullptr};
 
-    // Текущая выбранная скважина
-    int current_well_index_{-1};
+    // Таймер проверки бюджета памяти
+    QTimer* memory_timer_{nullptr};
+
+    // Текущая выбранная скважина (по идентификатору — не сдвигается при вставке/удалении)
+    models::WellId current_well_id_;
 };
 
 }  // namespace ui
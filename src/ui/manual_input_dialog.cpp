@@ -25,6 +25,7 @@
 #include "models/measurements_model.h"
 #include "utils/angle_utils.h"
 #include "utils/logger.h"
+#include "utils/parse_arena.h"
 
 namespace incline3d::ui {
 
@@ -598,18 +599,22 @@ void ManualInputDialog::onImportFromClipboard() {
         return;
     }
 
-    // Разбор текста из буфера
-    QStringList lines = text.split(QRegularExpression("[\r\n]+"), Qt::SkipEmptyParts);
+    // Разбор текста из буфера: поля — представления в text, списки — в арене
+    utils::ParseArena arena;
+    const auto lines = utils::split_line_any(text, u"\r\n", arena.resource());
 
+    // Списки полей строк выделяются из отдельной арены, чтобы reset() не задел lines
+    utils::ParseArena line_arena;
     int imported = 0;
-    for (const QString& line : lines) {
+    for (const QStringView line : lines) {
+        line_arena.reset();
         // Разделители: табуляция, точка с запятой, запятая, пробелы
-        QStringList parts = line.split(QRegularExpression("[\\t;,\\s]+"), Qt::SkipEmptyParts);
+        const auto parts = utils::split_line_any(line, u"\t;, ", line_arena.resource());
 
         if (parts.size() >= 2) {
             bool ok_depth, ok_angle;
-            double depth = parts[0].replace(',', '.').toDouble(&ok_depth);
-            double angle = parts[1].replace(',', '.').toDouble(&ok_angle);
+            double depth = utils::parse_number(parts[0], &ok_depth);
+            double angle = utils::parse_number(parts[1], &ok_angle);
 
             if (ok_depth && ok_angle) {
                 models::MeasuredPoint point;
@@ -619,7 +624,7 @@ void ManualInputDialog::onImportFromClipboard() {
                 // Азимут магнитный (если есть)
                 if (parts.size() >= 3) {
                     bool ok_azim;
-                    double azim = parts[2].replace(',', '.').toDouble(&ok_azim);
+                    double azim = utils::parse_number(parts[2], &ok_azim);
                     if (ok_azim && !parts[2].isEmpty()) {
                         point.azimuth_deg = angleToDecimal(azim);
                         point.azimuth_type = models::AzimuthType::kMagnetic;
@@ -629,7 +634,7 @@ void ManualInputDialog::onImportFromClipboard() {
                 // Азимут истинный (если есть)
                 if (parts.size() >= 4) {
                     bool ok_azim_true;
-                    double azim_true = parts[3].replace(',', '.').toDouble(&ok_azim_true);
+                    double azim_true = utils::parse_number(parts[3], &ok_azim_true);
                     if (ok_azim_true && !parts[3].isEmpty()) {
                         point.azimuth_true_deg = angleToDecimal(azim_true);
                         // Если магнитный не задан, используем истинный как основной
@@ -664,7 +669,7 @@ void ManualInputDialog::onFlipArray() {
         return;
     }
 
-    std::reverse(well_->measurements.begin(), well_->measurements.end());
+    well_->measurements.reverse();
     measurements_model_->refresh();
 
     QMessageBox::information(this, tr("Переворот"),
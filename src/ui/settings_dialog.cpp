@@ -56,6 +56,21 @@ void SettingsDialog::setupUi() {
 
     main_layout->addWidget(autosave_group);
 
+    // Группа памяти
+    auto* memory_group = new QGroupBox(tr("Память"));
+    auto* memory_layout = new QFormLayout(memory_group);
+
+    memory_budget_spin_ = new QSpinBox();
+    memory_budget_spin_->setRange(0, 65536);
+    memory_budget_spin_->setSingleStep(256);
+    memory_budget_spin_->setSuffix(tr(" МБ"));
+    memory_budget_spin_->setSpecialValueText(tr("Без ограничения"));
+    memory_budget_spin_->setToolTip(tr("При превышении освобождаются данные, "
+                                       "которые можно восстановить (сцены скрытых видов)"));
+    memory_layout->addRow(tr("Мягкий бюджет:"), memory_budget_spin_);
+
+    main_layout->addWidget(memory_group);
+
     main_layout->addStretch();
 
     // Кнопки
@@ -70,6 +85,7 @@ void SettingsDialog::loadSettings() {
     inclproc_path_edit_->setText(s.inclprocPath());
     autosave_enabled_check_->setChecked(s.autoSaveEnabled());
     autosave_interval_spin_->setValue(s.autoSaveIntervalMinutes());
+    memory_budget_spin_->setValue(s.memorySoftBudgetMb());
 }
 
 void SettingsDialog::onBrowseInclproc() {
@@ -85,6 +101,7 @@ void SettingsDialog::onAccept() {
     s.setInclprocPath(inclproc_path_edit_->text());
     s.setAutoSaveEnabled(autosave_enabled_check_->isChecked());
     s.setAutoSaveIntervalMinutes(autosave_interval_spin_->value());
+    s.setMemorySoftBudgetMb(memory_budget_spin_->value());
     s.save();
     accept();
 }
@@ -23,6 +23,7 @@ private:
     QLineEdit* inclproc_path_edit_{nullptr};
     QSpinBox* autosave_interval_spin_{nullptr};
     QCheckBox* autosave_enabled_check_{nullptr};
+    QSpinBox* memory_budget_spin_{nullptr};
 };
 
 }  // namespace incline3d::ui
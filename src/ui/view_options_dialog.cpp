@@ -2,6 +2,7 @@
 
 #include <QCheckBox>
 #include <QColorDialog>
+#include <QComboBox>
 #include <QDialogButtonBox>
 #include <QDoubleSpinBox>
 #include <QFormLayout>
@@ -188,6 +189,49 @@ void ViewOptionsDialog::setup3DTab(QWidget* tab) {
     rotation_sens_spin_->setSingleStep(0.1);
     view_layout->addRow(tr("Чувствительность вращения:"), rotation_sens_spin_);
 
+    show_tubes_check_ = new QCheckBox(tr("Скважины трубками"), tab);
+    view_layout->addRow(show_tubes_check_);
+
+    tube_coloring_combo_ = new QComboBox(tab);
+    tube_coloring_combo_->addItem(tr("Интенсивность на 10 м"), static_cast<int>(views::TubeColoring::kIntensity10m));
+    tube_coloring_combo_->addItem(tr("Угол искривления"), static_cast<int>(views::TubeColoring::kDogleg));
+    view_layout->addRow(tr("Цвет трубок:"), tube_coloring_combo_);
+
+    tube_radius_spin_ = new QDoubleSpinBox(tab);
+    tube_radius_spin_->setRange(0.1, 500);
+    tube_radius_spin_->setValue(5.0);
+    tube_radius_spin_->setSuffix(tr(" м"));
+    view_layout->addRow(tr("Радиус трубок:"), tube_radius_spin_);
+
+    connect(show_tubes_check_, &QCheckBox::toggled, tube_coloring_combo_, &QComboBox::setEnabled);
+    connect(show_tubes_check_, &QCheckBox::toggled, tube_radius_spin_, &QDoubleSpinBox::setEnabled);
+
+    show_uncertainty_check_ = new QCheckBox(tr("Эллипсоиды погрешностей"), tab);
+    view_layout->addRow(show_uncertainty_check_);
+
+    uncertainty_step_spin_ = new QDoubleSpinBox(tab);
+    uncertainty_step_spin_->setRange(0, 1000);
+    uncertainty_step_spin_->setValue(0.0);
+    uncertainty_step_spin_->setSingleStep(10);
+    uncertainty_step_spin_->setSuffix(tr(" м"));
+    uncertainty_step_spin_->setSpecialValueText(tr("В точках замеров"));
+    view_layout->addRow(tr("Шаг эллипсоидов:"), uncertainty_step_spin_);
+
+    connect(show_uncertainty_check_, &QCheckBox::toggled, uncertainty_step_spin_, &QDoubleSpinBox::setEnabled);
+
+    show_horizons_check_ = new QCheckBox(tr("Поверхности пластов по проектным точкам"), tab);
+    view_layout->addRow(show_horizons_check_);
+
+    horizon_step_spin_ = new QDoubleSpinBox(tab);
+    horizon_step_spin_->setRange(0, 5000);
+    horizon_step_spin_->setValue(0.0);
+    horizon_step_spin_->setSingleStep(50);
+    horizon_step_spin_->setSuffix(tr(" м"));
+    horizon_step_spin_->setSpecialValueText(tr("По точкам"));
+    view_layout->addRow(tr("Шаг сетки поверхностей:"), horizon_step_spin_);
+
+    connect(show_horizons_check_, &QCheckBox::toggled, horizon_step_spin_, &QDoubleSpinBox::setEnabled);
+
     layout->addWidget(view_group);
 
     // Вертикальная проекция
@@ -288,6 +332,17 @@ void ViewOptionsDialog::setOptions(const ViewOptions& options) {
     show_sea_level_check_->setChecked(options.show_sea_level_plane);
     perspective_check_->setChecked(options.enable_perspective);
     rotation_sens_spin_->setValue(options.rotation_sensitivity);
+    show_tubes_check_->setChecked(options.show_tubes);
+    tube_coloring_combo_->setCurrentIndex(tube_coloring_combo_->findData(static_cast<int>(options.tube_coloring)));
+    tube_radius_spin_->setValue(options.tube_radius);
+    tube_coloring_combo_->setEnabled(options.show_tubes);
+    tube_radius_spin_->setEnabled(options.show_tubes);
+    show_uncertainty_check_->setChecked(options.show_uncertainty);
+    uncertainty_step_spin_->setValue(options.uncertainty_step);
+    uncertainty_step_spin_->setEnabled(options.show_uncertainty);
+    show_horizons_check_->setChecked(options.show_horizons);
+    horizon_step_spin_->setValue(options.horizon_grid_step);
+    horizon_step_spin_->setEnabled(options.show_horizons);
 
     auto_azimuth_check_->setChecked(options.auto_fit_azimuth);
     azimuth_spin_->setValue(options.profile_azimuth);
@@ -330,6 +385,13 @@ ViewOptions ViewOptionsDialog::options() const {
     opts.show_sea_level_plane = show_sea_level_check_->isChecked();
     opts.enable_perspective = perspective_check_->isChecked();
     opts.rotation_sensitivity = rotation_sens_spin_->value();
+    opts.show_tubes = show_tubes_check_->isChecked();
+    opts.tube_coloring = static_cast<views::TubeColoring>(tube_coloring_combo_->currentData().toInt());
+    opts.tube_radius = tube_radius_spin_->value();
+    opts.show_uncertainty = show_uncertainty_check_->isChecked();
+    opts.uncertainty_step = uncertainty_step_spin_->value();
+    opts.show_horizons = show_horizons_check_->isChecked();
+    opts.horizon_grid_step = horizon_step_spin_->value();
 
     opts.auto_fit_azimuth = auto_azimuth_check_->isChecked();
     opts.profile_azimuth = azimuth_spin_->value();
@@ -3,6 +3,8 @@
 #include <QDialog>
 #include <QColor>
 
+#include "views/view_settings.h"
+
 class QSpinBox;
 class QDoubleSpinBox;
 class QCheckBox;
@@ -41,6 +43,13 @@ struct ViewOptions {
     QColor sea_level_color{0, 100, 200, 80};
     bool enable_perspective{true};
     double rotation_sensitivity{1.0};
+    bool show_tubes{false};
+    views::TubeColoring tube_coloring{views::TubeColoring::kIntensity10m};
+    double tube_radius{5.0};              ///< Радиус трубок, м
+    bool show_uncertainty{false};
+    double uncertainty_step{0.0};         ///< Шаг эллипсоидов по стволу, м (0 — в точках замеров)
+    bool show_horizons{false};
+    double horizon_grid_step{0.0};        ///< Шаг сетки поверхностей пластов, м (0 — по точкам)
 
     // Вертикальная проекция
     bool auto_fit_azimuth{true};
@@ -112,6 +121,13 @@ private:
     QCheckBox* show_sea_level_check_{nullptr};
     QCheckBox* perspective_check_{nullptr};
     QDoubleSpinBox* rotation_sens_spin_{nullptr};
+    QCheckBox* show_tubes_check_{nullptr};
+    QComboBox* tube_coloring_combo_{nullptr};
+    QDoubleSpinBox* tube_radius_spin_{nullptr};
+    QCheckBox* show_uncertainty_check_{nullptr};
+    QDoubleSpinBox* uncertainty_step_spin_{nullptr};
+    QCheckBox* show_horizons_check_{nullptr};
+    QDoubleSpinBox* horizon_step_spin_{nullptr};
 
     // Вертикальная проекция
     QCheckBox* auto_azimuth_check_{nullptr};
@@ -0,0 +1,283 @@
+#include "utils/delaunay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace incline3d::utils {
+
+namespace {
+
+/// Описанный треугольник во столько раз больше области
+constexpr double kSuperTriangleScale = 100.0;
+
+/// Разрядность координат на кривой Гильберта
+constexpr std::uint32_t kHilbertOrder = 16;
+
+/// Ориентация тройки: > 0 — против часовой стрелки
+double orient(Point2D a, Point2D b, Point2D c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+/// Номер ячейки (x, y) на кривой Гильберта
+std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y) {
+    std::uint64_t index = 0;
+    for (std::uint32_t s = 1u << (kHilbertOrder - 1); s > 0; s >>= 1) {
+        const std::uint32_t rx = (x & s) ? 1 : 0;
+        const std::uint32_t ry = (y & s) ? 1 : 0;
+        index += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+}  // namespace
+
+DelaunayTriangulation::DelaunayTriangulation(Point2D min, Point2D max)
+    : min_(min), max_(max) {
+    const double size = std::max({max.x - min.x, max.y - min.y, 1.0});
+    const double cx = 0.5 * (min.x + max.x);
+    const double cy = 0.5 * (min.y + max.y);
+    const double far = kSuperTriangleScale * size;
+    merge_distance_ = kMergeDistance * size;
+
+    vertices_ = {{cx - far, cy - size}, {cx + far, cy - size}, {cx, cy + far}};
+    ids_ = {0, 0, 0};
+    faces_.push_back({{0, 1, 2}, {-1, -1, -1}, true});
+    marks_.push_back(0);
+}
+
+DelaunayTriangulation DelaunayTriangulation::build(std::span<const Point2D> points) {
+    Point2D min{0.0, 0.0};
+    Point2D max{0.0, 0.0};
+    if (!points.empty()) {
+        min = max = points.front();
+        for (const auto& p : points) {
+            min = {std::min(min.x, p.x), std::min(min.y, p.y)};
+            max = {std::max(max.x, p.x), std::max(max.y, p.y)};
+        }
+    }
+    DelaunayTriangulation triangulation(min, max);
+
+    // Соседние по кривой точки близки и на плоскости: поиск начинается рядом
+    const double scale_x = max.x > min.x ? ((1u << kHilbertOrder) - 1) / (max.x - min.x) : 0.0;
+    const double scale_y = max.y > min.y ? ((1u << kHilbertOrder) - 1) / (max.y - min.y) : 0.0;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> order(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const auto x = static_cast<std::uint32_t>((points[i].x - min.x) * scale_x);
+        const auto y = static_cast<std::uint32_t>((points[i].y - min.y) * scale_y);
+        order[i] = {hilbertIndex(x, y), static_cast<std::uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end());
+
+    triangulation.vertices_.reserve(points.size() + 3);
+    triangulation.ids_.reserve(points.size() + 3);
+    triangulation.faces_.reserve(2 * points.size() + 1);
+    triangulation.marks_.reserve(2 * points.size() + 1);
+    for (const auto& [key, index] : order) {
+        triangulation.insert(points[index], index);
+    }
+    return triangulation;
+}
+
+bool DelaunayTriangulation::insert(Point2D point, std::uint32_t id) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || point.x < min_.x || point.x > max_.x ||
+        point.y < min_.y || point.y > max_.y) {
+        return false;
+    }
+    const std::int32_t start = walk(point, last_face_);
+    if (start < 0) {
+        return false;
+    }
+
+    // Полость: связная область треугольников, в описанную окружность которых попала точка
+    ++epoch_;
+    cavity_.clear();
+    boundary_.clear();
+    cavity_.push_back(start);
+    marks_[start] = epoch_;
+    for (std::size_t k = 0; k < cavity_.size(); ++k) {
+        const std::int32_t f = cavity_[k];
+        for (int i = 0; i < 3; ++i) {
+            const std::int32_t n = faces_[f].neighbor[i];
+            if (n >= 0 && marks_[n] == epoch_) {
+                continue;
+            }
+            if (n >= 0 && inCircumcircle(faces_[n], point)) {
+                marks_[n] = epoch_;
+                cavity_.push_back(n);
+                continue;
+            }
+            const auto& v = faces_[f].vertex;
+            boundary_.push_back({v[(i + 1) % 3], v[(i + 2) % 3], n});
+        }
+    }
+
+    // Совпадающая точка — ближайшая вершина всегда на границе полости
+    for (const auto& edge : boundary_) {
+        const Point2D p = vertices_[edge.from];
+        if (std::hypot(p.x - point.x, p.y - point.y) <= merge_distance_) {
+            return false;
+        }
+    }
+
+    const auto vertex = static_cast<std::uint32_t>(vertices_.size());
+    vertices_.push_back(point);
+    ids_.push_back(id);
+
+    for (const std::int32_t f : cavity_) {
+        faces_[f].alive = false;
+        free_faces_.push_back(f);
+    }
+
+    // Веер из новой точки: треугольник (from, to, vertex) на каждое ребро границы
+    const std::size_t first = cavity_.size();
+    for (const auto& edge : boundary_) {
+        const std::int32_t f = allocateFace();
+        faces_[f] = {{edge.from, edge.to, vertex}, {-1, -1, edge.outside}, true};
+        cavity_.push_back(f);
+        if (edge.outside >= 0) {
+            auto& outside = faces_[edge.outside];
+            for (int i = 0; i < 3; ++i) {
+                const auto& v = outside.vertex;
+                if (v[(i + 1) % 3] == edge.to && v[(i + 2) % 3] == edge.from) {
+                    outside.neighbor[i] = f;
+                }
+            }
+        }
+    }
+
+    // Соседи внутри веера: ребро (to, vertex) — общее с треугольником, начинающимся в to
+    for (std::size_t j = 0; j < boundary_.size(); ++j) {
+        for (std::size_t k = 0; k < boundary_.size(); ++k) {
+            if (boundary_[k].from == boundary_[j].to) {
+                faces_[cavity_[first + j]].neighbor[0] = cavity_[first + k];
+                faces_[cavity_[first + k]].neighbor[1] = cavity_[first + j];
+            }
+        }
+    }
+    last_face_ = cavity_[first];
+    return true;
+}
+
+std::vector<DelaunayTriangulation::Triangle> DelaunayTriangulation::triangles() const {
+    std::vector<Triangle> result;
+    result.reserve(faces_.size());
+    for (const auto& face : faces_) {
+        if (face.alive && !hasSuperVertex(face)) {
+            result.push_back({ids_[face.vertex[0]], ids_[face.vertex[1]], ids_[face.vertex[2]]});
+        }
+    }
+    return result;
+}
+
+bool DelaunayTriangulation::locate(Point2D point, Triangle& triangle, std::array<double, 3>& weights) const {
+    const std::int32_t start = faces_[last_located_].alive ? last_located_ : last_face_;
+    std::int32_t f = walk(point, start);
+    if (f < 0) {
+        return false;
+    }
+    if (hasSuperVertex(faces_[f])) {
+        // Точка на ребре оболочки: берётся треугольник по другую сторону ребра
+        const auto& face = faces_[f];
+        std::int32_t inner = -1;
+        for (int i = 0; i < 3; ++i) {
+            const std::int32_t n = face.neighbor[i];
+            if (n >= 0 && !hasSuperVertex(faces_[n]) &&
+                orient(vertices_[face.vertex[(i + 1) % 3]], vertices_[face.vertex[(i + 2) % 3]], point) == 0.0) {
+                inner = n;
+            }
+        }
+        if (inner < 0) {
+            return false;
+        }
+        f = inner;
+    }
+    last_located_ = f;
+    const auto& v = faces_[f].vertex;
+    const Point2D a = vertices_[v[0]];
+    const Point2D b = vertices_[v[1]];
+    const Point2D c = vertices_[v[2]];
+    const double area = orient(a, b, c);
+    if (area <= 0.0) {
+        return false;
+    }
+    weights = {orient(b, c, point) / area, orient(c, a, point) / area, orient(a, b, point) / area};
+    triangle = {ids_[v[0]], ids_[v[1]], ids_[v[2]]};
+    return true;
+}
+
+std::int32_t DelaunayTriangulation::walk(Point2D point, std::int32_t start) const {
+    // Переход через ребро, за которым лежит точка; ребро проверяется первым
+    // по очереди, чтобы на вырожденных конфигурациях обход не зацикливался
+    std::int32_t f = start;
+    for (std::size_t step = 0; step <= faces_.size(); ++step) {
+        const auto& face = faces_[f];
+        std::int32_t next = -2;
+        for (int k = 0; k < 3; ++k) {
+            const int i = static_cast<int>((k + step) % 3);
+            const Point2D a = vertices_[face.vertex[(i + 1) % 3]];
+            const Point2D b = vertices_[face.vertex[(i + 2) % 3]];
+            if (orient(a, b, point) < 0.0) {
+                next = face.neighbor[i];
+                break;
+            }
+        }
+        if (next == -2) {
+            return f;
+        }
+        if (next < 0) {
+            return -1;
+        }
+        f = next;
+    }
+
+    // Сюда обход не доходит на корректной триангуляции; перебор — на случай ошибок округления
+    for (std::size_t i = 0; i < faces_.size(); ++i) {
+        const auto& face = faces_[i];
+        if (face.alive && orient(vertices_[face.vertex[0]], vertices_[face.vertex[1]], point) >= 0.0 &&
+            orient(vertices_[face.vertex[1]], vertices_[face.vertex[2]], point) >= 0.0 &&
+            orient(vertices_[face.vertex[2]], vertices_[face.vertex[0]], point) >= 0.0) {
+            return static_cast<std::int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+bool DelaunayTriangulation::hasSuperVertex(const Face& face) const {
+    return face.vertex[0] < 3 || face.vertex[1] < 3 || face.vertex[2] < 3;
+}
+
+bool DelaunayTriangulation::inCircumcircle(const Face& face, Point2D point) const {
+    const Point2D a = vertices_[face.vertex[0]];
+    const Point2D b = vertices_[face.vertex[1]];
+    const Point2D c = vertices_[face.vertex[2]];
+    const double ax = a.x - point.x;
+    const double ay = a.y - point.y;
+    const double bx = b.x - point.x;
+    const double by = b.y - point.y;
+    const double cx = c.x - point.x;
+    const double cy = c.y - point.y;
+    const double det = (ax * ax + ay * ay) * (bx * cy - cx * by) - (bx * bx + by * by) * (ax * cy - cx * ay) +
+                       (cx * cx + cy * cy) * (ax * by - bx * ay);
+    return det > 0.0;
+}
+
+std::int32_t DelaunayTriangulation::allocateFace() {
+    if (!free_faces_.empty()) {
+        const std::int32_t f = free_faces_.back();
+        free_faces_.pop_back();
+        return f;
+    }
+    faces_.emplace_back();
+    marks_.push_back(0);
+    return static_cast<std::int32_t>(faces_.size() - 1);
+}
+
+}  // namespace incline3d::utils
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace incline3d::utils {
+
+/// Точка плоскости
+struct Point2D {
+    double x{0.0};
+    double y{0.0};
+};
+
+/// Триангуляция Делоне на плоскости (Боуер — Ватсон, по одной точке)
+///
+/// Точки добавляются по одной: треугольник, содержащий точку, находится
+/// шагами по соседям от последнего созданного, полость из треугольников,
+/// в описанную окружность которых попала точка, собирается обходом соседей
+/// и заменяется веером из новой точки. При вставке в порядке кривой
+/// Гильберта (build()) шаг поиска и полость в среднем
+/// постоянны, поэтому тысячи точек триангулируются за миллисекунды.
+///
+/// Вставка начинается с описанного треугольника, вершины которого в
+/// результат не входят. Совпадающие (ближе kMergeDistance) точки не
+/// добавляются. Треугольники и поиск возвращают идентификаторы, заданные
+/// при вставке (для build() — индексы во входном массиве).
+class DelaunayTriangulation {
+public:
+    /// Треугольник: идентификаторы точек против часовой стрелки
+    using Triangle = std::array<std::uint32_t, 3>;
+
+    /// Точки ближе этого считаются одной, в долях размера области
+    static constexpr double kMergeDistance = 1e-9;
+
+    /// Начать триангуляцию в прямоугольнике (точки вне него не добавляются)
+    DelaunayTriangulation(Point2D min, Point2D max);
+
+    /// Триангуляция набора точек в порядке кривой Гильберта
+    /// @note Из совпадающих точек в треугольники входит одна
+    static DelaunayTriangulation build(std::span<const Point2D> points);
+
+    /// Добавить точку
+    /// @return false — точка вне области или совпадает с уже добавленной
+    bool insert(Point2D point, std::uint32_t id);
+
+    /// Треугольники без вершин описанного треугольника
+    std::vector<Triangle> triangles() const;
+
+    /// Число добавленных точек
+    std::size_t pointCount() const { return vertices_.size() - 3; }
+
+    /// Найти треугольник, содержащий точку, и барицентрические координаты
+    /// @note Поиск начинается от треугольника предыдущего поиска: соседние
+    ///       точки (например, узлы сетки подряд) находятся за несколько шагов
+    /// @return false — точка вне выпуклой оболочки добавленных точек
+    bool locate(Point2D point, Triangle& triangle, std::array<double, 3>& weights) const;
+
+private:
+    /// Внутренний треугольник: вершины и соседи (сосед i — через ребро напротив вершины i)
+    struct Face {
+        std::array<std::uint32_t, 3> vertex{};
+        std::array<std::int32_t, 3> neighbor{-1, -1, -1};
+        bool alive{true};
+    };
+
+    /// Треугольник, содержащий точку (шаги по соседям от start)
+    std::int32_t walk(Point2D point, std::int32_t start) const;
+
+    bool hasSuperVertex(const Face& face) const;
+    bool inCircumcircle(const Face& face, Point2D point) const;
+    std::int32_t allocateFace();
+
+    /// Ребро границы полости и треугольник за ним
+    struct BoundaryEdge {
+        std::uint32_t from{0};
+        std::uint32_t to{0};
+        std::int32_t outside{-1};
+    };
+
+    // Вершины: первые три — описанный треугольник, далее — добавленные точки
+    std::vector<Point2D> vertices_;
+    std::vector<std::uint32_t> ids_;
+    std::vector<Face> faces_;
+    std::vector<std::int32_t> free_faces_;
+    std::int32_t last_face_{0};
+    mutable std::int32_t last_located_{0};  ///< Начало следующего поиска locate()
+    Point2D min_;
+    Point2D max_;
+    double merge_distance_{0.0};
+
+    // Буферы вставки (память переиспользуется)
+    std::vector<std::int32_t> cavity_;
+    std::vector<BoundaryEdge> boundary_;
+    std::vector<std::uint32_t> marks_;      ///< Номер вставки, на которой треугольник попал в полость
+    std::uint32_t epoch_{0};
+};
+
+}  // namespace incline3d::utils
@@ -0,0 +1,101 @@
+#include "utils/parse_arena.h"
+
+#include <QVarLengthArray>
+
+namespace incline3d::utils {
+
+// --- ParseArena ---
+
+ParseArena::ParseArena()
+    : arena_(buffer_, sizeof(buffer_), &upstream_) {
+}
+
+void* ParseArena::CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++allocations_;
+    bytes_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void ParseArena::CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool ParseArena::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// --- Разбор строк ---
+
+namespace {
+
+bool isSeparator(QChar c, QStringView separators, bool any_space) {
+    return (any_space && c.isSpace()) || separators.contains(c);
+}
+
+}  // namespace
+
+TokenList split_line(QStringView line, QChar separator, std::pmr::memory_resource* arena,
+                     Qt::SplitBehavior behavior) {
+    TokenList tokens(arena);
+    // Точный размер заранее: растущий вектор оставил бы в арене старые буферы
+    tokens.reserve(static_cast<std::size_t>(line.count(separator)) + 1);
+
+    qsizetype start = 0;
+    for (;;) {
+        const qsizetype end = line.indexOf(separator, start);
+        const QStringView token = line.sliced(start, (end < 0 ? line.size() : end) - start);
+        if (!token.isEmpty() || behavior == Qt::KeepEmptyParts) {
+            tokens.push_back(token);
+        }
+        if (end < 0) {
+            break;
+        }
+        start = end + 1;
+    }
+    return tokens;
+}
+
+TokenList split_line_any(QStringView line, QStringView separators, std::pmr::memory_resource* arena) {
+    const bool any_space = separators.contains(QLatin1Char(' '));
+
+    std::size_t estimate = 1;
+    for (QChar c : line) {
+        if (isSeparator(c, separators, any_space)) {
+            ++estimate;
+        }
+    }
+
+    TokenList tokens(arena);
+    tokens.reserve(estimate);
+
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= line.size(); ++i) {
+        const bool boundary = i == line.size() || isSeparator(line[i], separators, any_space);
+        if (boundary) {
+            if (start >= 0) {
+                tokens.push_back(line.sliced(start, i - start));
+                start = -1;
+            }
+        } else if (start < 0) {
+            start = i;
+        }
+    }
+    return tokens;
+}
+
+double parse_number(QStringView token, bool* ok, bool comma_decimal) {
+    token = token.trimmed();
+    if (comma_decimal && token.contains(QLatin1Char(','))) {
+        // Замена запятой в копии на стеке: исходная строка не меняется
+        QVarLengthArray<QChar, 64> copy(token.begin(), token.end());
+        for (QChar& c : copy) {
+            if (c == QLatin1Char(',')) {
+                c = QLatin1Char('.');
+            }
+        }
+        return QStringView(copy.constData(), copy.size()).toDouble(ok);
+    }
+    return token.toDouble(ok);
+}
+
+}  // namespace incline3d::utils
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QStringView>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace incline3d::utils {
+
+/// Арена временных данных разбора файла
+///
+/// Живёт на стеке на время одного задания разбора (файл, буфер обмена).
+/// Списки полей строки выделяются из встроенного буфера; reset() в начале
+/// строки возвращает арену к началу буфера, деструктор освобождает всё
+/// разом. Обычная строка не обращается к куче вовсе, поэтому параллельный
+/// импорт нескольких файлов не конкурирует за общий аллокатор.
+class ParseArena {
+public:
+    /// Встроенный буфер, байт (≈500 полей строки)
+    static constexpr std::size_t kInlineBytes = 8192;
+
+    ParseArena();
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena_; }
+
+    /// Освободить всё выделенное с начала задания или с прошлого reset()
+    void reset() { arena_.release(); }
+
+    /// Сколько раз арене не хватило встроенного буфера (обращения к куче)
+    std::size_t heapAllocations() const { return upstream_.allocations(); }
+
+    /// Сколько байт арена запросила у кучи
+    std::size_t heapBytes() const { return upstream_.bytes(); }
+
+private:
+    /// Источник памяти сверх встроенного буфера со счётчиками обращений
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations() const { return allocations_; }
+        std::size_t bytes() const { return bytes_; }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        std::size_t allocations_{0};
+        std::size_t bytes_{0};
+    };
+
+    alignas(std::max_align_t) std::byte buffer_[kInlineBytes];
+    CountingResource upstream_;
+    std::pmr::monotonic_buffer_resource arena_;
+};
+
+/// Поля строки — представления в исходную строку, без копирования текста
+using TokenList = std::pmr::vector<QStringView>;
+
+/// Разбить строку по одному разделителю
+/// @param arena память под список полей (обычно ParseArena::resource())
+TokenList split_line(QStringView line, QChar separator, std::pmr::memory_resource* arena,
+                     Qt::SplitBehavior behavior = Qt::KeepEmptyParts);
+
+/// Разбить строку по любому из символов separators, пропуская пустые поля
+/// @note Пробел в наборе означает любой пробельный символ (как \s+)
+TokenList split_line_any(QStringView line, QStringView separators, std::pmr::memory_resource* arena);
+
+/// Разобрать число из поля (с обрезкой пробелов)
+/// @param comma_decimal допускать запятую как десятичный разделитель
+double parse_number(QStringView token, bool* ok = nullptr, bool comma_decimal = false);
+
+}  // namespace incline3d::utils
@@ -0,0 +1,71 @@
+#include "utils/range_allocator.h"
+
+#include <iterator>
+
+namespace incline3d::utils {
+
+RangeAllocator::Range RangeAllocator::allocate(std::size_t size) {
+    if (size == 0) {
+        return {};
+    }
+
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+        if (it->second >= size) {
+            const Range range{it->first, size};
+            const std::size_t rest = it->second - size;
+            free_.erase(it);
+            if (rest > 0) {
+                free_.emplace(range.end(), rest);
+            }
+            used_ += size;
+            return range;
+        }
+    }
+
+    // Свободные диапазоны не примыкают к границе (см. free), новая память — в конце
+    const std::size_t offset = end_;
+    end_ += size;
+    used_ += size;
+    return {offset, size};
+}
+
+void RangeAllocator::free(Range range) {
+    if (range.empty()) {
+        return;
+    }
+    used_ -= range.size;
+
+    std::size_t offset = range.offset;
+    std::size_t size = range.size;
+
+    // Слияние со следующим свободным диапазоном
+    auto next = free_.lower_bound(offset);
+    if (next != free_.end() && next->first == offset + size) {
+        size += next->second;
+        next = free_.erase(next);
+    }
+    // Слияние с предыдущим
+    if (next != free_.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            free_.erase(prev);
+        }
+    }
+
+    // Свободный хвост возвращается за границу
+    if (offset + size == end_) {
+        end_ = offset;
+    } else {
+        free_.emplace(offset, size);
+    }
+}
+
+void RangeAllocator::clear() {
+    free_.clear();
+    end_ = 0;
+    used_ = 0;
+}
+
+}  // namespace incline3d::utils
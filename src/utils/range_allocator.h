@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+
+namespace incline3d::utils {
+
+/// Распределитель диапазонов в общем линейном буфере
+///
+/// Выдаёт непересекающиеся диапазоны [offset, offset + size) в единицах
+/// элементов буфера (например, вершин в общем буфере видеокарты). Свободные
+/// диапазоны сливаются с соседями; поиск — первый подходящий. Если места
+/// нет, диапазон выделяется в конце и граница end() растёт — владелец
+/// буфера сам увеличивает его ёмкость до end().
+class RangeAllocator {
+public:
+    struct Range {
+        std::size_t offset{0};
+        std::size_t size{0};
+
+        bool empty() const { return size == 0; }
+        std::size_t end() const { return offset + size; }
+    };
+
+    /// Выделить диапазон заданного размера (пустой для size == 0)
+    Range allocate(std::size_t size);
+
+    /// Вернуть диапазон, выделенный allocate()
+    void free(Range range);
+
+    /// Освободить всё
+    void clear();
+
+    /// Граница занятой части буфера (все диапазоны лежат до неё)
+    std::size_t end() const { return end_; }
+
+    /// Суммарный размер выделенных диапазонов
+    std::size_t used() const { return used_; }
+
+private:
+    std::map<std::size_t, std::size_t> free_;   ///< Свободные диапазоны: начало → размер
+    std::size_t end_{0};
+    std::size_t used_{0};
+};
+
+}  // namespace incline3d::utils
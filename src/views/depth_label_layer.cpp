@@ -0,0 +1,195 @@
+#include "views/depth_label_layer.h"
+
+#include <QFontInfo>
+#include <QFontMetricsF>
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace incline3d::views {
+
+namespace {
+
+/// Поле вокруг символа в атласе (против наложения соседей при фильтрации), пиксели
+constexpr int kGlyphPadding = 1;
+
+/// Отступ подписи от траектории, логические пиксели
+constexpr float kLabelGap = 4.0f;
+
+}  // namespace
+
+GlyphAtlas GlyphAtlas::build(const QFont& font, qreal device_pixel_ratio) {
+    GlyphAtlas atlas;
+    atlas.device_pixel_ratio_ = device_pixel_ratio;
+    atlas.index_.fill(-1);
+
+    // Шрифт в физических пикселях: атлас выводится без масштабирования
+    QFont pixel_font = font;
+    pixel_font.setPixelSize(std::max(1, qRound(QFontInfo(font).pixelSize() * device_pixel_ratio)));
+    const QFontMetricsF metrics(pixel_font);
+
+    const int cell_height = static_cast<int>(std::ceil(metrics.ascent() + metrics.descent())) + 2 * kGlyphPadding;
+    std::vector<int> cell_widths;
+    int width = 0;
+    for (const char c : kCharacters) {
+        const int cell = static_cast<int>(std::ceil(metrics.horizontalAdvance(QLatin1Char(c)))) + 2 * kGlyphPadding;
+        cell_widths.push_back(cell);
+        width += cell;
+    }
+
+    atlas.image_ = QImage(width, cell_height, QImage::Format_Alpha8);
+    atlas.image_.fill(Qt::transparent);
+    atlas.height_ = static_cast<float>(cell_height);
+
+    QPainter painter(&atlas.image_);
+    painter.setFont(pixel_font);
+    painter.setPen(Qt::white);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+
+    int x = 0;
+    for (std::size_t i = 0; i < kCharacters.size(); ++i) {
+        const char c = kCharacters[i];
+        painter.drawText(QPointF(x + kGlyphPadding, kGlyphPadding + metrics.ascent()), QString(QLatin1Char(c)));
+
+        // Строка 0 изображения попадает в v = 0: у верха ячейки v меньше, чем у низа
+        const int cell = cell_widths[i];
+        atlas.index_[static_cast<unsigned char>(c)] = static_cast<std::int8_t>(atlas.glyphs_.size());
+        atlas.glyphs_.push_back({static_cast<float>(x) / width, 1.0f,
+                                 static_cast<float>(x + cell) / width, 0.0f,
+                                 static_cast<float>(cell), static_cast<float>(cell_height),
+                                 static_cast<float>(metrics.horizontalAdvance(QLatin1Char(c)))});
+        x += cell;
+    }
+    return atlas;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::glyph(char c) const {
+    const auto code = static_cast<unsigned char>(c);
+    if (code >= index_.size() || index_[code] < 0) {
+        return nullptr;
+    }
+    return &glyphs_[index_[code]];
+}
+
+float GlyphAtlas::textWidth(std::string_view text) const {
+    float width = 0.0f;
+    for (const char c : text) {
+        if (const Glyph* g = glyph(c)) {
+            width += g->advance;
+        }
+    }
+    return width + 2 * kGlyphPadding;
+}
+
+void DepthLabelLayer::setAtlas(GlyphAtlas atlas) {
+    atlas_ = std::move(atlas);
+    wells_.clear();
+}
+
+DepthLabelLayer::WellLabels& DepthLabelLayer::labelsFor(const models::WellData& well,
+                                                        DepthLabelMode mode, double step) {
+    WellLabels& entry = wells_[well.id];
+    entry.used = true;
+    const auto revision = well.results.revision();
+    if (entry.revision == revision && entry.mode == mode && entry.step == step) {
+        return entry;
+    }
+
+    entry.revision = revision;
+    entry.mode = mode;
+    entry.step = step;
+    entry.labels = computeDepthLabels(well.results, mode, step);
+    entry.text.clear();
+    entry.text_offsets.clear();
+    entry.widths.clear();
+
+    // Дробный шаг — с одним знаком после запятой
+    const bool whole = std::floor(step) == step;
+    char buffer[32];
+    for (const auto& label : entry.labels) {
+        const int length = std::snprintf(buffer, sizeof(buffer), whole ? "%.0f" : "%.1f", label.value);
+        const std::string_view text(buffer, static_cast<std::size_t>(std::max(length, 0)));
+        entry.text_offsets.push_back(static_cast<std::uint32_t>(entry.text.size()));
+        entry.text.append(text);
+        entry.widths.push_back(atlas_.textWidth(text));
+    }
+    entry.text_offsets.push_back(static_cast<std::uint32_t>(entry.text.size()));
+    return entry;
+}
+
+void DepthLabelLayer::layout(std::span<const models::WellData* const> wells, DepthLabelMode mode,
+                             double step, const QMatrix4x4& view_projection, const QSizeF& viewport,
+                             const QColor& color, std::vector<GlyphInstance>& glyphs) {
+    glyphs.clear();
+    const float width = static_cast<float>(viewport.width());
+    const float height = static_cast<float>(viewport.height());
+    const float label_height = atlas_.height();
+    grid_.reset(width, height, label_height * 2.0f);
+    if (atlas_.isNull() || step <= 0.0) {
+        return;
+    }
+
+    for (auto& [id, entry] : wells_) {
+        entry.used = false;
+    }
+    for (auto& bucket : candidates_) {
+        bucket.clear();
+    }
+
+    // Проекция на экран: точки за камерой и вне области вывода отбрасываются
+    const float* m = view_projection.constData();   // По столбцам
+    for (const models::WellData* well : wells) {
+        const WellLabels& entry = labelsFor(*well, mode, step);
+        for (std::uint32_t i = 0; i < entry.labels.size(); ++i) {
+            const auto& p = entry.labels[i].position;
+            const float w = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+            if (w <= 0.0f) {
+                continue;
+            }
+            const float x = (m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12]) / w;
+            const float y = (m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13]) / w;
+            const float z = (m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]) / w;
+            if (x < -1.0f || x > 1.0f || y < -1.0f || y > 1.0f || z < -1.0f || z > 1.0f) {
+                continue;
+            }
+            candidates_[entry.labels[i].rank].push_back(
+                {(x * 0.5f + 0.5f) * width, (0.5f - y * 0.5f) * height, &entry, i});
+        }
+    }
+
+    std::erase_if(wells_, [](const auto& item) { return !item.second.used; });
+
+    const float gap = kLabelGap * static_cast<float>(atlas_.devicePixelRatio());
+    const float r = static_cast<float>(color.redF());
+    const float g = static_cast<float>(color.greenF());
+    const float b = static_cast<float>(color.blueF());
+    const float a = static_cast<float>(color.alphaF());
+
+    for (const auto& bucket : candidates_) {
+        for (const Candidate& candidate : bucket) {
+            const WellLabels& entry = *candidate.well;
+            const float label_width = entry.widths[candidate.label];
+            if (!grid_.tryPlace(candidate.x + gap, candidate.y - 0.5f * label_height, label_width,
+                                label_height)) {
+                continue;
+            }
+
+            // Подпись справа от траектории, по центру по высоте
+            const auto& p = entry.labels[candidate.label].position;
+            float pen = gap;
+            for (auto c = entry.text_offsets[candidate.label]; c < entry.text_offsets[candidate.label + 1]; ++c) {
+                const GlyphAtlas::Glyph* glyph = atlas_.glyph(entry.text[c]);
+                if (!glyph) {
+                    continue;
+                }
+                glyphs.push_back({p[0], p[1], p[2], pen, -0.5f * label_height, glyph->width, glyph->height,
+                                  glyph->u0, glyph->v0, glyph->u1, glyph->v1, r, g, b, a});
+                pen += glyph->advance;
+            }
+        }
+    }
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QMatrix4x4>
+#include <QSizeF>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "models/well_data.h"
+#include "views/depth_labels.h"
+
+namespace incline3d::views {
+
+/// Экземпляр символа подписи (буфер экземпляров рендерера)
+struct GlyphInstance {
+    float x, y, z;              ///< Точка привязки подписи
+    float offset_x, offset_y;   ///< Левый нижний угол символа относительно точки привязки, пиксели
+    float width, height;        ///< Размер символа, пиксели
+    float u0, v0, u1, v1;       ///< Текстурные координаты левого нижнего и правого верхнего углов
+    float r, g, b, a;
+};
+
+/// Растровый атлас символов подписей глубины
+///
+/// Символы растеризуются один раз через QPainter в одну строку изображения
+/// Format_Alpha8 в физических пикселях экрана.
+class GlyphAtlas {
+public:
+    /// Символ в атласе
+    struct Glyph {
+        float u0, v0, u1, v1;   ///< Как в GlyphInstance
+        float width, height;    ///< Размер ячейки, пиксели
+        float advance;          ///< Сдвиг пера, пиксели
+    };
+
+    /// Символы, из которых состоят подписи
+    static constexpr std::string_view kCharacters = "0123456789.-";
+
+    /// Растеризовать символы шрифта
+    /// @param device_pixel_ratio отношение физических пикселей к логическим
+    static GlyphAtlas build(const QFont& font, qreal device_pixel_ratio);
+
+    bool isNull() const { return image_.isNull(); }
+    const QImage& image() const { return image_; }
+    qreal devicePixelRatio() const { return device_pixel_ratio_; }
+
+    /// Символ или nullptr, если его нет в атласе
+    const Glyph* glyph(char c) const;
+
+    /// Высота строки, пиксели
+    float height() const { return height_; }
+
+    /// Ширина строки, пиксели
+    float textWidth(std::string_view text) const;
+
+private:
+    QImage image_;
+    qreal device_pixel_ratio_{1.0};
+    float height_{0.0f};
+    std::array<std::int8_t, 128> index_{};  ///< Номер символа в glyphs_ или -1
+    std::vector<Glyph> glyphs_;
+};
+
+/// Подписи глубины на траекториях 3D-вида
+///
+/// Положения подписей считаются один раз на версию результатов скважины,
+/// шаг и режим (computeDepthLabels) вместе с текстом и шириной. В кадре
+/// подписи проецируются на экран и отбираются сеткой занятости: сначала
+/// кратные 10 шагам, затем 5 шагам, затем остальные — при отдалении
+/// остаются «круглые» глубины. Результат — символы для одного инстансного
+/// вызова рендерера.
+class DepthLabelLayer {
+public:
+    /// Сменить атлас (подписи пересчитываются)
+    void setAtlas(GlyphAtlas atlas);
+    const GlyphAtlas& atlas() const { return atlas_; }
+
+    /// Разместить подписи скважин без наложений
+    /// @param view_projection матрица проекции и вида
+    /// @param viewport размер области вывода в физических пикселях
+    /// @param glyphs символы размещённых подписей (заполняется заново)
+    void layout(std::span<const models::WellData* const> wells, DepthLabelMode mode, double step,
+                const QMatrix4x4& view_projection, const QSizeF& viewport, const QColor& color,
+                std::vector<GlyphInstance>& glyphs);
+
+    /// Подписей размещено в последнем кадре
+    std::size_t placedCount() const { return grid_.placedCount(); }
+
+private:
+    /// Подписи скважины с подготовленным текстом
+    struct WellLabels {
+        std::uint64_t revision{0};
+        DepthLabelMode mode{DepthLabelMode::kMeasuredDepth};
+        double step{0.0};
+        std::vector<DepthLabel> labels;
+        std::string text;                   ///< Тексты всех подписей подряд
+        std::vector<std::uint32_t> text_offsets;   ///< Начало текста подписи; последний — конец
+        std::vector<float> widths;          ///< Ширина подписи, пиксели
+        bool used{false};
+    };
+
+    /// Кандидат на размещение в кадре
+    struct Candidate {
+        float x, y;                 ///< Точка привязки на экране (ось y вниз), пиксели
+        const WellLabels* well;
+        std::uint32_t label;
+    };
+
+    WellLabels& labelsFor(const models::WellData& well, DepthLabelMode mode, double step);
+
+    GlyphAtlas atlas_;
+    std::unordered_map<models::WellId, WellLabels> wells_;
+    LabelCollisionGrid grid_;
+    std::array<std::vector<Candidate>, 3> candidates_;  ///< По приоритету DepthLabel::rank
+};
+
+}  // namespace incline3d::views
@@ -0,0 +1,111 @@
+#include "views/depth_labels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+
+namespace incline3d::views {
+
+std::vector<DepthLabel> computeDepthLabels(const models::TrajectoryColumns& results,
+                                           DepthLabelMode mode, double step) {
+    using Column = models::TrajectoryColumns::Column;
+
+    std::vector<DepthLabel> labels;
+    if (step <= 0.0 || results.size() < 2) {
+        return labels;
+    }
+
+    const auto east = results.column(Column::kEast);
+    const auto north = results.column(Column::kNorth);
+    const auto tvd = results.column(Column::kTvd);
+    const auto depth = mode == DepthLabelMode::kTvd ? tvd : results.column(Column::kMeasuredDepth);
+
+    const auto rankOf = [](long long multiple) {
+        if (multiple % 10 == 0) {
+            return 0;
+        }
+        return multiple % 5 == 0 ? 1 : 2;
+    };
+
+    // Уровень k * step относится к сегменту, если лежит в (d0, d1] или [d1, d0):
+    // подпись в точке замера ставится один раз
+    for (std::size_t i = 0; i + 1 < depth.size(); ++i) {
+        const double d0 = depth[i];
+        const double d1 = depth[i + 1];
+        if (d0 == d1) {
+            continue;
+        }
+        const bool rising = d1 > d0;
+        long long first = rising ? static_cast<long long>(std::floor(d0 / step)) + 1
+                                 : static_cast<long long>(std::ceil(d0 / step)) - 1;
+        if (i == 0 && std::fmod(d0, step) == 0.0) {
+            first = static_cast<long long>(d0 / step);     // Устье на уровне кратном шагу
+        }
+        const long long last = rising ? static_cast<long long>(std::floor(d1 / step))
+                                      : static_cast<long long>(std::ceil(d1 / step));
+        const long long direction = rising ? 1 : -1;
+
+        for (long long k = first; rising ? k <= last : k >= last; k += direction) {
+            const double value = k * step;
+            const double t = (value - d0) / (d1 - d0);
+            labels.push_back({{static_cast<float>(east[i] + t * (east[i + 1] - east[i])),
+                               static_cast<float>(north[i] + t * (north[i + 1] - north[i])),
+                               static_cast<float>(-(tvd[i] + t * (tvd[i + 1] - tvd[i])))},
+                              value, rankOf(k)});
+        }
+    }
+    return labels;
+}
+
+void LabelCollisionGrid::reset(float width, float height, float cell_size) {
+    width_ = width;
+    height_ = height;
+    cell_size_ = std::max(cell_size, 1.0f);
+    columns_ = std::max(1, static_cast<int>(std::ceil(width / cell_size_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(height / cell_size_)));
+
+    rects_.clear();
+    const auto cells = static_cast<std::size_t>(columns_) * rows_;
+    if (cells_.size() < cells) {
+        cells_.resize(cells);
+    }
+    for (std::size_t c = 0; c < cells; ++c) {
+        cells_[c].clear();
+    }
+}
+
+bool LabelCollisionGrid::tryPlace(float left, float top, float width, float height) {
+    const Rect rect{left, top, left + width, top + height};
+    if (rect.left < 0.0f || rect.top < 0.0f || rect.right > width_ || rect.bottom > height_) {
+        return false;
+    }
+
+    const int c0 = static_cast<int>(rect.left / cell_size_);
+    const int c1 = std::min(columns_ - 1, static_cast<int>(rect.right / cell_size_));
+    const int r0 = static_cast<int>(rect.top / cell_size_);
+    const int r1 = std::min(rows_ - 1, static_cast<int>(rect.bottom / cell_size_));
+
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            for (const auto index : cells_[static_cast<std::size_t>(r) * columns_ + c]) {
+                const Rect& other = rects_[index];
+                if (rect.left < other.right && other.left < rect.right &&
+                    rect.top < other.bottom && other.top < rect.bottom) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    const auto index = static_cast<std::uint32_t>(rects_.size());
+    rects_.push_back(rect);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            cells_[static_cast<std::size_t>(r) * columns_ + c].push_back(index);
+        }
+    }
+    return true;
+}
+
+}  // namespace incline3d::views
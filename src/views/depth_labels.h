@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "views/view_settings.h"
+
+namespace incline3d::models {
+class TrajectoryColumns;
+}  // namespace incline3d::models
+
+namespace incline3d::views {
+
+/// Подпись глубины на траектории
+struct DepthLabel {
+    std::array<float, 3> position;  ///< Точка траектории (координаты сцены: восток, север, -TVD)
+    double value{0.0};              ///< Глубина, м
+    int rank{0};                    ///< Приоритет при наложении: 0 — кратна 10 шагам, 1 — 5 шагам, 2 — прочие
+};
+
+/// Подписи во всех точках, где глубина кратна шагу
+///
+/// Положение интерполируется между точками замеров. TVD может убывать
+/// (восходящие участки горизонтальных скважин) — подпись ставится в каждом
+/// пересечении уровня.
+std::vector<DepthLabel> computeDepthLabels(const models::TrajectoryColumns& results,
+                                           DepthLabelMode mode, double step);
+
+/// Сетка занятости экрана для отбора подписей без наложений
+///
+/// Экран делится на ячейки; прямоугольник проверяется только против
+/// занятых прямоугольников своих ячеек — отбор n подписей стоит O(n).
+class LabelCollisionGrid {
+public:
+    /// Очистить сетку (память ячеек сохраняется между кадрами)
+    /// @param cell_size сторона ячейки — порядка высоты подписи, пиксели
+    void reset(float width, float height, float cell_size);
+
+    /// Занять прямоугольник, если он не пересекается с уже занятыми
+    /// @return false — прямоугольник пересекается с занятым или вне экрана
+    bool tryPlace(float left, float top, float width, float height);
+
+    /// Число занятых прямоугольников
+    std::size_t placedCount() const { return rects_.size(); }
+
+private:
+    struct Rect {
+        float left, top, right, bottom;
+    };
+
+    float width_{0.0f};
+    float height_{0.0f};
+    float cell_size_{1.0f};
+    int columns_{0};
+    int rows_{0};
+    std::vector<Rect> rects_;
+    std::vector<std::vector<std::uint32_t>> cells_;
+};
+
+}  // namespace incline3d::views
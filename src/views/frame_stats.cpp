@@ -0,0 +1,181 @@
+#include "views/frame_stats.h"
+
+#include <QFontMetrics>
+#include <QPainter>
+#include <QRect>
+#include <QStringList>
+
+#include <algorithm>
+#include <cmath>
+
+namespace incline3d::views {
+
+namespace {
+
+/// Отступ панели от края вида и текста от края панели, пиксели
+constexpr int kOverlayMargin = 6;
+
+/// Запись значения в кольцевое окно
+template <typename T>
+void pushRing(std::vector<T>& ring, std::size_t& next, std::size_t capacity, const T& value) {
+    if (ring.size() < capacity) {
+        ring.push_back(value);
+        return;
+    }
+    ring[next] = value;
+    next = (next + 1) % capacity;
+}
+
+QString formatMs(double ms) {
+    return ms < 0.0 ? QString::fromUtf8("—") : QString::number(ms, 'f', ms < 10.0 ? 2 : 1);
+}
+
+}  // namespace
+
+QJsonObject FrameStatsSummary::toJson() const {
+    QJsonObject obj;
+    obj["frames"] = frames;
+    obj["cpu_p50_ms"] = cpu_p50_ms;
+    obj["cpu_p95_ms"] = cpu_p95_ms;
+    obj["cpu_p99_ms"] = cpu_p99_ms;
+    obj["cpu_max_ms"] = cpu_max_ms;
+    if (gpu_p50_ms >= 0.0) {
+        obj["gpu_p50_ms"] = gpu_p50_ms;
+        obj["gpu_p95_ms"] = gpu_p95_ms;
+    }
+    if (background_p95_ms >= 0.0) {
+        obj["background_p95_ms"] = background_p95_ms;
+    }
+    if (build_ms >= 0.0) {
+        obj["build_ms"] = build_ms;
+        obj["build_max_ms"] = build_max_ms;
+    }
+    obj["draw_calls"] = draw_calls;
+    obj["vertices"] = static_cast<qint64>(vertices);
+    obj["items"] = items;
+    return obj;
+}
+
+void FrameStats::addFrame(const FrameSample& sample) {
+    pushRing(frames_, next_frame_, kWindow, sample);
+}
+
+void FrameStats::addBuild(double ms) {
+    pushRing(builds_, next_build_, kBuildWindow, ms);
+    last_build_ms_ = ms;
+}
+
+void FrameStats::setItemCount(int items) {
+    items_ = items;
+}
+
+void FrameStats::clear() {
+    frames_.clear();
+    next_frame_ = 0;
+    builds_.clear();
+    next_build_ = 0;
+    last_build_ms_ = -1.0;
+}
+
+FrameStatsSummary FrameStats::summary() const {
+    FrameStatsSummary summary;
+    summary.items = items_;
+    summary.build_ms = last_build_ms_;
+    if (!builds_.empty()) {
+        summary.build_max_ms = *std::max_element(builds_.begin(), builds_.end());
+    }
+    if (frames_.empty()) {
+        return summary;
+    }
+
+    std::vector<double> cpu;
+    std::vector<double> gpu;
+    std::vector<double> background;
+    cpu.reserve(frames_.size());
+    for (const auto& frame : frames_) {
+        cpu.push_back(frame.cpu_ms);
+        if (frame.gpu_ms >= 0.0) {
+            gpu.push_back(frame.gpu_ms);
+        }
+        if (frame.background_ms >= 0.0) {
+            background.push_back(frame.background_ms);
+        }
+    }
+
+    summary.frames = static_cast<int>(frames_.size());
+    summary.cpu_p50_ms = percentile(cpu, 50.0);
+    summary.cpu_p95_ms = percentile(cpu, 95.0);
+    summary.cpu_p99_ms = percentile(cpu, 99.0);
+    summary.cpu_max_ms = *std::max_element(cpu.begin(), cpu.end());
+    if (!gpu.empty()) {
+        summary.gpu_p50_ms = percentile(gpu, 50.0);
+        summary.gpu_p95_ms = percentile(gpu, 95.0);
+    }
+    if (!background.empty()) {
+        summary.background_p95_ms = percentile(std::move(background), 95.0);
+    }
+
+    // Последний записанный кадр стоит перед next_frame_ (или в конце, пока окно не заполнено)
+    const auto& last = frames_.size() < kWindow ? frames_.back()
+                                                : frames_[(next_frame_ + kWindow - 1) % kWindow];
+    summary.draw_calls = last.draw_calls;
+    summary.vertices = last.vertices;
+    return summary;
+}
+
+double FrameStats::percentile(std::vector<double> values, double percent) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const double rank = std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * values.size());
+    const auto index = static_cast<std::size_t>(std::max(rank, 1.0)) - 1;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void drawFrameStatsOverlay(QPainter& painter, const QRect& area, const FrameStatsSummary& summary) {
+    QStringList lines;
+    lines << QString::fromUtf8("Кадр, мс: p50 %1  p95 %2  p99 %3  max %4")
+                 .arg(formatMs(summary.cpu_p50_ms), formatMs(summary.cpu_p95_ms),
+                      formatMs(summary.cpu_p99_ms), formatMs(summary.cpu_max_ms));
+    if (summary.gpu_p50_ms >= 0.0) {
+        lines << QString::fromUtf8("GPU, мс: p50 %1  p95 %2")
+                     .arg(formatMs(summary.gpu_p50_ms), formatMs(summary.gpu_p95_ms));
+    }
+    if (summary.background_p95_ms >= 0.0) {
+        lines << QString::fromUtf8("Фон, мс: p95 %1").arg(formatMs(summary.background_p95_ms));
+    }
+    lines << QString::fromUtf8("Построение, мс: %1  max %2")
+                 .arg(formatMs(summary.build_ms), formatMs(summary.build_max_ms));
+    lines << QString::fromUtf8("Вызовов: %1  вершин: %2  элементов: %3")
+                 .arg(summary.draw_calls)
+                 .arg(static_cast<qulonglong>(summary.vertices))
+                 .arg(summary.items);
+
+    painter.save();
+    painter.resetTransform();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    const QFontMetrics metrics(painter.font());
+    int width = 0;
+    for (const auto& line : lines) {
+        width = std::max(width, metrics.horizontalAdvance(line));
+    }
+    const QRect panel(area.left() + kOverlayMargin, area.top() + kOverlayMargin,
+                      width + 2 * kOverlayMargin,
+                      static_cast<int>(lines.size()) * metrics.height() + 2 * kOverlayMargin);
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 160));
+    painter.drawRect(panel);
+
+    painter.setPen(Qt::white);
+    int y = panel.top() + kOverlayMargin + metrics.ascent();
+    for (const auto& line : lines) {
+        painter.drawText(panel.left() + kOverlayMargin, y, line);
+        y += metrics.height();
+    }
+    painter.restore();
+}
+
+}  // namespace incline3d::views
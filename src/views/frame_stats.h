@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QJsonObject>
+
+#include <cstddef>
+#include <vector>
+
+class QPainter;
+class QRect;
+
+namespace incline3d::views {
+
+/// Замеры одного кадра вида
+struct FrameSample {
+    double cpu_ms{0.0};             ///< Подготовка и выдача команд на процессоре
+    double gpu_ms{-1.0};            ///< Выполнение на видеокарте (< 0 — нет данных)
+    double background_ms{-1.0};     ///< Фон 2D-вида: сетка и оси (< 0 — не измерялся)
+    int draw_calls{0};              ///< Вызовы отрисовки (glDraw* или элементы QPainter)
+    std::size_t vertices{0};        ///< Отправлено вершин
+};
+
+/// Сводка по скользящему окну кадров
+struct FrameStatsSummary {
+    int frames{0};                  ///< Кадров в окне
+    double cpu_p50_ms{0.0};
+    double cpu_p95_ms{0.0};
+    double cpu_p99_ms{0.0};
+    double cpu_max_ms{0.0};
+    double gpu_p50_ms{-1.0};        ///< < 0 — таймеры видеокарты недоступны
+    double gpu_p95_ms{-1.0};
+    double background_p95_ms{-1.0};
+    double build_ms{-1.0};          ///< Последнее построение сцены (< 0 — не было)
+    double build_max_ms{-1.0};      ///< Самое долгое построение в окне
+    int draw_calls{0};              ///< Последний кадр
+    std::size_t vertices{0};        ///< Последний кадр
+    int items{0};                   ///< Элементы сцены
+
+    QJsonObject toJson() const;
+};
+
+/// Скользящая статистика времени кадров вида
+///
+/// Хранит последние kWindow кадров и kBuildWindow построений сцены;
+/// перцентили считаются при запросе сводки, поэтому запись кадра — O(1).
+/// Время видеокарты приходит из таймерных запросов с задержкой в несколько
+/// кадров и относится к одному из предыдущих кадров — для перцентилей это
+/// неважно.
+class FrameStats {
+public:
+    static constexpr std::size_t kWindow = 240;
+    static constexpr std::size_t kBuildWindow = 32;
+
+    void addFrame(const FrameSample& sample);
+
+    /// Записать время построения сцены (перестроение элементов, загрузка данных)
+    void addBuild(double ms);
+
+    /// Число элементов сцены (скважины, маркеры, подписи)
+    void setItemCount(int items);
+
+    void clear();
+
+    std::size_t frameCount() const { return frames_.size(); }
+
+    FrameStatsSummary summary() const;
+
+    /// Перцентиль по ближайшему рангу
+    /// @param percent 0–100
+    /// @return 0 для пустого набора
+    static double percentile(std::vector<double> values, double percent);
+
+private:
+    std::vector<FrameSample> frames_;
+    std::size_t next_frame_{0};
+    std::vector<double> builds_;
+    std::size_t next_build_{0};
+    double last_build_ms_{-1.0};
+    int items_{0};
+};
+
+/// Нарисовать сводку полупрозрачной панелью в левом верхнем углу area
+/// (координаты устройства, преобразование painter не учитывается)
+void drawFrameStatsOverlay(QPainter& painter, const QRect& area, const FrameStatsSummary& summary);
+
+}  // namespace incline3d::views
@@ -0,0 +1,215 @@
+#include "views/horizon_surfaces.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "utils/delaunay.h"
+
+namespace incline3d::views {
+
+namespace {
+
+/// Нормали вершин — сумма нормалей треугольников (с весом площади)
+void computeNormals(HorizonMesh& mesh) {
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        auto& a = mesh.vertices[mesh.indices[i]];
+        auto& b = mesh.vertices[mesh.indices[i + 1]];
+        auto& c = mesh.vertices[mesh.indices[i + 2]];
+        const float ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+        const float vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+        const float nx = uy * vz - uz * vy;
+        const float ny = uz * vx - ux * vz;
+        const float nz = ux * vy - uy * vx;
+        for (auto* v : {&a, &b, &c}) {
+            v->nx += nx;
+            v->ny += ny;
+            v->nz += nz;
+        }
+    }
+    for (auto& v : mesh.vertices) {
+        const float length = std::sqrt(v.nx * v.nx + v.ny * v.ny + v.nz * v.nz);
+        if (length > 0.0f) {
+            v.nx /= length;
+            v.ny /= length;
+            v.nz /= length;
+        } else {
+            v.nz = 1.0f;
+        }
+    }
+}
+
+SurfaceVertex makeVertex(double east, double north, double tvd, const QColor& color) {
+    return {static_cast<float>(east), static_cast<float>(north), static_cast<float>(-tvd),
+            0.0f, 0.0f, 0.0f,
+            static_cast<float>(color.redF()), static_cast<float>(color.greenF()),
+            static_cast<float>(color.blueF()), static_cast<float>(color.alphaF())};
+}
+
+}  // namespace
+
+std::vector<HorizonGroup> groupHorizonPoints(std::span<const models::ProjectPoint> points) {
+    std::vector<HorizonGroup> groups;
+    std::unordered_map<std::string, std::size_t> index;
+    for (const auto& point : points) {
+        if (!point.visible || point.name.empty() ||
+            (point.fact_north_m == 0.0 && point.fact_east_m == 0.0 && point.fact_tvd_m == 0.0)) {
+            continue;
+        }
+        auto [it, inserted] = index.try_emplace(point.name, groups.size());
+        if (inserted) {
+            groups.push_back({point.name, point.display_color, {}});
+        }
+        groups[it->second].points.push_back({point.fact_east_m, point.fact_north_m, point.fact_tvd_m});
+    }
+    return groups;
+}
+
+HorizonMesh buildHorizonMesh(std::span<const HorizonPoint> points, double grid_step, const QColor& color) {
+    HorizonMesh mesh;
+    if (points.size() < 3) {
+        return mesh;
+    }
+
+    std::vector<utils::Point2D> plane;
+    plane.reserve(points.size());
+    for (const auto& point : points) {
+        plane.push_back({point.east, point.north});
+    }
+    auto triangulation = utils::DelaunayTriangulation::build(plane);
+
+    if (grid_step <= 0.0) {
+        // Вершины — сами точки; точки-дубликаты остаются без треугольников
+        mesh.vertices.reserve(points.size());
+        for (const auto& point : points) {
+            mesh.vertices.push_back(makeVertex(point.east, point.north, point.tvd, color));
+        }
+        for (const auto& triangle : triangulation.triangles()) {
+            mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+        }
+        computeNormals(mesh);
+        return mesh;
+    }
+
+    // Регулярная сетка по прямоугольнику точек
+    auto [min_east, max_east] = std::minmax_element(plane.begin(), plane.end(),
+                                                    [](auto a, auto b) { return a.x < b.x; });
+    auto [min_north, max_north] = std::minmax_element(plane.begin(), plane.end(),
+                                                      [](auto a, auto b) { return a.y < b.y; });
+    const double x0 = min_east->x;
+    const double y0 = min_north->y;
+    const double width = max_east->x - x0;
+    const double height = max_north->y - y0;
+    const double step = std::max({grid_step, width / (kMaxHorizonGridNodes - 1),
+                                  height / (kMaxHorizonGridNodes - 1)});
+    const int columns = static_cast<int>(std::floor(width / step)) + 1;
+    const int rows = static_cast<int>(std::floor(height / step)) + 1;
+    if (columns < 2 || rows < 2) {
+        // Область уже шага сетки — поверхность по самим точкам
+        return buildHorizonMesh(points, 0.0, color);
+    }
+
+    // Номер вершины узла; -1 — узел вне выпуклой оболочки
+    std::vector<std::int64_t> node(static_cast<std::size_t>(columns) * rows, -1);
+    utils::DelaunayTriangulation::Triangle triangle{};
+    std::array<double, 3> weights{};
+    for (int row = 0; row < rows; ++row) {
+        // Змейкой: соседние узлы ищутся от соседнего треугольника
+        for (int k = 0; k < columns; ++k) {
+            const int column = row % 2 == 0 ? k : columns - 1 - k;
+            const double x = x0 + column * step;
+            const double y = y0 + row * step;
+            if (!triangulation.locate({x, y}, triangle, weights)) {
+                continue;
+            }
+            const double tvd = weights[0] * points[triangle[0]].tvd + weights[1] * points[triangle[1]].tvd +
+                               weights[2] * points[triangle[2]].tvd;
+            node[static_cast<std::size_t>(row) * columns + column] = static_cast<std::int64_t>(mesh.vertices.size());
+            mesh.vertices.push_back(makeVertex(x, y, tvd, color));
+        }
+    }
+
+    // Ячейка — два треугольника, если все её углы внутри оболочки
+    for (int row = 0; row + 1 < rows; ++row) {
+        for (int column = 0; column + 1 < columns; ++column) {
+            const auto at = [&](int r, int c) { return node[static_cast<std::size_t>(r) * columns + c]; };
+            const std::int64_t a = at(row, column);
+            const std::int64_t b = at(row, column + 1);
+            const std::int64_t c = at(row + 1, column + 1);
+            const std::int64_t d = at(row + 1, column);
+            if (a < 0 || b < 0 || c < 0 || d < 0) {
+                continue;
+            }
+            for (const std::int64_t v : {a, b, c, a, c, d}) {
+                mesh.indices.push_back(static_cast<std::uint32_t>(v));
+            }
+        }
+    }
+    computeNormals(mesh);
+    return mesh;
+}
+
+bool HorizonLayer::update(std::span<const models::ProjectPoint> points, double grid_step) {
+    const auto groups = groupHorizonPoints(points);
+
+    bool changed = groups.size() != order_.size();
+    std::unordered_map<std::string, Surface> surfaces;
+    surfaces.reserve(groups.size());
+    for (std::size_t k = 0; k < groups.size(); ++k) {
+        const auto& group = groups[k];
+        QColor color = group.color;
+        color.setAlphaF(kAlpha);
+
+        Surface surface;
+        auto cached = surfaces_.find(group.name);
+        if (cached != surfaces_.end() && cached->second.points == group.points &&
+            cached->second.color == color.rgba() && cached->second.step == grid_step) {
+            surface = std::move(cached->second);
+        } else {
+            surface.points = group.points;
+            surface.color = color.rgba();
+            surface.step = grid_step;
+            surface.mesh = buildHorizonMesh(group.points, grid_step, color);
+            changed = true;
+        }
+        if (!changed && order_[k] != group.name) {
+            changed = true;
+        }
+        surfaces.emplace(group.name, std::move(surface));
+    }
+
+    // Пласты без точек забываются вместе с поверхностями
+    surfaces_ = std::move(surfaces);
+    if (!changed) {
+        return false;
+    }
+
+    order_.clear();
+    vertices_.clear();
+    indices_.clear();
+    surface_count_ = 0;
+    for (const auto& group : groups) {
+        const auto& mesh = surfaces_.at(group.name).mesh;
+        order_.push_back(group.name);
+        if (mesh.empty()) {
+            continue;
+        }
+        const auto base = static_cast<std::uint32_t>(vertices_.size());
+        vertices_.insert(vertices_.end(), mesh.vertices.begin(), mesh.vertices.end());
+        for (const std::uint32_t index : mesh.indices) {
+            indices_.push_back(base + index);
+        }
+        ++surface_count_;
+    }
+    return true;
+}
+
+void HorizonLayer::clear() {
+    surfaces_.clear();
+    order_.clear();
+    vertices_.clear();
+    indices_.clear();
+    surface_count_ = 0;
+}
+
+}  // namespace incline3d::views
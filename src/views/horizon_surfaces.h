@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QColor>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "models/project_point.h"
+
+namespace incline3d::views {
+
+/// Вершина поверхности пласта: положение (восток, север, -TVD), нормаль, цвет
+struct SurfaceVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    float r, g, b, a;
+};
+
+/// Точка кровли пласта
+struct HorizonPoint {
+    double east{0.0};
+    double north{0.0};
+    double tvd{0.0};
+
+    bool operator==(const HorizonPoint&) const = default;
+};
+
+/// Точки одного пласта
+struct HorizonGroup {
+    std::string name;
+    QColor color;
+    std::vector<HorizonPoint> points;
+};
+
+/// Сетка поверхности (индексы — треугольники против часовой стрелки, вид сверху)
+struct HorizonMesh {
+    std::vector<SurfaceVertex> vertices;
+    std::vector<std::uint32_t> indices;
+
+    bool empty() const { return indices.empty(); }
+};
+
+/// Наибольшее число узлов сетки по стороне: мелкий шаг на большой площади укрупняется
+constexpr int kMaxHorizonGridNodes = 512;
+
+/// Сгруппировать видимые рассчитанные проектные точки по названию пласта
+///
+/// Цвет группы — цвет первой точки. Точки без фактических координат
+/// (не рассчитаны) пропускаются. Группы — в порядке первого появления.
+std::vector<HorizonGroup> groupHorizonPoints(std::span<const models::ProjectPoint> points);
+
+/// Построить поверхность пласта по триангуляции Делоне его точек
+/// @param grid_step шаг регулярной сетки, м: значения в узлах интерполируются
+///        линейно по треугольникам, узлы вне выпуклой оболочки точек
+///        отбрасываются; ≤ 0 — сами треугольники по точкам
+HorizonMesh buildHorizonMesh(std::span<const HorizonPoint> points, double grid_step, const QColor& color);
+
+/// Поверхности пластов 3D-вида
+///
+/// Поверхность пласта строится заново, только когда меняются его точки,
+/// цвет или шаг сетки; остальные берутся из кэша. Общий массив для буфера
+/// рендерера пересобирается, если изменилась хотя бы одна поверхность.
+class HorizonLayer {
+public:
+    /// Непрозрачность поверхностей
+    static constexpr float kAlpha = 0.6f;
+
+    /// Обновить поверхности по проектным точкам
+    /// @return true, если vertices() и indices() изменились
+    bool update(std::span<const models::ProjectPoint> points, double grid_step);
+
+    /// Вершины и индексы всех поверхностей подряд
+    const std::vector<SurfaceVertex>& vertices() const { return vertices_; }
+    const std::vector<std::uint32_t>& indices() const { return indices_; }
+
+    /// Число поверхностей с треугольниками
+    int surfaceCount() const { return surface_count_; }
+
+    /// Забыть все поверхности (слой выключен)
+    void clear();
+
+private:
+    /// Поверхность одного пласта и данные, по которым она построена
+    struct Surface {
+        std::vector<HorizonPoint> points;
+        QRgb color{0};
+        double step{0.0};
+        HorizonMesh mesh;
+    };
+
+    std::unordered_map<std::string, Surface> surfaces_;
+    std::vector<std::string> order_;        ///< Пласты в порядке общего массива
+    std::vector<SurfaceVertex> vertices_;
+    std::vector<std::uint32_t> indices_;
+    int surface_count_{0};
+};
+
+}  // namespace incline3d::views
@@ -0,0 +1,54 @@
+#include "views/image_tiles.h"
+
+#include <algorithm>
+
+namespace incline3d::views {
+
+std::vector<QRect> splitIntoTiles(const QSize& size, int max_tile) {
+    std::vector<QRect> tiles;
+    if (size.isEmpty() || max_tile <= 0) {
+        return tiles;
+    }
+
+    for (int y = 0; y < size.height(); y += max_tile) {
+        for (int x = 0; x < size.width(); x += max_tile) {
+            tiles.emplace_back(x, y, std::min(max_tile, size.width() - x),
+                               std::min(max_tile, size.height() - y));
+        }
+    }
+    return tiles;
+}
+
+QMatrix4x4 tileProjection(const QMatrix4x4& projection, const QSize& size, const QRect& tile) {
+    // Границы плитки в нормализованных координатах всего кадра
+    const float left = 2.0f * tile.left() / size.width() - 1.0f;
+    const float right = 2.0f * (tile.left() + tile.width()) / size.width() - 1.0f;
+    const float top = 1.0f - 2.0f * tile.top() / size.height();
+    const float bottom = 1.0f - 2.0f * (tile.top() + tile.height()) / size.height();
+
+    // Растяжение [left, right] × [bottom, top] на [-1, 1]² в однородных координатах
+    const float sx = 2.0f / (right - left);
+    const float sy = 2.0f / (top - bottom);
+    const QMatrix4x4 crop(sx, 0.0f, 0.0f, -(left + right) / (right - left),
+                          0.0f, sy, 0.0f, -(bottom + top) / (top - bottom),
+                          0.0f, 0.0f, 1.0f, 0.0f,
+                          0.0f, 0.0f, 0.0f, 1.0f);
+    return crop * projection;
+}
+
+QTransform fitSceneToImage(const QRectF& scene_rect, const QSize& size, bool invert_y) {
+    if (scene_rect.isEmpty() || size.isEmpty()) {
+        return {};
+    }
+
+    const double scale = std::min(size.width() / scene_rect.width(), size.height() / scene_rect.height());
+    const QPointF center = scene_rect.center();
+
+    QTransform transform;
+    transform.translate(size.width() / 2.0, size.height() / 2.0);
+    transform.scale(scale, invert_y ? -scale : scale);
+    transform.translate(-center.x(), -center.y());
+    return transform;
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QMatrix4x4>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+#include <QTransform>
+
+#include <vector>
+
+namespace incline3d::views {
+
+/// Разбить изображение на плитки со стороной не больше max_tile пикселей
+///
+/// Плитки идут построчно сверху вниз, покрывают изображение без перекрытий;
+/// крайние плитки могут быть меньше.
+std::vector<QRect> splitIntoTiles(const QSize& size, int max_tile);
+
+/// Проекция для плитки: часть кадра projection, попадающая в прямоугольник
+/// tile изображения size (ось y изображения — вниз)
+///
+/// Размер пикселя в плитке совпадает с размером пикселя всего изображения,
+/// поэтому толщины линий, маркеры и подписи в пикселях не меняются.
+QMatrix4x4 tileProjection(const QMatrix4x4& projection, const QSize& size, const QRect& tile);
+
+/// Преобразование сцены в изображение: прямоугольник scene_rect вписывается
+/// по центру с сохранением пропорций
+/// @param invert_y ось y сцены направлена вверх (план: север — вверх)
+QTransform fitSceneToImage(const QRectF& scene_rect, const QSize& size, bool invert_y);
+
+}  // namespace incline3d::views
@@ -0,0 +1,65 @@
+#include "views/offscreen_context.h"
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+
+#include <algorithm>
+
+#include "utils/logger.h"
+
+namespace incline3d::views {
+
+OffscreenContext::OffscreenContext()
+    : previous_context_(QOpenGLContext::currentContext()),
+      previous_surface_(previous_context_ ? previous_context_->surface() : nullptr) {}
+
+OffscreenContext::~OffscreenContext() {
+    if (context_) {
+        context_->doneCurrent();
+    }
+    if (previous_context_ && previous_surface_) {
+        previous_context_->makeCurrent(previous_surface_);
+    }
+}
+
+bool OffscreenContext::create() {
+    QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+
+    context_ = std::make_unique<QOpenGLContext>();
+    context_->setFormat(format);
+    if (!context_->create()) {
+        LOG_ERROR(QString::fromUtf8("Не удалось создать контекст OpenGL для отрисовки без окна"));
+        context_.reset();
+        return false;
+    }
+
+    surface_ = std::make_unique<QOffscreenSurface>();
+    surface_->setFormat(context_->format());
+    surface_->create();
+    if (!surface_->isValid() || !context_->makeCurrent(surface_.get())) {
+        LOG_ERROR(QString::fromUtf8("Не удалось создать поверхность OpenGL для отрисовки без окна"));
+        context_.reset();
+        return false;
+    }
+    return true;
+}
+
+int OffscreenContext::maxTileSize() const {
+    if (!context_) {
+        return 0;
+    }
+    GLint renderbuffer = 0;
+    GLint viewport[2] = {0, 0};
+    auto* functions = context_->functions();
+    functions->glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &renderbuffer);
+    functions->glGetIntegerv(GL_MAX_VIEWPORT_DIMS, viewport);
+    return std::min({kMaxTileSize, static_cast<int>(renderbuffer), static_cast<int>(viewport[0]),
+                     static_cast<int>(viewport[1])});
+}
+
+}  // namespace incline3d::views
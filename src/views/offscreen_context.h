@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QSurface;
+
+namespace incline3d::views {
+
+/// Контекст OpenGL без окна для отрисовки в кадровый буфер
+///
+/// QOffscreenSurface не требует видимого окна и работает на программном
+/// Mesa llvmpipe. Пока объект жив, его контекст текущий; при разрушении
+/// текущим снова становится прежний контекст. Используется только в потоке GUI.
+class OffscreenContext {
+public:
+    /// Наибольшая сторона плитки, пиксели (ограничивает память кадрового буфера)
+    static constexpr int kMaxTileSize = 4096;
+
+    OffscreenContext();
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    /// Создать контекст OpenGL 3.3 core и сделать его текущим
+    /// @return false, если контекст или поверхность не создаются (подробности в журнале)
+    bool create();
+
+    QOpenGLContext* context() const { return context_.get(); }
+
+    /// Наибольшая сторона плитки: не больше kMaxTileSize и предела кадрового буфера
+    int maxTileSize() const;
+
+private:
+    std::unique_ptr<QOffscreenSurface> surface_;
+    std::unique_ptr<QOpenGLContext> context_;
+    QOpenGLContext* previous_context_{nullptr};
+    QSurface* previous_surface_{nullptr};
+};
+
+}  // namespace incline3d::views
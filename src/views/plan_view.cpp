@@ -1,21 +1,33 @@
 #include "views/plan_view.h"
 
-#include <QGraphicsPathItem>
 #include <QGraphicsEllipseItem>
+#include <QGraphicsItemGroup>
+#include <QGraphicsLineItem>
 #include <QGraphicsPolygonItem>
 #include <QGraphicsTextItem>
+#include <QElapsedTimer>
+#include <QHideEvent>
 #include <QMouseEvent>
+#include <QPaintEvent>
+#include <QShowEvent>
 #include <QWheelEvent>
 #include <QPainter>
 #include <QScrollBar>
 #include <cmath>
 
 #include "models/well_table_model.h"
+#include "views/image_tiles.h"
+#include "views/scene_stats.h"
+#include "views/trajectory_layer_item.h"
 #include "models/project_points_model.h"
 #include "models/shot_points_model.h"
 
 namespace incline3d::views {
 
+namespace {
+constexpr double kMinFitMargin = 10.0;   // м
+}  // namespace
+
 PlanView::PlanView(QWidget* parent)
     : QGraphicsView(parent) {
     scene_ = new QGraphicsScene(this);
@@ -34,55 +46,93 @@ PlanView::PlanView(QWidget* parent)
 
     setMinimumSize(400, 300);
     setBackgroundBrush(Qt::white);
+
+    // Изменения копятся и обрабатываются раз за проход цикла событий;
+    // после прокрутки и перетаскивания траектории уточняются
+    scheduler_ = new UpdateScheduler(this);
+    connect(scheduler_, &UpdateScheduler::flushRequested, this, &PlanView::applyChanges);
+    connect(scheduler_, &UpdateScheduler::refineRequested, this, [this]() {
+        updateTrajectoryDetail();
+    });
 }
 
 PlanView::~PlanView() = default;
 
 void PlanView::setWellModel(models::WellTableModel* model) {
     well_model_ = model;
-    rebuildScene();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void PlanView::setProjectPointsModel(models::ProjectPointsModel* model) {
+    if (project_points_model_) {
+        disconnect(project_points_model_, nullptr, this, nullptr);
+    }
     project_points_model_ = model;
-    rebuildScene();
+    watchPointsModel(model);
+    invalidatePoints();
 }
 
 void PlanView::setShotPointsModel(models::ShotPointsModel* model) {
+    if (shot_points_model_) {
+        disconnect(shot_points_model_, nullptr, this, nullptr);
+    }
     shot_points_model_ = model;
-    rebuildScene();
+    watchPointsModel(model);
+    invalidatePoints();
+}
+
+void PlanView::watchPointsModel(QAbstractItemModel* model) {
+    if (!model) return;
+    connect(model, &QAbstractItemModel::dataChanged, this, &PlanView::invalidatePoints);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &PlanView::invalidatePoints);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &PlanView::invalidatePoints);
+    connect(model, &QAbstractItemModel::modelReset, this, &PlanView::invalidatePoints);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &PlanView::invalidatePoints);
+}
+
+void PlanView::invalidatePoints() {
+    points_dirty_ = true;
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void PlanView::setShowGrid(bool show) {
     show_grid_ = show;
-    viewport()->update();
+    invalidate(UpdateScheduler::kStyle);
 }
 
 void PlanView::setShowAxes(bool show) {
     show_axes_ = show;
-    viewport()->update();
+    invalidate(UpdateScheduler::kStyle);
 }
 
 void PlanView::setShowLabels(bool show) {
     show_labels_ = show;
-    rebuildScene();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void PlanView::setGridStep(double step) {
     grid_step_ = step;
-    viewport()->update();
+    invalidate(UpdateScheduler::kStyle);
+}
+
+void PlanView::setShowFrameStats(bool show) {
+    show_frame_stats_ = show;
+    frame_stats_.clear();
+    invalidate(UpdateScheduler::kStyle);
 }
 
 void PlanView::fitToContent() {
-    if (scene_->items().isEmpty()) {
+    const auto content = contentBounds();
+    if (!content) {
         return;
     }
 
-    QRectF bounds = scene_->itemsBoundingRect();
-    // Добавляем отступы
-    double margin = std::max(bounds.width(), bounds.height()) * 0.1;
+    QRectF bounds = *content;
+    // Добавляем отступы (не меньше kMinFitMargin — вертикальная скважина в плане — точка)
+    double margin = std::max(std::max(bounds.width(), bounds.height()) * 0.1, kMinFitMargin);
     bounds.adjust(-margin, -margin, margin, margin);
     fitInView(bounds, Qt::KeepAspectRatio);
+    updateTrajectoryDetail();
 }
 
 void PlanView::resetView() {
@@ -92,26 +142,210 @@ void PlanView::resetView() {
     fitToContent();
 }
 
+QImage PlanView::renderImage(const QSize& size, const QRect& tile, bool fit_content) {
+    const QRect region = tile.isNull() ? QRect(QPoint(0, 0), size) : tile;
+    if (size.isEmpty() || region.isEmpty()) {
+        return {};
+    }
+    // Отложенные изменения — до снимка
+    applyChanges(scheduler_->takePending() |
+                 (scene_released_ ? UpdateScheduler::kGeometry : UpdateScheduler::kNone));
+
+    // Область сцены: всё содержимое с полями, как в fitToContent, или видимая в окне
+    QRectF source = mapToScene(viewport()->rect()).boundingRect();
+    if (fit_content) {
+        if (const auto content = contentBounds()) {
+            source = *content;
+            const double margin = std::max(std::max(source.width(), source.height()) * 0.1, kMinFitMargin);
+            source.adjust(-margin, -margin, margin, margin);
+        }
+    }
+    QTransform transform = fitSceneToImage(source, size, true);
+    transform *= QTransform::fromTranslate(-region.left(), -region.top());
+    const QRectF visible = transform.inverted().mapRect(QRectF(QPointF(0, 0), QSizeF(region.size())));
+
+    // Детализация траекторий — под размер пикселя изображения
+    applyTrajectoryDetail(1.0 / std::abs(transform.m11()));
+
+    QImage image(region.size(), QImage::Format_RGB32);
+    image.fill(backgroundBrush().color());
+    {
+        QPainter painter(&image);
+        painter.setRenderHints(renderHints());
+        painter.setTransform(transform);
+        if (show_grid_) {
+            drawGrid(&painter, visible);
+        }
+        if (show_axes_) {
+            drawAxes(&painter, visible);
+        }
+        scene_->render(&painter, visible, visible, Qt::IgnoreAspectRatio);
+    }
+    if (trajectory_layer_) {
+        trajectory_layer_->takePaintStats();  // Снимок — не кадр вида
+    }
+
+    updateTrajectoryDetail();
+    return image;
+}
+
 void PlanView::refresh() {
-    rebuildScene();
+    points_dirty_ = true;
+    applyChanges(scheduler_->takePending() | UpdateScheduler::kGeometry);
+}
+
+void PlanView::invalidate(UpdateScheduler::Changes changes) {
+    scheduler_->invalidate(changes);
+}
+
+void PlanView::applyChanges(UpdateScheduler::Changes changes) {
+    if (changes.testFlag(UpdateScheduler::kGeometry)) {
+        syncScene();
+    }
+    if (changes.testFlag(UpdateScheduler::kGeometry) || changes.testFlag(UpdateScheduler::kCamera)) {
+        // Во время прокрутки и перетаскивания — грубее; уточнение после паузы
+        const double scale = scheduler_->isInteracting() ? UpdateScheduler::kInteractionDetailScale : 1.0;
+        applyTrajectoryDetail(pixelSizeM(), scale);
+    }
+    viewport()->update();
+}
+
+int PlanView::sceneItemCount() const {
+    return static_cast<int>(scene_->items().size());
+}
+
+std::size_t PlanView::sceneMemoryEstimate() const {
+    return estimateSceneMemory(scene_) + (trajectory_layer_ ? trajectory_layer_->memoryUsage() : 0);
 }
 
-void PlanView::rebuildScene() {
+std::size_t PlanView::releaseScene() {
+    const std::size_t bytes = sceneMemoryEstimate();
+    well_items_.clear();
+    trajectory_layer_ = nullptr;
+    points_group_ = nullptr;
     scene_->clear();
+    scene_released_ = true;
+    return bytes;
+}
+
+bool PlanView::isSceneReleased() const {
+    return scene_released_;
+}
+
+void PlanView::showEvent(QShowEvent* event) {
+    // Изменения, пришедшие, пока вид был скрыт, — до первого кадра
+    applyChanges(scheduler_->takePending() |
+                 (scene_released_ ? UpdateScheduler::kGeometry : UpdateScheduler::kNone));
+    scheduler_->setActive(true);
+    QGraphicsView::showEvent(event);
+}
 
-    addWellTrajectories();
-    addProjectPoints();
-    addShotPoints();
+void PlanView::hideEvent(QHideEvent* event) {
+    scheduler_->setActive(false);
+    QGraphicsView::hideEvent(event);
+}
+
+void PlanView::syncScene() {
+    QElapsedTimer build_timer;
+    build_timer.start();
+
+    if (scene_released_) {
+        scene_released_ = false;
+        points_dirty_ = true;
+    }
+    if (!trajectory_layer_) {
+        trajectory_layer_ = new TrajectoryLayerItem;
+        scene_->addItem(trajectory_layer_);
+    }
 
-    if (show_labels_) {
-        addDepthLabels();
+    syncWells();
+    if (points_dirty_) {
+        rebuildPoints();
     }
+
+    frame_stats_.addBuild(build_timer.nsecsElapsed() * 1e-6);
+    frame_stats_.setItemCount(sceneItemCount());
+}
+
+double PlanView::pixelSizeM() const {
+    const double pixels_per_m = std::abs(transform().m11());
+    return pixels_per_m > 0.0 ? 1.0 / pixels_per_m : 1.0;
+}
+
+void PlanView::updateTrajectoryDetail() {
+    applyTrajectoryDetail(pixelSizeM());
+}
+
+void PlanView::applyTrajectoryDetail(double pixel_m, double detail_scale) {
+    if (trajectory_layer_) {
+        trajectory_layer_->setPixelSize(pixel_m);
+        trajectory_layer_->setDetailScale(detail_scale);
+    }
+}
+
+std::optional<QRectF> PlanView::contentBounds() const {
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    bool has_content = false;
+
+    auto extend = [&](double x0, double y0, double x1, double y1) {
+        if (!has_content) {
+            min_x = x0; max_x = x1; min_y = y0; max_y = y1;
+            has_content = true;
+            return;
+        }
+        min_x = std::min(min_x, x0);
+        max_x = std::max(max_x, x1);
+        min_y = std::min(min_y, y0);
+        max_y = std::max(max_y, y1);
+    };
+
+    if (well_model_) {
+        for (int i = 0; i < well_model_->wellCount(); ++i) {
+            auto well = well_model_->wellAt(i);
+            if (!well || !well->visible) {
+                continue;
+            }
+            const auto geometry = well->results.geometry();
+            if (geometry.valid) {
+                extend(geometry.min_east, geometry.min_north, geometry.max_east, geometry.max_north);
+            }
+        }
+    }
+
+    if (project_points_model_) {
+        for (int i = 0; i < project_points_model_->pointCount(); ++i) {
+            const auto& pt = project_points_model_->pointAt(i);
+            if (pt.visible) {
+                const double r = std::max(pt.radius_m, 0.0);
+                extend(pt.fact_east_m - r, pt.fact_north_m - r, pt.fact_east_m + r, pt.fact_north_m + r);
+            }
+        }
+    }
+
+    if (shot_points_model_) {
+        for (int i = 0; i < shot_points_model_->pointCount(); ++i) {
+            const auto& pt = shot_points_model_->pointAt(i);
+            if (pt.visible) {
+                extend(pt.x_m, pt.y_m, pt.x_m, pt.y_m);
+            }
+        }
+    }
+
+    if (!has_content) {
+        return std::nullopt;
+    }
+    return QRectF(QPointF(min_x, min_y), QPointF(max_x, max_y));
 }
 
 void PlanView::wheelEvent(QWheelEvent* event) {
     double factor = (event->angleDelta().y() > 0) ? 1.15 : 1.0 / 1.15;
     scale(factor, factor);
     scale_factor_ *= factor;
+    scheduler_->interact();
+    invalidate(UpdateScheduler::kCamera);
     event->accept();
 }
 
@@ -133,6 +367,8 @@ void PlanView::mouseMoveEvent(QMouseEvent* event) {
 
         horizontalScrollBar()->setValue(horizontalScrollBar()->value() - delta.x());
         verticalScrollBar()->setValue(verticalScrollBar()->value() + delta.y());  // Инверсия Y
+        scheduler_->interact();
+        invalidate(UpdateScheduler::kCamera);
         event->accept();
     } else {
         QGraphicsView::mouseMoveEvent(event);
@@ -150,6 +386,9 @@ void PlanView::mouseReleaseEvent(QMouseEvent* event) {
 }
 
 void PlanView::drawBackground(QPainter* painter, const QRectF& rect) {
+    QElapsedTimer background_timer;
+    background_timer.start();
+
     QGraphicsView::drawBackground(painter, rect);
 
     if (show_grid_) {
@@ -159,6 +398,33 @@ void PlanView::drawBackground(QPainter* painter, const QRectF& rect) {
     if (show_axes_) {
         drawAxes(painter, rect);
     }
+
+    frame_sample_.background_ms = background_timer.nsecsElapsed() * 1e-6;
+}
+
+void PlanView::paintEvent(QPaintEvent* event) {
+    QElapsedTimer frame_timer;
+    frame_timer.start();
+    frame_sample_ = {};
+
+    QGraphicsView::paintEvent(event);
+
+    // Траектории, нарисованные слоем: ломаная и вершины на каждую
+    if (trajectory_layer_) {
+        const auto stats = trajectory_layer_->takePaintStats();
+        frame_sample_.draw_calls += stats.wells;
+        frame_sample_.vertices += stats.vertices;
+    }
+    frame_sample_.cpu_ms = frame_timer.nsecsElapsed() * 1e-6;
+    frame_stats_.addFrame(frame_sample_);
+}
+
+void PlanView::drawForeground(QPainter* painter, const QRectF& rect) {
+    QGraphicsView::drawForeground(painter, rect);
+
+    if (show_frame_stats_) {
+        drawFrameStatsOverlay(*painter, viewport()->rect(), frame_stats_.summary());
+    }
 }
 
 void PlanView::drawGrid(QPainter* painter, const QRectF& rect) {
@@ -168,6 +434,7 @@ void PlanView::drawGrid(QPainter* painter, const QRectF& rect) {
     painter->setPen(gridPen);
 
     double step = grid_step_;
+    int lines = 0;
 
     // Определяем границы сетки
     double left = std::floor(rect.left() / step) * step;
@@ -177,14 +444,19 @@ void PlanView::drawGrid(QPainter* painter, const QRectF& rect) {
 
     // Вертикальные линии
     for (double x = left; x <= right; x += step) {
+        ++lines;
         painter->drawLine(QPointF(x, bottom), QPointF(x, top));
     }
 
     // Горизонтальные линии
     for (double y = bottom; y <= top; y += step) {
+        ++lines;
         painter->drawLine(QPointF(left, y), QPointF(right, y));
     }
 
+    frame_sample_.draw_calls += lines;
+    frame_sample_.vertices += 2 * static_cast<std::size_t>(lines);
+
     painter->restore();
 }
 
@@ -219,50 +491,136 @@ void PlanView::drawAxes(QPainter* painter, const QRectF& rect) {
     painter->restore();
 }
 
-void PlanView::addWellTrajectories() {
-    if (!well_model_) return;
+void PlanView::syncWells() {
+    for (auto& [id, entry] : well_items_) {
+        entry.used = false;
+    }
 
-    for (int i = 0; i < well_model_->wellCount(); ++i) {
-        auto well = well_model_->wellAt(i);
-        if (!well || !well->visible || well->results.empty()) {
-            continue;
+    if (well_model_) {
+        for (const auto& well : well_model_->wells()) {
+            if (!well) {
+                continue;
+            }
+            auto& entry = well_items_[well->id];
+            entry.used = true;
+            updateWellItems(entry, *well, WellSceneState::of(*well, show_labels_));
         }
+    }
 
-        // Строим путь траектории
-        QPainterPath path;
-        bool first = true;
-
-        for (const auto& pt : well->results) {
-            // X = восток, Y = север
-            if (first) {
-                path.moveTo(pt.east_m, pt.north_m);
-                first = false;
-            } else {
-                path.lineTo(pt.east_m, pt.north_m);
+    // Скважины, удалённые из проекта, — вместе с элементами
+    for (auto it = well_items_.begin(); it != well_items_.end();) {
+        if (!it->second.used) {
+            trajectory_layer_->removeWell(it->first);
+            delete it->second.labels;
+            it = well_items_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PlanView::updateWellItems(WellItems& entry, const models::WellData& well, const WellSceneState& state) {
+    if (!state.visible) {
+        // Скрытая скважина не перестраивается: остальные изменения — при показе
+        if (entry.built && entry.state.visible) {
+            trajectory_layer_->setWellVisible(well.id, false);
+            if (entry.labels) {
+                entry.labels->setVisible(false);
             }
+            entry.state.visible = false;
         }
+        return;
+    }
 
-        auto* pathItem = new QGraphicsPathItem(path);
-        QPen pen(well->display_color, well->line_width);
-        pen.setCosmetic(true);  // Толщина не зависит от масштаба
-        pathItem->setPen(pen);
-        pathItem->setToolTip(QString::fromStdString(well->metadata.well_name));
-        scene_->addItem(pathItem);
-
-        // Точка устья
-        if (!well->results.empty()) {
-            const auto& first_pt = well->results.front();
-            auto* wellhead = new QGraphicsEllipseItem(
-                first_pt.east_m - 3, first_pt.north_m - 3, 6, 6);
-            wellhead->setBrush(well->display_color);
-            wellhead->setPen(Qt::NoPen);
-            wellhead->setFlag(QGraphicsItem::ItemIgnoresTransformations);
-            scene_->addItem(wellhead);
+    WellChanges changes = WellChange::kGeometry | WellChange::kLabels;
+    if (entry.built) {
+        changes = diffWellState(entry.state, state);
+    }
+    if (!changes) {
+        return;
+    }
+    const bool geometry = changes.testFlag(WellChange::kGeometry);
+    if (geometry || changes.testFlag(WellChange::kStyle) || changes.testFlag(WellChange::kVisibility)) {
+        // Слой перестраивает ломаные только при новой версии результатов
+        trajectory_layer_->setWell(well);
+        entry.built = true;
+    }
+    if (geometry || changes.testFlag(WellChange::kLabels)) {
+        delete entry.labels;
+        entry.labels = nullptr;
+        entry.name_label = nullptr;
+        if (state.labels) {
+            buildDepthLabels(entry, well);
+        }
+    } else if (changes.testFlag(WellChange::kStyle)) {
+        applyLabelStyle(entry, well);
+    }
+    if (entry.labels && changes.testFlag(WellChange::kVisibility)) {
+        entry.labels->setVisible(true);
+    }
+    entry.state = state;
+}
+
+void PlanView::buildDepthLabels(WellItems& entry, const models::WellData& well) {
+    entry.labels = new QGraphicsItemGroup;
+    scene_->addItem(entry.labels);
+
+    // Инвертируем текст обратно для читаемости
+    QTransform flip;
+    flip.scale(1, -1);
+
+    // Подпись через каждые N метров глубины
+    double label_step = 500.0;  // каждые 500 м
+    double last_labeled_tvd = -label_step;
+
+    const auto east = well.results.column(models::TrajectoryColumns::Column::kEast);
+    const auto north = well.results.column(models::TrajectoryColumns::Column::kNorth);
+    const auto tvd = well.results.column(models::TrajectoryColumns::Column::kTvd);
+
+    for (size_t k = 0; k < tvd.size(); ++k) {
+        if (tvd[k] >= last_labeled_tvd + label_step) {
+            auto* label = new QGraphicsTextItem(QString("%1").arg(tvd[k], 0, 'f', 0), entry.labels);
+            label->setPos(east[k] + 5, north[k]);
+            label->setTransform(flip);
+            label->setFlag(QGraphicsItem::ItemIgnoresTransformations);
+            last_labeled_tvd = tvd[k];
         }
     }
+
+    // Подпись имени скважины у устья
+    entry.name_label = new QGraphicsTextItem(entry.labels);
+    entry.name_label->setPos(east[0] + 10, north[0]);
+    entry.name_label->setTransform(flip);
+    entry.name_label->setFlag(QGraphicsItem::ItemIgnoresTransformations);
+
+    QFont font = entry.name_label->font();
+    font.setBold(true);
+    entry.name_label->setFont(font);
+
+    applyLabelStyle(entry, well);
+}
+
+void PlanView::applyLabelStyle(WellItems& entry, const models::WellData& well) {
+    if (!entry.labels) {
+        return;
+    }
+    for (auto* child : entry.labels->childItems()) {
+        static_cast<QGraphicsTextItem*>(child)->setDefaultTextColor(well.display_color);
+    }
+    entry.name_label->setPlainText(QString::fromStdString(well.metadata.well_name));
+}
+
+void PlanView::rebuildPoints() {
+    points_dirty_ = false;
+    delete points_group_;
+    points_group_ = new QGraphicsItemGroup;
+    scene_->addItem(points_group_);
+
+    addProjectPoints(points_group_);
+    addShotPoints(points_group_);
 }
 
-void PlanView::addProjectPoints() {
+void PlanView::addProjectPoints(QGraphicsItemGroup* group) {
     if (!project_points_model_) return;
 
     for (int i = 0; i < project_points_model_->pointCount(); ++i) {
@@ -271,26 +629,24 @@ void PlanView::addProjectPoints() {
 
         // Фактическая точка
         auto* point = new QGraphicsEllipseItem(
-            pt.fact_east_m - 4, pt.fact_north_m - 4, 8, 8);
+            pt.fact_east_m - 4, pt.fact_north_m - 4, 8, 8, group);
         point->setBrush(pt.display_color);
         point->setPen(Qt::NoPen);
         point->setFlag(QGraphicsItem::ItemIgnoresTransformations);
         point->setToolTip(QString::fromStdString(pt.name) +
                           QString("\nГлубина: %1 м").arg(pt.fact_tvd_m, 0, 'f', 1));
-        scene_->addItem(point);
 
         // Круг допуска
         if (pt.radius_m > 0) {
             auto* tolerance = new QGraphicsEllipseItem(
                 pt.fact_east_m - pt.radius_m,
                 pt.fact_north_m - pt.radius_m,
-                pt.radius_m * 2, pt.radius_m * 2);
+                pt.radius_m * 2, pt.radius_m * 2, group);
             QPen tolPen(pt.display_color, 1);
             tolPen.setCosmetic(true);
             tolPen.setStyle(Qt::DashLine);
             tolerance->setPen(tolPen);
             tolerance->setBrush(Qt::NoBrush);
-            scene_->addItem(tolerance);
         }
 
         // Показываем направление до проектной точки (базовое смещение)
@@ -301,16 +657,15 @@ void PlanView::addProjectPoints() {
             double plan_north = pt.shift_m * std::cos(az_rad);
 
             // Линия от фактической к плановой позиции
-            auto* line = scene_->addLine(
+            auto* line = new QGraphicsLineItem(
                 pt.fact_east_m, pt.fact_north_m,
-                plan_east, plan_north,
-                QPen(pt.display_color, 1, Qt::DotLine));
-            Q_UNUSED(line)
+                plan_east, plan_north, group);
+            line->setPen(QPen(pt.display_color, 1, Qt::DotLine));
         }
     }
 }
 
-void PlanView::addShotPoints() {
+void PlanView::addShotPoints(QGraphicsItemGroup* group) {
     if (!shot_points_model_) return;
 
     for (int i = 0; i < shot_points_model_->pointCount(); ++i) {
@@ -324,64 +679,10 @@ void PlanView::addShotPoints() {
                  << QPointF(pt.x_m - size * 0.866, pt.y_m - size * 0.5)
                  << QPointF(pt.x_m + size * 0.866, pt.y_m - size * 0.5);
 
-        auto* marker = new QGraphicsPolygonItem(triangle);
+        auto* marker = new QGraphicsPolygonItem(triangle, group);
         marker->setBrush(pt.display_color);
         marker->setPen(Qt::NoPen);
         marker->setToolTip(QString::fromStdString(pt.name));
-        scene_->addItem(marker);
-    }
-}
-
-void PlanView::addDepthLabels() {
-    if (!well_model_) return;
-
-    for (int i = 0; i < well_model_->wellCount(); ++i) {
-        auto well = well_model_->wellAt(i);
-        if (!well || !well->visible || well->results.empty()) {
-            continue;
-        }
-
-        // Подпись через каждые N метров глубины
-        double label_step = 500.0;  // каждые 500 м
-        double last_labeled_tvd = -label_step;
-
-        for (const auto& pt : well->results) {
-            if (pt.tvd_m >= last_labeled_tvd + label_step) {
-                auto* label = new QGraphicsTextItem(
-                    QString("%1").arg(pt.tvd_m, 0, 'f', 0));
-                label->setPos(pt.east_m + 5, pt.north_m);
-                label->setDefaultTextColor(well->display_color);
-
-                // Инвертируем текст обратно для читаемости
-                QTransform t;
-                t.scale(1, -1);
-                label->setTransform(t);
-                label->setFlag(QGraphicsItem::ItemIgnoresTransformations);
-
-                scene_->addItem(label);
-                last_labeled_tvd = pt.tvd_m;
-            }
-        }
-
-        // Подпись имени скважины у устья
-        if (!well->results.empty()) {
-            const auto& first_pt = well->results.front();
-            auto* nameLabel = new QGraphicsTextItem(
-                QString::fromStdString(well->metadata.well_name));
-            nameLabel->setPos(first_pt.east_m + 10, first_pt.north_m);
-            nameLabel->setDefaultTextColor(well->display_color);
-
-            QTransform t;
-            t.scale(1, -1);
-            nameLabel->setTransform(t);
-            nameLabel->setFlag(QGraphicsItem::ItemIgnoresTransformations);
-
-            QFont font = nameLabel->font();
-            font.setBold(true);
-            nameLabel->setFont(font);
-
-            scene_->addItem(nameLabel);
-        }
     }
 }
 
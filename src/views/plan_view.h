@@ -2,9 +2,25 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
+#include <QImage>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 #include <QVector>
 #include <QPointF>
 
+#include "models/well_data.h"
+#include "views/frame_stats.h"
+#include "views/update_scheduler.h"
+#include "views/well_scene_state.h"
+
+class QAbstractItemModel;
+class QGraphicsItemGroup;
+class QGraphicsTextItem;
+
 namespace incline3d::models {
 class WellTableModel;
 class ProjectPointsModel;
@@ -13,7 +29,18 @@ class ShotPointsModel;
 
 namespace incline3d::views {
 
+class TrajectoryLayerItem;
+
 /// 2D вид "План" — горизонтальная проекция траекторий скважин
+///
+/// Траектории и устья всех скважин рисует один элемент TrajectoryLayerItem;
+/// подписи скважины собраны в группу. Для каждой скважины вид помнит, по
+/// какой версии результатов и стилю построены её элементы. При изменениях
+/// сцена не очищается: скважины модели сверяются с построенными, и у каждой
+/// обновляется только изменившееся — видимость переключается, цвет и
+/// толщина меняются на месте, ломаные и подписи перестраиваются только при
+/// новой версии результатов. Точки (проектные и пункты возбуждения)
+/// перестраиваются по сигналам своих моделей.
 class PlanView : public QGraphicsView {
     Q_OBJECT
 
@@ -33,26 +60,111 @@ public:
     void fitToContent();
     void resetView();
 
+    /// Отрисовать вид в изображение без окна (QPainter в QImage)
+    /// @param size размер всего изображения, пиксели
+    /// @param tile часть изображения (пустой — всё изображение)
+    /// @param fit_content вписать всё содержимое; иначе — область, видимая в окне
+    QImage renderImage(const QSize& size, const QRect& tile = {}, bool fit_content = false);
+
+    /// Показывать поверх вида панель статистики кадров
+    void setShowFrameStats(bool show);
+    bool showFrameStats() const { return show_frame_stats_; }
+
+    /// Время кадров и построения сцены за последние кадры
+    const FrameStats& frameStats() const { return frame_stats_; }
+
+    // --- Учёт памяти ---
+
+    /// Число элементов сцены
+    int sceneItemCount() const;
+
+    /// Оценка памяти элементов сцены, байт
+    std::size_t sceneMemoryEstimate() const;
+
+    /// Освободить элементы сцены; сцена перестраивается при следующем показе
+    /// @return оценка освобождённой памяти, байт
+    std::size_t releaseScene();
+
+    bool isSceneReleased() const;
+
+    /// Отметить изменения; обработка — один раз за проход цикла событий,
+    /// у скрытого вида — при показе
+    void invalidate(UpdateScheduler::Changes changes);
+
 public slots:
     void refresh();
 
 protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
     void drawBackground(QPainter* painter, const QRectF& rect) override;
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
 
 private:
-    void rebuildScene();
+    /// Сверить сцену с моделями: обновить изменившиеся скважины и точки
+    void syncScene();
+
+    /// Обработать накопленные изменения: перестроить сцену, сменить детализацию, перерисовать
+    void applyChanges(UpdateScheduler::Changes changes);
     void drawGrid(QPainter* painter, const QRectF& rect);
     void drawAxes(QPainter* painter, const QRectF& rect);
-    void addWellTrajectories();
-    void addProjectPoints();
-    void addShotPoints();
-    void addDepthLabels();
+
+    /// Скважина на сцене: группа подписей и данные, по которым построены её элементы
+    struct WellItems {
+        QGraphicsItemGroup* labels{nullptr};        ///< nullptr — подписи не построены
+        QGraphicsTextItem* name_label{nullptr};
+        WellSceneState state;
+        bool built{false};                          ///< Траектория передана слою
+        bool used{false};
+    };
+
+    /// Сверить скважины с моделью; элементы удалённых скважин удаляются
+    void syncWells();
+
+    /// Обновить элементы скважины по изменениям с прошлого построения
+    void updateWellItems(WellItems& entry, const models::WellData& well, const WellSceneState& state);
+    void buildDepthLabels(WellItems& entry, const models::WellData& well);
+    void applyLabelStyle(WellItems& entry, const models::WellData& well);
+
+    /// Перестроить группу точек (проектные точки и пункты возбуждения)
+    void rebuildPoints();
+    void addProjectPoints(QGraphicsItemGroup* group);
+    void addShotPoints(QGraphicsItemGroup* group);
+
+    /// Следить за изменениями модели точек (группа точек перестраивается по сигналам)
+    void watchPointsModel(QAbstractItemModel* model);
+    void invalidatePoints();
+
+    /// Габариты содержимого по сводной геометрии скважин и точкам (без обхода сцены)
+    std::optional<QRectF> contentBounds() const;
+
+    /// Размер пикселя в метрах при текущем масштабе
+    double pixelSizeM() const;
+
+    /// Сменить уровень детализации траекторий после изменения масштаба
+    void updateTrajectoryDetail();
+
+    /// Передать слою траекторий размер пикселя, м, и множитель допуска упрощения
+    /// @note Уровень детализации слой выбирает сам при рисовании
+    void applyTrajectoryDetail(double pixel_m, double detail_scale = 1.0);
 
     QGraphicsScene* scene_{nullptr};
+    UpdateScheduler* scheduler_{nullptr};
+    bool scene_released_{false};
+    TrajectoryLayerItem* trajectory_layer_{nullptr};
+    std::unordered_map<models::WellId, WellItems> well_items_;
+    QGraphicsItemGroup* points_group_{nullptr};
+    bool points_dirty_{true};
+
+    // Статистика кадров: счётчики текущего кадра заполняются в drawBackground
+    FrameStats frame_stats_;
+    bool show_frame_stats_{false};
+    FrameSample frame_sample_;
 
     models::WellTableModel* well_model_{nullptr};
     models::ProjectPointsModel* project_points_model_{nullptr};
@@ -0,0 +1,1473 @@
+#include "views/scene3d_renderer.h"
+
+#include <QVector2D>
+#include <QVector3D>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+
+#include "utils/logger.h"
+
+namespace incline3d::views {
+
+namespace {
+
+/// Положение атрибутов в шейдере временной геометрии
+constexpr GLuint kPositionLocation = 0;
+constexpr GLuint kColorLocation = 1;
+
+/// Размер точек замеров на траектории, пиксели
+constexpr float kStationPointSize = 4.0f;
+
+/// Точка общего буфера: x, y, z и метка (стиль * 4 + флаги участка)
+constexpr std::size_t kPointBytes = 4 * sizeof(float);
+constexpr float kRunStartFlag = 1.0f;
+constexpr float kRunEndFlag = 2.0f;
+
+/// Начальная ёмкость общих буферов
+constexpr std::size_t kMinPointCapacity = 64 * 1024;
+constexpr std::size_t kMinStyleCapacity = 64;
+constexpr std::size_t kMinTubeVertexCapacity = 256 * 1024;
+constexpr std::size_t kMinTubeIndexCapacity = 1024 * 1024;
+
+/// Сетка единичной сферы эллипсоидов: долготы и широты
+constexpr int kSphereSlices = 16;
+constexpr int kSphereStacks = 8;
+
+/// Ближе этого линии самого мелкого уровня сетки не сходятся, пиксели
+constexpr float kGridMinCellPixels = 8.0f;
+
+/// Текстурные блоки
+constexpr GLenum kColorTableUnit = GL_TEXTURE2;
+constexpr GLenum kGlyphAtlasUnit = GL_TEXTURE3;
+constexpr int kColorTableSize = 256;
+
+const char* const kVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec4 color;
+
+uniform mat4 mvp;
+uniform float point_size;
+
+out vec4 vertex_color;
+
+void main() {
+    gl_Position = mvp * vec4(position, 1.0);
+    gl_PointSize = point_size;
+    vertex_color = color;
+}
+)";
+
+const char* const kFragmentShader = R"(#version 330 core
+in vec4 vertex_color;
+out vec4 frag_color;
+
+void main() {
+    frag_color = vertex_color;
+}
+)";
+
+// Вершины траекторий читаются из буфера-текстуры по gl_VertexID: в режиме
+// линий каждой точке соответствуют две вершины полосы (по обе стороны линии)
+const char* const kWellVertexShader = R"(#version 330 core
+uniform samplerBuffer points;   // x, y, z, метка: стиль * 4 + 1 (начало участка) + 2 (конец)
+uniform samplerBuffer styles;   // r, g, b, толщина линии в пикселях
+uniform mat4 mvp;
+uniform vec2 viewport;
+uniform bool expand_lines;
+uniform float point_size;
+
+out vec4 vertex_color;
+noperspective out float edge_distance;
+flat out float half_width;
+
+vec2 toScreen(vec4 clip) {
+    return clip.xy / max(clip.w, 1e-6) * viewport * 0.5;
+}
+
+vec2 direction(vec2 from, vec2 to) {
+    vec2 d = to - from;
+    float len = length(d);
+    return len > 1e-6 ? d / len : vec2(0.0);
+}
+
+void main() {
+    int index = expand_lines ? gl_VertexID >> 1 : gl_VertexID;
+    vec4 point = texelFetch(points, index);
+    int tag = int(point.w);
+    vec4 style = texelFetch(styles, tag >> 2);
+    vertex_color = vec4(style.rgb, 1.0);
+
+    vec4 clip = mvp * vec4(point.xyz, 1.0);
+    if (!expand_lines) {
+        gl_Position = clip;
+        gl_PointSize = point_size;
+        edge_distance = 0.0;
+        half_width = point_size;
+        return;
+    }
+
+    // Соседние точки участка (на концах участка — сама точка)
+    vec4 prev_clip = (tag & 1) != 0 ? clip : mvp * vec4(texelFetch(points, index - 1).xyz, 1.0);
+    vec4 next_clip = (tag & 2) != 0 ? clip : mvp * vec4(texelFetch(points, index + 1).xyz, 1.0);
+
+    vec2 screen = toScreen(clip);
+    vec2 dir_in = direction(toScreen(prev_clip), screen);
+    vec2 dir_out = direction(screen, toScreen(next_clip));
+    vec2 segment = length(dir_out) > 0.0 ? dir_out : dir_in;
+
+    vec2 tangent = dir_in + dir_out;
+    tangent = length(tangent) > 1e-6 ? normalize(tangent) : (length(segment) > 0.0 ? segment : vec2(1.0, 0.0));
+    vec2 normal = vec2(-tangent.y, tangent.x);
+
+    // Удлинение на изломе, чтобы толщина сегментов не менялась (не более чем вдвое)
+    float miter = length(segment) > 0.0 ? 1.0 / max(abs(dot(normal, vec2(-segment.y, segment.x))), 0.5) : 1.0;
+
+    // Полоса на полпикселя шире с каждой стороны — под сглаживание края
+    half_width = style.a * 0.5 + 0.5;
+    float side = (gl_VertexID & 1) == 0 ? -1.0 : 1.0;
+    edge_distance = side * half_width;
+
+    vec2 offset = normal * side * half_width * miter;
+    gl_Position = clip + vec4(offset / (viewport * 0.5) * clip.w, 0.0, 0.0);
+}
+)";
+
+const char* const kWellFragmentShader = R"(#version 330 core
+in vec4 vertex_color;
+noperspective in float edge_distance;
+flat in float half_width;
+out vec4 frag_color;
+
+void main() {
+    // Последний пиксель к краю полосы становится прозрачным
+    float alpha = clamp(half_width - abs(edge_distance), 0.0, 1.0);
+    frag_color = vec4(vertex_color.rgb, vertex_color.a * alpha);
+}
+)";
+
+const char* const kMarkerVertexShader = R"(#version 330 core
+layout(location = 0) in vec2 corner;    // угол единичного квадрата
+layout(location = 1) in vec3 center;
+layout(location = 2) in float size;
+layout(location = 3) in vec4 color;
+layout(location = 4) in vec2 shape;     // форма, размер в пикселях (0/1)
+
+uniform mat4 mvp;
+uniform vec2 viewport;
+
+out vec2 local;
+out vec4 marker_color;
+flat out int marker_shape;
+
+void main() {
+    local = corner;
+    marker_color = color;
+    marker_shape = int(shape.x);
+
+    if (shape.y > 0.5) {
+        vec4 clip = mvp * vec4(center, 1.0);
+        gl_Position = clip + vec4(corner * size / (viewport * 0.5) * clip.w, 0.0, 0.0);
+    } else {
+        gl_Position = mvp * vec4(center + vec3(corner * size, 0.0), 1.0);
+    }
+}
+)";
+
+// Формы заданы функциями расстояния в единичном квадрате (< 0 внутри)
+const char* const kMarkerFragmentShader = R"(#version 330 core
+in vec2 local;
+in vec4 marker_color;
+flat in int marker_shape;
+out vec4 frag_color;
+
+float triangle(vec2 p) {
+    // Равносторонний треугольник, вписанный в единичную окружность
+    const float k = sqrt(3.0);
+    const float r = 0.5 * k;
+    p.x = abs(p.x) - r;
+    p.y = p.y + r / k;
+    if (p.x + k * p.y > 0.0) {
+        p = vec2(p.x - k * p.y, -k * p.x - p.y) / 2.0;
+    }
+    p.x -= clamp(p.x, -2.0 * r, 0.0);
+    return -length(p) * sign(p.y);
+}
+
+void main() {
+    vec2 p = local;
+    vec2 a = abs(p);
+    float d;
+    if (marker_shape == 1) {
+        d = triangle(p);
+    } else if (marker_shape == 2) {
+        d = max(a.x, a.y) - 0.7071;
+    } else if (marker_shape == 3) {
+        d = (a.x + a.y - 1.0) * 0.7071;
+    } else if (marker_shape == 4) {
+        d = min(max(a.x - 1.0, a.y - 0.25), max(a.x - 0.25, a.y - 1.0));
+    } else if (marker_shape == 5) {
+        // Окружность: линия толщиной в пиксель вдоль единичного радиуса
+        float radius = length(p);
+        d = abs(radius - 1.0) - 0.5 * fwidth(radius);
+    } else {
+        d = length(p) - 1.0;
+    }
+
+    float alpha = clamp(0.5 - d / max(fwidth(d), 1e-6), 0.0, 1.0);
+    if (alpha <= 0.0) {
+        discard;
+    }
+    frag_color = vec4(marker_color.rgb, marker_color.a * alpha);
+}
+)";
+
+const char* const kTubeVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in float value;
+
+uniform mat4 mvp;
+uniform float value_scale;
+
+out vec3 vertex_normal;
+out float color_coord;
+
+void main() {
+    vertex_normal = normal;
+    color_coord = clamp(value * value_scale, 0.0, 1.0);
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+const char* const kTubeFragmentShader = R"(#version 330 core
+in vec3 vertex_normal;
+in float color_coord;
+
+uniform sampler1D color_table;
+uniform vec3 light_direction;   // к камере
+
+out vec4 frag_color;
+
+void main() {
+    // Центры крайних текселей — концы шкалы
+    float coord = color_coord * (255.0 / 256.0) + 0.5 / 256.0;
+    vec3 base = texture(color_table, coord).rgb;
+    float diffuse = abs(dot(normalize(vertex_normal), light_direction));
+    frag_color = vec4(base * (0.35 + 0.65 * diffuse), 1.0);
+}
+)";
+
+// Символ — прямоугольник в пикселях от проекции точки привязки; привязка
+// округляется до пикселя, чтобы символы атласа выводились без размытия
+const char* const kGlyphVertexShader = R"(#version 330 core
+layout(location = 0) in vec2 corner;    // угол единичного квадрата
+layout(location = 1) in vec3 anchor;
+layout(location = 2) in vec4 rect;      // смещение и размер в пикселях
+layout(location = 3) in vec4 uv;        // левый нижний и правый верхний углы в атласе
+layout(location = 4) in vec4 color;
+
+uniform mat4 mvp;
+uniform vec2 viewport;
+
+out vec2 atlas_coord;
+out vec4 glyph_color;
+
+void main() {
+    vec2 unit = corner * 0.5 + 0.5;
+    vec4 clip = mvp * vec4(anchor, 1.0);
+    vec2 pixel = floor((clip.xy / clip.w * 0.5 + 0.5) * viewport + 0.5) + rect.xy + unit * rect.zw;
+    gl_Position = vec4(pixel / viewport * 2.0 - 1.0, 0.0, 1.0);
+    atlas_coord = mix(uv.xy, uv.zw, unit);
+    glyph_color = color;
+}
+)";
+
+const char* const kGlyphFragmentShader = R"(#version 330 core
+in vec2 atlas_coord;
+in vec4 glyph_color;
+
+uniform sampler2D atlas;
+
+out vec4 frag_color;
+
+void main() {
+    float alpha = texture(atlas, atlas_coord).r;
+    if (alpha <= 0.0) {
+        discard;
+    }
+    frag_color = vec4(glyph_color.rgb, glyph_color.a * alpha);
+}
+)";
+
+// Сетка — один треугольник на весь экран: для каждого пикселя луч камеры
+// пересекается с плоскостью z = 0. Концы луча на ближней и дальней
+// плоскостях линейны по экрану и интерполируются без перспективы
+const char* const kGridVertexShader = R"(#version 330 core
+uniform mat4 inverse_mvp;
+
+out vec3 near_point;
+out vec3 far_point;
+
+vec3 unproject(vec2 ndc, float depth) {
+    vec4 p = inverse_mvp * vec4(ndc, depth, 1.0);
+    return p.xyz / p.w;
+}
+
+void main() {
+    vec2 ndc = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+    near_point = unproject(ndc, -1.0);
+    far_point = unproject(ndc, 1.0);
+    gl_Position = vec4(ndc, 0.0, 1.0);
+}
+)";
+
+// Шаг линий — base_step × 10^k: мелкий уровень выбирается так, чтобы ячейка
+// была не уже min_cell пикселей, и гаснет по мере приближения к этой границе,
+// передавая линии следующему (в 10 раз крупнее)
+const char* const kGridFragmentShader = R"(#version 330 core
+in vec3 near_point;
+in vec3 far_point;
+
+uniform vec4 grid_color;
+uniform float base_step;
+uniform float min_cell;
+
+out vec4 frag_color;
+
+// Покрытие пикселя линиями сетки с шагом spacing (линия — в пиксель толщиной)
+float lines(vec2 coord, float spacing) {
+    vec2 cell = coord / spacing;
+    vec2 pixels = abs(fract(cell - 0.5) - 0.5) / max(fwidth(cell), vec2(1e-6));
+    return 1.0 - min(min(pixels.x, pixels.y), 1.0);
+}
+
+void main() {
+    vec3 ray = far_point - near_point;
+    // t в (0, 1] — пересечение между ближней и дальней плоскостями
+    float t = abs(ray.z) > 1e-6 ? -near_point.z / ray.z : -1.0;
+    vec2 coord = near_point.xy + t * ray.xy;
+
+    // Производные считаются до discard
+    float pixel_m = max(length(fwidth(coord)), 1e-6);
+    float level = log2(pixel_m * min_cell / base_step) / log2(10.0);
+    float fine_step = base_step * pow(10.0, floor(level) + 1.0);
+    float fine = lines(coord, fine_step) * (1.0 - fract(level));
+    float coarse = lines(coord, fine_step * 10.0);
+
+    // У горизонта сетка гаснет: там пиксель вытянут вдоль луча
+    float horizon = smoothstep(0.0, 0.1, abs(normalize(ray).z));
+    float alpha = max(fine, coarse) * horizon * grid_color.a;
+    if (t <= 0.0 || t > 1.0 || alpha <= 0.0) {
+        discard;
+    }
+    frag_color = vec4(grid_color.rgb, alpha);
+}
+)";
+
+// Нормаль эллипсоида — нормаль сферы, умноженная на обратную транспонированную
+// матрицу полуосей
+const char* const kEllipsoidVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;  // точка единичной сферы (она же нормаль)
+layout(location = 1) in vec3 center;
+layout(location = 2) in vec3 axis_u;
+layout(location = 3) in vec3 axis_v;
+layout(location = 4) in vec3 axis_w;
+layout(location = 5) in vec4 color;
+
+uniform mat4 mvp;
+
+out vec3 vertex_normal;
+out vec4 vertex_color;
+
+void main() {
+    mat3 axes = mat3(axis_u, axis_v, axis_w);
+    vertex_normal = transpose(inverse(axes)) * position;
+    vertex_color = color;
+    gl_Position = mvp * vec4(center + axes * position, 1.0);
+}
+)";
+
+const char* const kSurfaceVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec4 color;
+
+uniform mat4 mvp;
+
+out vec3 vertex_normal;
+out vec4 vertex_color;
+
+void main() {
+    vertex_normal = normal;
+    vertex_color = color;
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+// Освещение полупрозрачных оболочек и поверхностей: обе стороны освещены одинаково
+const char* const kShadedFragmentShader = R"(#version 330 core
+in vec3 vertex_normal;
+in vec4 vertex_color;
+
+uniform vec3 light_direction;   // к камере
+
+out vec4 frag_color;
+
+void main() {
+    float diffuse = abs(dot(normalize(vertex_normal), light_direction));
+    frag_color = vec4(vertex_color.rgb * (0.45 + 0.55 * diffuse), vertex_color.a);
+}
+)";
+
+/// Единичная сфера: вершины (x, y, z) и треугольники против часовой стрелки снаружи
+void unitSphere(std::vector<float>& vertices, std::vector<GLushort>& indices) {
+    constexpr double kPi = 3.14159265358979323846;
+    for (int stack = 0; stack <= kSphereStacks; ++stack) {
+        const double theta = kPi * stack / kSphereStacks;
+        for (int slice = 0; slice <= kSphereSlices; ++slice) {
+            const double phi = 2.0 * kPi * slice / kSphereSlices;
+            vertices.push_back(static_cast<float>(std::sin(theta) * std::cos(phi)));
+            vertices.push_back(static_cast<float>(std::sin(theta) * std::sin(phi)));
+            vertices.push_back(static_cast<float>(std::cos(theta)));
+        }
+    }
+    const int row = kSphereSlices + 1;
+    for (int stack = 0; stack < kSphereStacks; ++stack) {
+        for (int slice = 0; slice < kSphereSlices; ++slice) {
+            const auto top = static_cast<GLushort>(stack * row + slice);
+            const auto bottom = static_cast<GLushort>(top + row);
+            indices.insert(indices.end(), {top, bottom, static_cast<GLushort>(top + 1)});
+            indices.insert(indices.end(), {static_cast<GLushort>(top + 1), bottom, static_cast<GLushort>(bottom + 1)});
+        }
+    }
+}
+
+/// Шкала цвета трубок: синий — зелёный — жёлтый — красный (RGBA8)
+std::vector<GLubyte> colorTable() {
+    struct Stop {
+        float position;
+        float r, g, b;
+    };
+    static const Stop kStops[] = {
+        {0.0f, 40, 90, 220}, {0.33f, 40, 190, 110}, {0.66f, 240, 210, 40}, {1.0f, 220, 40, 40}};
+
+    std::vector<GLubyte> table;
+    table.reserve(kColorTableSize * 4);
+    for (int i = 0; i < kColorTableSize; ++i) {
+        const float t = static_cast<float>(i) / (kColorTableSize - 1);
+        std::size_t s = 0;
+        while (s + 2 < std::size(kStops) && t > kStops[s + 1].position) {
+            ++s;
+        }
+        const Stop& a = kStops[s];
+        const Stop& b = kStops[s + 1];
+        const float f = std::clamp((t - a.position) / (b.position - a.position), 0.0f, 1.0f);
+        table.push_back(static_cast<GLubyte>(a.r + f * (b.r - a.r)));
+        table.push_back(static_cast<GLubyte>(a.g + f * (b.g - a.g)));
+        table.push_back(static_cast<GLubyte>(a.b + f * (b.b - a.b)));
+        table.push_back(255);
+    }
+    return table;
+}
+
+std::unique_ptr<QOpenGLShaderProgram> buildProgram(const char* vertex, const char* fragment) {
+    auto program = std::make_unique<QOpenGLShaderProgram>();
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertex) ||
+        !program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment) ||
+        !program->link()) {
+        LOG_ERROR(QString::fromUtf8("Не удалось собрать шейдеры 3D-вида: ") + program->log());
+        return nullptr;
+    }
+    return program;
+}
+
+}  // namespace
+
+Scene3DRenderer::Scene3DRenderer() = default;
+
+Scene3DRenderer::~Scene3DRenderer() = default;
+
+bool Scene3DRenderer::initialize() {
+    if (!initializeOpenGLFunctions()) {
+        LOG_ERROR(QString::fromUtf8("Контекст OpenGL 3.3 core недоступен, 3D-вид не будет отрисован"));
+        return false;
+    }
+
+    auto program = buildProgram(kVertexShader, kFragmentShader);
+    auto well_program = buildProgram(kWellVertexShader, kWellFragmentShader);
+    auto marker_program = buildProgram(kMarkerVertexShader, kMarkerFragmentShader);
+    auto tube_program = buildProgram(kTubeVertexShader, kTubeFragmentShader);
+    auto glyph_program = buildProgram(kGlyphVertexShader, kGlyphFragmentShader);
+    auto grid_program = buildProgram(kGridVertexShader, kGridFragmentShader);
+    auto ellipsoid_program = buildProgram(kEllipsoidVertexShader, kShadedFragmentShader);
+    auto surface_program = buildProgram(kSurfaceVertexShader, kShadedFragmentShader);
+    if (!program || !well_program || !marker_program || !tube_program || !glyph_program || !grid_program ||
+        !ellipsoid_program || !surface_program) {
+        return false;
+    }
+    well_program->bind();
+    well_program->setUniformValue("points", 0);
+    well_program->setUniformValue("styles", 1);
+    well_program->release();
+    tube_program->bind();
+    tube_program->setUniformValue("color_table", static_cast<GLint>(kColorTableUnit - GL_TEXTURE0));
+    tube_program->release();
+    glyph_program->bind();
+    glyph_program->setUniformValue("atlas", static_cast<GLint>(kGlyphAtlasUnit - GL_TEXTURE0));
+    glyph_program->release();
+
+    // Потоковый буфер: содержимое заменяется при каждом вызове drawVertices
+    stream_vao_.create();
+    {
+        QOpenGLVertexArrayObject::Binder binder(&stream_vao_);
+        stream_buffer_.create();
+        stream_buffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        stream_buffer_.bind();
+        glEnableVertexAttribArray(kPositionLocation);
+        glVertexAttribPointer(kPositionLocation, 3, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex),
+                              reinterpret_cast<const void*>(offsetof(ColoredVertex, x)));
+        glEnableVertexAttribArray(kColorLocation);
+        glVertexAttribPointer(kColorLocation, 4, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex),
+                              reinterpret_cast<const void*>(offsetof(ColoredVertex, r)));
+    }
+
+    // Общие буферы траекторий: вершинных атрибутов нет, но core-профиль требует VAO
+    wells_vao_.create();
+    glGenTextures(1, &points_texture_);
+    glGenTextures(1, &styles_texture_);
+    glGenBuffers(1, &styles_buffer_);
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texture_buffer_size_);
+
+    // Маркеры: вершины единичного квадрата и атрибуты экземпляров
+    markers_vao_.create();
+    {
+        QOpenGLVertexArrayObject::Binder binder(&markers_vao_);
+        static const float kQuad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+        quad_buffer_.create();
+        quad_buffer_.bind();
+        quad_buffer_.allocate(kQuad, sizeof(kQuad));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        instance_buffer_.create();
+        instance_buffer_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        instance_buffer_.bind();
+        const auto instanceAttribute = [this](GLuint location, GLint components, std::size_t offset) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, sizeof(MarkerInstance),
+                                  reinterpret_cast<const void*>(offset));
+            glVertexAttribDivisor(location, 1);
+        };
+        instanceAttribute(1, 3, offsetof(MarkerInstance, x));
+        instanceAttribute(2, 1, offsetof(MarkerInstance, size));
+        instanceAttribute(3, 4, offsetof(MarkerInstance, r));
+        instanceAttribute(4, 2, offsetof(MarkerInstance, shape));
+    }
+
+    // Эллипсоиды: сетка единичной сферы и атрибуты экземпляров
+    ellipsoids_vao_.create();
+    {
+        QOpenGLVertexArrayObject::Binder binder(&ellipsoids_vao_);
+        std::vector<float> sphere_vertices;
+        std::vector<GLushort> sphere_indices;
+        unitSphere(sphere_vertices, sphere_indices);
+        sphere_vertex_buffer_.create();
+        sphere_vertex_buffer_.bind();
+        sphere_vertex_buffer_.allocate(sphere_vertices.data(),
+                                       static_cast<int>(sphere_vertices.size() * sizeof(float)));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        sphere_index_buffer_.create();
+        sphere_index_buffer_.bind();
+        sphere_index_buffer_.allocate(sphere_indices.data(),
+                                      static_cast<int>(sphere_indices.size() * sizeof(GLushort)));
+        sphere_index_count_ = static_cast<GLsizei>(sphere_indices.size());
+
+        ellipsoid_buffer_.create();
+        ellipsoid_buffer_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        ellipsoid_buffer_.bind();
+        const auto instanceAttribute = [this](GLuint location, GLint components, std::size_t offset) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, sizeof(EllipsoidInstance),
+                                  reinterpret_cast<const void*>(offset));
+            glVertexAttribDivisor(location, 1);
+        };
+        instanceAttribute(1, 3, offsetof(EllipsoidInstance, x));
+        instanceAttribute(2, 3, offsetof(EllipsoidInstance, ux));
+        instanceAttribute(3, 3, offsetof(EllipsoidInstance, vx));
+        instanceAttribute(4, 3, offsetof(EllipsoidInstance, wx));
+        instanceAttribute(5, 4, offsetof(EllipsoidInstance, r));
+    }
+
+    // Поверхности пластов: общие буферы вершин и индексов всех поверхностей
+    surfaces_vao_.create();
+    {
+        QOpenGLVertexArrayObject::Binder binder(&surfaces_vao_);
+        surface_vertex_buffer_.create();
+        surface_vertex_buffer_.bind();
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SurfaceVertex),
+                              reinterpret_cast<const void*>(offsetof(SurfaceVertex, x)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(SurfaceVertex),
+                              reinterpret_cast<const void*>(offsetof(SurfaceVertex, nx)));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SurfaceVertex),
+                              reinterpret_cast<const void*>(offsetof(SurfaceVertex, r)));
+        surface_index_buffer_.create();
+        surface_index_buffer_.bind();
+    }
+
+    // Подписи: тот же единичный квадрат, символы — потоковый буфер экземпляров
+    glyphs_vao_.create();
+    {
+        QOpenGLVertexArrayObject::Binder binder(&glyphs_vao_);
+        quad_buffer_.bind();
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        glyph_buffer_.create();
+        glyph_buffer_.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        glyph_buffer_.bind();
+        const auto instanceAttribute = [this](GLuint location, GLint components, std::size_t offset) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance),
+                                  reinterpret_cast<const void*>(offset));
+            glVertexAttribDivisor(location, 1);
+        };
+        instanceAttribute(1, 3, offsetof(GlyphInstance, x));
+        instanceAttribute(2, 4, offsetof(GlyphInstance, offset_x));
+        instanceAttribute(3, 4, offsetof(GlyphInstance, u0));
+        instanceAttribute(4, 4, offsetof(GlyphInstance, r));
+    }
+    glGenTextures(1, &glyph_atlas_texture_);
+
+    // Трубки: атрибуты привязываются к буферам при их создании (reserveTubes)
+    tubes_vao_.create();
+    const auto table = colorTable();
+    glGenTextures(1, &color_table_texture_);
+    glBindTexture(GL_TEXTURE_1D, color_table_texture_);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA8, kColorTableSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, table.data());
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_1D, 0);
+
+    glEnable(GL_PROGRAM_POINT_SIZE);
+
+    glGenQueries(kTimerQueries, timer_queries_.data());
+    timer_pending_.fill(false);
+    timer_active_ = false;
+    gpu_frame_ms_ = -1.0;
+
+    program_ = std::move(program);
+    well_program_ = std::move(well_program);
+    marker_program_ = std::move(marker_program);
+    tube_program_ = std::move(tube_program);
+    glyph_program_ = std::move(glyph_program);
+    grid_program_ = std::move(grid_program);
+    ellipsoid_program_ = std::move(ellipsoid_program);
+    surface_program_ = std::move(surface_program);
+    return true;
+}
+
+void Scene3DRenderer::release() {
+    if (!program_) {
+        return;
+    }
+    wells_.clear();
+    point_allocator_.clear();
+    styles_.clear();
+    free_styles_.clear();
+
+    glDeleteTextures(1, &points_texture_);
+    glDeleteTextures(1, &styles_texture_);
+    if (points_buffer_ != 0) {
+        glDeleteBuffers(1, &points_buffer_);
+    }
+    glDeleteBuffers(1, &styles_buffer_);
+    points_texture_ = styles_texture_ = points_buffer_ = styles_buffer_ = 0;
+    point_capacity_ = style_capacity_ = 0;
+
+    wells_vao_.destroy();
+
+    tubes_.clear();
+    tube_vertex_allocator_.clear();
+    tube_index_allocator_.clear();
+    for (GLuint* buffer : {&tube_vertex_buffer_, &tube_index_buffer_}) {
+        if (*buffer != 0) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    tube_vertex_capacity_ = tube_index_capacity_ = 0;
+    glDeleteTextures(1, &color_table_texture_);
+    color_table_texture_ = 0;
+    tubes_vao_.destroy();
+
+    glDeleteTextures(1, &glyph_atlas_texture_);
+    glyph_atlas_texture_ = 0;
+    glyph_buffer_.destroy();
+    glyphs_vao_.destroy();
+
+    instance_buffer_.destroy();
+    quad_buffer_.destroy();
+    markers_vao_.destroy();
+    marker_count_ = 0;
+    ellipsoid_buffer_.destroy();
+    sphere_index_buffer_.destroy();
+    sphere_vertex_buffer_.destroy();
+    ellipsoids_vao_.destroy();
+    ellipsoid_count_ = 0;
+    sphere_index_count_ = 0;
+    surface_index_buffer_.destroy();
+    surface_vertex_buffer_.destroy();
+    surfaces_vao_.destroy();
+    surface_index_count_ = 0;
+    stream_buffer_.destroy();
+    stream_vao_.destroy();
+    if (timer_active_) {
+        glEndQuery(GL_TIME_ELAPSED);
+        timer_active_ = false;
+    }
+    glDeleteQueries(kTimerQueries, timer_queries_.data());
+    timer_queries_.fill(0);
+    timer_pending_.fill(false);
+    surface_program_.reset();
+    ellipsoid_program_.reset();
+    grid_program_.reset();
+    glyph_program_.reset();
+    tube_program_.reset();
+    marker_program_.reset();
+    well_program_.reset();
+    program_.reset();
+}
+
+void Scene3DRenderer::beginFrame(const QMatrix4x4& projection, const QMatrix4x4& view,
+                                 const QSizeF& viewport) {
+    view_projection_ = projection * view;
+    viewport_ = viewport;
+
+    // Плоскости пирамиды видимости из строк матрицы (Гриб–Хартман)
+    const QVector4D w = view_projection_.row(3);
+    for (int axis = 0; axis < 3; ++axis) {
+        const QVector4D row = view_projection_.row(axis);
+        frustum_[axis * 2] = w + row;
+        frustum_[axis * 2 + 1] = w - row;
+    }
+
+    // Камера смотрит вдоль -Z своей системы координат
+    depth_row_ = -view.row(2);
+    pixel_size_per_m_ = 2.0 / (projection(1, 1) * std::max(1.0, viewport.height()));
+
+    counters_ = {};
+    collectTimerQueries();
+    // Если все запросы ещё в полёте, кадр не измеряется
+    if (!timer_pending_[timer_next_]) {
+        glBeginQuery(GL_TIME_ELAPSED, timer_queries_[timer_next_]);
+        timer_active_ = true;
+    }
+}
+
+void Scene3DRenderer::endFrame() {
+    if (timer_active_) {
+        glEndQuery(GL_TIME_ELAPSED);
+        timer_pending_[timer_next_] = true;
+        timer_next_ = (timer_next_ + 1) % kTimerQueries;
+        timer_active_ = false;
+    }
+
+    for (auto it = wells_.begin(); it != wells_.end();) {
+        if (!it->second->used) {
+            freeSlot(*it->second);
+            it = wells_.erase(it);
+        } else {
+            it->second->used = false;
+            ++it;
+        }
+    }
+    for (auto it = tubes_.begin(); it != tubes_.end();) {
+        if (!it->second.used) {
+            freeTube(it->second);
+            it = tubes_.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+}
+
+void Scene3DRenderer::collectTimerQueries() {
+    // От самого старого запроса к новому: последним записывается свежий результат
+    for (int i = 0; i < kTimerQueries; ++i) {
+        const int q = (timer_next_ + i) % kTimerQueries;
+        if (!timer_pending_[q]) {
+            continue;
+        }
+        GLint available = 0;
+        glGetQueryObjectiv(timer_queries_[q], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(timer_queries_[q], GL_QUERY_RESULT, &elapsed_ns);
+        gpu_frame_ms_ = static_cast<double>(elapsed_ns) * 1e-6;
+        timer_pending_[q] = false;
+    }
+}
+
+void Scene3DRenderer::drawVertices(GLenum mode, std::span<const ColoredVertex> vertices, float size) {
+    if (vertices.empty()) {
+        return;
+    }
+
+    program_->bind();
+    program_->setUniformValue("mvp", view_projection_);
+    program_->setUniformValue("point_size", size);
+
+    QOpenGLVertexArrayObject::Binder binder(&stream_vao_);
+    stream_buffer_.bind();
+    stream_buffer_.allocate(vertices.data(), static_cast<int>(vertices.size_bytes()));
+
+    glLineWidth(size);
+    glDrawArrays(mode, 0, static_cast<GLsizei>(vertices.size()));
+    countDraw(vertices.size());
+}
+
+void Scene3DRenderer::drawGrid(const QColor& color, float base_step) {
+    if (base_step <= 0.0f) {
+        return;
+    }
+    bool invertible = false;
+    const QMatrix4x4 inverse = view_projection_.inverted(&invertible);
+    if (!invertible) {
+        return;
+    }
+
+    grid_program_->bind();
+    grid_program_->setUniformValue("inverse_mvp", inverse);
+    grid_program_->setUniformValue("grid_color", QVector4D(color.redF(), color.greenF(), color.blueF(), 0.5f));
+    grid_program_->setUniformValue("base_step", base_step);
+    grid_program_->setUniformValue("min_cell", kGridMinCellPixels);
+
+    // Сетка — фон: глубину не пишет, траектории под ней остаются видны
+    QOpenGLVertexArrayObject::Binder binder(&wells_vao_);
+    glDepthMask(GL_FALSE);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glDepthMask(GL_TRUE);
+    countDraw(3);
+}
+
+void Scene3DRenderer::drawWells(std::span<const WellDrawItem> wells) {
+    line_firsts_.clear();
+    line_counts_.clear();
+    point_firsts_.clear();
+    point_counts_.clear();
+
+    for (const auto& item : wells) {
+        const auto& well = *item.well;
+        const std::uint64_t revision = well.results.revision();
+        if (revision == 0 || well.results.empty()) {
+            continue;
+        }
+
+        // Габариты скважины проверяются до загрузки: невидимые скважины не
+        // занимают буфер, а уже загруженные сохраняют данные до появления в кадре
+        const auto found = wells_.find(well.id);
+        WellSlot* slot = found != wells_.end() ? found->second.get() : nullptr;
+        const bool current = slot && slot->revision == revision;
+        if (slot) {
+            slot->used = true;
+        }
+        if (!isVisible(current ? slot->bounds : boundsOf(well.results.geometry()))) {
+            continue;
+        }
+
+        if (!slot) {
+            slot = &slotFor(well);
+            slot->used = true;
+        }
+        if (!current) {
+            uploadPoints(*slot, well);
+            slot->revision = revision;
+        }
+        updateStyle(*slot, well);
+
+        // Участки вне кадра пропускаются, уровень — по расстоянию до каждого участка
+        const auto lod = well.results.lod();
+        const std::size_t level_count = slot->levels.size();
+        for (std::size_t c = 0; c < slot->chunks.size(); ++c) {
+            const Box& chunk = slot->chunks[c];
+            if (!isVisible(chunk)) {
+                continue;
+            }
+            const auto level = static_cast<std::size_t>(std::min(
+                lod->levelIndexFor(maxErrorFor(chunk)), static_cast<int>(level_count) - 1));
+            appendRun(line_firsts_, line_counts_, slot->chunk_runs[c * level_count + level]);
+            appendRun(point_firsts_, point_counts_, slot->chunk_runs[c * level_count]);
+        }
+    }
+
+    // Полоса линии — по две вершины на точку
+    for (std::size_t i = 0; i < line_firsts_.size(); ++i) {
+        line_firsts_[i] *= 2;
+        line_counts_[i] *= 2;
+    }
+
+    if (line_firsts_.empty()) {
+        return;
+    }
+
+    well_program_->bind();
+    well_program_->setUniformValue("mvp", view_projection_);
+    well_program_->setUniformValue("viewport", QVector2D(viewport_.width(), viewport_.height()));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, points_texture_);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, styles_texture_);
+
+    QOpenGLVertexArrayObject::Binder binder(&wells_vao_);
+
+    well_program_->setUniformValue("expand_lines", true);
+    glMultiDrawArrays(GL_TRIANGLE_STRIP, line_firsts_.data(), line_counts_.data(),
+                      static_cast<GLsizei>(line_firsts_.size()));
+    countDraw(std::accumulate(line_counts_.begin(), line_counts_.end(), std::size_t{0}));
+
+    // Точки замеров
+    well_program_->setUniformValue("expand_lines", false);
+    well_program_->setUniformValue("point_size", kStationPointSize);
+    glMultiDrawArrays(GL_POINTS, point_firsts_.data(), point_counts_.data(),
+                      static_cast<GLsizei>(point_firsts_.size()));
+    countDraw(std::accumulate(point_counts_.begin(), point_counts_.end(), std::size_t{0}));
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Scene3DRenderer::drawTubes(std::span<const TubeDrawItem> tubes, float color_max) {
+    tube_counts_.clear();
+    tube_offsets_.clear();
+    tube_base_vertices_.clear();
+
+    for (const auto& item : tubes) {
+        if (!item.mesh || item.mesh->empty()) {
+            continue;
+        }
+
+        // Сетка вне кадра не загружается; уже загруженная остаётся до появления в кадре
+        auto found = tubes_.find(item.well);
+        if (found != tubes_.end()) {
+            found->second.used = true;
+        }
+        const Box bounds{item.mesh->boundsMin(), item.mesh->boundsMax()};
+        if (!isVisible(bounds)) {
+            continue;
+        }
+
+        TubeSlot& slot = tubes_[item.well];
+        slot.used = true;
+        if (slot.mesh != item.mesh) {
+            uploadTube(slot, item.mesh);
+        }
+
+        // Число граней — по видимому радиусу у ближайшей к камере точки
+        const double pixel_m = maxErrorFor(bounds);
+        const double radius_px = pixel_m > 0.0 ? slot.mesh->radius() / pixel_m : 1e9;
+        const auto& level = slot.mesh->levels()[TubeMesh::levelForRadius(radius_px)];
+        tube_counts_.push_back(static_cast<GLsizei>(level.index_count));
+        tube_offsets_.push_back(reinterpret_cast<const void*>(
+            (slot.indices.offset + level.first_index) * sizeof(std::uint32_t)));
+        tube_base_vertices_.push_back(static_cast<GLint>(slot.vertices.offset));
+    }
+
+    if (tube_counts_.empty()) {
+        return;
+    }
+
+    tube_program_->bind();
+    tube_program_->setUniformValue("mvp", view_projection_);
+    tube_program_->setUniformValue("value_scale", color_max > 0.0f ? 1.0f / color_max : 0.0f);
+    tube_program_->setUniformValue("light_direction", (-depth_row_.toVector3D()).normalized());
+
+    glActiveTexture(kColorTableUnit);
+    glBindTexture(GL_TEXTURE_1D, color_table_texture_);
+
+    QOpenGLVertexArrayObject::Binder binder(&tubes_vao_);
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, tube_counts_.data(), GL_UNSIGNED_INT, tube_offsets_.data(),
+                                  static_cast<GLsizei>(tube_counts_.size()), tube_base_vertices_.data());
+    countDraw(std::accumulate(tube_counts_.begin(), tube_counts_.end(), std::size_t{0}));
+
+    glBindTexture(GL_TEXTURE_1D, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Scene3DRenderer::setMarkers(std::span<const MarkerInstance> markers) {
+    instance_buffer_.bind();
+    instance_buffer_.allocate(markers.data(), static_cast<int>(markers.size_bytes()));
+    instance_buffer_.release();
+    marker_count_ = static_cast<GLsizei>(markers.size());
+}
+
+void Scene3DRenderer::drawMarkers() {
+    if (marker_count_ == 0) {
+        return;
+    }
+
+    marker_program_->bind();
+    marker_program_->setUniformValue("mvp", view_projection_);
+    marker_program_->setUniformValue("viewport", QVector2D(viewport_.width(), viewport_.height()));
+
+    QOpenGLVertexArrayObject::Binder binder(&markers_vao_);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, marker_count_);
+    countDraw(4 * static_cast<std::size_t>(marker_count_));
+}
+
+void Scene3DRenderer::setEllipsoids(std::span<const EllipsoidInstance> ellipsoids) {
+    ellipsoid_buffer_.bind();
+    ellipsoid_buffer_.allocate(ellipsoids.data(), static_cast<int>(ellipsoids.size_bytes()));
+    ellipsoid_buffer_.release();
+    ellipsoid_count_ = static_cast<GLsizei>(ellipsoids.size());
+}
+
+void Scene3DRenderer::drawEllipsoids() {
+    if (ellipsoid_count_ == 0) {
+        return;
+    }
+
+    ellipsoid_program_->bind();
+    ellipsoid_program_->setUniformValue("mvp", view_projection_);
+    ellipsoid_program_->setUniformValue("light_direction", (-depth_row_.toVector3D()).normalized());
+
+    // Полупрозрачные оболочки глубину не пишут: ствол внутри остаётся виден.
+    // Задние грани отбрасываются, чтобы оболочка не темнела вдвое
+    QOpenGLVertexArrayObject::Binder binder(&ellipsoids_vao_);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_CULL_FACE);
+    glDrawElementsInstanced(GL_TRIANGLES, sphere_index_count_, GL_UNSIGNED_SHORT, nullptr, ellipsoid_count_);
+    glDisable(GL_CULL_FACE);
+    glDepthMask(GL_TRUE);
+    countDraw(static_cast<std::size_t>(sphere_index_count_) * static_cast<std::size_t>(ellipsoid_count_));
+}
+
+void Scene3DRenderer::setSurfaces(std::span<const SurfaceVertex> vertices,
+                                  std::span<const std::uint32_t> indices) {
+    surface_vertex_buffer_.bind();
+    surface_vertex_buffer_.allocate(vertices.data(), static_cast<int>(vertices.size_bytes()));
+    surface_vertex_buffer_.release();
+    // Буфер индексов привязан к VAO: загружается при привязанном VAO
+    QOpenGLVertexArrayObject::Binder binder(&surfaces_vao_);
+    surface_index_buffer_.bind();
+    surface_index_buffer_.allocate(indices.data(), static_cast<int>(indices.size_bytes()));
+    surface_index_count_ = static_cast<GLsizei>(indices.size());
+}
+
+void Scene3DRenderer::drawSurfaces() {
+    if (surface_index_count_ == 0) {
+        return;
+    }
+
+    surface_program_->bind();
+    surface_program_->setUniformValue("mvp", view_projection_);
+    surface_program_->setUniformValue("light_direction", (-depth_row_.toVector3D()).normalized());
+
+    // Полупрозрачные поверхности глубину не пишут: стволы сквозь них видны
+    QOpenGLVertexArrayObject::Binder binder(&surfaces_vao_);
+    glDepthMask(GL_FALSE);
+    glDrawElements(GL_TRIANGLES, surface_index_count_, GL_UNSIGNED_INT, nullptr);
+    glDepthMask(GL_TRUE);
+    countDraw(static_cast<std::size_t>(surface_index_count_));
+}
+
+void Scene3DRenderer::setGlyphAtlas(const QImage& atlas) {
+    // Строки QImage выровнены на 4 байта — как GL_UNPACK_ALIGNMENT по умолчанию
+    glBindTexture(GL_TEXTURE_2D, glyph_atlas_texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas.width(), atlas.height(), 0, GL_RED, GL_UNSIGNED_BYTE,
+                 atlas.constBits());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Scene3DRenderer::drawGlyphs(std::span<const GlyphInstance> glyphs) {
+    if (glyphs.empty()) {
+        return;
+    }
+
+    glyph_buffer_.bind();
+    glyph_buffer_.allocate(glyphs.data(), static_cast<int>(glyphs.size_bytes()));
+    glyph_buffer_.release();
+
+    glyph_program_->bind();
+    glyph_program_->setUniformValue("mvp", view_projection_);
+    glyph_program_->setUniformValue("viewport", QVector2D(viewport_.width(), viewport_.height()));
+
+    glActiveTexture(kGlyphAtlasUnit);
+    glBindTexture(GL_TEXTURE_2D, glyph_atlas_texture_);
+    glDisable(GL_DEPTH_TEST);
+
+    QOpenGLVertexArrayObject::Binder binder(&glyphs_vao_);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(glyphs.size()));
+    countDraw(4 * glyphs.size());
+
+    glEnable(GL_DEPTH_TEST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+Scene3DRenderer::Box Scene3DRenderer::boundsOf(const models::WellGeometrySummary& geometry) {
+    return {{static_cast<float>(geometry.min_east), static_cast<float>(geometry.min_north),
+             static_cast<float>(-geometry.max_tvd)},
+            {static_cast<float>(geometry.max_east), static_cast<float>(geometry.max_north),
+             static_cast<float>(-geometry.min_tvd)}};
+}
+
+bool Scene3DRenderer::isVisible(const Box& box) const {
+    for (const auto& plane : frustum_) {
+        // Вершина бокса, дальше всего продвинутая внутрь плоскости
+        const float x = plane.x() >= 0.0f ? box.max[0] : box.min[0];
+        const float y = plane.y() >= 0.0f ? box.max[1] : box.min[1];
+        const float z = plane.z() >= 0.0f ? box.max[2] : box.min[2];
+        if (plane.x() * x + plane.y() * y + plane.z() * z + plane.w() < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double Scene3DRenderer::maxErrorFor(const Box& box) const {
+    // Ближайшая к камере вершина бокса; камера внутри бокса — полная детализация
+    const QVector4D& d = depth_row_;
+    const float x = d.x() >= 0.0f ? box.min[0] : box.max[0];
+    const float y = d.y() >= 0.0f ? box.min[1] : box.max[1];
+    const float z = d.z() >= 0.0f ? box.min[2] : box.max[2];
+    const double depth = d.x() * x + d.y() * y + d.z() * z + d.w();
+    return std::max(0.0, depth) * pixel_size_per_m_ * detail_scale_;
+}
+
+void Scene3DRenderer::appendRun(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, PointRun run) {
+    // Соседние участки одного уровня делят общую точку: полоса продолжается без
+    // разрыва. Уровни лежат в буфере раздельно и перекрыться не могут
+    if (!firsts.empty()) {
+        const GLint last_end = firsts.back() + counts.back();
+        if (run.first >= firsts.back() && run.first < last_end) {
+            counts.back() = std::max(last_end, run.first + run.count) - firsts.back();
+            return;
+        }
+    }
+    firsts.push_back(run.first);
+    counts.push_back(run.count);
+}
+
+Scene3DRenderer::WellSlot& Scene3DRenderer::slotFor(const models::WellData& well) {
+    auto& slot = wells_[well.id];
+    if (!slot) {
+        slot = std::make_unique<WellSlot>();
+        if (free_styles_.empty()) {
+            slot->style_index = static_cast<std::uint32_t>(styles_.size() / 4);
+            styles_.resize(styles_.size() + 4, 0.0f);
+        } else {
+            slot->style_index = free_styles_.back();
+            free_styles_.pop_back();
+        }
+    }
+    return *slot;
+}
+
+void Scene3DRenderer::uploadPoints(WellSlot& slot, const models::WellData& well) {
+    using Column = models::TrajectoryColumns::Column;
+    const auto east = well.results.column(Column::kEast);
+    const auto north = well.results.column(Column::kNorth);
+    const auto tvd = well.results.column(Column::kTvd);
+    const auto lod = well.results.lod();
+
+    std::size_t total = 0;
+    for (int l = 0; l < lod->levelCount(); ++l) {
+        total += lod->level(l).indices.size();
+    }
+
+    // Диапазон занимается заново только при смене числа точек
+    if (slot.points.size != total) {
+        point_allocator_.free(slot.points);
+        slot.points = point_allocator_.allocate(total);
+        reservePoints(point_allocator_.end());
+    }
+
+    // X = восток, Y = север, Z = -TVD (глубина вниз)
+    const float style = static_cast<float>(slot.style_index) * 4.0f;
+    std::vector<float> data;
+    data.reserve(total * 4);
+    slot.levels.clear();
+    for (int l = 0; l < lod->levelCount(); ++l) {
+        const auto& indices = lod->level(l).indices;
+        slot.levels.push_back({static_cast<GLint>(slot.points.offset + data.size() / 4),
+                               static_cast<GLsizei>(indices.size())});
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            const auto k = indices[i];
+            float tag = style;
+            if (i == 0) {
+                tag += kRunStartFlag;
+            }
+            if (i + 1 == indices.size()) {
+                tag += kRunEndFlag;
+            }
+            data.push_back(static_cast<float>(east[k]));
+            data.push_back(static_cast<float>(north[k]));
+            data.push_back(static_cast<float>(-tvd[k]));
+            data.push_back(tag);
+        }
+    }
+
+    // Боксы участков по исходным точкам; участки соседей делят граничную точку
+    const std::size_t count = east.size();
+    const std::size_t chunk_count = std::max<std::size_t>(1, (count - 1 + kChunkPoints - 1) / kChunkPoints);
+    slot.chunks.assign(chunk_count, Box{});
+    slot.chunk_runs.assign(chunk_count * slot.levels.size(), PointRun{});
+    for (std::size_t c = 0; c < chunk_count; ++c) {
+        const std::size_t first = c * kChunkPoints;
+        const std::size_t last = std::min(first + kChunkPoints, count - 1);
+
+        Box& box = slot.chunks[c];
+        box.min = box.max = {static_cast<float>(east[first]), static_cast<float>(north[first]),
+                             static_cast<float>(-tvd[first])};
+        for (std::size_t k = first + 1; k <= last; ++k) {
+            const float point[3] = {static_cast<float>(east[k]), static_cast<float>(north[k]),
+                                    static_cast<float>(-tvd[k])};
+            for (int axis = 0; axis < 3; ++axis) {
+                box.min[axis] = std::min(box.min[axis], point[axis]);
+                box.max[axis] = std::max(box.max[axis], point[axis]);
+            }
+        }
+
+        // На каждом уровне — точки от последней сохранённой до начала участка
+        // до первой сохранённой после конца (устье и забой есть на всех уровнях)
+        for (std::size_t l = 0; l < slot.levels.size(); ++l) {
+            const auto& indices = lod->level(static_cast<int>(l)).indices;
+            const auto from = std::upper_bound(indices.begin(), indices.end(), first) - 1;
+            const auto to = std::lower_bound(from, indices.end(), last);
+            slot.chunk_runs[c * slot.levels.size() + l] = {
+                slot.levels[l].first + static_cast<GLint>(from - indices.begin()),
+                static_cast<GLsizei>(to - from + 1)};
+        }
+    }
+
+    slot.bounds = slot.chunks.front();
+    for (const Box& box : slot.chunks) {
+        for (int axis = 0; axis < 3; ++axis) {
+            slot.bounds.min[axis] = std::min(slot.bounds.min[axis], box.min[axis]);
+            slot.bounds.max[axis] = std::max(slot.bounds.max[axis], box.max[axis]);
+        }
+    }
+
+    // Перезаписывается только диапазон этой скважины
+    glBindBuffer(GL_TEXTURE_BUFFER, points_buffer_);
+    glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(slot.points.offset * kPointBytes),
+                    static_cast<GLsizeiptr>(data.size() * sizeof(float)), data.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void Scene3DRenderer::updateStyle(WellSlot& slot, const models::WellData& well) {
+    if (slot.line_width == well.line_width && slot.color == well.display_color) {
+        return;
+    }
+    slot.color = well.display_color;
+    slot.line_width = well.line_width;
+
+    float* texel = styles_.data() + static_cast<std::size_t>(slot.style_index) * 4;
+    texel[0] = static_cast<float>(slot.color.redF());
+    texel[1] = static_cast<float>(slot.color.greenF());
+    texel[2] = static_cast<float>(slot.color.blueF());
+    texel[3] = static_cast<float>(std::max(1, slot.line_width));
+
+    glBindBuffer(GL_TEXTURE_BUFFER, styles_buffer_);
+    const std::size_t count = styles_.size() / 4;
+    if (count > style_capacity_) {
+        // Таблица выросла: буфер создаётся заново из копии
+        style_capacity_ = std::max({count, style_capacity_ * 2, kMinStyleCapacity});
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(style_capacity_ * 4 * sizeof(float)),
+                     nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(styles_.size() * sizeof(float)),
+                        styles_.data());
+        glBindTexture(GL_TEXTURE_BUFFER, styles_texture_);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, styles_buffer_);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else {
+        glBufferSubData(GL_TEXTURE_BUFFER,
+                        static_cast<GLintptr>(slot.style_index * 4 * sizeof(float)),
+                        4 * sizeof(float), texel);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void Scene3DRenderer::freeSlot(WellSlot& slot) {
+    point_allocator_.free(slot.points);
+    slot.points = {};
+    free_styles_.push_back(slot.style_index);
+}
+
+void Scene3DRenderer::uploadTube(TubeSlot& slot, const std::shared_ptr<const TubeMesh>& mesh) {
+    const auto& vertices = mesh->vertices();
+    const auto& indices = mesh->indices();
+
+    // Диапазоны занимаются заново только при смене размера
+    if (slot.vertices.size != vertices.size()) {
+        tube_vertex_allocator_.free(slot.vertices);
+        slot.vertices = tube_vertex_allocator_.allocate(vertices.size());
+    }
+    if (slot.indices.size != indices.size()) {
+        tube_index_allocator_.free(slot.indices);
+        slot.indices = tube_index_allocator_.allocate(indices.size());
+    }
+    reserveTubes(tube_vertex_allocator_.end(), tube_index_allocator_.end());
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, tube_vertex_buffer_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(slot.vertices.offset * sizeof(TubeVertex)),
+                    static_cast<GLsizeiptr>(vertices.size() * sizeof(TubeVertex)), vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, tube_index_buffer_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(slot.indices.offset * sizeof(std::uint32_t)),
+                    static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)), indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    slot.mesh = mesh;
+}
+
+void Scene3DRenderer::freeTube(TubeSlot& slot) {
+    tube_vertex_allocator_.free(slot.vertices);
+    tube_index_allocator_.free(slot.indices);
+    slot.vertices = {};
+    slot.indices = {};
+    slot.mesh.reset();
+}
+
+void Scene3DRenderer::reserveTubes(std::size_t vertex_count, std::size_t index_count) {
+    bool rebind = false;
+    if (vertex_count > tube_vertex_capacity_) {
+        const std::size_t capacity = std::max({vertex_count, tube_vertex_capacity_ * 2, kMinTubeVertexCapacity});
+        tube_vertex_buffer_ = growBuffer(tube_vertex_buffer_, tube_vertex_capacity_ * sizeof(TubeVertex),
+                                         capacity * sizeof(TubeVertex));
+        tube_vertex_capacity_ = capacity;
+        rebind = true;
+    }
+    if (index_count > tube_index_capacity_) {
+        const std::size_t capacity = std::max({index_count, tube_index_capacity_ * 2, kMinTubeIndexCapacity});
+        tube_index_buffer_ = growBuffer(tube_index_buffer_, tube_index_capacity_ * sizeof(std::uint32_t),
+                                        capacity * sizeof(std::uint32_t));
+        tube_index_capacity_ = capacity;
+        rebind = true;
+    }
+    if (!rebind) {
+        return;
+    }
+
+    // Новые буферы подключаются к VAO трубок
+    QOpenGLVertexArrayObject::Binder binder(&tubes_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, tube_vertex_buffer_);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TubeVertex),
+                          reinterpret_cast<const void*>(offsetof(TubeVertex, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TubeVertex),
+                          reinterpret_cast<const void*>(offsetof(TubeVertex, nx)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(TubeVertex),
+                          reinterpret_cast<const void*>(offsetof(TubeVertex, value)));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tube_index_buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+std::size_t Scene3DRenderer::wellMemoryUsage(models::WellId id) const {
+    std::size_t bytes = 0;
+    if (const auto it = wells_.find(id); it != wells_.end()) {
+        const WellSlot& slot = *it->second;
+        bytes += sizeof(WellSlot) + slot.points.size * kPointBytes;
+        bytes += (slot.levels.capacity() + slot.chunk_runs.capacity()) * sizeof(PointRun);
+        bytes += slot.chunks.capacity() * sizeof(Box);
+    }
+    if (const auto it = tubes_.find(id); it != tubes_.end()) {
+        bytes += it->second.vertices.size * sizeof(TubeVertex) +
+                 it->second.indices.size * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+std::size_t Scene3DRenderer::releaseWellData() {
+    std::size_t bytes = 0;
+    for (const auto& [id, slot] : wells_) {
+        bytes += wellMemoryUsage(id);
+    }
+    for (const auto& [id, slot] : tubes_) {
+        if (!wells_.contains(id)) {
+            bytes += wellMemoryUsage(id);
+        }
+    }
+
+    for (auto& [id, slot] : wells_) {
+        freeSlot(*slot);
+    }
+    wells_.clear();
+    point_allocator_.clear();
+    if (points_buffer_ != 0) {
+        glBindTexture(GL_TEXTURE_BUFFER, points_texture_);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glDeleteBuffers(1, &points_buffer_);
+        points_buffer_ = 0;
+    }
+    point_capacity_ = 0;
+
+    // Буферы трубок создаются заново при первой загрузке (reserveTubes)
+    tubes_.clear();
+    tube_vertex_allocator_.clear();
+    tube_index_allocator_.clear();
+    for (GLuint* buffer : {&tube_vertex_buffer_, &tube_index_buffer_}) {
+        if (*buffer != 0) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    tube_vertex_capacity_ = tube_index_capacity_ = 0;
+    return bytes;
+}
+
+GLuint Scene3DRenderer::growBuffer(GLuint buffer, std::size_t used_bytes, std::size_t capacity_bytes) {
+    GLuint grown = 0;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity_bytes), nullptr, GL_DYNAMIC_DRAW);
+    if (buffer != 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                            static_cast<GLsizeiptr>(used_bytes));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return grown;
+}
+
+void Scene3DRenderer::reservePoints(std::size_t count) {
+    if (count <= point_capacity_) {
+        return;
+    }
+
+    const std::size_t capacity = std::max({count, point_capacity_ * 2, kMinPointCapacity});
+    if (capacity > static_cast<std::size_t>(max_texture_buffer_size_)) {
+        LOG_WARNING(QString::fromUtf8("Общий буфер точек 3D-вида превышает предел буфера-текстуры: %1 > %2")
+                        .arg(capacity)
+                        .arg(max_texture_buffer_size_));
+    }
+
+    points_buffer_ = growBuffer(points_buffer_, point_capacity_ * kPointBytes, capacity * kPointBytes);
+    point_capacity_ = capacity;
+
+    glBindTexture(GL_TEXTURE_BUFFER, points_texture_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, points_buffer_);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <QColor>
+#include <QMatrix4x4>
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <QSizeF>
+#include <QVector4D>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "models/well_data.h"
+#include "utils/range_allocator.h"
+#include "views/depth_label_layer.h"
+#include "views/horizon_surfaces.h"
+#include "views/tube_mesh.h"
+#include "views/uncertainty_ellipsoids.h"
+
+namespace incline3d::views {
+
+/// Вершина временной геометрии (сетка, оси, маркеры)
+struct ColoredVertex {
+    float x, y, z;
+    float r, g, b, a;
+};
+
+/// Форма маркера (номера совпадают с шейдером маркеров)
+enum class MarkerShape : int {
+    kDisc,          ///< Круг
+    kTriangle,      ///< Треугольник вершиной на север
+    kSquare,        ///< Квадрат
+    kDiamond,       ///< Ромб
+    kCross,         ///< Крест
+    kRing           ///< Окружность толщиной в пиксель (круг допуска)
+};
+
+/// Экземпляр маркера
+struct MarkerInstance {
+    float x, y, z;          ///< Центр
+    float size;             ///< Радиус описанной окружности: м или пиксели
+    float r, g, b, a;
+    float shape;            ///< MarkerShape
+    float screen_space;     ///< 1 — размер в пикселях, маркер обращён к камере; 0 — лежит в плоскости XY
+};
+
+/// Скважина для пакетной отрисовки
+struct WellDrawItem {
+    const models::WellData* well{nullptr};
+};
+
+/// Счётчики команд отрисовки с начала кадра
+struct RenderCounters {
+    int draw_calls{0};          ///< Вызовы glDraw* (glMultiDraw* считается одним)
+    std::size_t vertices{0};    ///< Вершины и индексы, отправленные на отрисовку
+};
+
+/// Трубка скважины для пакетной отрисовки
+struct TubeDrawItem {
+    models::WellId well;
+    std::shared_ptr<const TubeMesh> mesh;
+};
+
+/// Отрисовка 3D-сцены через буферы вершин и шейдеры (OpenGL 3.3 core)
+///
+/// Точки траекторий всех скважин лежат в одном общем буфере видеокарты:
+/// каждой скважине выделен свой диапазон, где подряд записаны точки всех
+/// её уровней детализации. Диапазон перезаписывается только при смене
+/// ревизии результатов (TrajectoryColumns::revision()), остальные скважины
+/// не затрагиваются. Цвет и толщина хранятся в отдельной таблице стилей.
+///
+/// Все траектории рисуются одним вызовом glMultiDrawArrays: вершинный шейдер
+/// читает точки из буфера-текстуры по gl_VertexID и сам разворачивает линию
+/// в полосу заданной толщины в экранных пикселях (без геометрического
+/// шейдера и без зависимости от glLineWidth). Точки замеров — второй вызов.
+///
+/// В вызов попадают только участки, видимые в кадре: скважина отсекается по
+/// габаритам, затем её траектория — по участкам из kChunkPoints точек с
+/// собственными боксами. Уровень детализации выбирается для каждого участка
+/// по размеру пикселя на ближайшей к камере точке его бокса, поэтому время
+/// кадра зависит от видимой части сцены, а не от размера проекта.
+///
+/// Маркеры (проектные точки, пункты возбуждения, круги допуска) рисуются
+/// одним инстансным вызовом: единичный квадрат на каждый экземпляр, форма
+/// вычисляется во фрагментном шейдере по функции расстояния. Буфер
+/// экземпляров загружается только при изменении данных.
+///
+/// Трубки (TubeMesh) лежат в общих буферах вершин и индексов и рисуются
+/// одним glMultiDrawElementsBaseVertex; сетка загружается один раз на версию,
+/// число граней по окружности выбирается по видимому радиусу. Цвет берётся
+/// из текстуры-шкалы по значению вершины.
+///
+/// Сетка в плоскости z = 0 строится во фрагментном шейдере по лучу камеры
+/// для каждого пикселя: протяжённость не ограничена, стоимость не зависит
+/// от масштаба, шаг линий меняется степенями десяти с плавным переходом.
+///
+/// Эллипсоиды погрешности — одна сфера-сетка на все экземпляры: вершинный
+/// шейдер переводит единичную сферу в эллипсоид матрицей из трёх полуосей
+/// экземпляра (масштаб и ориентация). Буфер экземпляров загружается только
+/// при изменении данных (UncertaintyLayer).
+///
+/// Поверхности пластов (HorizonLayer) лежат в общих буферах вершин и
+/// индексов и рисуются одним вызовом; вершина несёт нормаль и цвет пласта.
+///
+/// Подписи глубины — символы из растрового атласа (GlyphAtlas), по
+/// экземпляру на символ; все символы кадра рисуются одним инстансным
+/// вызовом поверх сцены, выровненными по пикселям экрана.
+///
+/// Прочая геометрия собирается на CPU и передаётся одним вызовом на тип
+/// примитива через потоковый буфер.
+///
+/// Каждый кадр обрамляется таймерным запросом GL_TIME_ELAPSED; результаты
+/// читаются без ожидания через несколько кадров (кольцо из kTimerQueries
+/// запросов), поэтому измерение не останавливает конвейер.
+///
+/// Все методы вызываются при текущем контексте OpenGL виджета.
+class Scene3DRenderer : protected QOpenGLFunctions_3_3_Core {
+public:
+    Scene3DRenderer();
+    ~Scene3DRenderer();
+
+    Scene3DRenderer(const Scene3DRenderer&) = delete;
+    Scene3DRenderer& operator=(const Scene3DRenderer&) = delete;
+
+    /// Собрать шейдеры и создать буферы
+    /// @return false, если контекст или шейдеры не подходят (подробности в журнале)
+    bool initialize();
+
+    /// Освободить ресурсы видеокарты (до разрушения контекста)
+    void release();
+
+    bool isInitialized() const { return program_ != nullptr; }
+
+    /// Точек исходной траектории в участке отсечения
+    static constexpr std::size_t kChunkPoints = 256;
+
+    /// Начать кадр: запомнить камеру и плоскости пирамиды видимости
+    /// @param projection перспективная проекция
+    /// @param view матрица вида
+    /// @param viewport размер области вывода в физических пикселях
+    void beginFrame(const QMatrix4x4& projection, const QMatrix4x4& view, const QSizeF& viewport);
+
+    /// Завершить кадр: освободить данные скважин, не нарисованных в нём
+    void endFrame();
+
+    /// Нарисовать примитивы из временного массива вершин
+    /// @param size толщина линий или размер точек, пиксели
+    void drawVertices(GLenum mode, std::span<const ColoredVertex> vertices, float size = 1.0f);
+
+    /// Нарисовать бесконечную сетку в плоскости z = 0 (один проход на весь экран)
+    /// @param base_step шаг сетки, м; видимые уровни — base_step × 10^k по размеру пикселя
+    void drawGrid(const QColor& color, float base_step);
+
+    /// Нарисовать видимые участки траекторий и точки замеров (два вызова на все скважины)
+    void drawWells(std::span<const WellDrawItem> wells);
+
+    /// Нарисовать трубки одним вызовом
+    /// @param color_max значение на красном конце шкалы цвета
+    void drawTubes(std::span<const TubeDrawItem> tubes, float color_max);
+
+    /// Нарисовано участков в последнем drawWells (после отсечения и слияния соседних)
+    std::size_t drawnRunCount() const { return line_firsts_.size(); }
+
+    /// Загрузить маркеры в буфер экземпляров (при изменении данных, не каждый кадр)
+    void setMarkers(std::span<const MarkerInstance> markers);
+
+    /// Нарисовать все загруженные маркеры одним вызовом
+    void drawMarkers();
+
+    /// Загрузить эллипсоиды погрешности в буфер экземпляров (при изменении данных, не каждый кадр)
+    void setEllipsoids(std::span<const EllipsoidInstance> ellipsoids);
+
+    /// Нарисовать все загруженные эллипсоиды одним инстансным вызовом (полупрозрачно)
+    void drawEllipsoids();
+
+    /// Загрузить поверхности пластов (при изменении точек, не каждый кадр)
+    void setSurfaces(std::span<const SurfaceVertex> vertices, std::span<const std::uint32_t> indices);
+
+    /// Нарисовать все загруженные поверхности одним вызовом (полупрозрачно)
+    void drawSurfaces();
+
+    /// Загрузить атлас символов подписей (Format_Alpha8)
+    void setGlyphAtlas(const QImage& atlas);
+
+    /// Нарисовать символы подписей одним вызовом поверх сцены (без теста глубины)
+    void drawGlyphs(std::span<const GlyphInstance> glyphs);
+
+    /// Множитель допуска упрощения линий и трубок: > 1 — грубее (во время вращения)
+    void setDetailScale(double scale) { detail_scale_ = scale; }
+
+    /// Вызовы отрисовки и вершины с начала кадра
+    const RenderCounters& counters() const { return counters_; }
+
+    /// Объём данных скважины в общих буферах видеокарты и описаниях участков, байт
+    /// (точки всех уровней, трубка; без запаса ёмкости буферов)
+    std::size_t wellMemoryUsage(models::WellId id) const;
+
+    /// Освободить данные всех скважин и трубок вместе с общими буферами
+    /// (вид скрыт); следующий кадр загружает их заново. Нужен текущий контекст
+    /// @return освобождённый объём (по wellMemoryUsage), байт
+    std::size_t releaseWellData();
+
+    /// Забрать новое измерение времени кадра на видеокарте, мс
+    /// @return < 0, если с прошлого вызова ни один таймерный запрос не завершился
+    double takeGpuFrameTimeMs() { return std::exchange(gpu_frame_ms_, -1.0); }
+
+private:
+    /// Непрерывный участок точек уровня детализации в общем буфере
+    struct PointRun {
+        GLint first{0};
+        GLsizei count{0};
+    };
+
+    /// Габариты участка траектории (в координатах сцены)
+    struct Box {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+    };
+
+    /// Данные скважины в общих буферах
+    struct WellSlot {
+        std::uint32_t style_index{0};
+        std::uint64_t revision{0};
+        utils::RangeAllocator::Range points;    ///< Точки всех уровней
+        std::vector<PointRun> levels;           ///< Уровень 0 — все точки
+        Box bounds{};                           ///< Вся траектория
+        std::vector<Box> chunks;                ///< Участки по kChunkPoints исходных точек
+        std::vector<PointRun> chunk_runs;       ///< [участок * число уровней + уровень]
+        QColor color;
+        int line_width{0};
+        bool used{false};                       ///< Нарисована в текущем кадре
+    };
+
+    /// Трубка скважины в общих буферах
+    struct TubeSlot {
+        std::shared_ptr<const TubeMesh> mesh;       ///< Загруженная сетка
+        utils::RangeAllocator::Range vertices;
+        utils::RangeAllocator::Range indices;
+        bool used{false};
+    };
+
+    WellSlot& slotFor(const models::WellData& well);
+    void uploadPoints(WellSlot& slot, const models::WellData& well);
+    void updateStyle(WellSlot& slot, const models::WellData& well);
+    void freeSlot(WellSlot& slot);
+
+    /// Увеличить общий буфер точек до count точек (с копированием содержимого)
+    void reservePoints(std::size_t count);
+
+    void uploadTube(TubeSlot& slot, const std::shared_ptr<const TubeMesh>& mesh);
+    void freeTube(TubeSlot& slot);
+
+    /// Увеличить общие буферы трубок (с копированием содержимого)
+    void reserveTubes(std::size_t vertex_count, std::size_t index_count);
+
+    /// Новый буфер размером capacity_bytes с копией первых used_bytes старого (старый удаляется)
+    GLuint growBuffer(GLuint buffer, std::size_t used_bytes, std::size_t capacity_bytes);
+
+    /// Габариты скважины по сводке (до загрузки точек)
+    static Box boundsOf(const models::WellGeometrySummary& geometry);
+
+    /// Пересекает ли бокс пирамиду видимости
+    bool isVisible(const Box& box) const;
+
+    /// Допустимое отклонение линии в боксе: размер пикселя у ближайшей к камере точки, м
+    double maxErrorFor(const Box& box) const;
+
+    /// Добавить участок в вызов, продолжив предыдущий, если они перекрываются
+    static void appendRun(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, PointRun run);
+
+    void countDraw(std::size_t vertices) {
+        ++counters_.draw_calls;
+        counters_.vertices += vertices;
+    }
+
+    /// Прочитать завершённые таймерные запросы (без ожидания)
+    void collectTimerQueries();
+
+    /// Таймерных запросов в полёте: результат появляется через 1–3 кадра
+    static constexpr int kTimerQueries = 4;
+
+    std::unique_ptr<QOpenGLShaderProgram> program_;        ///< Временная геометрия
+    std::unique_ptr<QOpenGLShaderProgram> well_program_;   ///< Траектории из общего буфера
+    std::unique_ptr<QOpenGLShaderProgram> marker_program_; ///< Инстансные маркеры
+    std::unique_ptr<QOpenGLShaderProgram> tube_program_;   ///< Трубки
+    std::unique_ptr<QOpenGLShaderProgram> glyph_program_;  ///< Символы подписей
+    std::unique_ptr<QOpenGLShaderProgram> grid_program_;   ///< Сетка на весь экран
+    std::unique_ptr<QOpenGLShaderProgram> ellipsoid_program_;  ///< Эллипсоиды погрешности
+    std::unique_ptr<QOpenGLShaderProgram> surface_program_;    ///< Поверхности пластов
+    QMatrix4x4 view_projection_;
+    QSizeF viewport_;
+    std::array<QVector4D, 6> frustum_;      ///< Плоскости: внутри ax + by + cz + d ≥ 0
+    QVector4D depth_row_;                   ///< Расстояние от камеры вдоль оси взгляда
+    double pixel_size_per_m_{0.0};          ///< Размер пикселя на метр расстояния
+    double detail_scale_{1.0};
+
+    QOpenGLVertexArrayObject stream_vao_;
+    QOpenGLBuffer stream_buffer_{QOpenGLBuffer::VertexBuffer};
+
+    // Общий буфер точек (x, y, z, метка) и таблица стилей (r, g, b, толщина)
+    QOpenGLVertexArrayObject wells_vao_;    ///< Пустой: вершины читаются из буфера-текстуры
+    GLuint points_buffer_{0};
+    GLuint points_texture_{0};
+    std::size_t point_capacity_{0};
+    GLint max_texture_buffer_size_{0};
+    utils::RangeAllocator point_allocator_;
+
+    GLuint styles_buffer_{0};
+    GLuint styles_texture_{0};
+    std::size_t style_capacity_{0};
+    std::vector<float> styles_;             ///< Копия таблицы стилей
+    std::vector<std::uint32_t> free_styles_;
+
+    std::unordered_map<models::WellId, std::unique_ptr<WellSlot>> wells_;
+
+    // Маркеры: единичный квадрат и буфер экземпляров
+    QOpenGLVertexArrayObject markers_vao_;
+    QOpenGLBuffer quad_buffer_{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer instance_buffer_{QOpenGLBuffer::VertexBuffer};
+    GLsizei marker_count_{0};
+
+    // Эллипсоиды: сетка единичной сферы и буфер экземпляров
+    QOpenGLVertexArrayObject ellipsoids_vao_;
+    QOpenGLBuffer sphere_vertex_buffer_{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer sphere_index_buffer_{QOpenGLBuffer::IndexBuffer};
+    QOpenGLBuffer ellipsoid_buffer_{QOpenGLBuffer::VertexBuffer};
+    GLsizei sphere_index_count_{0};
+    GLsizei ellipsoid_count_{0};
+
+    // Поверхности пластов
+    QOpenGLVertexArrayObject surfaces_vao_;
+    QOpenGLBuffer surface_vertex_buffer_{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer surface_index_buffer_{QOpenGLBuffer::IndexBuffer};
+    GLsizei surface_index_count_{0};
+
+    // Трубки: общие буферы вершин и индексов, шкала цвета
+    QOpenGLVertexArrayObject tubes_vao_;
+    GLuint tube_vertex_buffer_{0};
+    GLuint tube_index_buffer_{0};
+    std::size_t tube_vertex_capacity_{0};
+    std::size_t tube_index_capacity_{0};
+    utils::RangeAllocator tube_vertex_allocator_;
+    utils::RangeAllocator tube_index_allocator_;
+    GLuint color_table_texture_{0};
+    std::unordered_map<models::WellId, TubeSlot> tubes_;
+
+    // Подписи: единичный квадрат, потоковый буфер символов и атлас
+    QOpenGLVertexArrayObject glyphs_vao_;
+    QOpenGLBuffer glyph_buffer_{QOpenGLBuffer::VertexBuffer};
+    GLuint glyph_atlas_texture_{0};
+
+    // Массивы вызовов glMultiDraw* (переиспользуются между кадрами)
+    std::vector<GLint> line_firsts_;
+    std::vector<GLsizei> line_counts_;
+    std::vector<GLint> point_firsts_;
+    std::vector<GLsizei> point_counts_;
+    std::vector<GLsizei> tube_counts_;
+    std::vector<const void*> tube_offsets_;
+    std::vector<GLint> tube_base_vertices_;
+
+    // Счётчики и таймеры кадра
+    RenderCounters counters_;
+    std::array<GLuint, kTimerQueries> timer_queries_{};
+    std::array<bool, kTimerQueries> timer_pending_{};
+    int timer_next_{0};
+    bool timer_active_{false};
+    double gpu_frame_ms_{-1.0};
+};
+
+}  // namespace incline3d::views
@@ -0,0 +1,34 @@
+#include "views/scene_stats.h"
+
+#include <QGraphicsPathItem>
+#include <QGraphicsScene>
+
+namespace incline3d::views {
+
+namespace {
+
+/// Средний размер элемента сцены с приватными данными Qt, байт
+constexpr std::size_t kItemOverheadBytes = 256;
+
+/// Размер вершины QPainterPath (x, y, тип)
+constexpr std::size_t kPathElementBytes = 24;
+
+}  // namespace
+
+std::size_t estimateSceneMemory(const QGraphicsScene* scene) {
+    if (!scene) {
+        return 0;
+    }
+
+    std::size_t bytes = 0;
+    const auto items = scene->items();
+    for (const auto* item : items) {
+        bytes += kItemOverheadBytes;
+        if (const auto* path_item = qgraphicsitem_cast<const QGraphicsPathItem*>(item)) {
+            bytes += static_cast<std::size_t>(path_item->path().elementCount()) * kPathElementBytes;
+        }
+    }
+    return bytes;
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+class QGraphicsScene;
+
+namespace incline3d::views {
+
+/// Оценка памяти элементов сцены, байт
+///
+/// Учитывает накладные расходы на элемент и вершины путей
+/// (основной объём для траекторий); точное значение Qt не сообщает.
+std::size_t estimateSceneMemory(const QGraphicsScene* scene);
+
+}  // namespace incline3d::views
@@ -0,0 +1,386 @@
+#include "views/trajectory_layer_item.h"
+
+#include <QGraphicsSceneHoverEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+#include <cmath>
+
+namespace incline3d::views {
+
+namespace {
+
+/// Пересечение прямоугольников с учётом вырожденных (вертикальная скважина в плане — точка)
+bool overlaps(const QRectF& a, const QRectF& b) {
+    return a.left() <= b.right() && b.left() <= a.right() && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+/// Расстояние от точки до отрезка
+double segmentDistance(const QPointF& p, const QPointF& a, const QPointF& b) {
+    const double dx = b.x() - a.x();
+    const double dy = b.y() - a.y();
+    const double length2 = dx * dx + dy * dy;
+    double t = 0.0;
+    if (length2 > 0.0) {
+        t = std::clamp(((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / length2, 0.0, 1.0);
+    }
+    return std::hypot(p.x() - (a.x() + t * dx), p.y() - (a.y() + t * dy));
+}
+
+}  // namespace
+
+TrajectoryLayerItem::TrajectoryLayerItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent) {
+    // exposedRect — для отбора траекторий по перерисовываемой области
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setAcceptHoverEvents(true);
+}
+
+void TrajectoryLayerItem::setWell(const models::WellData& well) {
+    const auto lod = well.results.lod();
+    if (!lod || lod->empty()) {
+        removeWell(well.id);
+        return;
+    }
+
+    auto [it, inserted] = index_.try_emplace(well.id, wells_.size());
+    if (inserted) {
+        wells_.emplace_back();
+        wells_.back().id = well.id;
+        wells_.back().sequence = next_sequence_++;
+    }
+    auto& trajectory = wells_[it->second];
+
+    const std::uint64_t revision = well.results.revision();
+    if (inserted || trajectory.revision != revision) {
+        // Ломаные уровней — при первом обращении
+        const auto geometry = well.results.geometry();
+        trajectory.results = well.results;
+        trajectory.lod = lod;
+        trajectory.levels.assign(static_cast<std::size_t>(lod->levelCount()), {});
+        trajectory.bounds = QRectF(QPointF(geometry.min_east, geometry.min_north),
+                                   QPointF(geometry.max_east, geometry.max_north));
+        trajectory.wellhead = QPointF(well.results.column(models::TrajectoryColumns::Column::kEast)[0],
+                                      well.results.column(models::TrajectoryColumns::Column::kNorth)[0]);
+        trajectory.revision = revision;
+        invalidateIndex();
+    }
+    if (!trajectory.visible) {
+        trajectory.visible = true;
+        invalidateIndex();
+    }
+
+    trajectory.color = well.display_color;
+    trajectory.line_width = well.line_width;
+    trajectory.name = QString::fromStdString(well.metadata.well_name);
+    update();
+}
+
+void TrajectoryLayerItem::setWellVisible(models::WellId id, bool visible) {
+    const auto it = index_.find(id);
+    if (it == index_.end() || wells_[it->second].visible == visible) {
+        return;
+    }
+    wells_[it->second].visible = visible;
+    invalidateIndex();
+}
+
+void TrajectoryLayerItem::removeWell(models::WellId id) {
+    const auto it = index_.find(id);
+    if (it == index_.end()) {
+        return;
+    }
+    // Последняя траектория занимает место удалённой; порядок рисования — по sequence
+    const std::size_t slot = it->second;
+    index_.erase(it);
+    if (slot + 1 != wells_.size()) {
+        wells_[slot] = std::move(wells_.back());
+        index_[wells_[slot].id] = slot;
+    }
+    wells_.pop_back();
+    invalidateIndex();
+}
+
+void TrajectoryLayerItem::clear() {
+    wells_.clear();
+    index_.clear();
+    invalidateIndex();
+}
+
+void TrajectoryLayerItem::setPixelSize(double pixel_m) {
+    if (pixel_m == pixel_m_) {
+        return;
+    }
+    // Поле габаритов под устья зависит от размера пикселя
+    prepareGeometryChange();
+    pixel_m_ = pixel_m;
+}
+
+void TrajectoryLayerItem::setDetailScale(double scale) {
+    if (scale == detail_scale_) {
+        return;
+    }
+    detail_scale_ = scale;
+    update();
+}
+
+std::optional<models::WellId> TrajectoryLayerItem::wellAt(const QPointF& pos, double tolerance_m) const {
+    const auto& candidates =
+        query(QRectF(pos.x() - tolerance_m, pos.y() - tolerance_m, 2.0 * tolerance_m, 2.0 * tolerance_m));
+
+    // Упрощение с допуском в половину допуска выбора не меняет результата заметно;
+    // при равных расстояниях выигрывает нарисованная позже (она сверху)
+    std::optional<models::WellId> result;
+    double best = tolerance_m;
+    for (const std::uint32_t i : candidates) {
+        const auto& trajectory = wells_[i];
+        const auto& line = levelFor(trajectory, 0.5 * tolerance_m);
+        double distance = std::hypot(pos.x() - trajectory.wellhead.x(), pos.y() - trajectory.wellhead.y());
+        for (qsizetype k = 1; k < line.size(); ++k) {
+            distance = std::min(distance, segmentDistance(pos, line[k - 1], line[k]));
+        }
+        if (distance <= best) {
+            best = distance;
+            result = trajectory.id;
+        }
+    }
+    return result;
+}
+
+TrajectoryLayerItem::PaintStats TrajectoryLayerItem::takePaintStats() {
+    const PaintStats stats = paint_stats_;
+    paint_stats_ = {};
+    return stats;
+}
+
+std::size_t TrajectoryLayerItem::memoryUsage() const {
+    std::size_t bytes = wells_.capacity() * sizeof(Trajectory);
+    for (const auto& trajectory : wells_) {
+        for (const auto& line : trajectory.levels) {
+            bytes += static_cast<std::size_t>(line.capacity()) * sizeof(QPointF);
+        }
+    }
+    bytes += (cell_start_.capacity() + cell_items_.capacity() + marks_.capacity()) * sizeof(std::uint32_t);
+    return bytes;
+}
+
+QRectF TrajectoryLayerItem::boundingRect() const {
+    ensureIndex();
+    if (!content_) {
+        return {};
+    }
+    const double margin = kWellheadRadius * pixel_m_;
+    return content_->adjusted(-margin, -margin, margin, margin);
+}
+
+bool TrajectoryLayerItem::contains(const QPointF& point) const {
+    return wellAt(point, kPickTolerance * pixel_m_).has_value();
+}
+
+bool TrajectoryLayerItem::collidesWithPath(const QPainterPath& path, Qt::ItemSelectionMode /*mode*/) const {
+    // Сцена спрашивает о попадании малой областью вокруг курсора: траектория
+    // в пределах области и допуска выбора — попадание
+    const QRectF area = path.boundingRect();
+    const double tolerance = kPickTolerance * pixel_m_ + 0.5 * std::max(area.width(), area.height());
+    return wellAt(area.center(), tolerance).has_value();
+}
+
+void TrajectoryLayerItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /*widget*/) {
+    const double detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (detail <= 0.0) {
+        return;
+    }
+    const double pixel_m = 1.0 / detail;
+    const double radius = kWellheadRadius * pixel_m;
+    const auto& visible = query(option->exposedRect.adjusted(-radius, -radius, radius, radius));
+
+    // Траектории: перо меняется только при смене цвета или толщины
+    QColor color;
+    int width = -1;
+    for (const std::uint32_t i : visible) {
+        const auto& trajectory = wells_[i];
+        if (trajectory.color != color || trajectory.line_width != width) {
+            color = trajectory.color;
+            width = trajectory.line_width;
+            QPen pen(color, width);
+            pen.setCosmetic(true);  // Толщина не зависит от масштаба
+            painter->setPen(pen);
+            ++paint_stats_.pen_changes;
+        }
+        const auto& line = levelFor(trajectory, pixel_m * detail_scale_);
+        painter->drawPolyline(line);
+        ++paint_stats_.wells;
+        paint_stats_.vertices += static_cast<std::size_t>(line.size());
+    }
+
+    // Устья поверх траекторий, постоянного размера на экране
+    painter->setPen(Qt::NoPen);
+    color = QColor();
+    for (const std::uint32_t i : visible) {
+        const auto& trajectory = wells_[i];
+        if (trajectory.color != color) {
+            color = trajectory.color;
+            painter->setBrush(color);
+        }
+        painter->drawEllipse(trajectory.wellhead, radius, radius);
+    }
+}
+
+void TrajectoryLayerItem::hoverEnterEvent(QGraphicsSceneHoverEvent* event) {
+    hoverMoveEvent(event);
+}
+
+void TrajectoryLayerItem::hoverMoveEvent(QGraphicsSceneHoverEvent* event) {
+    const auto id = wellAt(event->pos(), kPickTolerance * pixel_m_);
+    setToolTip(id ? wells_[index_.at(*id)].name : QString());
+}
+
+void TrajectoryLayerItem::ensureIndex() const {
+    if (!index_dirty_) {
+        return;
+    }
+    index_dirty_ = false;
+    content_.reset();
+    grid_columns_ = 0;
+    grid_rows_ = 0;
+    cell_start_.assign(1, 0);
+    cell_items_.clear();
+    marks_.assign(wells_.size(), 0);
+    epoch_ = 0;
+
+    std::size_t count = 0;
+    double left = 0.0, top = 0.0, right = 0.0, bottom = 0.0;
+    for (const auto& trajectory : wells_) {
+        if (!trajectory.visible) {
+            continue;
+        }
+        const QRectF& b = trajectory.bounds;
+        if (count == 0) {
+            left = b.left(); top = b.top(); right = b.right(); bottom = b.bottom();
+        } else {
+            left = std::min(left, b.left());
+            top = std::min(top, b.top());
+            right = std::max(right, b.right());
+            bottom = std::max(bottom, b.bottom());
+        }
+        ++count;
+    }
+    if (count == 0) {
+        return;
+    }
+    content_ = QRectF(QPointF(left, top), QPointF(right, bottom));
+
+    // Около одной траектории на ячейку
+    const int side = std::clamp(static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))), 1, kMaxGridSide);
+    grid_columns_ = right > left ? side : 1;
+    grid_rows_ = bottom > top ? side : 1;
+    const auto column = [&](double x) {
+        return right > left ? std::clamp(static_cast<int>((x - left) / (right - left) * grid_columns_), 0,
+                                         grid_columns_ - 1)
+                            : 0;
+    };
+    const auto row = [&](double y) {
+        return bottom > top ? std::clamp(static_cast<int>((y - top) / (bottom - top) * grid_rows_), 0,
+                                         grid_rows_ - 1)
+                            : 0;
+    };
+
+    // Два прохода: число записей в ячейках, затем сами записи
+    cell_start_.assign(static_cast<std::size_t>(grid_columns_) * grid_rows_ + 1, 0);
+    std::vector<std::uint32_t> cursor;
+    for (const int pass : {0, 1}) {
+        if (pass == 1) {
+            for (std::size_t cell = 1; cell < cell_start_.size(); ++cell) {
+                cell_start_[cell] += cell_start_[cell - 1];
+            }
+            cell_items_.resize(cell_start_.back());
+            cursor.assign(cell_start_.begin(), cell_start_.end() - 1);
+        }
+        for (std::size_t i = 0; i < wells_.size(); ++i) {
+            const auto& trajectory = wells_[i];
+            if (!trajectory.visible) {
+                continue;
+            }
+            const QRectF& b = trajectory.bounds;
+            for (int r = row(b.top()); r <= row(b.bottom()); ++r) {
+                for (int c = column(b.left()); c <= column(b.right()); ++c) {
+                    const std::size_t cell = static_cast<std::size_t>(r) * grid_columns_ + c;
+                    if (pass == 0) {
+                        ++cell_start_[cell + 1];
+                    } else {
+                        cell_items_[cursor[cell]++] = static_cast<std::uint32_t>(i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+const std::vector<std::uint32_t>& TrajectoryLayerItem::query(const QRectF& rect) const {
+    ensureIndex();
+    selection_.clear();
+    if (!content_ || !overlaps(*content_, rect)) {
+        return selection_;
+    }
+
+    const QRectF& content = *content_;
+    const auto column = [&](double x) {
+        return content.width() > 0.0
+                   ? std::clamp(static_cast<int>((x - content.left()) / content.width() * grid_columns_), 0,
+                                grid_columns_ - 1)
+                   : 0;
+    };
+    const auto row = [&](double y) {
+        return content.height() > 0.0
+                   ? std::clamp(static_cast<int>((y - content.top()) / content.height() * grid_rows_), 0,
+                                grid_rows_ - 1)
+                   : 0;
+    };
+
+    // Траектория в нескольких ячейках попадает в выборку один раз
+    if (++epoch_ == 0) {
+        std::fill(marks_.begin(), marks_.end(), 0);
+        epoch_ = 1;
+    }
+    for (int r = row(rect.top()); r <= row(rect.bottom()); ++r) {
+        for (int c = column(rect.left()); c <= column(rect.right()); ++c) {
+            const std::size_t cell = static_cast<std::size_t>(r) * grid_columns_ + c;
+            for (std::uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+                const std::uint32_t i = cell_items_[k];
+                if (marks_[i] != epoch_) {
+                    marks_[i] = epoch_;
+                    if (overlaps(wells_[i].bounds, rect)) {
+                        selection_.push_back(i);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(selection_.begin(), selection_.end(),
+              [this](std::uint32_t a, std::uint32_t b) { return wells_[a].sequence < wells_[b].sequence; });
+    return selection_;
+}
+
+const QPolygonF& TrajectoryLayerItem::levelFor(const Trajectory& trajectory, double pixel_m) const {
+    const int level = trajectory.lod->levelIndexFor(pixel_m);
+    auto& line = trajectory.levels[static_cast<std::size_t>(level)];
+    if (line.isEmpty()) {
+        const auto east = trajectory.results.column(models::TrajectoryColumns::Column::kEast);
+        const auto north = trajectory.results.column(models::TrajectoryColumns::Column::kNorth);
+        const auto& indices = trajectory.lod->level(level).indices;
+        line.reserve(static_cast<qsizetype>(indices.size()));
+        for (const std::uint32_t k : indices) {
+            line.append(QPointF(east[k], north[k]));
+        }
+    }
+    return line;
+}
+
+void TrajectoryLayerItem::invalidateIndex() {
+    prepareGeometryChange();
+    index_dirty_ = true;
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QColor>
+#include <QGraphicsItem>
+#include <QPolygonF>
+#include <QRectF>
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "models/trajectory_lod.h"
+#include "models/well_data.h"
+
+namespace incline3d::views {
+
+/// Траектории и устья скважин 2D-вида «План» одним элементом сцены
+///
+/// Вместо элемента пути и эллипса устья на скважину — один элемент: индекс
+/// сцены (BSP) хранит одну запись, а paint() рисует все траектории в
+/// видимой области за один проход, меняя перо только при смене цвета или
+/// толщины. Уровень детализации выбирается в paint() по масштабу рисования
+/// (levelOfDetailFromTransform); ломаная уровня (X = восток, Y = север)
+/// строится при первом обращении и хранится до смены версии результатов,
+/// поэтому масштаб вида и экспорт в изображение не перестраивают геометрию,
+/// а при отдалении в памяти только грубые уровни.
+///
+/// Отбор по видимой области и выбор курсором идут через равномерную сетку
+/// над габаритами видимых траекторий; сетка строится заново при изменении
+/// геометрии или видимости, при первом обращении.
+class TrajectoryLayerItem : public QGraphicsItem {
+public:
+    enum { Type = UserType + 1 };
+
+    /// Радиус точки устья, пиксели
+    static constexpr double kWellheadRadius = 3.0;
+
+    /// Допуск выбора траектории курсором, пиксели
+    static constexpr double kPickTolerance = 4.0;
+
+    /// Наибольшее число ячеек сетки по стороне
+    static constexpr int kMaxGridSide = 256;
+
+    /// Счётчики последней отрисовки
+    struct PaintStats {
+        std::size_t wells{0};       ///< Нарисовано траекторий
+        std::size_t vertices{0};    ///< Вершин в нарисованных ломаных
+        std::size_t pen_changes{0}; ///< Смен пера (пакетов с общим стилем)
+    };
+
+    explicit TrajectoryLayerItem(QGraphicsItem* parent = nullptr);
+
+    /// Добавить или обновить скважину и показать её
+    /// @note Ломаные строятся заново, только если сменилась версия результатов;
+    ///       цвет, толщина и имя обновляются всегда. Скважина без результатов
+    ///       удаляется.
+    void setWell(const models::WellData& well);
+
+    /// Скрыть или показать скважину (ломаные сохраняются)
+    void setWellVisible(models::WellId id, bool visible);
+
+    void removeWell(models::WellId id);
+    void clear();
+
+    bool hasWell(models::WellId id) const { return index_.contains(id); }
+    int wellCount() const { return static_cast<int>(wells_.size()); }
+
+    /// Размер пикселя вида, м: поле габаритов под устья и допуск выбора курсором
+    void setPixelSize(double pixel_m);
+
+    /// Множитель допуска упрощения (грубее во время прокрутки и перетаскивания)
+    void setDetailScale(double scale);
+
+    /// Ближайшая к точке видимая траектория не дальше tolerance_m
+    std::optional<models::WellId> wellAt(const QPointF& pos, double tolerance_m) const;
+
+    /// Счётчики последней отрисовки; обнуляются
+    PaintStats takePaintStats();
+
+    /// Объём памяти под построенные ломаные и сетку, байт
+    std::size_t memoryUsage() const;
+
+    int type() const override { return Type; }
+    QRectF boundingRect() const override;
+    bool contains(const QPointF& point) const override;
+    bool collidesWithPath(const QPainterPath& path,
+                          Qt::ItemSelectionMode mode = Qt::IntersectsItemShape) const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+protected:
+    /// Подсказка — имя траектории под курсором
+    void hoverEnterEvent(QGraphicsSceneHoverEvent* event) override;
+    void hoverMoveEvent(QGraphicsSceneHoverEvent* event) override;
+
+private:
+    /// Траектория скважины и построенные ломаные уровней детализации
+    struct Trajectory {
+        models::WellId id;
+        std::uint64_t revision{0};
+        std::uint64_t sequence{0};                      ///< Порядок добавления (порядок рисования)
+        models::TrajectoryColumns results;              ///< Копия разделяет хранилище с моделью
+        std::shared_ptr<const models::TrajectoryLod> lod;
+        mutable std::vector<QPolygonF> levels;          ///< Ломаная уровня (0 — все точки); пустая — не построена
+        QRectF bounds;
+        QPointF wellhead;
+        QColor color;
+        int line_width{1};
+        QString name;
+        bool visible{true};
+    };
+
+    /// Перестроить сетку и габариты, если они устарели
+    void ensureIndex() const;
+
+    /// Номера видимых траекторий, чьи габариты пересекают область (в порядке рисования)
+    const std::vector<std::uint32_t>& query(const QRectF& rect) const;
+
+    /// Ломаная уровня детализации траектории под размер пикселя, м
+    const QPolygonF& levelFor(const Trajectory& trajectory, double pixel_m) const;
+
+    /// Отметить изменение геометрии или видимости
+    void invalidateIndex();
+
+    std::vector<Trajectory> wells_;
+    std::unordered_map<models::WellId, std::size_t> index_;
+    std::uint64_t next_sequence_{0};
+
+    double pixel_m_{1.0};
+    double detail_scale_{1.0};
+
+    // Равномерная сетка над видимыми траекториями: номера траекторий ячейки
+    // cell — cell_items_[cell_start_[cell] .. cell_start_[cell + 1])
+    mutable bool index_dirty_{true};
+    mutable std::optional<QRectF> content_;             ///< Габариты видимых траекторий (нет — нет видимых)
+    mutable int grid_columns_{0};
+    mutable int grid_rows_{0};
+    mutable std::vector<std::uint32_t> cell_start_;
+    mutable std::vector<std::uint32_t> cell_items_;
+    mutable std::vector<std::uint32_t> marks_;          ///< Эпоха последнего попадания в выборку
+    mutable std::uint32_t epoch_{0};
+    mutable std::vector<std::uint32_t> selection_;
+
+    PaintStats paint_stats_;
+};
+
+}  // namespace incline3d::views
@@ -0,0 +1,106 @@
+#include "views/tube_builder.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+namespace incline3d::views {
+
+TubeBuilder::TubeBuilder(QObject* parent)
+    : QObject(parent) {}
+
+TubeBuilder::~TubeBuilder() = default;
+
+std::shared_ptr<const TubeMesh> TubeBuilder::mesh(const models::WellData& well, const TubeParams& params) {
+    const std::uint64_t revision = well.results.revision();
+    Entry& entry = entries_[well.id];
+    entry.used = true;
+
+    const bool ready = entry.mesh && entry.revision == revision && entry.params == params;
+    const bool in_progress = entry.building && entry.building_revision == revision &&
+                             entry.building_params == params;
+    if (!ready && !in_progress && revision != 0) {
+        start(well.id, entry, well.results, revision, params);
+    }
+    return entry.mesh;
+}
+
+void TubeBuilder::start(models::WellId id, Entry& entry, const models::TrajectoryColumns& results,
+                        std::uint64_t revision, const TubeParams& params) {
+    entry.building = true;
+    entry.building_revision = revision;
+    entry.building_params = params;
+    ++pending_;
+
+    using MeshPtr = std::shared_ptr<const TubeMesh>;
+    auto* watcher = new QFutureWatcher<MeshPtr>(this);
+    connect(watcher, &QFutureWatcher<MeshPtr>::finished, this, [this, watcher, id, revision, params]() {
+        watcher->deleteLater();
+        --pending_;
+
+        // Результат устарел, если скважину забыли или запустили более новое построение
+        const auto it = entries_.find(id);
+        if (it == entries_.end() || !it->second.building ||
+            it->second.building_revision != revision || !(it->second.building_params == params)) {
+            return;
+        }
+        Entry& done = it->second;
+        done.mesh = watcher->result();
+        done.revision = revision;
+        done.params = params;
+        done.building = false;
+        emit meshReady();
+    });
+
+    // Копия результатов разделяет хранилище (copy-on-write) и не меняется при пересчёте
+    watcher->setFuture(QtConcurrent::run([results, params]() -> MeshPtr {
+        return std::make_shared<const TubeMesh>(TubeMesh::build(results, params));
+    }));
+}
+
+std::size_t TubeBuilder::memoryUsage(models::WellId id) const {
+    const auto it = entries_.find(id);
+    return it != entries_.end() && it->second.mesh ? it->second.mesh->memoryUsage() : 0;
+}
+
+std::size_t TubeBuilder::memoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& [id, entry] : entries_) {
+        if (entry.mesh) {
+            bytes += entry.mesh->memoryUsage();
+        }
+    }
+    return bytes;
+}
+
+int TubeBuilder::meshCount() const {
+    return static_cast<int>(std::count_if(entries_.begin(), entries_.end(),
+                                          [](const auto& item) { return item.second.mesh != nullptr; }));
+}
+
+std::size_t TubeBuilder::release() {
+    const std::size_t bytes = memoryUsage();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (!it->second.building) {
+            it = entries_.erase(it);
+        } else {
+            it->second.mesh.reset();
+            ++it;
+        }
+    }
+    return bytes;
+}
+
+void TubeBuilder::prune() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (!it->second.used && !it->second.building) {
+            it = entries_.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+}
+
+}  // namespace incline3d::views
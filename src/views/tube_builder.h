@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QObject>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "models/well_data.h"
+#include "views/tube_mesh.h"
+
+namespace incline3d::views {
+
+/// Фоновое построение трубок скважин
+///
+/// Сетка строится в пуле потоков (QtConcurrent) один раз на версию
+/// результатов (TrajectoryColumns::revision()) и параметры трубки. Пока
+/// новая сетка строится, mesh() возвращает предыдущую (или nullptr — тогда
+/// вид рисует скважину линией). По готовности испускается meshReady().
+class TubeBuilder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TubeBuilder(QObject* parent = nullptr);
+    ~TubeBuilder() override;
+
+    /// Последняя готовая сетка скважины; при необходимости запускает построение
+    std::shared_ptr<const TubeMesh> mesh(const models::WellData& well, const TubeParams& params);
+
+    /// Забыть сетки скважин, не запрошенные с прошлого вызова
+    void prune();
+
+    /// Число построений в работе
+    int pendingCount() const { return pending_; }
+
+    /// Объём готовой сетки скважины в памяти, байт (0 — сетки нет)
+    std::size_t memoryUsage(models::WellId id) const;
+
+    /// Объём всех готовых сеток, байт
+    std::size_t memoryUsage() const;
+
+    /// Число готовых сеток
+    int meshCount() const;
+
+    /// Забыть все готовые сетки (вид скрыт); построения в работе доводятся до конца
+    /// @return освобождённый объём, байт
+    std::size_t release();
+
+signals:
+    /// Готова новая сетка (вид перерисовывается)
+    void meshReady();
+
+private:
+    struct Entry {
+        std::shared_ptr<const TubeMesh> mesh;
+        std::uint64_t revision{0};
+        TubeParams params;
+
+        bool building{false};
+        std::uint64_t building_revision{0};
+        TubeParams building_params;
+
+        bool used{false};
+    };
+
+    void start(models::WellId id, Entry& entry, const models::TrajectoryColumns& results,
+               std::uint64_t revision, const TubeParams& params);
+
+    std::unordered_map<models::WellId, Entry> entries_;
+    int pending_{0};
+};
+
+}  // namespace incline3d::views
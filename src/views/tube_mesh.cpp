@@ -0,0 +1,227 @@
+#include "views/tube_mesh.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+
+namespace incline3d::views {
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+/// Точки ближе этого расстояния сливаются (касательная не определена), м
+constexpr double kMinSegmentLength = 1e-4;
+
+Vec3 sub(const Vec3& a, const Vec3& b) {
+    return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+Vec3 scaled(const Vec3& a, double k) {
+    return {a[0] * k, a[1] * k, a[2] * k};
+}
+
+double dot(const Vec3& a, const Vec3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+Vec3 normalized(const Vec3& a) {
+    const double length = std::sqrt(dot(a, a));
+    return length > 0.0 ? scaled(a, 1.0 / length) : a;
+}
+
+/// Отражение v относительно плоскости с нормалью n (c = n·n)
+Vec3 reflect(const Vec3& v, const Vec3& n, double c) {
+    return sub(v, scaled(n, 2.0 * dot(n, v) / c));
+}
+
+/// Единичный вектор, перпендикулярный t
+Vec3 anyPerpendicular(const Vec3& t) {
+    // Ось, наименее сонаправленная с t, даёт устойчивое векторное произведение
+    const Vec3 axis = std::abs(t[2]) < 0.9 ? Vec3{0.0, 0.0, 1.0} : Vec3{1.0, 0.0, 0.0};
+    return normalized(cross(t, axis));
+}
+
+}  // namespace
+
+TubeMesh TubeMesh::build(const models::TrajectoryColumns& results, const TubeParams& params) {
+    using Column = models::TrajectoryColumns::Column;
+
+    TubeMesh mesh;
+    mesh.radius_ = params.radius_m;
+    const auto lod = results.lod();
+    if (!lod || params.radius_m <= 0.0) {
+        return mesh;
+    }
+
+    const auto east = results.column(Column::kEast);
+    const auto north = results.column(Column::kNorth);
+    const auto tvd = results.column(Column::kTvd);
+    const auto values = results.column(params.coloring == TubeColoring::kDogleg
+                                           ? Column::kDogleg : Column::kIntensity10m);
+
+    // Ось: точки уровня детализации; значение — максимум на отброшенных точках
+    const auto& kept = lod->levelFor(params.radius_m * kCenterlineTolerance).indices;
+    std::vector<Vec3> points;
+    std::vector<float> point_values;
+    points.reserve(kept.size());
+    point_values.reserve(kept.size());
+    std::size_t next = 0;
+    for (const auto k : kept) {
+        double value = 0.0;
+        for (; next <= k; ++next) {
+            value = std::max(value, values.empty() ? 0.0 : values[next]);
+        }
+
+        const Vec3 point = {east[k], north[k], -tvd[k]};
+        if (!points.empty()) {
+            const Vec3 step = sub(point, points.back());
+            if (dot(step, step) < kMinSegmentLength * kMinSegmentLength) {
+                point_values.back() = std::max(point_values.back(), static_cast<float>(value));
+                continue;
+            }
+        }
+        points.push_back(point);
+        point_values.push_back(static_cast<float>(value));
+    }
+
+    const std::size_t count = points.size();
+    if (count < 2) {
+        return mesh;
+    }
+
+    // Касательные: центральные разности, на концах — односторонние
+    std::vector<Vec3> tangents(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Vec3& from = points[i == 0 ? 0 : i - 1];
+        const Vec3& to = points[i + 1 == count ? i : i + 1];
+        tangents[i] = normalized(sub(to, from));
+    }
+
+    // Кадры параллельного переноса (Wang et al., «Computation of rotation
+    // minimizing frames», 2008): два отражения переводят кадр в следующую точку
+    std::vector<Vec3> normals(count);
+    std::vector<Vec3> binormals(count);
+    normals[0] = anyPerpendicular(tangents[0]);
+    binormals[0] = cross(tangents[0], normals[0]);
+    for (std::size_t i = 1; i < count; ++i) {
+        const Vec3 v1 = sub(points[i], points[i - 1]);
+        const double c1 = dot(v1, v1);
+        const Vec3 r_left = reflect(normals[i - 1], v1, c1);
+        const Vec3 t_left = reflect(tangents[i - 1], v1, c1);
+        const Vec3 v2 = sub(tangents[i], t_left);
+        const double c2 = dot(v2, v2);
+        Vec3 r = c2 > 1e-24 ? reflect(r_left, v2, c2) : r_left;
+
+        // Ортогонализация против накопления погрешности
+        r = normalized(sub(r, scaled(tangents[i], dot(r, tangents[i]))));
+        normals[i] = r;
+        binormals[i] = cross(tangents[i], r);
+    }
+
+    const double radius = params.radius_m;
+    std::size_t vertex_total = 0;
+    std::size_t index_total = 0;
+    for (const int sides : kSides) {
+        vertex_total += count * sides + 2 * (sides + 1);
+        index_total += (count - 1) * sides * 6 + 2 * sides * 3;
+    }
+    mesh.vertices_.reserve(vertex_total);
+    mesh.indices_.reserve(index_total);
+
+    const auto pushVertex = [&mesh](const Vec3& position, const Vec3& normal, float value) {
+        mesh.vertices_.push_back({static_cast<float>(position[0]), static_cast<float>(position[1]),
+                                  static_cast<float>(position[2]), static_cast<float>(normal[0]),
+                                  static_cast<float>(normal[1]), static_cast<float>(normal[2]), value});
+    };
+
+    for (const int sides : kSides) {
+        Level level;
+        level.sides = sides;
+        level.first_index = static_cast<std::uint32_t>(mesh.indices_.size());
+
+        std::vector<double> cosines(sides);
+        std::vector<double> sines(sides);
+        for (int k = 0; k < sides; ++k) {
+            const double angle = 2.0 * 3.14159265358979323846 * k / sides;
+            cosines[k] = std::cos(angle);
+            sines[k] = std::sin(angle);
+        }
+
+        // Кольца сечений
+        const auto rings = static_cast<std::uint32_t>(mesh.vertices_.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int k = 0; k < sides; ++k) {
+                const Vec3 normal = {cosines[k] * normals[i][0] + sines[k] * binormals[i][0],
+                                     cosines[k] * normals[i][1] + sines[k] * binormals[i][1],
+                                     cosines[k] * normals[i][2] + sines[k] * binormals[i][2]};
+                const Vec3 position = {points[i][0] + radius * normal[0], points[i][1] + radius * normal[1],
+                                       points[i][2] + radius * normal[2]};
+                pushVertex(position, normal, point_values[i]);
+            }
+        }
+        for (std::size_t i = 0; i + 1 < count; ++i) {
+            const auto ring = rings + static_cast<std::uint32_t>(i * sides);
+            for (int k = 0; k < sides; ++k) {
+                const std::uint32_t a = ring + k;
+                const std::uint32_t b = ring + (k + 1) % sides;
+                const std::uint32_t c = a + sides;
+                const std::uint32_t d = b + sides;
+                mesh.indices_.insert(mesh.indices_.end(), {a, c, b, b, c, d});
+            }
+        }
+
+        // Торцы: центр и отдельное кольцо с нормалью вдоль оси
+        for (const std::size_t i : {std::size_t{0}, count - 1}) {
+            const Vec3 axis = scaled(tangents[i], i == 0 ? -1.0 : 1.0);
+            const auto center = static_cast<std::uint32_t>(mesh.vertices_.size());
+            pushVertex(points[i], axis, point_values[i]);
+            const auto ring = rings + static_cast<std::uint32_t>(i * sides);
+            for (int k = 0; k < sides; ++k) {
+                const TubeVertex& v = mesh.vertices_[ring + k];
+                pushVertex({v.x, v.y, v.z}, axis, point_values[i]);
+            }
+            for (int k = 0; k < sides; ++k) {
+                mesh.indices_.insert(mesh.indices_.end(),
+                                     {center, center + 1 + k, center + 1 + (k + 1) % sides});
+            }
+        }
+
+        level.index_count = static_cast<std::uint32_t>(mesh.indices_.size()) - level.first_index;
+        mesh.levels_.push_back(level);
+    }
+
+    // Габариты оси, расширенные на радиус
+    Vec3 lo = points[0];
+    Vec3 hi = points[0];
+    for (const auto& p : points) {
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::min(lo[axis], p[axis]);
+            hi[axis] = std::max(hi[axis], p[axis]);
+        }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        mesh.bounds_min_[axis] = static_cast<float>(lo[axis] - radius);
+        mesh.bounds_max_[axis] = static_cast<float>(hi[axis] + radius);
+    }
+    return mesh;
+}
+
+int TubeMesh::levelForRadius(double radius_px) {
+    if (radius_px >= 8.0) {
+        return 0;
+    }
+    return radius_px >= 2.0 ? 1 : 2;
+}
+
+std::size_t TubeMesh::memoryUsage() const {
+    return vertices_.capacity() * sizeof(TubeVertex) + indices_.capacity() * sizeof(std::uint32_t) +
+           levels_.capacity() * sizeof(Level);
+}
+
+}  // namespace incline3d::views
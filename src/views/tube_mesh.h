@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "views/view_settings.h"
+
+namespace incline3d::models {
+class TrajectoryColumns;
+}  // namespace incline3d::models
+
+namespace incline3d::views {
+
+/// Вершина трубки: положение, нормаль и значение для шкалы цвета
+struct TubeVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    float value;
+};
+
+/// Параметры построения трубки
+struct TubeParams {
+    double radius_m{5.0};
+    TubeColoring coloring{TubeColoring::kIntensity10m};
+
+    bool operator==(const TubeParams&) const = default;
+};
+
+/// Сетка трубки вдоль траектории
+///
+/// Сечения ориентируются параллельным переносом (кадры минимального
+/// вращения, метод двойного отражения): на спиральных участках трубка не
+/// закручивается, как это бывает с кадрами Френе. Ось берётся из пирамиды
+/// детализации с допуском в долю радиуса — отклонение оси меньше толщины
+/// трубки незаметно. Значение вершины — максимум параметра раскраски на
+/// отброшенных точках участка, поэтому резкие перегибы не теряются.
+///
+/// Сетка содержит несколько уровней с разным числом граней по окружности;
+/// вид выбирает уровень по видимому радиусу трубки в пикселях.
+///
+/// Построение не обращается к OpenGL и выполняется в рабочих потоках
+/// (см. TubeBuilder).
+class TubeMesh {
+public:
+    /// Уровень детализации: диапазон индексов в общем массиве
+    struct Level {
+        int sides{0};
+        std::uint32_t first_index{0};
+        std::uint32_t index_count{0};
+    };
+
+    /// Число граней по окружности на уровнях (от подробного к грубому)
+    static constexpr std::array<int, 3> kSides = {16, 8, 4};
+
+    /// Допуск упрощения оси в долях радиуса
+    static constexpr double kCenterlineTolerance = 0.1;
+
+    /// Построить сетку по результатам расчёта
+    /// @note Пусто, если у траектории меньше двух несовпадающих точек
+    static TubeMesh build(const models::TrajectoryColumns& results, const TubeParams& params);
+
+    /// Уровень по видимому радиусу трубки в пикселях
+    static int levelForRadius(double radius_px);
+
+    bool empty() const { return indices_.empty(); }
+    double radius() const { return radius_; }
+
+    /// Вершины всех уровней (координаты сцены: восток, север, -TVD)
+    const std::vector<TubeVertex>& vertices() const { return vertices_; }
+
+    /// Треугольники всех уровней; номера вершин отсчитываются от начала vertices()
+    const std::vector<std::uint32_t>& indices() const { return indices_; }
+
+    const std::vector<Level>& levels() const { return levels_; }
+
+    /// Габариты с учётом радиуса
+    const std::array<float, 3>& boundsMin() const { return bounds_min_; }
+    const std::array<float, 3>& boundsMax() const { return bounds_max_; }
+
+    /// Объём памяти под вершины и индексы, байт
+    std::size_t memoryUsage() const;
+
+private:
+    double radius_{0.0};
+    std::vector<TubeVertex> vertices_;
+    std::vector<std::uint32_t> indices_;
+    std::vector<Level> levels_;
+    std::array<float, 3> bounds_min_{};
+    std::array<float, 3> bounds_max_{};
+};
+
+}  // namespace incline3d::views
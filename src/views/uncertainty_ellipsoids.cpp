@@ -0,0 +1,161 @@
+#include "views/uncertainty_ellipsoids.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace incline3d::views {
+
+namespace {
+
+using Column = models::TrajectoryColumns::Column;
+
+/// Значение редкой колонки (пустая — ещё не создана, все значения нулевые)
+double valueAt(std::span<const double> column, std::size_t index) {
+    return column.empty() ? 0.0 : column[index];
+}
+
+}  // namespace
+
+std::vector<EllipsoidInstance> computeUncertaintyEllipsoids(const models::TrajectoryColumns& results,
+                                                            double md_step, const QColor& color) {
+    std::vector<EllipsoidInstance> instances;
+
+    const auto md = results.column(Column::kMeasuredDepth);
+    const auto north = results.column(Column::kNorth);
+    const auto east = results.column(Column::kEast);
+    const auto tvd = results.column(Column::kTvd);
+    const auto error_north = results.column(Column::kMistakeX);
+    const auto error_east = results.column(Column::kMistakeY);
+    const auto error_vertical = results.column(Column::kMistakeZ);
+    const auto error_offset = results.column(Column::kMistakeAbsg);
+    if (md.empty() || (error_north.empty() && error_east.empty() && error_vertical.empty() &&
+                       error_offset.empty())) {
+        return instances;
+    }
+
+    const float r = static_cast<float>(color.redF());
+    const float g = static_cast<float>(color.greenF());
+    const float b = static_cast<float>(color.blueF());
+    const float a = static_cast<float>(color.alphaF());
+
+    // Точка между замерами i и j (доля f от i к j)
+    const auto append = [&](std::size_t i, std::size_t j, double f) {
+        const auto lerp = [&](std::span<const double> column) {
+            const double from = valueAt(column, i);
+            return from + f * (valueAt(column, j) - from);
+        };
+        double sigma_north = std::abs(lerp(error_north));
+        double sigma_east = std::abs(lerp(error_east));
+        const double sigma_vertical = std::abs(lerp(error_vertical));
+        if (sigma_north <= 0.0 && sigma_east <= 0.0) {
+            sigma_north = sigma_east = std::abs(lerp(error_offset));
+        }
+        if (sigma_north <= 0.0 && sigma_east <= 0.0 && sigma_vertical <= 0.0) {
+            return;
+        }
+
+        EllipsoidInstance instance{};
+        instance.x = static_cast<float>(lerp(east));
+        instance.y = static_cast<float>(lerp(north));
+        instance.z = static_cast<float>(-lerp(tvd));
+        instance.ux = static_cast<float>(std::max(sigma_east, kMinEllipsoidAxis));
+        instance.vy = static_cast<float>(std::max(sigma_north, kMinEllipsoidAxis));
+        instance.wz = static_cast<float>(std::max(sigma_vertical, kMinEllipsoidAxis));
+        instance.r = r;
+        instance.g = g;
+        instance.b = b;
+        instance.a = a;
+        instances.push_back(instance);
+    };
+
+    const std::size_t count = md.size();
+    if (md_step <= 0.0) {
+        instances.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            append(i, i, 0.0);
+        }
+        return instances;
+    }
+
+    // Глубины, кратные шагу; номер шага считается от нуля, чтобы не копить ошибку сложения
+    const auto first = static_cast<long long>(std::ceil(md.front() / md_step));
+    const auto last = static_cast<long long>(std::floor(md.back() / md_step));
+    if (last >= first) {
+        instances.reserve(static_cast<std::size_t>(last - first + 1));
+    }
+    std::size_t i = 0;
+    for (long long k = first; k <= last; ++k) {
+        const double depth = k * md_step;
+        while (i + 1 < count && md[i + 1] < depth) {
+            ++i;
+        }
+        const std::size_t j = std::min(i + 1, count - 1);
+        const double span = md[j] - md[i];
+        const double f = span > 0.0 ? std::clamp((depth - md[i]) / span, 0.0, 1.0) : 0.0;
+        append(i, j, f);
+    }
+    return instances;
+}
+
+bool UncertaintyLayer::update(std::span<const models::WellData* const> wells, double md_step) {
+    bool changed = md_step != sources_step_ || wells.size() != sources_.size();
+    std::size_t total = 0;
+
+    for (std::size_t k = 0; k < wells.size(); ++k) {
+        const auto& well = *wells[k];
+        QColor color = well.display_color;
+        color.setAlphaF(kAlpha);
+        const Source source{well.id, well.results.revision(), color.rgba()};
+
+        auto [it, inserted] = wells_.try_emplace(well.id);
+        WellEllipsoids& entry = it->second;
+        if (inserted || entry.revision != source.revision || entry.step != md_step ||
+            entry.color != source.color) {
+            entry.revision = source.revision;
+            entry.step = md_step;
+            entry.color = source.color;
+            entry.instances = computeUncertaintyEllipsoids(well.results, md_step, color);
+            changed = true;
+        }
+        entry.used = true;
+        total += entry.instances.size();
+
+        if (!changed && sources_[k] != source) {
+            changed = true;
+        }
+    }
+
+    // Скважины, скрытые или удалённые с прошлого кадра, забываются
+    for (auto it = wells_.begin(); it != wells_.end();) {
+        if (!it->second.used) {
+            it = wells_.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+
+    if (!changed) {
+        return false;
+    }
+
+    sources_.clear();
+    instances_.clear();
+    instances_.reserve(total);
+    for (const auto* well : wells) {
+        const auto& entry = wells_.at(well->id);
+        sources_.push_back({well->id, entry.revision, entry.color});
+        instances_.insert(instances_.end(), entry.instances.begin(), entry.instances.end());
+    }
+    sources_step_ = md_step;
+    return true;
+}
+
+void UncertaintyLayer::clear() {
+    wells_.clear();
+    sources_.clear();
+    sources_step_ = -1.0;
+    instances_.clear();
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QColor>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "models/well_data.h"
+
+namespace incline3d::views {
+
+/// Экземпляр эллипсоида погрешности (буфер экземпляров рендерера)
+///
+/// Полуоси заданы векторами в координатах сцены: направление — ориентация,
+/// длина — погрешность, м. Единичная сфера переводится в эллипсоид матрицей
+/// из трёх полуосей.
+struct EllipsoidInstance {
+    float x, y, z;              ///< Центр (восток, север, -TVD)
+    float ux, uy, uz;           ///< Первая полуось
+    float vx, vy, vz;           ///< Вторая полуось
+    float wx, wy, wz;           ///< Третья полуось
+    float r, g, b, a;
+};
+
+/// Наименьшая полуось, м: при нулевой погрешности по одной оси эллипсоид не вырождается в диск
+constexpr double kMinEllipsoidAxis = 0.01;
+
+/// Эллипсоиды погрешности положения ствола
+///
+/// Погрешности результатов заданы по осям север (mistake_x), восток
+/// (mistake_y) и вертикаль (mistake_z), поэтому полуоси направлены по осям
+/// сцены. Если плановых погрешностей нет, обе горизонтальные полуоси равны
+/// погрешности смещения (mistake_absg). Точки без погрешностей пропускаются.
+/// @param md_step шаг по стволу, м: положение и погрешности интерполируются
+///        между точками замеров; ≤ 0 — в каждой точке замера
+std::vector<EllipsoidInstance> computeUncertaintyEllipsoids(const models::TrajectoryColumns& results,
+                                                            double md_step, const QColor& color);
+
+/// Эллипсоиды погрешности видимых скважин 3D-вида
+///
+/// Экземпляры скважины считаются один раз на версию результатов, шаг и
+/// цвет; общий массив для буфера рендерера пересобирается, только когда
+/// меняется набор видимых скважин или их версии. Пока ничего не меняется,
+/// вращение и масштаб не стоят ничего, кроме одного инстансного вызова.
+class UncertaintyLayer {
+public:
+    /// Непрозрачность оболочек
+    static constexpr float kAlpha = 0.25f;
+
+    /// Обновить экземпляры видимых скважин
+    /// @return true, если instances() изменился (буфер рендерера нужно загрузить заново)
+    bool update(std::span<const models::WellData* const> wells, double md_step);
+
+    /// Экземпляры всех скважин подряд
+    const std::vector<EllipsoidInstance>& instances() const { return instances_; }
+
+    /// Забыть все скважины (эллипсоиды выключены)
+    void clear();
+
+private:
+    /// Эллипсоиды одной скважины
+    struct WellEllipsoids {
+        std::uint64_t revision{0};
+        double step{0.0};
+        QRgb color{0};
+        std::vector<EllipsoidInstance> instances;
+        bool used{false};
+    };
+
+    /// Из какой версии скважины собрана часть общего массива
+    struct Source {
+        models::WellId id;
+        std::uint64_t revision{0};
+        QRgb color{0};
+
+        bool operator==(const Source&) const = default;
+    };
+
+    std::unordered_map<models::WellId, WellEllipsoids> wells_;
+    std::vector<Source> sources_;
+    double sources_step_{-1.0};
+    std::vector<EllipsoidInstance> instances_;
+};
+
+}  // namespace incline3d::views
@@ -0,0 +1,68 @@
+#include "views/update_scheduler.h"
+
+#include <utility>
+
+namespace incline3d::views {
+
+UpdateScheduler::UpdateScheduler(QObject* parent)
+    : QObject(parent) {
+    // Нулевой интервал — срабатывание после обработки уже пришедших событий
+    flush_timer_.setSingleShot(true);
+    flush_timer_.setInterval(0);
+    connect(&flush_timer_, &QTimer::timeout, this, &UpdateScheduler::flush);
+
+    idle_timer_.setSingleShot(true);
+    idle_timer_.setInterval(kRefineDelayMs);
+    connect(&idle_timer_, &QTimer::timeout, this, &UpdateScheduler::finishInteraction);
+}
+
+void UpdateScheduler::invalidate(Changes changes) {
+    if (!changes) {
+        return;
+    }
+    pending_ |= changes;
+    if (active_ && !flush_timer_.isActive()) {
+        flush_timer_.start();
+    }
+}
+
+UpdateScheduler::Changes UpdateScheduler::takePending() {
+    flush_timer_.stop();
+    return std::exchange(pending_, Changes{});
+}
+
+void UpdateScheduler::setActive(bool active) {
+    active_ = active;
+    if (!active_) {
+        flush_timer_.stop();
+        return;
+    }
+    if (!pending_) {
+        return;
+    }
+    flush_timer_.start();
+}
+
+void UpdateScheduler::interact() {
+    interacting_ = true;
+    idle_timer_.start();
+}
+
+void UpdateScheduler::flush() {
+    if (!active_ || !pending_) {
+        return;
+    }
+    emit flushRequested(std::exchange(pending_, Changes{}));
+}
+
+void UpdateScheduler::finishInteraction() {
+    interacting_ = false;
+    if (active_) {
+        emit refineRequested();
+    } else {
+        // Скрытый вид уточнится при показе
+        invalidate(kCamera);
+    }
+}
+
+}  // namespace incline3d::views
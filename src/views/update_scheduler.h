@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QFlags>
+#include <QObject>
+#include <QTimer>
+
+namespace incline3d::views {
+
+/// Отложенное обновление вида по флагам изменений
+///
+/// Источники изменений (сигналы проекта, сеттеры, мышь) только отмечают, что
+/// устарело; обработка выполняется один раз за проход цикла событий, сколько
+/// бы изменений ни пришло. Скрытый вид (неактивная вкладка) копит флаги и
+/// обрабатывает их при показе. Во время перетаскивания и прокрутки вид
+/// рисуется грубее; после паузы kRefineDelayMs испускается refineRequested().
+class UpdateScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum Change {
+        kNone = 0x0,
+        kCamera = 0x1,      ///< Положение камеры или масштаб — только перерисовка
+        kStyle = 0x2,       ///< Цвета, сетка, слои — перерисовка без перестроения сцены
+        kGeometry = 0x4,    ///< Скважины и точки — перестроение сцены
+    };
+    Q_DECLARE_FLAGS(Changes, Change)
+
+    /// Пауза после последнего движения мыши или колеса до уточнения, мс
+    static constexpr int kRefineDelayMs = 150;
+
+    /// Во сколько раз больше допуск упрощения траекторий во время взаимодействия
+    static constexpr double kInteractionDetailScale = 4.0;
+
+    explicit UpdateScheduler(QObject* parent = nullptr);
+
+    /// Отметить изменения; обработка — в следующем проходе цикла событий
+    void invalidate(Changes changes);
+
+    /// Забрать накопленные изменения (для немедленной обработки, например перед экспортом)
+    Changes takePending();
+
+    Changes pending() const { return pending_; }
+
+    /// Вид показан или скрыт; при показе накопленные изменения обрабатываются
+    void setActive(bool active);
+    bool isActive() const { return active_; }
+
+    /// Перетаскивание или прокрутка продолжается: уточнение откладывается до паузы
+    void interact();
+    bool isInteracting() const { return interacting_; }
+
+signals:
+    /// Накопленные изменения (не пустые) для обработки видом
+    void flushRequested(incline3d::views::UpdateScheduler::Changes changes);
+
+    /// Взаимодействие закончилось — вид рисуется в полной детализации
+    void refineRequested();
+
+private:
+    void flush();
+    void finishInteraction();
+
+    QTimer flush_timer_;
+    QTimer idle_timer_;
+    Changes pending_;
+    bool active_{false};
+    bool interacting_{false};
+};
+
+}  // namespace incline3d::views
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(incline3d::views::UpdateScheduler::Changes)
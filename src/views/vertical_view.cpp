@@ -4,7 +4,11 @@
 #include <QGraphicsEllipseItem>
 #include <QGraphicsTextItem>
 #include <QGraphicsLineItem>
+#include <QElapsedTimer>
+#include <QHideEvent>
 #include <QMouseEvent>
+#include <QPaintEvent>
+#include <QShowEvent>
 #include <QWheelEvent>
 #include <QPainter>
 #include <QScrollBar>
@@ -12,12 +16,15 @@
 #include <algorithm>
 
 #include "models/well_table_model.h"
+#include "views/image_tiles.h"
+#include "views/scene_stats.h"
 #include "models/project_points_model.h"
 
 namespace incline3d::views {
 
 namespace {
 constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double kMinFitMargin = 10.0;   // м
 }
 
 VerticalView::VerticalView(QWidget* parent)
@@ -37,18 +44,26 @@ VerticalView::VerticalView(QWidget* parent)
 
     setMinimumSize(400, 300);
     setBackgroundBrush(Qt::white);
+
+    // Изменения копятся и обрабатываются раз за проход цикла событий;
+    // после прокрутки и перетаскивания траектории уточняются
+    scheduler_ = new UpdateScheduler(this);
+    connect(scheduler_, &UpdateScheduler::flushRequested, this, &VerticalView::applyChanges);
+    connect(scheduler_, &UpdateScheduler::refineRequested, this, [this]() {
+        updateTrajectoryDetail();
+    });
 }
 
 VerticalView::~VerticalView() = default;
 
 void VerticalView::setWellModel(models::WellTableModel* model) {
     well_model_ = model;
-    rebuildScene();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void VerticalView::setProjectPointsModel(models::ProjectPointsModel* model) {
     project_points_model_ = model;
-    rebuildScene();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void VerticalView::setProfileAzimuth(double azimuth_deg) {
@@ -58,7 +73,7 @@ void VerticalView::setProfileAzimuth(double azimuth_deg) {
 
     if (std::abs(profile_azimuth_ - azimuth_deg) > 0.01) {
         profile_azimuth_ = azimuth_deg;
-        rebuildScene();
+        invalidate(UpdateScheduler::kGeometry);
         emit profileAzimuthChanged(profile_azimuth_);
     }
 }
@@ -77,46 +92,44 @@ void VerticalView::autoFitAzimuth() {
             continue;
         }
 
-        // Вычисляем азимут от устья до забоя
-        const auto& first = well->results.front();
-        const auto& last = well->results.back();
-
-        double delta_e = last.east_m - first.east_m;
-        double delta_n = last.north_m - first.north_m;
-
         // Азимут от устья к забою
-        double azimuth = std::atan2(delta_e, delta_n) / DEG_TO_RAD;
-        if (azimuth < 0) azimuth += 360.0;
-
-        setProfileAzimuth(azimuth);
+        setProfileAzimuth(well->results.geometry().headToTdAzimuth());
         return;
     }
 }
 
 void VerticalView::setShowGrid(bool show) {
     show_grid_ = show;
-    viewport()->update();
+    invalidate(UpdateScheduler::kStyle);
 }
 
 void VerticalView::setShowLabels(bool show) {
     show_labels_ = show;
-    rebuildScene();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void VerticalView::setGridStep(double step) {
     grid_step_ = step;
-    viewport()->update();
+    invalidate(UpdateScheduler::kStyle);
+}
+
+void VerticalView::setShowFrameStats(bool show) {
+    show_frame_stats_ = show;
+    frame_stats_.clear();
+    invalidate(UpdateScheduler::kStyle);
 }
 
 void VerticalView::fitToContent() {
-    if (scene_->items().isEmpty()) {
+    const auto content = contentBounds();
+    if (!content) {
         return;
     }
 
-    QRectF bounds = scene_->itemsBoundingRect();
-    double margin = std::max(bounds.width(), bounds.height()) * 0.1;
+    QRectF bounds = *content;
+    double margin = std::max(std::max(bounds.width(), bounds.height()) * 0.1, kMinFitMargin);
     bounds.adjust(-margin, -margin, margin, margin);
     fitInView(bounds, Qt::KeepAspectRatio);
+    updateTrajectoryDetail();
 }
 
 void VerticalView::resetView() {
@@ -125,12 +138,107 @@ void VerticalView::resetView() {
     fitToContent();
 }
 
+QImage VerticalView::renderImage(const QSize& size, const QRect& tile, bool fit_content) {
+    const QRect region = tile.isNull() ? QRect(QPoint(0, 0), size) : tile;
+    if (size.isEmpty() || region.isEmpty()) {
+        return {};
+    }
+    // Отложенные изменения — до снимка
+    applyChanges(scheduler_->takePending() |
+                 (scene_released_ ? UpdateScheduler::kGeometry : UpdateScheduler::kNone));
+
+    // Область сцены: всё содержимое с полями, как в fitToContent, или видимая в окне
+    QRectF source = mapToScene(viewport()->rect()).boundingRect();
+    if (fit_content) {
+        if (const auto content = contentBounds()) {
+            source = *content;
+            const double margin = std::max(std::max(source.width(), source.height()) * 0.1, kMinFitMargin);
+            source.adjust(-margin, -margin, margin, margin);
+        }
+    }
+    QTransform transform = fitSceneToImage(source, size, false);
+    transform *= QTransform::fromTranslate(-region.left(), -region.top());
+    const QRectF visible = transform.inverted().mapRect(QRectF(QPointF(0, 0), QSizeF(region.size())));
+
+    // Детализация траекторий — под размер пикселя изображения
+    applyTrajectoryDetail(1.0 / std::abs(transform.m11()));
+
+    QImage image(region.size(), QImage::Format_RGB32);
+    image.fill(backgroundBrush().color());
+    {
+        QPainter painter(&image);
+        painter.setRenderHints(renderHints());
+        painter.setTransform(transform);
+        if (show_grid_) {
+            drawGrid(&painter, visible);
+        }
+        scene_->render(&painter, visible, visible, Qt::IgnoreAspectRatio);
+    }
+
+    updateTrajectoryDetail();
+    return image;
+}
+
 void VerticalView::refresh() {
-    rebuildScene();
+    applyChanges(scheduler_->takePending() | UpdateScheduler::kGeometry);
+}
+
+void VerticalView::invalidate(UpdateScheduler::Changes changes) {
+    scheduler_->invalidate(changes);
+}
+
+void VerticalView::applyChanges(UpdateScheduler::Changes changes) {
+    if (changes.testFlag(UpdateScheduler::kGeometry)) {
+        rebuildScene();
+    }
+    if (changes.testFlag(UpdateScheduler::kGeometry) || changes.testFlag(UpdateScheduler::kCamera)) {
+        // Во время прокрутки и перетаскивания — грубее; уточнение после паузы
+        const double scale = scheduler_->isInteracting() ? UpdateScheduler::kInteractionDetailScale : 1.0;
+        applyTrajectoryDetail(pixelSizeM() * scale);
+    }
+    viewport()->update();
+}
+
+int VerticalView::sceneItemCount() const {
+    return static_cast<int>(scene_->items().size());
+}
+
+std::size_t VerticalView::sceneMemoryEstimate() const {
+    return estimateSceneMemory(scene_);
+}
+
+std::size_t VerticalView::releaseScene() {
+    const std::size_t bytes = sceneMemoryEstimate();
+    trajectory_items_.clear();
+    scene_->clear();
+    scene_released_ = true;
+    return bytes;
+}
+
+bool VerticalView::isSceneReleased() const {
+    return scene_released_;
+}
+
+void VerticalView::showEvent(QShowEvent* event) {
+    // Изменения, пришедшие, пока вид был скрыт, — до первого кадра
+    applyChanges(scheduler_->takePending() |
+                 (scene_released_ ? UpdateScheduler::kGeometry : UpdateScheduler::kNone));
+    scheduler_->setActive(true);
+    QGraphicsView::showEvent(event);
+}
+
+void VerticalView::hideEvent(QHideEvent* event) {
+    scheduler_->setActive(false);
+    QGraphicsView::hideEvent(event);
 }
 
 void VerticalView::rebuildScene() {
+    QElapsedTimer build_timer;
+    build_timer.start();
+
+    trajectory_items_.clear();
     scene_->clear();
+    scene_released_ = false;
 
     addWellProfiles();
     addProjectPoints();
@@ -138,6 +246,98 @@ void VerticalView::rebuildScene() {
     if (show_labels_) {
         addDepthScale();
     }
+
+    frame_stats_.addBuild(build_timer.nsecsElapsed() * 1e-6);
+    frame_stats_.setItemCount(sceneItemCount());
+}
+
+QPainterPath VerticalView::profilePath(const models::WellData& well, int lod_level) const {
+    const auto east = well.results.column(models::TrajectoryColumns::Column::kEast);
+    const auto north = well.results.column(models::TrajectoryColumns::Column::kNorth);
+    const auto tvd = well.results.column(models::TrajectoryColumns::Column::kTvd);
+    const auto& indices = well.results.lod()->level(lod_level).indices;
+
+    QPainterPath path;
+    path.moveTo(projectToProfile(east[indices.front()], north[indices.front()]), tvd[indices.front()]);
+    for (std::size_t k = 1; k < indices.size(); ++k) {
+        const auto i = indices[k];
+        path.lineTo(projectToProfile(east[i], north[i]), tvd[i]);
+    }
+    return path;
+}
+
+double VerticalView::pixelSizeM() const {
+    const double pixels_per_m = std::abs(transform().m11());
+    return pixels_per_m > 0.0 ? 1.0 / pixels_per_m : 1.0;
+}
+
+void VerticalView::updateTrajectoryDetail() {
+    applyTrajectoryDetail(pixelSizeM());
+}
+
+void VerticalView::applyTrajectoryDetail(double pixel_m) {
+    for (auto& entry : trajectory_items_) {
+        const auto well = entry.well.lock();
+        const auto lod = well ? well->results.lod() : nullptr;
+        if (!lod) {
+            continue;
+        }
+        const int level = lod->levelIndexFor(pixel_m);
+        if (level != entry.lod_level) {
+            entry.item->setPath(profilePath(*well, level));
+            entry.lod_level = level;
+        }
+    }
+}
+
+std::optional<QRectF> VerticalView::contentBounds() const {
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    bool has_content = false;
+
+    auto extend = [&](double x0, double y0, double x1, double y1) {
+        if (!has_content) {
+            min_x = x0; max_x = x1; min_y = y0; max_y = y1;
+            has_content = true;
+            return;
+        }
+        min_x = std::min(min_x, x0);
+        max_x = std::max(max_x, x1);
+        min_y = std::min(min_y, y0);
+        max_y = std::max(max_y, y1);
+    };
+
+    if (well_model_) {
+        for (int i = 0; i < well_model_->wellCount(); ++i) {
+            auto well = well_model_->wellAt(i);
+            if (!well || !well->visible) {
+                continue;
+            }
+            const auto geometry = well->results.geometry();
+            if (geometry.valid) {
+                const auto [x0, x1] = geometry.profileRange(profile_azimuth_);
+                extend(x0, geometry.min_tvd, x1, geometry.max_tvd);
+            }
+        }
+    }
+
+    if (project_points_model_) {
+        for (int i = 0; i < project_points_model_->pointCount(); ++i) {
+            const auto& pt = project_points_model_->pointAt(i);
+            if (pt.visible) {
+                const double x = projectToProfile(pt.fact_east_m, pt.fact_north_m);
+                const double r = std::max(pt.radius_m, 0.0);
+                extend(x - r, pt.fact_tvd_m, x + r, pt.fact_tvd_m);
+            }
+        }
+    }
+
+    if (!has_content) {
+        return std::nullopt;
+    }
+    return QRectF(QPointF(min_x, min_y), QPointF(max_x, max_y));
 }
 
 double VerticalView::projectToProfile(double east, double north) const {
@@ -157,6 +357,8 @@ void VerticalView::wheelEvent(QWheelEvent* event) {
     double factor = (event->angleDelta().y() > 0) ? 1.15 : 1.0 / 1.15;
     scale(factor, factor);
     scale_factor_ *= factor;
+    scheduler_->interact();
+    invalidate(UpdateScheduler::kCamera);
     event->accept();
 }
 
@@ -178,6 +380,8 @@ void VerticalView::mouseMoveEvent(QMouseEvent* event) {
 
         horizontalScrollBar()->setValue(horizontalScrollBar()->value() - delta.x());
         verticalScrollBar()->setValue(verticalScrollBar()->value() - delta.y());
+        scheduler_->interact();
+        invalidate(UpdateScheduler::kCamera);
         event->accept();
     } else {
         QGraphicsView::mouseMoveEvent(event);
@@ -195,11 +399,43 @@ void VerticalView::mouseReleaseEvent(QMouseEvent* event) {
 }
 
 void VerticalView::drawBackground(QPainter* painter, const QRectF& rect) {
+    QElapsedTimer background_timer;
+    background_timer.start();
+
     QGraphicsView::drawBackground(painter, rect);
 
     if (show_grid_) {
         drawGrid(painter, rect);
     }
+
+    frame_sample_.background_ms = background_timer.nsecsElapsed() * 1e-6;
+}
+
+void VerticalView::paintEvent(QPaintEvent* event) {
+    QElapsedTimer frame_timer;
+    frame_timer.start();
+    frame_sample_ = {};
+
+    QGraphicsView::paintEvent(event);
+
+    // Траектории в видимой области: по элементу и вершинам пути на каждую
+    const QRectF visible = mapToScene(viewport()->rect()).boundingRect();
+    for (const auto& entry : trajectory_items_) {
+        if (entry.item->isVisible() && entry.item->sceneBoundingRect().intersects(visible)) {
+            ++frame_sample_.draw_calls;
+            frame_sample_.vertices += static_cast<std::size_t>(entry.item->path().elementCount());
+        }
+    }
+    frame_sample_.cpu_ms = frame_timer.nsecsElapsed() * 1e-6;
+    frame_stats_.addFrame(frame_sample_);
+}
+
+void VerticalView::drawForeground(QPainter* painter, const QRectF& rect) {
+    QGraphicsView::drawForeground(painter, rect);
+
+    if (show_frame_stats_) {
+        drawFrameStatsOverlay(*painter, viewport()->rect(), frame_stats_.summary());
+    }
 }
 
 void VerticalView::drawGrid(QPainter* painter, const QRectF& rect) {
@@ -209,6 +445,7 @@ void VerticalView::drawGrid(QPainter* painter, const QRectF& rect) {
     painter->setPen(gridPen);
 
     double step = grid_step_;
+    int lines = 0;
 
     double left = std::floor(rect.left() / step) * step;
     double right = std::ceil(rect.right() / step) * step;
@@ -217,11 +454,13 @@ void VerticalView::drawGrid(QPainter* painter, const QRectF& rect) {
 
     // Вертикальные линии (смещение по профилю)
     for (double x = left; x <= right; x += step) {
+        ++lines;
         painter->drawLine(QPointF(x, top), QPointF(x, bottom));
     }
 
     // Горизонтальные линии (глубина)
     for (double y = top; y <= bottom; y += step) {
+        ++lines;
         painter->drawLine(QPointF(left, y), QPointF(right, y));
     }
 
@@ -234,6 +473,9 @@ void VerticalView::drawGrid(QPainter* painter, const QRectF& rect) {
     // Нулевая глубина
     painter->drawLine(QPointF(left, 0), QPointF(right, 0));
 
+    frame_sample_.draw_calls += lines;
+    frame_sample_.vertices += 2 * static_cast<std::size_t>(lines);
+
     painter->restore();
 }
 
@@ -246,24 +488,17 @@ void VerticalView::addWellProfiles() {
             continue;
         }
 
-        // Строим путь профиля
-        QPainterPath path;
-        bool first = true;
+        const auto east = well->results.column(models::TrajectoryColumns::Column::kEast);
+        const auto north = well->results.column(models::TrajectoryColumns::Column::kNorth);
+        const auto tvd = well->results.column(models::TrajectoryColumns::Column::kTvd);
 
-        for (const auto& pt : well->results) {
-            // X = проекция на профиль, Y = TVD (глубина вниз)
-            double x = projectToProfile(pt.east_m, pt.north_m);
-            double y = pt.tvd_m;
+        // Строим путь профиля: X = проекция на профиль, Y = TVD (глубина вниз).
+        // Проекция не увеличивает отклонение упрощённой траектории, поэтому
+        // уровень детализации выбирается по размеру пикселя, как в плане
+        const int level = well->results.lod()->levelIndexFor(pixelSizeM());
 
-            if (first) {
-                path.moveTo(x, y);
-                first = false;
-            } else {
-                path.lineTo(x, y);
-            }
-        }
-
-        auto* pathItem = new QGraphicsPathItem(path);
+        auto* pathItem = new QGraphicsPathItem(profilePath(*well, level));
+        trajectory_items_.push_back({pathItem, well, level});
         QPen pen(well->display_color, well->line_width);
         pen.setCosmetic(true);
         pathItem->setPen(pen);
@@ -271,9 +506,9 @@ void VerticalView::addWellProfiles() {
         scene_->addItem(pathItem);
 
         // Точки замеров
-        for (const auto& pt : well->results) {
-            double x = projectToProfile(pt.east_m, pt.north_m);
-            double y = pt.tvd_m;
+        for (size_t k = 0; k < tvd.size(); ++k) {
+            double x = projectToProfile(east[k], north[k]);
+            double y = tvd[k];
 
             auto* point = new QGraphicsEllipseItem(x - 2, y - 2, 4, 4);
             point->setBrush(well->display_color);
@@ -283,13 +518,12 @@ void VerticalView::addWellProfiles() {
         }
 
         // Подпись скважины
-        if (show_labels_ && !well->results.empty()) {
-            const auto& first_pt = well->results.front();
-            double x = projectToProfile(first_pt.east_m, first_pt.north_m);
+        if (show_labels_) {
+            double x = projectToProfile(east[0], north[0]);
 
             auto* label = new QGraphicsTextItem(
                 QString::fromStdString(well->metadata.well_name));
-            label->setPos(x + 5, first_pt.tvd_m - 15);
+            label->setPos(x + 5, tvd[0] - 15);
             label->setDefaultTextColor(well->display_color);
             label->setFlag(QGraphicsItem::ItemIgnoresTransformations);
 
@@ -342,8 +576,9 @@ void VerticalView::addProjectPoints() {
 
 void VerticalView::addDepthScale() {
     // Добавляем шкалу глубины слева
-    QRectF bounds = scene_->itemsBoundingRect();
-    if (bounds.isEmpty()) return;
+    const auto content = contentBounds();
+    if (!content) return;
+    const QRectF bounds = *content;
 
     double step = grid_step_;
     double min_depth = std::floor(bounds.top() / step) * step;
@@ -2,8 +2,21 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
+#include <QImage>
+#include <QPainterPath>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "views/frame_stats.h"
+#include "views/update_scheduler.h"
+
+class QGraphicsPathItem;
 
 namespace incline3d::models {
+struct WellData;
 class WellTableModel;
 class ProjectPointsModel;
 }  // namespace incline3d::models
@@ -38,6 +51,37 @@ public:
     void fitToContent();
     void resetView();
 
+    /// Отрисовать вид в изображение без окна (QPainter в QImage)
+    /// @param size размер всего изображения, пиксели
+    /// @param tile часть изображения (пустой — всё изображение)
+    /// @param fit_content вписать всё содержимое; иначе — область, видимая в окне
+    QImage renderImage(const QSize& size, const QRect& tile = {}, bool fit_content = false);
+
+    /// Показывать поверх вида панель статистики кадров
+    void setShowFrameStats(bool show);
+    bool showFrameStats() const { return show_frame_stats_; }
+
+    /// Время кадров и построения сцены за последние кадры
+    const FrameStats& frameStats() const { return frame_stats_; }
+
+    // --- Учёт памяти ---
+
+    /// Число элементов сцены
+    int sceneItemCount() const;
+
+    /// Оценка памяти элементов сцены, байт
+    std::size_t sceneMemoryEstimate() const;
+
+    /// Освободить элементы сцены; сцена перестраивается при следующем показе
+    /// @return оценка освобождённой памяти, байт
+    std::size_t releaseScene();
+
+    bool isSceneReleased() const;
+
+    /// Отметить изменения; обработка — один раз за проход цикла событий,
+    /// у скрытого вида — при показе
+    void invalidate(UpdateScheduler::Changes changes);
+
 public slots:
     void refresh();
 
@@ -45,14 +89,21 @@ signals:
     void profileAzimuthChanged(double azimuth_deg);
 
 protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
     void drawBackground(QPainter* painter, const QRectF& rect) override;
+    void drawForeground(QPainter* painter, const QRectF& rect) override;
 
 private:
     void rebuildScene();
+
+    /// Обработать накопленные изменения: перестроить сцену, сменить детализацию, перерисовать
+    void applyChanges(UpdateScheduler::Changes changes);
     void drawGrid(QPainter* painter, const QRectF& rect);
     void addWellProfiles();
     void addProjectPoints();
@@ -61,7 +112,37 @@ private:
     /// Проецировать точку (east, north) на профиль с заданным азимутом
     double projectToProfile(double east, double north) const;
 
+    /// Габариты содержимого по сводной геометрии скважин и точкам (без обхода сцены)
+    std::optional<QRectF> contentBounds() const;
+
+    /// Путь профиля скважины по уровню детализации (X = проекция на профиль, Y = TVD)
+    QPainterPath profilePath(const models::WellData& well, int lod_level) const;
+
+    /// Размер пикселя в метрах при текущем масштабе
+    double pixelSizeM() const;
+
+    /// Сменить уровень детализации профилей после изменения масштаба
+    void updateTrajectoryDetail();
+
+    /// Выбрать уровень детализации профилей под размер пикселя, м
+    void applyTrajectoryDetail(double pixel_m);
+
+    /// Профиль на сцене и выбранный для него уровень детализации
+    struct TrajectoryItem {
+        QGraphicsPathItem* item{nullptr};
+        std::weak_ptr<models::WellData> well;
+        int lod_level{0};
+    };
+
     QGraphicsScene* scene_{nullptr};
+    UpdateScheduler* scheduler_{nullptr};
+    bool scene_released_{false};
+    std::vector<TrajectoryItem> trajectory_items_;
+
+    // Статистика кадров: счётчики текущего кадра заполняются в drawBackground
+    FrameStats frame_stats_;
+    bool show_frame_stats_{false};
+    FrameSample frame_sample_;
 
     models::WellTableModel* well_model_{nullptr};
     models::ProjectPointsModel* project_points_model_{nullptr};
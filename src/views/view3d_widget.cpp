@@ -1,42 +1,180 @@
 #include "views/view3d_widget.h"
 
+#include <QElapsedTimer>
+#include <QHideEvent>
 #include <QMouseEvent>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QPainter>
+#include <QShowEvent>
+#include <QSurfaceFormat>
+#include <QtMath>
+#include <QToolTip>
 #include <QWheelEvent>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "models/well_table_model.h"
 #include "models/project_points_model.h"
 #include "models/shot_points_model.h"
+#include "utils/logger.h"
+#include "views/image_tiles.h"
+#include "views/offscreen_context.h"
 
 namespace incline3d::views {
 
+namespace {
+constexpr float kFieldOfViewDeg = 45.0f;
+constexpr float kNearPlane = 0.1f;
+constexpr float kFarPlane = 10000.0f;
+
+/// Расстояние от камеры до точки вращения при масштабе 1, м
+constexpr float kCameraDistance = 1000.0f;
+
+/// Допуск выбора траектории курсором, пиксели
+constexpr double kPickRadiusPx = 6.0;
+
+ColoredVertex makeVertex(double x, double y, double z, const QColor& color, float alpha = 1.0f) {
+    return {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z),
+            static_cast<float>(color.redF()), static_cast<float>(color.greenF()),
+            static_cast<float>(color.blueF()), alpha};
+}
+}  // namespace
+
 View3DWidget::View3DWidget(QWidget* parent)
     : QOpenGLWidget(parent) {
     setMinimumSize(400, 300);
+    setMouseTracking(true);     // Подсказка по наведению на траекторию
+
+    // Изменения копятся и обрабатываются раз за проход цикла событий
+    scheduler_ = new UpdateScheduler(this);
+    connect(scheduler_, &UpdateScheduler::flushRequested, this, &View3DWidget::applyChanges);
+    connect(scheduler_, &UpdateScheduler::refineRequested, this, qOverload<>(&View3DWidget::update));
+
+    // Трубки строятся в фоне; готовая сетка появляется со следующим кадром
+    tube_builder_ = new TubeBuilder(this);
+    connect(tube_builder_, &TubeBuilder::meshReady, this, [this]() {
+        invalidate(UpdateScheduler::kGeometry);
+    });
+
+    // Шейдерный конвейер рассчитан на OpenGL 3.3 core (есть и в Mesa llvmpipe)
+    QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+    setFormat(format);
+}
+
+View3DWidget::~View3DWidget() {
+    cleanupGL();
 }
 
 void View3DWidget::setWellModel(models::WellTableModel* model) {
     well_model_ = model;
-    update();
+    invalidate(UpdateScheduler::kGeometry);
 }
 
 void View3DWidget::setProjectPointsModel(models::ProjectPointsModel* model) {
+    if (project_points_model_) {
+        disconnect(project_points_model_, nullptr, this, nullptr);
+    }
     project_points_model_ = model;
-    update();
+    watchMarkerModel(model);
+    invalidateMarkers();
 }
 
 void View3DWidget::setShotPointsModel(models::ShotPointsModel* model) {
+    if (shot_points_model_) {
+        disconnect(shot_points_model_, nullptr, this, nullptr);
+    }
     shot_points_model_ = model;
+    watchMarkerModel(model);
+    invalidateMarkers();
+}
+
+void View3DWidget::watchMarkerModel(QAbstractItemModel* model) {
+    if (!model) return;
+    connect(model, &QAbstractItemModel::dataChanged, this, &View3DWidget::invalidateMarkers);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &View3DWidget::invalidateMarkers);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &View3DWidget::invalidateMarkers);
+    connect(model, &QAbstractItemModel::modelReset, this, &View3DWidget::invalidateMarkers);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &View3DWidget::invalidateMarkers);
+}
+
+void View3DWidget::invalidateMarkers() {
+    markers_dirty_ = true;
+    horizons_dirty_ = true;
+    pick_index_ = {};   // Не удерживать удалённые скважины до следующего выбора
+    invalidate(UpdateScheduler::kGeometry);
+}
+
+void View3DWidget::invalidate(UpdateScheduler::Changes changes) {
+    scheduler_->invalidate(changes);
+}
+
+void View3DWidget::applyChanges(UpdateScheduler::Changes changes) {
+    // Траектории и трубки сверяются с версиями результатов при отрисовке,
+    // маркеры — по markers_dirty_: любое изменение сводится к одному кадру
+    Q_UNUSED(changes)
     update();
 }
 
+void View3DWidget::interactCamera() {
+    scheduler_->interact();
+    invalidate(UpdateScheduler::kCamera);
+}
+
+void View3DWidget::showEvent(QShowEvent* event) {
+    QOpenGLWidget::showEvent(event);
+    scheduler_->setActive(true);
+}
+
+void View3DWidget::hideEvent(QHideEvent* event) {
+    scheduler_->setActive(false);
+    QOpenGLWidget::hideEvent(event);
+}
+
 void View3DWidget::resetView() {
     rotation_x_ = 30.0;
     rotation_y_ = -45.0;
     rotation_z_ = 0.0;
     scale_ = 1.0;
     pan_ = QVector3D(0, 0, 0);
-    update();
+    target_ = QVector3D(0, 0, 0);
+    invalidate(UpdateScheduler::kCamera);
+}
+
+void View3DWidget::fitToContent() {
+    if (!well_model_) {
+        return;
+    }
+
+    bool has_content = false;
+    QVector3D lo;
+    QVector3D hi;
+    for (const auto* well : visibleWells()) {
+        const auto geometry = well->results.geometry();
+        if (!geometry.valid) {
+            continue;
+        }
+        const QVector3D a(geometry.min_east, geometry.min_north, -geometry.max_tvd);
+        const QVector3D b(geometry.max_east, geometry.max_north, -geometry.min_tvd);
+        lo = has_content ? QVector3D(std::min(lo.x(), a.x()), std::min(lo.y(), a.y()), std::min(lo.z(), a.z())) : a;
+        hi = has_content ? QVector3D(std::max(hi.x(), b.x()), std::max(hi.y(), b.y()), std::max(hi.z(), b.z())) : b;
+        has_content = true;
+    }
+    if (!has_content) {
+        return;
+    }
+
+    // Описанная сфера габаритов целиком входит в поле зрения
+    const float radius = std::max(0.5f * (hi - lo).length(), 1.0f);
+    const float distance = radius / std::sin(qDegreesToRadians(kFieldOfViewDeg) / 2.0f);
+    target_ = (lo + hi) / 2.0f;
+    pan_ = QVector3D(0, 0, 0);
+    scale_ = distance / kCameraDistance;
+    invalidate(UpdateScheduler::kCamera);
 }
 
 ViewSettings& View3DWidget::settings() {
@@ -47,24 +185,56 @@ const ViewSettings& View3DWidget::settings() const {
     return settings_;
 }
 
+void View3DWidget::setShowFrameStats(bool show) {
+    show_frame_stats_ = show;
+    frame_stats_.clear();
+    invalidate(UpdateScheduler::kStyle);
+}
+
+std::size_t View3DWidget::wellRenderMemory(models::WellId id) const {
+    return renderer_.wellMemoryUsage(id);
+}
+
+std::size_t View3DWidget::tubeMeshMemory() const {
+    return tube_builder_->memoryUsage();
+}
+
+int View3DWidget::tubeMeshCount() const {
+    return tube_builder_->meshCount();
+}
+
+std::size_t View3DWidget::releaseCaches() {
+    // Видимый вид сам забывает в каждом кадре то, что в нём не нарисовано
+    if (isVisible()) {
+        return 0;
+    }
+    std::size_t freed = tube_builder_->release();
+    if (renderer_.isInitialized()) {
+        makeCurrent();
+        freed += renderer_.releaseWellData();
+        doneCurrent();
+    }
+    return freed;
+}
+
 void View3DWidget::setRotationX(double angle) {
     rotation_x_ = angle;
-    update();
+    invalidate(UpdateScheduler::kCamera);
 }
 
 void View3DWidget::setRotationY(double angle) {
     rotation_y_ = angle;
-    update();
+    invalidate(UpdateScheduler::kCamera);
 }
 
 void View3DWidget::setRotationZ(double angle) {
     rotation_z_ = angle;
-    update();
+    invalidate(UpdateScheduler::kCamera);
 }
 
 void View3DWidget::setScale(double scale) {
     scale_ = scale;
-    update();
+    invalidate(UpdateScheduler::kCamera);
 }
 
 void View3DWidget::initializeGL() {
@@ -73,6 +243,24 @@ void View3DWidget::initializeGL() {
     glEnable(GL_LINE_SMOOTH);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Ресурсы освобождаются до разрушения контекста (в т.ч. при смене окна)
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &View3DWidget::cleanupGL);
+    renderer_.initialize();
+    markers_dirty_ = true;
+    atlas_font_size_ = 0;
+    uncertainty_.clear();
+    horizons_.clear();
+    horizons_dirty_ = true;
+}
+
+void View3DWidget::cleanupGL() {
+    if (!renderer_.isInitialized()) {
+        return;
+    }
+    makeCurrent();
+    renderer_.release();
+    doneCurrent();
 }
 
 void View3DWidget::resizeGL(int w, int h) {
@@ -83,179 +271,481 @@ void View3DWidget::resizeGL(int w, int h) {
 void View3DWidget::updateProjectionMatrix() {
     projection_matrix_.setToIdentity();
     float aspect = static_cast<float>(width()) / std::max(1, height());
-    projection_matrix_.perspective(45.0f, aspect, 0.1f, 10000.0f);
+    projection_matrix_.perspective(kFieldOfViewDeg, aspect, kNearPlane, kFarPlane);
 }
 
 void View3DWidget::paintGL() {
+    QElapsedTimer frame_timer;
+    frame_timer.start();
+
     const auto& bg = settings_.background_color;
     glClearColor(bg.redF(), bg.greenF(), bg.blueF(), 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // Настройка матрицы вида
-    view_matrix_.setToIdentity();
-    view_matrix_.translate(pan_.x(), pan_.y(), -1000.0f * scale_);
-    view_matrix_.rotate(rotation_x_, 1, 0, 0);
-    view_matrix_.rotate(rotation_y_, 0, 1, 0);
-    view_matrix_.rotate(rotation_z_, 0, 0, 1);
-
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(projection_matrix_.constData());
+    view_matrix_ = cameraViewMatrix();
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(view_matrix_.constData());
+    if (!renderer_.isInitialized()) {
+        return;
+    }
+    if (show_frame_stats_) {
+        // Панель рисуется через QPainter, который меняет состояние OpenGL
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    // Во время вращения и прокрутки — грубее; после паузы кадр перерисовывается полностью
+    renderer_.setDetailScale(scheduler_->isInteracting() ? UpdateScheduler::kInteractionDetailScale : 1.0);
+    renderer_.beginFrame(projection_matrix_, view_matrix_,
+                         QSizeF(width(), height()) * devicePixelRatioF());
 
     if (settings_.show_grid) {
-        drawGrid();
+        renderer_.drawGrid(settings_.grid_color, static_cast<float>(settings_.grid_step));
     }
 
     if (settings_.show_axes) {
-        drawAxes();
+        drawAxes(renderer_);
     }
 
     drawWells();
+    drawHorizons();
+    drawUncertainty();
+
+    // Проектные точки, круги допуска и пункты возбуждения — один вызов
+    updateMarkers();
+    renderer_.drawMarkers();
+
+    // Подписи — поверх сцены
+    drawDepthLabels();
+
+    renderer_.endFrame();
+
+    FrameSample sample;
+    sample.cpu_ms = frame_timer.nsecsElapsed() * 1e-6;
+    sample.gpu_ms = renderer_.takeGpuFrameTimeMs();
+    sample.draw_calls = renderer_.counters().draw_calls;
+    sample.vertices = renderer_.counters().vertices;
+    frame_stats_.addFrame(sample);
+    frame_stats_.setItemCount(drawn_well_count_ + marker_count_ + horizons_.surfaceCount() +
+                              static_cast<int>(uncertainty_.instances().size() + glyphs_.size()));
+
+    if (show_frame_stats_) {
+        QPainter painter(this);
+        drawFrameStatsOverlay(painter, rect(), frame_stats_.summary());
+    }
+}
 
-    if (settings_.show_project_points) {
-        drawProjectPoints();
+QMatrix4x4 View3DWidget::cameraViewMatrix() const {
+    QMatrix4x4 view;
+    view.translate(pan_.x(), pan_.y(), -kCameraDistance * scale_);
+    view.rotate(rotation_x_, 1, 0, 0);
+    view.rotate(rotation_y_, 0, 1, 0);
+    view.rotate(rotation_z_, 0, 0, 1);
+    view.translate(-target_);
+    return view;
+}
+
+QImage View3DWidget::renderImage(const QSize& size, const QRect& tile) {
+    const QRect region = tile.isNull() ? QRect(QPoint(0, 0), size) : tile;
+    if (size.isEmpty() || region.isEmpty()) {
+        return {};
     }
 
-    if (settings_.show_shot_points) {
-        drawShotPoints();
+    OffscreenContext gl;
+    if (!gl.create()) {
+        return {};
+    }
+    Scene3DRenderer renderer;
+    if (!renderer.initialize()) {
+        return {};
+    }
+    auto* functions = gl.context()->functions();
+    functions->glEnable(GL_DEPTH_TEST);
+    functions->glEnable(GL_BLEND);
+    functions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Камера та же, что на экране; пропорции — по всему изображению
+    const QMatrix4x4 view = cameraViewMatrix();
+    QMatrix4x4 projection;
+    projection.perspective(kFieldOfViewDeg, static_cast<float>(size.width()) / size.height(),
+                           kNearPlane, kFarPlane);
+
+    std::vector<MarkerInstance> markers;
+    collectMarkers(markers);
+    renderer.setMarkers(markers);
+
+    std::vector<WellDrawItem> lines;
+    std::vector<TubeDrawItem> tubes;
+    collectWellItems(lines, tubes, true);
+
+    if (settings_.show_horizons && project_points_model_) {
+        HorizonLayer horizons;
+        horizons.update(project_points_model_->points(), settings_.horizon_grid_step);
+        renderer.setSurfaces(horizons.vertices(), horizons.indices());
+    }
+    if (settings_.show_uncertainty) {
+        UncertaintyLayer uncertainty;
+        uncertainty.update(visibleWells(), settings_.uncertainty_step);
+        renderer.setEllipsoids(uncertainty.instances());
     }
-}
 
-void View3DWidget::drawGrid() {
-    const auto& c = settings_.grid_color;
-    glColor4f(c.redF(), c.greenF(), c.blueF(), 0.5f);
-    glLineWidth(1.0f);
+    // Подписи раскладываются один раз на всё изображение: на стыках плиток
+    // они не пропадают и не дублируются
+    std::vector<GlyphInstance> glyphs;
+    if (settings_.show_depth_labels && settings_.depth_label_step > 0.0) {
+        QFont label_font = font();
+        label_font.setPointSize(settings_.depth_label_font_size);
+        DepthLabelLayer labels;
+        labels.setAtlas(GlyphAtlas::build(label_font, 1.0));
+        renderer.setGlyphAtlas(labels.atlas().image());
+        labels.layout(visibleWells(), settings_.depth_label_mode, settings_.depth_label_step,
+                      projection * view, QSizeF(size), depthLabelColor(), glyphs);
+    }
 
-    double step = settings_.grid_step;
-    int n = settings_.grid_divisions;
-    double size = step * n;
+    const auto& bg = settings_.background_color;
+    QImage image(region.size(), QImage::Format_RGB32);
+    image.fill(bg);
+    QPainter painter(&image);
+
+    QOpenGLFramebufferObjectFormat fbo_format;
+    fbo_format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    fbo_format.setSamples(4);
+
+    // Плитки кадрового буфера внутри запрошенной части изображения
+    for (QRect part : splitIntoTiles(region.size(), gl.maxTileSize())) {
+        part.translate(region.topLeft());
+        QOpenGLFramebufferObject fbo(part.size(), fbo_format);
+        if (!fbo.isValid() || !fbo.bind()) {
+            LOG_ERROR(tr("Не удалось создать кадровый буфер %1×%2").arg(part.width()).arg(part.height()));
+            renderer.release();
+            return {};
+        }
+        functions->glViewport(0, 0, part.width(), part.height());
+        functions->glClearColor(bg.redF(), bg.greenF(), bg.blueF(), 1.0f);
+        functions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glBegin(GL_LINES);
-    for (int i = -n; i <= n; ++i) {
-        glVertex3f(i * step, -size, 0);
-        glVertex3f(i * step, size, 0);
-        glVertex3f(-size, i * step, 0);
-        glVertex3f(size, i * step, 0);
+        renderer.beginFrame(tileProjection(projection, size, part), view, QSizeF(part.size()));
+        if (settings_.show_grid) {
+            renderer.drawGrid(settings_.grid_color, static_cast<float>(settings_.grid_step));
+        }
+        if (settings_.show_axes) {
+            drawAxes(renderer);
+        }
+        renderer.drawTubes(tubes, static_cast<float>(settings_.tube_color_max));
+        renderer.drawWells(lines);
+        renderer.drawSurfaces();
+        renderer.drawEllipsoids();
+        renderer.drawMarkers();
+        renderer.drawGlyphs(glyphs);
+        renderer.endFrame();
+
+        fbo.release();
+        painter.drawImage(part.topLeft() - region.topLeft(), fbo.toImage());
     }
-    glEnd();
+
+    renderer.release();
+    return image;
 }
 
-void View3DWidget::drawAxes() {
+void View3DWidget::drawAxes(Scene3DRenderer& renderer) {
     double len = settings_.axis_length;
-    glLineWidth(2.0f);
-
-    // X - красный (восток)
-    glColor3f(1, 0, 0);
-    glBegin(GL_LINES);
-    glVertex3f(0, 0, 0);
-    glVertex3f(len, 0, 0);
-    glEnd();
-
-    // Y - зелёный (север)
-    glColor3f(0, 1, 0);
-    glBegin(GL_LINES);
-    glVertex3f(0, 0, 0);
-    glVertex3f(0, len, 0);
-    glEnd();
-
-    // Z - синий (глубина вниз)
-    glColor3f(0, 0, 1);
-    glBegin(GL_LINES);
-    glVertex3f(0, 0, 0);
-    glVertex3f(0, 0, -len);
-    glEnd();
+
+    // X - красный (восток), Y - зелёный (север), Z - синий (глубина вниз)
+    const ColoredVertex vertices[] = {
+        makeVertex(0, 0, 0, Qt::red), makeVertex(len, 0, 0, Qt::red),
+        makeVertex(0, 0, 0, Qt::green), makeVertex(0, len, 0, Qt::green),
+        makeVertex(0, 0, 0, Qt::blue), makeVertex(0, 0, -len, Qt::blue),
+    };
+    renderer.drawVertices(GL_LINES, vertices, 2.0f);
+}
+
+std::vector<const models::WellData*> View3DWidget::visibleWells() const {
+    std::vector<const models::WellData*> wells;
+    if (!well_model_) {
+        return wells;
+    }
+    wells.reserve(well_model_->wellCount());
+    for (const auto& well : well_model_->wells()) {
+        if (well && well->visible && !well->results.empty()) {
+            wells.push_back(well.get());
+        }
+    }
+    return wells;
+}
+
+void View3DWidget::collectWellItems(std::vector<WellDrawItem>& lines, std::vector<TubeDrawItem>& tubes,
+                                    bool wait_for_tubes) {
+    const bool tube_mode = settings_.well_display_mode == WellDisplayMode::kTubes;
+    const TubeParams tube_params{settings_.tube_radius, settings_.tube_coloring};
+
+    const auto wells = visibleWells();
+    lines.reserve(wells.size());
+    for (const auto* well : wells) {
+        if (tube_mode) {
+            // Пока сетка строится, скважина рисуется линией
+            auto mesh = wait_for_tubes
+                            ? std::make_shared<const TubeMesh>(TubeMesh::build(well->results, tube_params))
+                            : tube_builder_->mesh(*well, tube_params);
+            if (mesh && !mesh->empty()) {
+                tubes.push_back({well->id, std::move(mesh)});
+                continue;
+            }
+        }
+        lines.push_back({well});
+    }
 }
 
 void View3DWidget::drawWells() {
     if (!well_model_) return;
 
-    for (int i = 0; i < well_model_->wellCount(); ++i) {
-        auto well = well_model_->wellAt(i);
-        if (!well || !well->visible || well->results.empty()) {
-            continue;
+    std::vector<WellDrawItem> items;
+    std::vector<TubeDrawItem> tube_items;
+    collectWellItems(items, tube_items, false);
+    tube_builder_->prune();
+    drawn_well_count_ = static_cast<int>(items.size() + tube_items.size());
+
+    // Все трубки — одним вызовом; видимые участки линий — вторым, уровень
+    // детализации рендерер выбирает по расстоянию до каждого участка
+    renderer_.drawTubes(tube_items, static_cast<float>(settings_.tube_color_max));
+    renderer_.drawWells(items);
+}
+
+void View3DWidget::drawHorizons() {
+    if (!project_points_model_ || !settings_.show_horizons) {
+        if (horizons_.surfaceCount() > 0) {
+            renderer_.setSurfaces({}, {});
         }
+        horizons_.clear();
+        horizons_dirty_ = true;
+        return;
+    }
+
+    // Поверхность пласта перестраивается, только если изменились его точки
+    if (horizons_dirty_) {
+        horizons_dirty_ = false;
+        if (horizons_.update(project_points_model_->points(), settings_.horizon_grid_step)) {
+            renderer_.setSurfaces(horizons_.vertices(), horizons_.indices());
+        }
+    }
+    renderer_.drawSurfaces();
+}
+
+void View3DWidget::drawUncertainty() {
+    if (!well_model_ || !settings_.show_uncertainty) {
+        if (!uncertainty_.instances().empty()) {
+            renderer_.setEllipsoids({});
+        }
+        uncertainty_.clear();
+        return;
+    }
+
+    // Вращение и масштаб буфер не трогают: экземпляры меняются только с данными
+    if (uncertainty_.update(visibleWells(), settings_.uncertainty_step)) {
+        renderer_.setEllipsoids(uncertainty_.instances());
+    }
+    renderer_.drawEllipsoids();
+}
+
+std::optional<View3DWidget::TrajectoryPick> View3DWidget::pickTrajectory(const QPointF& pos) const {
+    if (!well_model_ || width() <= 0 || height() <= 0) {
+        return std::nullopt;
+    }
 
-        const auto& color = well->display_color;
-        glColor3f(color.redF(), color.greenF(), color.blueF());
-        glLineWidth(well->line_width);
+    // Луч от ближней до дальней плоскости через точку под курсором
+    const QRect viewport(0, 0, width(), height());
+    const float window_y = static_cast<float>(height() - pos.y());
+    const QVector3D near_point = QVector3D(static_cast<float>(pos.x()), window_y, 0.0f)
+                                     .unproject(view_matrix_, projection_matrix_, viewport);
+    const QVector3D far_point = QVector3D(static_cast<float>(pos.x()), window_y, 1.0f)
+                                    .unproject(view_matrix_, projection_matrix_, viewport);
+    const QVector3D direction = (far_point - near_point).normalized();
+    if (direction.isNull()) {
+        return std::nullopt;
+    }
 
-        glBegin(GL_LINE_STRIP);
-        for (const auto& pt : well->results) {
-            // X = восток, Y = север, Z = -TVD (глубина вниз)
-            glVertex3f(pt.east_m, pt.north_m, -pt.tvd_m);
+    // Сцена: X — восток, Y — север, Z — минус TVD
+    models::PickRay ray;
+    ray.origin = {near_point.x(), near_point.y(), -near_point.z()};
+    ray.direction = {direction.x(), direction.y(), -direction.z()};
+
+    // Допуск в пикселях растёт с расстоянием от камеры (начало луча — на ближней плоскости)
+    const double pixel_size_per_m = 2.0 * std::tan(kFieldOfViewDeg * 0.5 * 3.14159265358979323846 / 180.0) /
+                               height();
+    ray.radius_per_m = kPickRadiusPx * pixel_size_per_m;
+    ray.radius_m = ray.radius_per_m * kNearPlane;
+
+    const PickIndex& index = pickIndex();
+    const auto hit = index.bvh.pick(ray, [&index, &ray](std::uint32_t item) -> std::optional<models::SegmentHit> {
+        const auto bvh = index.wells[item]->results.segmentBvh();
+        return bvh ? bvh->pick(ray) : std::nullopt;
+    });
+    if (!hit) {
+        return std::nullopt;
+    }
+    return TrajectoryPick{index.wells[hit->item], hit->hit};
+}
+
+const View3DWidget::PickIndex& View3DWidget::pickIndex() const {
+    // Сверка с версиями, как у буферов траекторий: O(n) сравнений чисел на запрос,
+    // дерево перестраивается только при изменении видимости, состава или результатов
+    std::size_t count = 0;
+    bool current = true;
+    for (const auto& well : well_model_->wells()) {
+        if (!well || !well->visible || well->results.empty()) {
+            continue;
+        }
+        if (count >= pick_index_.wells.size() || pick_index_.wells[count] != well ||
+            pick_index_.revisions[count] != well->results.revision()) {
+            current = false;
+            break;
         }
-        glEnd();
+        ++count;
+    }
+    if (current && count == pick_index_.wells.size()) {
+        return pick_index_;
+    }
 
-        // Точки замеров
-        glPointSize(4.0f);
-        glBegin(GL_POINTS);
-        for (const auto& pt : well->results) {
-            glVertex3f(pt.east_m, pt.north_m, -pt.tvd_m);
+    pick_index_ = {};
+    std::vector<models::TrajectoryBvh::Bounds> bounds;
+    for (const auto& well : well_model_->wells()) {
+        if (!well || !well->visible || well->results.empty()) {
+            continue;
         }
-        glEnd();
+        const auto geometry = well->results.geometry();
+        pick_index_.wells.push_back(well);
+        pick_index_.revisions.push_back(well->results.revision());
+        bounds.push_back({{geometry.min_east, geometry.min_north, geometry.min_tvd},
+                          {geometry.max_east, geometry.max_north, geometry.max_tvd}});
     }
+    pick_index_.bvh = models::TrajectoryBvh::build(bounds);
+    return pick_index_;
 }
 
-void View3DWidget::drawProjectPoints() {
+void View3DWidget::showStationTooltip(const QPointF& pos, const QPoint& global_pos) {
+    const auto pick = pickTrajectory(pos);
+    if (!pick) {
+        QToolTip::hideText();
+        return;
+    }
+
+    const auto sample = models::sample_station(pick->well->results, pick->hit);
+    QString text = QString("<b>%1</b><br>").arg(QString::fromStdString(pick->well->metadata.well_name).toHtmlEscaped());
+    text += tr("Глубина: %1 м").arg(sample.md_m, 0, 'f', 2) + "<br>";
+    text += tr("TVD: %1 м").arg(sample.tvd_m, 0, 'f', 2) + "<br>";
+    text += tr("Угол: %1°").arg(sample.inclination_deg, 0, 'f', 2);
+    if (sample.azimuth_deg) {
+        text += "<br>" + tr("Азимут: %1°").arg(*sample.azimuth_deg, 0, 'f', 2);
+    }
+    QToolTip::showText(global_pos, text, this);
+}
+
+void View3DWidget::updateMarkers() {
+    const MarkerFilter filter{settings_.show_project_points,
+                              settings_.show_project_points && settings_.show_tolerance_circles,
+                              settings_.show_shot_points};
+    if (!markers_dirty_ && filter == marker_filter_) {
+        return;
+    }
+    marker_filter_ = filter;
+    markers_dirty_ = false;
+
+    QElapsedTimer build_timer;
+    build_timer.start();
+    std::vector<MarkerInstance> markers;
+    collectMarkers(markers);
+    renderer_.setMarkers(markers);
+    marker_count_ = static_cast<int>(markers.size());
+    frame_stats_.addBuild(build_timer.nsecsElapsed() * 1e-6);
+}
+
+void View3DWidget::collectMarkers(std::vector<MarkerInstance>& markers) const {
+    if (settings_.show_shot_points) {
+        appendShotPointMarkers(markers);
+    }
+    if (settings_.show_project_points) {
+        appendProjectPointMarkers(markers);
+    }
+}
+
+void View3DWidget::appendProjectPointMarkers(std::vector<MarkerInstance>& markers) const {
     if (!project_points_model_) return;
 
     for (int i = 0; i < project_points_model_->pointCount(); ++i) {
         const auto& pt = project_points_model_->pointAt(i);
         if (!pt.visible) continue;
 
-        const auto& color = pt.display_color;
-        glColor3f(color.redF(), color.greenF(), color.blueF());
+        const auto& c = pt.display_color;
+        const float x = static_cast<float>(pt.fact_east_m);
+        const float y = static_cast<float>(pt.fact_north_m);
+        const float z = static_cast<float>(-pt.fact_tvd_m);
 
-        // Рисуем точку
-        glPointSize(8.0f);
-        glBegin(GL_POINTS);
-        glVertex3f(pt.fact_east_m, pt.fact_north_m, -pt.fact_tvd_m);
-        glEnd();
+        // Точка — круг 8 пикселей
+        markers.push_back({x, y, z, 4.0f,
+                           static_cast<float>(c.redF()), static_cast<float>(c.greenF()),
+                           static_cast<float>(c.blueF()), 1.0f,
+                           static_cast<float>(MarkerShape::kDisc), 1.0f});
 
-        // Круг допуска (упрощённо)
+        // Круг допуска в горизонтальной плоскости
         if (settings_.show_tolerance_circles && pt.radius_m > 0) {
-            glLineWidth(1.0f);
-            glBegin(GL_LINE_LOOP);
-            for (int j = 0; j < 36; ++j) {
-                double angle = j * 10.0 * 3.14159 / 180.0;
-                double x = pt.fact_east_m + pt.radius_m * std::cos(angle);
-                double y = pt.fact_north_m + pt.radius_m * std::sin(angle);
-                glVertex3f(x, y, -pt.fact_tvd_m);
-            }
-            glEnd();
+            markers.push_back({x, y, z, static_cast<float>(pt.radius_m),
+                               static_cast<float>(c.redF()), static_cast<float>(c.greenF()),
+                               static_cast<float>(c.blueF()), 1.0f,
+                               static_cast<float>(MarkerShape::kRing), 0.0f});
         }
     }
 }
 
-void View3DWidget::drawShotPoints() {
+void View3DWidget::appendShotPointMarkers(std::vector<MarkerInstance>& markers) const {
     if (!shot_points_model_) return;
 
+    markers.reserve(markers.size() + shot_points_model_->pointCount());
     for (int i = 0; i < shot_points_model_->pointCount(); ++i) {
         const auto& pt = shot_points_model_->pointAt(i);
         if (!pt.visible) continue;
 
-        const auto& color = pt.display_color;
-        glColor3f(color.redF(), color.greenF(), color.blueF());
-
-        // Рисуем маркер (треугольник)
-        float size = pt.marker_size;
-        float x = pt.x_m;
-        float y = pt.y_m;
-        float z = -pt.z_m;
+        MarkerShape shape = MarkerShape::kTriangle;
+        switch (pt.marker) {
+            case models::ShotPointMarker::kTriangle: shape = MarkerShape::kTriangle; break;
+            case models::ShotPointMarker::kSquare: shape = MarkerShape::kSquare; break;
+            case models::ShotPointMarker::kCircle: shape = MarkerShape::kDisc; break;
+            case models::ShotPointMarker::kDiamond: shape = MarkerShape::kDiamond; break;
+            case models::ShotPointMarker::kCross: shape = MarkerShape::kCross; break;
+        }
 
-        glBegin(GL_TRIANGLES);
-        glVertex3f(x, y + size, z);
-        glVertex3f(x - size * 0.866f, y - size * 0.5f, z);
-        glVertex3f(x + size * 0.866f, y - size * 0.5f, z);
-        glEnd();
+        // Маркер в горизонтальной плоскости, размер — в метрах
+        const auto& c = pt.display_color;
+        markers.push_back({static_cast<float>(pt.x_m), static_cast<float>(pt.y_m),
+                           static_cast<float>(-pt.z_m), static_cast<float>(pt.marker_size),
+                           static_cast<float>(c.redF()), static_cast<float>(c.greenF()),
+                           static_cast<float>(c.blueF()), 1.0f,
+                           static_cast<float>(shape), 0.0f});
     }
 }
 
 void View3DWidget::drawDepthLabels() {
-    // Реализация через QPainter overlay или OpenGL текст
-    // Пока заглушка
+    if (!well_model_ || !settings_.show_depth_labels || settings_.depth_label_step <= 0.0) {
+        glyphs_.clear();
+        return;
+    }
+
+    const qreal ratio = devicePixelRatioF();
+    if (atlas_font_size_ != settings_.depth_label_font_size || atlas_pixel_ratio_ != ratio) {
+        QFont label_font = font();
+        label_font.setPointSize(settings_.depth_label_font_size);
+        depth_labels_.setAtlas(GlyphAtlas::build(label_font, ratio));
+        renderer_.setGlyphAtlas(depth_labels_.atlas().image());
+        atlas_font_size_ = settings_.depth_label_font_size;
+        atlas_pixel_ratio_ = ratio;
+    }
+
+    depth_labels_.layout(visibleWells(), settings_.depth_label_mode, settings_.depth_label_step,
+                         projection_matrix_ * view_matrix_, QSizeF(width(), height()) * ratio,
+                         depthLabelColor(), glyphs_);
+    renderer_.drawGlyphs(glyphs_);
+}
+
+QColor View3DWidget::depthLabelColor() const {
+    // Тёмные подписи на светлом фоне и наоборот
+    return settings_.background_color.lightnessF() > 0.5 ? QColor(40, 40, 40) : QColor(230, 230, 230);
 }
 
 void View3DWidget::mousePressEvent(QMouseEvent* event) {
@@ -277,11 +767,13 @@ void View3DWidget::mouseMoveEvent(QMouseEvent* event) {
     if (is_rotating_) {
         rotation_y_ += delta.x() * 0.5;
         rotation_x_ += delta.y() * 0.5;
-        update();
+        interactCamera();
     } else if (is_panning_) {
         pan_.setX(pan_.x() + delta.x() * scale_);
         pan_.setY(pan_.y() - delta.y() * scale_);
-        update();
+        interactCamera();
+    } else {
+        showStationTooltip(event->position(), event->globalPosition().toPoint());
     }
 }
 
@@ -296,7 +788,7 @@ void View3DWidget::wheelEvent(QWheelEvent* event) {
     scale_ *= (1.0 - delta * 0.1);
     if (scale_ < 0.01) scale_ = 0.01;
     if (scale_ > 100.0) scale_ = 100.0;
-    update();
+    interactCamera();
 }
 
 }  // namespace incline3d::views
@@ -1,12 +1,29 @@
 #pragma once
 
+#include <QImage>
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
 #include <QMatrix4x4>
 #include <QVector3D>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "models/segment_bvh.h"
+#include "views/depth_label_layer.h"
+#include "views/frame_stats.h"
+#include "views/horizon_surfaces.h"
+#include "views/scene3d_renderer.h"
+#include "views/tube_builder.h"
+#include "views/uncertainty_ellipsoids.h"
+#include "views/update_scheduler.h"
 #include "views/view_settings.h"
 
+class QAbstractItemModel;
+
 namespace incline3d::models {
 class WellTableModel;
 class ProjectPointsModel;
@@ -21,6 +38,7 @@ class View3DWidget : public QOpenGLWidget, protected QOpenGLFunctions {
 
 public:
     explicit View3DWidget(QWidget* parent = nullptr);
+    ~View3DWidget() override;
 
     void setWellModel(models::WellTableModel* model);
     void setProjectPointsModel(models::ProjectPointsModel* model);
@@ -28,21 +46,89 @@ public:
 
     void resetView();
 
+    /// Направить камеру на видимые скважины (направление взгляда сохраняется)
+    void fitToContent();
+
+    /// Отрисовать сцену в изображение без окна (кадровый буфер вне экрана)
+    /// @param size размер всего изображения, пиксели; камера — как на экране
+    /// @param tile часть изображения (пустой — всё изображение)
+    /// @note Крупные изображения собираются из плиток не больше
+    ///       OffscreenContext::kMaxTileSize; пустое изображение — OpenGL недоступен
+    QImage renderImage(const QSize& size, const QRect& tile = {});
+
     ViewSettings& settings();
     const ViewSettings& settings() const;
 
+    /// Отметить изменения; перерисовка — один раз за проход цикла событий,
+    /// у скрытого вида — при показе
+    void invalidate(UpdateScheduler::Changes changes);
+
+    /// Показывать поверх сцены панель статистики кадров
+    void setShowFrameStats(bool show);
+    bool showFrameStats() const { return show_frame_stats_; }
+
+    /// Время кадров, вызовы отрисовки и элементы сцены за последние кадры
+    const FrameStats& frameStats() const { return frame_stats_; }
+
+    /// Память визуализации скважины в 3D-виде, байт: данные в буферах видеокарты
+    std::size_t wellRenderMemory(models::WellId id) const;
+
+    /// Построенные сетки трубок: объём, байт, и число
+    std::size_t tubeMeshMemory() const;
+    int tubeMeshCount() const;
+
+    /// Освободить данные, которые вид восстановит при следующем кадре:
+    /// у скрытого вида — сетки трубок и буферы скважин
+    /// @return освобождённый объём, байт
+    std::size_t releaseCaches();
+
     // Accessor методы для настроек отображения
     bool showGrid() const { return settings_.show_grid; }
-    void setShowGrid(bool show) { settings_.show_grid = show; update(); }
+    void setShowGrid(bool show) { settings_.show_grid = show; invalidate(UpdateScheduler::kStyle); }
 
     bool showLabels() const { return settings_.show_depth_labels; }
-    void setShowLabels(bool show) { settings_.show_depth_labels = show; update(); }
+    void setShowLabels(bool show) { settings_.show_depth_labels = show; invalidate(UpdateScheduler::kStyle); }
+
+    double depthLabelStep() const { return settings_.depth_label_step; }
+    void setDepthLabelStep(double step) { settings_.depth_label_step = step; invalidate(UpdateScheduler::kStyle); }
 
     bool showAxes() const { return settings_.show_axes; }
-    void setShowAxes(bool show) { settings_.show_axes = show; update(); }
+    void setShowAxes(bool show) { settings_.show_axes = show; invalidate(UpdateScheduler::kStyle); }
 
     double gridStep() const { return settings_.grid_step; }
-    void setGridStep(double step) { settings_.grid_step = step; update(); }
+    void setGridStep(double step) { settings_.grid_step = step; invalidate(UpdateScheduler::kStyle); }
+
+    bool showTubes() const { return settings_.well_display_mode == WellDisplayMode::kTubes; }
+    void setShowTubes(bool show) {
+        settings_.well_display_mode = show ? WellDisplayMode::kTubes : WellDisplayMode::kLines;
+        invalidate(UpdateScheduler::kStyle);
+    }
+
+    TubeColoring tubeColoring() const { return settings_.tube_coloring; }
+    void setTubeColoring(TubeColoring coloring) { settings_.tube_coloring = coloring; invalidate(UpdateScheduler::kStyle); }
+
+    double tubeRadius() const { return settings_.tube_radius; }
+    void setTubeRadius(double radius) { settings_.tube_radius = radius; invalidate(UpdateScheduler::kStyle); }
+
+    bool showUncertainty() const { return settings_.show_uncertainty; }
+    void setShowUncertainty(bool show) { settings_.show_uncertainty = show; invalidate(UpdateScheduler::kStyle); }
+
+    double uncertaintyStep() const { return settings_.uncertainty_step; }
+    void setUncertaintyStep(double step) { settings_.uncertainty_step = step; invalidate(UpdateScheduler::kStyle); }
+
+    bool showHorizons() const { return settings_.show_horizons; }
+    void setShowHorizons(bool show) {
+        settings_.show_horizons = show;
+        horizons_dirty_ = true;
+        invalidate(UpdateScheduler::kStyle);
+    }
+
+    double horizonGridStep() const { return settings_.horizon_grid_step; }
+    void setHorizonGridStep(double step) {
+        settings_.horizon_grid_step = step;
+        horizons_dirty_ = true;
+        invalidate(UpdateScheduler::kStyle);
+    }
 
 public slots:
     void setRotationX(double angle);
@@ -54,6 +140,8 @@ protected:
     void initializeGL() override;
     void resizeGL(int w, int h) override;
     void paintGL() override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
@@ -61,20 +149,111 @@ protected:
     void wheelEvent(QWheelEvent* event) override;
 
 private:
-    void drawGrid();
-    void drawAxes();
+    /// Освободить ресурсы OpenGL (при разрушении контекста или виджета)
+    void cleanupGL();
+
+    /// Обработать накопленные изменения
+    void applyChanges(UpdateScheduler::Changes changes);
+
+    /// Камера сдвинута мышью: кадры до паузы рисуются грубее
+    void interactCamera();
+
+    void drawAxes(Scene3DRenderer& renderer);
     void drawWells();
-    void drawProjectPoints();
-    void drawShotPoints();
+
+    /// Эллипсоиды погрешности видимых скважин (буфер загружается только при изменении)
+    void drawUncertainty();
+
+    /// Поверхности пластов по проектным точкам (перестраиваются по сигналам модели точек)
+    void drawHorizons();
+
+    /// Матрица вида по текущему положению камеры
+    QMatrix4x4 cameraViewMatrix() const;
+
+    /// Видимые скважины с результатами
+    std::vector<const models::WellData*> visibleWells() const;
+
+    /// Разделить видимые скважины на трубки и линии
+    /// @param wait_for_tubes построить сетки сразу (экспорт), а не в фоне
+    void collectWellItems(std::vector<WellDrawItem>& lines, std::vector<TubeDrawItem>& tubes,
+                          bool wait_for_tubes);
+
+    /// Пересобрать экземпляры маркеров, если изменились данные или фильтры
+    void updateMarkers();
+    void collectMarkers(std::vector<MarkerInstance>& markers) const;
+    void appendProjectPointMarkers(std::vector<MarkerInstance>& markers) const;
+    void appendShotPointMarkers(std::vector<MarkerInstance>& markers) const;
+
+    /// Следить за изменениями модели точек (маркеры пересобираются по сигналам)
+    void watchMarkerModel(QAbstractItemModel* model);
+    void invalidateMarkers();
+
+    /// Подписи глубины видимых скважин (атлас пересоздаётся при смене шрифта или масштаба экрана)
     void drawDepthLabels();
+    QColor depthLabelColor() const;
 
     void updateProjectionMatrix();
 
+    /// Траектория под курсором
+    struct TrajectoryPick {
+        std::shared_ptr<const models::WellData> well;
+        models::SegmentHit hit;
+    };
+
+    /// Найти ближайшую к камере траекторию под точкой виджета
+    /// @note Деревья сегментов кэшируются в результатах скважин и
+    ///       перестраиваются только у изменённых; верхний уровень — дерево
+    ///       над габаритами видимых скважин (pickIndex())
+    std::optional<TrajectoryPick> pickTrajectory(const QPointF& pos) const;
+
+    /// Верхний уровень выбора: видимые скважины и дерево над их габаритами
+    struct PickIndex {
+        std::vector<std::shared_ptr<const models::WellData>> wells;     ///< Номер в дереве → скважина
+        std::vector<std::uint64_t> revisions;                           ///< Версии результатов при построении
+        models::TrajectoryBvh bvh;
+    };
+
+    /// Дерево выбора, перестроенное, если сменились видимые скважины или их результаты
+    const PickIndex& pickIndex() const;
+
+    /// Показать подсказку со значениями траектории под курсором (или скрыть)
+    void showStationTooltip(const QPointF& pos, const QPoint& global_pos);
+
     models::WellTableModel* well_model_{nullptr};
     models::ProjectPointsModel* project_points_model_{nullptr};
     models::ShotPointsModel* shot_points_model_{nullptr};
 
     ViewSettings settings_;
+    Scene3DRenderer renderer_;
+    TubeBuilder* tube_builder_{nullptr};
+    UpdateScheduler* scheduler_{nullptr};
+
+    /// Какие маркеры загружены в рендерер
+    struct MarkerFilter {
+        bool project_points{false};
+        bool tolerance_circles{false};
+        bool shot_points{false};
+
+        bool operator==(const MarkerFilter&) const = default;
+    };
+    MarkerFilter marker_filter_;
+    bool markers_dirty_{true};
+
+    UncertaintyLayer uncertainty_;
+    HorizonLayer horizons_;
+    bool horizons_dirty_{true};
+
+    mutable PickIndex pick_index_;
+
+    DepthLabelLayer depth_labels_;
+    std::vector<GlyphInstance> glyphs_;     ///< Символы кадра (память переиспользуется)
+    int atlas_font_size_{0};                ///< Параметры загруженного атласа; 0 — не загружен
+    qreal atlas_pixel_ratio_{0.0};
+
+    FrameStats frame_stats_;
+    bool show_frame_stats_{false};
+    int marker_count_{0};                   ///< Маркеров в рендерере
+    int drawn_well_count_{0};               ///< Скважин (линий и трубок) в последнем кадре
 
     // Параметры вида
     double rotation_x_{30.0};
@@ -82,6 +261,7 @@ private:
     double rotation_z_{0.0};
     double scale_{1.0};
     QVector3D pan_{0, 0, 0};
+    QVector3D target_{0, 0, 0};     ///< Точка сцены, вокруг которой вращается камера
 
     // Матрицы
     QMatrix4x4 projection_matrix_;
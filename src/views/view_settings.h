@@ -4,6 +4,24 @@
 
 namespace incline3d::views {
 
+/// Отображение скважин в 3D-виде
+enum class WellDisplayMode {
+    kLines,         ///< Линии заданной толщины в пикселях
+    kTubes          ///< Трубки заданного радиуса в метрах
+};
+
+/// Параметр, по которому раскрашиваются трубки
+enum class TubeColoring {
+    kIntensity10m,  ///< Интенсивность на 10 м
+    kDogleg         ///< Угол пространственного искривления
+};
+
+/// По какой глубине расставляются подписи
+enum class DepthLabelMode {
+    kMeasuredDepth, ///< Глубина по стволу
+    kTvd            ///< Вертикальная глубина
+};
+
 /// Настройки визуализации
 struct ViewSettings {
     // Цвета
@@ -17,7 +35,6 @@ struct ViewSettings {
     // Сетка
     bool show_grid{true};
     double grid_step{100.0};
-    int grid_divisions{10};
 
     // Оси
     bool show_axes{true};
@@ -26,6 +43,7 @@ struct ViewSettings {
     // Глубины
     bool show_depth_labels{true};
     double depth_label_step{100.0};
+    DepthLabelMode depth_label_mode{DepthLabelMode::kMeasuredDepth};
     int depth_label_font_size{10};
 
     // Проектные точки
@@ -35,6 +53,20 @@ struct ViewSettings {
     // Пункты возбуждения
     bool show_shot_points{true};
 
+    // Трубки (3D)
+    WellDisplayMode well_display_mode{WellDisplayMode::kLines};
+    TubeColoring tube_coloring{TubeColoring::kIntensity10m};
+    double tube_radius{5.0};            ///< Радиус трубки, м
+    double tube_color_max{3.0};         ///< Значение на красном конце шкалы (град/10м или град)
+
+    // Эллипсоиды погрешности (3D)
+    bool show_uncertainty{false};
+    double uncertainty_step{0.0};       ///< Шаг по стволу, м (0 — в точках замеров)
+
+    // Поверхности пластов по проектным точкам (3D)
+    bool show_horizons{false};
+    double horizon_grid_step{0.0};      ///< Шаг сетки интерполяции, м (0 — по самим точкам)
+
     // Уровень моря
     bool show_sea_level{false};
     double sea_level_elevation{0.0};
@@ -0,0 +1,35 @@
+#include "views/well_scene_state.h"
+
+#include "models/well_data.h"
+
+namespace incline3d::views {
+
+WellSceneState WellSceneState::of(const models::WellData& well, bool labels) {
+    WellSceneState state;
+    state.revision = well.results.revision();
+    state.color = well.display_color.rgba();
+    state.line_width = well.line_width;
+    state.name = well.metadata.well_name;
+    state.visible = well.visible && !well.results.empty();
+    state.labels = labels;
+    return state;
+}
+
+WellChanges diffWellState(const WellSceneState& built, const WellSceneState& current) {
+    WellChanges changes;
+    if (built.visible != current.visible) {
+        changes |= WellChange::kVisibility;
+    }
+    if (built.color != current.color || built.line_width != current.line_width || built.name != current.name) {
+        changes |= WellChange::kStyle;
+    }
+    if (built.labels != current.labels) {
+        changes |= WellChange::kLabels;
+    }
+    if (built.revision != current.revision) {
+        changes |= WellChange::kGeometry;
+    }
+    return changes;
+}
+
+}  // namespace incline3d::views
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QColor>
+#include <QFlags>
+
+#include <cstdint>
+#include <string>
+
+namespace incline3d::models {
+struct WellData;
+}  // namespace incline3d::models
+
+namespace incline3d::views {
+
+/// Что изменилось у скважины с прошлого построения её элементов сцены
+enum class WellChange : std::uint8_t {
+    kNone = 0x0,
+    kVisibility = 0x1,  ///< Показать или скрыть группу элементов
+    kStyle = 0x2,       ///< Цвет, толщина, имя — правка элементов на месте
+    kLabels = 0x4,      ///< Подписи включены или выключены
+    kGeometry = 0x8,    ///< Новая версия результатов — путь и подписи строятся заново
+};
+Q_DECLARE_FLAGS(WellChanges, WellChange)
+
+/// Данные скважины, по которым построены её элементы на 2D-виде
+struct WellSceneState {
+    std::uint64_t revision{0};  ///< Версия результатов
+    QRgb color{0};
+    double line_width{0.0};
+    std::string name;
+    bool visible{false};        ///< Видима и есть результаты
+    bool labels{false};
+
+    /// Состояние скважины для вида с подписями или без
+    static WellSceneState of(const models::WellData& well, bool labels);
+
+    bool operator==(const WellSceneState&) const = default;
+};
+
+/// Сравнить построенное состояние с новым
+/// @note Для скрытой скважины (в обоих состояниях) изменения возвращаются
+///       как есть; откладывать ли их до показа, решает вид
+WellChanges diffWellState(const WellSceneState& built, const WellSceneState& current);
+
+}  // namespace incline3d::views
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(incline3d::views::WellChanges)
@@ -0,0 +1,131 @@
+#include <QtTest>
+
+#include <vector>
+
+#include "models/chunked_array.h"
+
+using namespace incline3d::models;
+
+class TestChunkedArray : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testPushBackAndIndex();
+    void testIteration();
+    void testInsertErase();
+    void testCopySharesChunks();
+    void testMutationDetachesOnlyOneChunk();
+    void testReverse();
+};
+
+void TestChunkedArray::testEmpty() {
+    ChunkedArray<int> array;
+
+    QVERIFY(array.empty());
+    QCOMPARE(array.size(), static_cast<size_t>(0));
+    QVERIFY(array.begin() == array.end());
+    QCOMPARE(array.chunkCount(), static_cast<size_t>(0));
+}
+
+void TestChunkedArray::testPushBackAndIndex() {
+    ChunkedArray<int, 4> array;
+    for (int i = 0; i < 10; ++i) {
+        array.push_back(i * 10);
+    }
+
+    QCOMPARE(array.size(), static_cast<size_t>(10));
+    QCOMPARE(array.chunkCount(), static_cast<size_t>(3));
+    QCOMPARE(array.front(), 0);
+    QCOMPARE(array.back(), 90);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(array[i], i * 10);
+    }
+    QVERIFY_EXCEPTION_THROWN(array.at(10), std::out_of_range);
+}
+
+void TestChunkedArray::testIteration() {
+    ChunkedArray<int, 3> array{1, 2, 3, 4, 5, 6, 7};
+
+    int expected = 1;
+    for (int value : array) {
+        QCOMPARE(value, expected);
+        ++expected;
+    }
+    QCOMPARE(expected, 8);
+
+    QCOMPARE(array.end() - array.begin(), static_cast<std::ptrdiff_t>(7));
+    auto it = array.begin() + 5;
+    QCOMPARE(*it, 6);
+    --it;
+    QCOMPARE(*it, 5);
+    QCOMPARE(*(array.end() - 1), 7);
+}
+
+void TestChunkedArray::testInsertErase() {
+    ChunkedArray<int, 2> array;
+    std::vector<int> reference;
+
+    for (int i = 0; i < 20; ++i) {
+        size_t pos = (i * 7) % (reference.size() + 1);
+        array.insert(array.begin() + pos, i);
+        reference.insert(reference.begin() + pos, i);
+    }
+    QCOMPARE(array.toVector(), reference);
+
+    for (int i = 0; i < 8; ++i) {
+        size_t pos = (i * 5) % reference.size();
+        array.erase(array.begin() + pos);
+        reference.erase(reference.begin() + pos);
+    }
+    QCOMPARE(array.toVector(), reference);
+
+    array.erase(array.begin() + 1, array.begin() + 4);
+    reference.erase(reference.begin() + 1, reference.begin() + 4);
+    QCOMPARE(array.toVector(), reference);
+    QCOMPARE(array.size(), reference.size());
+}
+
+void TestChunkedArray::testCopySharesChunks() {
+    ChunkedArray<int, 16> array;
+    for (int i = 0; i < 160; ++i) {
+        array.push_back(i);
+    }
+
+    ChunkedArray<int, 16> copy = array;
+    QCOMPARE(copy.chunkCount(), static_cast<size_t>(10));
+    QCOMPARE(copy.sharedChunkCount(array), static_cast<size_t>(10));
+}
+
+void TestChunkedArray::testMutationDetachesOnlyOneChunk() {
+    ChunkedArray<int, 16> array;
+    for (int i = 0; i < 160; ++i) {
+        array.push_back(i);
+    }
+
+    ChunkedArray<int, 16> version = array;
+    array.set(40, -1);
+
+    // Старая версия не изменилась, новая разделяет все блоки, кроме одного
+    QCOMPARE(version[40], 40);
+    QCOMPARE(array[40], -1);
+    QCOMPARE(array.sharedChunkCount(version), static_cast<size_t>(9));
+
+    // Повторная запись в уже отделённый блок не копирует его снова
+    array.mutableAt(41) = -2;
+    QCOMPARE(array.sharedChunkCount(version), static_cast<size_t>(9));
+    QCOMPARE(version[41], 41);
+}
+
+void TestChunkedArray::testReverse() {
+    ChunkedArray<int, 3> array{1, 2, 3, 4, 5};
+    ChunkedArray<int, 3> original = array;
+
+    array.reverse();
+
+    QCOMPARE(array.toVector(), (std::vector<int>{5, 4, 3, 2, 1}));
+    QCOMPARE(original.toVector(), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+QTEST_MAIN(TestChunkedArray)
+#include "test_chunked_array.moc"
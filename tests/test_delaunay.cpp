@@ -0,0 +1,132 @@
+#include <QtTest>
+
+#include <random>
+#include <vector>
+
+#include "utils/delaunay.h"
+
+using namespace incline3d::utils;
+
+class TestDelaunay : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testTooFewPoints();
+    void testSquareGrid();
+    void testRandomEmptyCircle();
+    void testDuplicates();
+    void testLocate();
+};
+
+namespace {
+
+double orient(Point2D a, Point2D b, Point2D c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+/// Точка строго внутри описанной окружности треугольника (с запасом на округление)
+bool insideCircle(Point2D a, Point2D b, Point2D c, Point2D p) {
+    const double ax = a.x - p.x, ay = a.y - p.y;
+    const double bx = b.x - p.x, by = b.y - p.y;
+    const double cx = c.x - p.x, cy = c.y - p.y;
+    const double det = (ax * ax + ay * ay) * (bx * cy - cx * by) - (bx * bx + by * by) * (ax * cy - cx * ay) +
+                       (cx * cx + cy * cy) * (ax * by - bx * ay);
+    return det > 1e-6 * (ax * ax + ay * ay + bx * bx + by * by + cx * cx + cy * cy);
+}
+
+double totalArea(const std::vector<Point2D>& points, const std::vector<DelaunayTriangulation::Triangle>& triangles) {
+    double area = 0.0;
+    for (const auto& t : triangles) {
+        area += 0.5 * orient(points[t[0]], points[t[1]], points[t[2]]);
+    }
+    return area;
+}
+
+}  // namespace
+
+void TestDelaunay::testTooFewPoints() {
+    QVERIFY(DelaunayTriangulation::build({}).triangles().empty());
+
+    const std::vector<Point2D> two = {{0.0, 0.0}, {10.0, 5.0}};
+    QVERIFY(DelaunayTriangulation::build(two).triangles().empty());
+
+    const std::vector<Point2D> three = {{0.0, 0.0}, {10.0, 0.0}, {0.0, 10.0}};
+    const auto triangles = DelaunayTriangulation::build(three).triangles();
+    QCOMPARE(triangles.size(), static_cast<size_t>(1));
+    QVERIFY(orient(three[triangles[0][0]], three[triangles[0][1]], three[triangles[0][2]]) > 0.0);
+}
+
+void TestDelaunay::testSquareGrid() {
+    // Сетка 20 × 30 через 10 м: оболочка — весь прямоугольник, 2(n − 1)(m − 1) треугольников
+    std::vector<Point2D> points;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            points.push_back({i * 10.0, j * 10.0});
+        }
+    }
+    const auto triangulation = DelaunayTriangulation::build(points);
+    const auto triangles = triangulation.triangles();
+    QCOMPARE(triangulation.pointCount(), points.size());
+    QCOMPARE(triangles.size(), static_cast<size_t>(2 * 19 * 29));
+    QCOMPARE(totalArea(points, triangles), 190.0 * 290.0);
+}
+
+void TestDelaunay::testRandomEmptyCircle() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(-3000.0, 3000.0);
+    std::vector<Point2D> points(500);
+    for (auto& p : points) {
+        p = {coordinate(rng), coordinate(rng)};
+    }
+
+    const auto triangles = DelaunayTriangulation::build(points).triangles();
+    QVERIFY(triangles.size() > points.size());
+    for (const auto& t : triangles) {
+        const Point2D a = points[t[0]];
+        const Point2D b = points[t[1]];
+        const Point2D c = points[t[2]];
+        QVERIFY(orient(a, b, c) > 0.0);
+        for (std::size_t k = 0; k < points.size(); ++k) {
+            if (k != t[0] && k != t[1] && k != t[2]) {
+                QVERIFY(!insideCircle(a, b, c, points[k]));
+            }
+        }
+    }
+}
+
+void TestDelaunay::testDuplicates() {
+    const std::vector<Point2D> points = {{0.0, 0.0}, {100.0, 0.0}, {0.0, 100.0}, {100.0, 100.0}, {100.0, 100.0}};
+    const auto triangulation = DelaunayTriangulation::build(points);
+    QCOMPARE(triangulation.pointCount(), static_cast<size_t>(4));
+    QCOMPARE(triangulation.triangles().size(), static_cast<size_t>(2));
+
+    // Вне области начальной триангуляции точки не добавляются
+    DelaunayTriangulation bounded({0.0, 0.0}, {10.0, 10.0});
+    QVERIFY(bounded.insert({5.0, 5.0}, 0));
+    QVERIFY(!bounded.insert({5.0, 5.0}, 1));
+    QVERIFY(!bounded.insert({20.0, 5.0}, 2));
+    QCOMPARE(bounded.pointCount(), static_cast<size_t>(1));
+}
+
+void TestDelaunay::testLocate() {
+    const std::vector<Point2D> points = {{0.0, 0.0}, {100.0, 0.0}, {0.0, 100.0}, {100.0, 100.0}};
+    const auto triangulation = DelaunayTriangulation::build(points);
+
+    DelaunayTriangulation::Triangle triangle{};
+    std::array<double, 3> weights{};
+    QVERIFY(triangulation.locate({25.0, 50.0}, triangle, weights));
+    double x = 0.0;
+    double y = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(weights[i] >= 0.0);
+        x += weights[i] * points[triangle[i]].x;
+        y += weights[i] * points[triangle[i]].y;
+    }
+    QVERIFY(qAbs(x - 25.0) < 1e-9);
+    QVERIFY(qAbs(y - 50.0) < 1e-9);
+
+    QVERIFY(!triangulation.locate({150.0, 50.0}, triangle, weights));
+}
+
+QTEST_MAIN(TestDelaunay)
+#include "test_delaunay.moc"
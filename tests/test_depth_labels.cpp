@@ -0,0 +1,136 @@
+#include <QtTest>
+
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+#include "views/depth_labels.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestDepthLabels : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testMeasuredDepth();
+    void testTvdCrossings();
+    void testRanks();
+    void testCollisionGrid();
+    void testCollisionGridReset();
+};
+
+void TestDepthLabels::testEmpty() {
+    TrajectoryColumns columns;
+    QVERIFY(computeDepthLabels(columns, DepthLabelMode::kMeasuredDepth, 100.0).empty());
+
+    ProcessedPoint pt;
+    columns.push_back(pt);
+    pt.measured_depth_m = 500.0;
+    pt.tvd_m = 500.0;
+    columns.push_back(pt);
+    QVERIFY(computeDepthLabels(columns, DepthLabelMode::kMeasuredDepth, 0.0).empty());
+    QVERIFY(!computeDepthLabels(columns, DepthLabelMode::kMeasuredDepth, 100.0).empty());
+}
+
+void TestDepthLabels::testMeasuredDepth() {
+    // Вертикальный ствол от 0 до 250 м, затем горизонтальный на восток до 450 м
+    TrajectoryColumns columns;
+    ProcessedPoint pt;
+    columns.push_back(pt);
+    pt.measured_depth_m = 250.0;
+    pt.tvd_m = 250.0;
+    columns.push_back(pt);
+    pt.measured_depth_m = 450.0;
+    pt.east_m = 200.0;
+    columns.push_back(pt);
+
+    const auto labels = computeDepthLabels(columns, DepthLabelMode::kMeasuredDepth, 100.0);
+    QCOMPARE(labels.size(), static_cast<size_t>(5));
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        QCOMPARE(labels[i].value, 100.0 * i);
+    }
+
+    // Устье в точке замера, 100 м — на вертикали, 300 м — на горизонтальном участке
+    QCOMPARE(labels[0].position[2], 0.0f);
+    QCOMPARE(labels[1].position[2], -100.0f);
+    QCOMPARE(labels[3].position[0], 50.0f);
+    QCOMPARE(labels[3].position[2], -250.0f);
+}
+
+void TestDepthLabels::testTvdCrossings() {
+    // Ствол опускается до 300 м, поднимается до 150 м и снова уходит на 250 м
+    TrajectoryColumns columns;
+    const double tvd[] = {0.0, 300.0, 150.0, 250.0};
+    for (int i = 0; i < 4; ++i) {
+        ProcessedPoint pt;
+        pt.measured_depth_m = i * 300.0;
+        pt.tvd_m = tvd[i];
+        pt.east_m = i * 100.0;
+        columns.push_back(pt);
+    }
+
+    const auto labels = computeDepthLabels(columns, DepthLabelMode::kTvd, 100.0);
+    std::vector<double> values;
+    for (const auto& label : labels) {
+        values.push_back(label.value);
+        QVERIFY(std::abs(label.position[2] + label.value) < 1e-3);
+    }
+
+    // 300 м в точке замера подписывается один раз, 200 м — при каждом пересечении
+    const std::vector<double> expected = {0.0, 100.0, 200.0, 300.0, 200.0, 200.0};
+    QCOMPARE(values, expected);
+    QVERIFY(std::abs(labels[4].position[0] - (100.0f + 100.0f * 2.0f / 3.0f)) < 1e-3);
+}
+
+void TestDepthLabels::testRanks() {
+    TrajectoryColumns columns;
+    ProcessedPoint pt;
+    columns.push_back(pt);
+    pt.measured_depth_m = 2000.0;
+    pt.tvd_m = 2000.0;
+    columns.push_back(pt);
+
+    const auto labels = computeDepthLabels(columns, DepthLabelMode::kMeasuredDepth, 100.0);
+    QCOMPARE(labels.size(), static_cast<size_t>(21));
+    QCOMPARE(labels[0].rank, 0);
+    QCOMPARE(labels[5].rank, 1);
+    QCOMPARE(labels[7].rank, 2);
+    QCOMPARE(labels[10].rank, 0);
+    QCOMPARE(labels[15].rank, 1);
+}
+
+void TestDepthLabels::testCollisionGrid() {
+    LabelCollisionGrid grid;
+    grid.reset(200.0f, 100.0f, 16.0f);
+
+    QVERIFY(grid.tryPlace(10.0f, 10.0f, 40.0f, 12.0f));
+    // Перекрытие на пиксель
+    QVERIFY(!grid.tryPlace(49.0f, 21.0f, 40.0f, 12.0f));
+    // Касание краем — не наложение
+    QVERIFY(grid.tryPlace(50.0f, 10.0f, 40.0f, 12.0f));
+    QVERIFY(grid.tryPlace(10.0f, 22.0f, 40.0f, 12.0f));
+    // Прямоугольник внутри занятого, но в другой ячейке сетки
+    QVERIFY(grid.tryPlace(100.0f, 40.0f, 80.0f, 40.0f));
+    QVERIFY(!grid.tryPlace(150.0f, 70.0f, 5.0f, 5.0f));
+    // За краем экрана
+    QVERIFY(!grid.tryPlace(190.0f, 50.0f, 20.0f, 10.0f));
+    QVERIFY(!grid.tryPlace(-1.0f, 50.0f, 20.0f, 10.0f));
+    QCOMPARE(grid.placedCount(), static_cast<size_t>(4));
+}
+
+void TestDepthLabels::testCollisionGridReset() {
+    LabelCollisionGrid grid;
+    grid.reset(100.0f, 100.0f, 10.0f);
+    QVERIFY(grid.tryPlace(0.0f, 0.0f, 50.0f, 50.0f));
+    QVERIFY(!grid.tryPlace(10.0f, 10.0f, 5.0f, 5.0f));
+
+    // Новый кадр с меньшим экраном: прежние прямоугольники забыты
+    grid.reset(60.0f, 60.0f, 10.0f);
+    QCOMPARE(grid.placedCount(), static_cast<size_t>(0));
+    QVERIFY(grid.tryPlace(10.0f, 10.0f, 5.0f, 5.0f));
+}
+
+QTEST_MAIN(TestDepthLabels)
+#include "test_depth_labels.moc"
@@ -0,0 +1,132 @@
+#include <QtTest>
+
+#include <vector>
+
+#include "views/frame_stats.h"
+
+using namespace incline3d::views;
+
+class TestFrameStats : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPercentile();
+    void testEmptySummary();
+    void testSummaryPercentiles();
+    void testWindowKeepsLatestFrames();
+    void testGpuAndBackgroundOptional();
+    void testBuilds();
+};
+
+void TestFrameStats::testPercentile() {
+    QCOMPARE(FrameStats::percentile({}, 50.0), 0.0);
+    QCOMPARE(FrameStats::percentile({7.0}, 99.0), 7.0);
+
+    // Ближайший ранг: 1..100 → p50 = 50, p95 = 95, p99 = 99
+    std::vector<double> values;
+    for (int i = 100; i >= 1; --i) {
+        values.push_back(i);
+    }
+    QCOMPARE(FrameStats::percentile(values, 50.0), 50.0);
+    QCOMPARE(FrameStats::percentile(values, 95.0), 95.0);
+    QCOMPARE(FrameStats::percentile(values, 99.0), 99.0);
+    QCOMPARE(FrameStats::percentile(values, 0.0), 1.0);
+    QCOMPARE(FrameStats::percentile(values, 100.0), 100.0);
+}
+
+void TestFrameStats::testEmptySummary() {
+    FrameStats stats;
+    const auto summary = stats.summary();
+    QCOMPARE(summary.frames, 0);
+    QVERIFY(summary.gpu_p50_ms < 0.0);
+    QVERIFY(summary.build_ms < 0.0);
+    QCOMPARE(summary.draw_calls, 0);
+}
+
+void TestFrameStats::testSummaryPercentiles() {
+    FrameStats stats;
+    for (int i = 1; i <= 100; ++i) {
+        FrameSample sample;
+        sample.cpu_ms = i;
+        sample.draw_calls = i;
+        sample.vertices = static_cast<std::size_t>(i) * 10;
+        stats.addFrame(sample);
+    }
+    stats.setItemCount(42);
+
+    const auto summary = stats.summary();
+    QCOMPARE(summary.frames, 100);
+    QCOMPARE(summary.cpu_p50_ms, 50.0);
+    QCOMPARE(summary.cpu_p95_ms, 95.0);
+    QCOMPARE(summary.cpu_p99_ms, 99.0);
+    QCOMPARE(summary.cpu_max_ms, 100.0);
+
+    // Счётчики — последнего кадра
+    QCOMPARE(summary.draw_calls, 100);
+    QCOMPARE(summary.vertices, static_cast<std::size_t>(1000));
+    QCOMPARE(summary.items, 42);
+}
+
+void TestFrameStats::testWindowKeepsLatestFrames() {
+    FrameStats stats;
+    // Долгие кадры вытесняются быстрыми после заполнения окна
+    for (std::size_t i = 0; i < FrameStats::kWindow; ++i) {
+        FrameSample sample;
+        sample.cpu_ms = 100.0;
+        stats.addFrame(sample);
+    }
+    for (std::size_t i = 0; i < FrameStats::kWindow + 5; ++i) {
+        FrameSample sample;
+        sample.cpu_ms = 1.0;
+        sample.draw_calls = static_cast<int>(i);
+        stats.addFrame(sample);
+    }
+    QCOMPARE(stats.frameCount(), FrameStats::kWindow);
+
+    const auto summary = stats.summary();
+    QCOMPARE(summary.cpu_max_ms, 1.0);
+    QCOMPARE(summary.draw_calls, static_cast<int>(FrameStats::kWindow + 4));
+
+    stats.clear();
+    QCOMPARE(stats.frameCount(), static_cast<std::size_t>(0));
+}
+
+void TestFrameStats::testGpuAndBackgroundOptional() {
+    FrameStats stats;
+    for (int i = 0; i < 10; ++i) {
+        FrameSample sample;
+        sample.cpu_ms = 5.0;
+        // Таймеры видеокарты отвечают не на каждый кадр
+        sample.gpu_ms = i % 3 == 0 ? 2.0 : -1.0;
+        stats.addFrame(sample);
+    }
+    auto summary = stats.summary();
+    QCOMPARE(summary.gpu_p50_ms, 2.0);
+    QVERIFY(summary.background_p95_ms < 0.0);
+
+    FrameSample sample;
+    sample.background_ms = 3.0;
+    stats.addFrame(sample);
+    summary = stats.summary();
+    QCOMPARE(summary.background_p95_ms, 3.0);
+}
+
+void TestFrameStats::testBuilds() {
+    FrameStats stats;
+    stats.addBuild(40.0);
+    stats.addBuild(10.0);
+    auto summary = stats.summary();
+    QCOMPARE(summary.build_ms, 10.0);
+    QCOMPARE(summary.build_max_ms, 40.0);
+
+    // Старые построения выходят из окна
+    for (std::size_t i = 0; i < FrameStats::kBuildWindow; ++i) {
+        stats.addBuild(5.0);
+    }
+    summary = stats.summary();
+    QCOMPARE(summary.build_ms, 5.0);
+    QCOMPARE(summary.build_max_ms, 5.0);
+}
+
+QTEST_MAIN(TestFrameStats)
+#include "test_frame_stats.moc"
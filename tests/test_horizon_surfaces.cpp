@@ -0,0 +1,111 @@
+#include <QtTest>
+
+#include <vector>
+
+#include "views/horizon_surfaces.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestHorizonSurfaces : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testGrouping();
+    void testPointMesh();
+    void testGridMesh();
+    void testLayerCaching();
+
+private:
+    /// Кровля пласта в точке (east, north) на глубине tvd
+    static ProjectPoint top(const std::string& name, double east, double north, double tvd);
+};
+
+ProjectPoint TestHorizonSurfaces::top(const std::string& name, double east, double north, double tvd) {
+    ProjectPoint point;
+    point.name = name;
+    point.fact_east_m = east;
+    point.fact_north_m = north;
+    point.fact_tvd_m = tvd;
+    return point;
+}
+
+void TestHorizonSurfaces::testGrouping() {
+    std::vector<ProjectPoint> points = {top("A", 0, 0, 1000), top("B", 0, 0, 1500), top("A", 100, 0, 1010),
+                                        top("A", 0, 0, 0)};
+    points.push_back(top("B", 50, 50, 1520));
+    points.back().visible = false;
+
+    // Нерассчитанные и скрытые точки не входят
+    const auto groups = groupHorizonPoints(points);
+    QCOMPARE(groups.size(), static_cast<size_t>(2));
+    QCOMPARE(groups[0].name, std::string("A"));
+    QCOMPARE(groups[0].points.size(), static_cast<size_t>(2));
+    QCOMPARE(groups[1].points.size(), static_cast<size_t>(1));
+}
+
+void TestHorizonSurfaces::testPointMesh() {
+    // Наклонная плоскость: TVD растёт на восток
+    const std::vector<HorizonPoint> points = {{0, 0, 1000}, {100, 0, 1010}, {0, 100, 1000}, {100, 100, 1010}};
+    const auto mesh = buildHorizonMesh(points, 0.0, Qt::green);
+    QCOMPARE(mesh.vertices.size(), static_cast<size_t>(4));
+    QCOMPARE(mesh.indices.size(), static_cast<size_t>(6));
+    QCOMPARE(mesh.vertices[1].z, -1010.0f);
+
+    // Нормаль смотрит вверх и наклонена к востоку, куда поверхность опускается
+    for (const auto& v : mesh.vertices) {
+        QVERIFY(v.nz > 0.99f);
+        QVERIFY(v.nx > 0.0f);
+    }
+
+    QVERIFY(buildHorizonMesh(std::span(points).first(2), 0.0, Qt::green).empty());
+}
+
+void TestHorizonSurfaces::testGridMesh() {
+    const std::vector<HorizonPoint> points = {{0, 0, 1000}, {100, 0, 1010}, {0, 100, 1000}, {100, 100, 1010}};
+
+    // Узлы через 25 м: 5 × 5 узлов, 4 × 4 ячейки, значения — линейная интерполяция
+    const auto mesh = buildHorizonMesh(points, 25.0, Qt::green);
+    QCOMPARE(mesh.vertices.size(), static_cast<size_t>(25));
+    QCOMPARE(mesh.indices.size(), static_cast<size_t>(4 * 4 * 6));
+    for (const auto& v : mesh.vertices) {
+        QVERIFY(qAbs(v.z + 1000.0f + v.x * 0.1f) < 1e-3f);
+    }
+
+    // Шаг больше области — треугольники по самим точкам
+    QCOMPARE(buildHorizonMesh(points, 500.0, Qt::green).vertices.size(), static_cast<size_t>(4));
+}
+
+void TestHorizonSurfaces::testLayerCaching() {
+    std::vector<ProjectPoint> points = {top("A", 0, 0, 1000), top("A", 100, 0, 1010), top("A", 0, 100, 1000),
+                                        top("B", 0, 0, 1500), top("B", 100, 0, 1500), top("B", 0, 100, 1500)};
+
+    HorizonLayer layer;
+    QVERIFY(layer.update(points, 0.0));
+    QCOMPARE(layer.surfaceCount(), 2);
+    QCOMPARE(layer.vertices().size(), static_cast<size_t>(6));
+    QCOMPARE(layer.indices().size(), static_cast<size_t>(6));
+    QCOMPARE(layer.vertices().front().a, HorizonLayer::kAlpha);
+    QVERIFY(!layer.update(points, 0.0));
+
+    // Изменилась точка одного пласта; индексы второго сдвинуты на вершины первого
+    points[4].fact_tvd_m = 1510.0;
+    QVERIFY(layer.update(points, 0.0));
+    QVERIFY(layer.indices().back() >= 3);
+    QVERIFY(!layer.update(points, 0.0));
+
+    QVERIFY(layer.update(points, 50.0));
+    QVERIFY(!layer.update(points, 50.0));
+
+    // Пласт без точек пропадает
+    points.resize(3);
+    QVERIFY(layer.update(points, 50.0));
+    QCOMPARE(layer.surfaceCount(), 1);
+
+    layer.clear();
+    QVERIFY(layer.vertices().empty());
+    QVERIFY(layer.update(points, 50.0));
+}
+
+QTEST_MAIN(TestHorizonSurfaces)
+#include "test_horizon_surfaces.moc"
@@ -0,0 +1,93 @@
+#include <QtTest>
+
+#include <cmath>
+
+#include "views/image_tiles.h"
+
+using namespace incline3d::views;
+
+class TestImageTiles : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSplitCoversImage();
+    void testSplitSmallImage();
+    void testTileProjectionMatchesFullImage();
+    void testFitSceneToImage();
+
+private:
+    /// Пиксель изображения size, в который проецируется точка
+    static QPointF toPixel(const QMatrix4x4& projection, const QSize& size, const QVector3D& point);
+};
+
+QPointF TestImageTiles::toPixel(const QMatrix4x4& projection, const QSize& size, const QVector3D& point) {
+    const QVector3D ndc = projection.map(point);
+    return {(ndc.x() + 1.0) / 2.0 * size.width(), (1.0 - ndc.y()) / 2.0 * size.height()};
+}
+
+void TestImageTiles::testSplitCoversImage() {
+    const QSize size(10000, 7000);
+    const auto tiles = splitIntoTiles(size, 4096);
+    QCOMPARE(tiles.size(), static_cast<size_t>(6));
+    QCOMPARE(tiles.front(), QRect(0, 0, 4096, 4096));
+    QCOMPARE(tiles.back(), QRect(8192, 4096, 1808, 2904));
+
+    // Плитки не перекрываются и в сумме дают всё изображение
+    qint64 area = 0;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        QVERIFY(QRect(QPoint(0, 0), size).contains(tiles[i]));
+        QVERIFY(tiles[i].width() <= 4096 && tiles[i].height() <= 4096);
+        area += static_cast<qint64>(tiles[i].width()) * tiles[i].height();
+        for (std::size_t j = i + 1; j < tiles.size(); ++j) {
+            QVERIFY(!tiles[i].intersects(tiles[j]));
+        }
+    }
+    QCOMPARE(area, static_cast<qint64>(size.width()) * size.height());
+}
+
+void TestImageTiles::testSplitSmallImage() {
+    QVERIFY(splitIntoTiles(QSize(), 4096).empty());
+    QVERIFY(splitIntoTiles(QSize(100, 100), 0).empty());
+
+    const auto tiles = splitIntoTiles(QSize(800, 600), 4096);
+    QCOMPARE(tiles.size(), static_cast<size_t>(1));
+    QCOMPARE(tiles.front(), QRect(0, 0, 800, 600));
+}
+
+void TestImageTiles::testTileProjectionMatchesFullImage() {
+    const QSize size(9000, 5000);
+    QMatrix4x4 projection;
+    projection.perspective(45.0f, static_cast<float>(size.width()) / size.height(), 1.0f, 10000.0f);
+    projection.translate(0.0f, 0.0f, -1000.0f);
+
+    // Точка попадает в тот же пиксель, что и на целом изображении, со сдвигом на угол плитки
+    const QVector3D points[] = {{0.0f, 0.0f, 0.0f}, {-300.0f, 120.0f, 50.0f}, {250.0f, -180.0f, -200.0f}};
+    for (const QRect& tile : splitIntoTiles(size, 4096)) {
+        const QMatrix4x4 tile_projection = tileProjection(projection, size, tile);
+        for (const QVector3D& point : points) {
+            const QPointF full = toPixel(projection, size, point);
+            const QPointF local = toPixel(tile_projection, tile.size(), point);
+            QVERIFY(std::abs(local.x() - (full.x() - tile.left())) < 0.05);
+            QVERIFY(std::abs(local.y() - (full.y() - tile.top())) < 0.05);
+        }
+    }
+}
+
+void TestImageTiles::testFitSceneToImage() {
+    const QRectF scene(0.0, 0.0, 200.0, 100.0);
+    const QSize size(400, 400);
+
+    // Ширина определяет масштаб, сцена по центру
+    const QTransform plan = fitSceneToImage(scene, size, true);
+    QCOMPARE(plan.map(scene.center()), QPointF(200.0, 200.0));
+    QCOMPARE(plan.map(QPointF(0.0, 0.0)), QPointF(0.0, 300.0));
+    QCOMPARE(plan.map(QPointF(200.0, 100.0)), QPointF(400.0, 100.0));
+
+    const QTransform vertical = fitSceneToImage(scene, size, false);
+    QCOMPARE(vertical.map(QPointF(0.0, 0.0)), QPointF(0.0, 100.0));
+
+    QVERIFY(fitSceneToImage(QRectF(), size, false).isIdentity());
+}
+
+QTEST_MAIN(TestImageTiles)
+#include "test_image_tiles.moc"
@@ -0,0 +1,131 @@
+#include <QtTest>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "models/well_data.h"
+
+using namespace incline3d::models;
+
+class TestInternedString : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testEqualValuesShareStorage();
+    void testStringAccess();
+    void testGrouping();
+    void testOrdering();
+    void testMetadataCopy();
+    void testConcurrentIntern();
+};
+
+void TestInternedString::testEmpty() {
+    InternedString s;
+    QVERIFY(s.empty());
+    QCOMPARE(s.size(), static_cast<size_t>(0));
+    QVERIFY(s.str().empty());
+    QVERIFY(s == InternedString(""));
+    QVERIFY(s.handle() == nullptr);
+}
+
+void TestInternedString::testEqualValuesShareStorage() {
+    std::string value = "Самотлорское";
+    InternedString a = value;
+    InternedString b = std::string("Самотлорское");
+
+    QVERIFY(a == b);
+    QVERIFY(a.handle() == b.handle());
+    QVERIFY(&a.str() == &b.str());
+    QVERIFY(!(a == InternedString("Приобское")));
+    QCOMPARE(sizeof(InternedString), sizeof(void*));
+}
+
+void TestInternedString::testStringAccess() {
+    WellMetadata meta;
+    meta.quality = "good";
+    meta.field_name = std::string("Тестовое месторождение");
+
+    QVERIFY(meta.quality == "good");
+    QVERIFY(!(meta.quality == "poor"));
+    QCOMPARE(QString::fromStdString(meta.field_name), QString("Тестовое месторождение"));
+
+    const std::string copy = meta.field_name;
+    QCOMPARE(copy, std::string("Тестовое месторождение"));
+    QVERIFY(meta.field_name == copy);
+    QCOMPARE(std::string(meta.quality.c_str()), std::string("good"));
+}
+
+void TestInternedString::testGrouping() {
+    std::vector<WellMetadata> wells(1000);
+    for (size_t i = 0; i < wells.size(); ++i) {
+        wells[i].field_name = "Месторождение " + std::to_string(i % 4);
+        wells[i].well_pad = "Куст " + std::to_string(i % 20);
+    }
+
+    std::unordered_map<InternedString, int> by_field;
+    std::unordered_map<InternedString, int> by_pad;
+    for (const auto& meta : wells) {
+        ++by_field[meta.field_name];
+        ++by_pad[meta.well_pad];
+    }
+
+    QCOMPARE(by_field.size(), static_cast<size_t>(4));
+    QCOMPARE(by_pad.size(), static_cast<size_t>(20));
+    QCOMPARE(by_field[InternedString("Месторождение 1")], 250);
+}
+
+void TestInternedString::testOrdering() {
+    std::map<InternedString, int> ordered;
+    ordered[InternedString("Подрядчик Б")] = 2;
+    ordered[InternedString("Подрядчик А")] = 1;
+    ordered[InternedString("Подрядчик Б")] = 3;
+
+    QCOMPARE(ordered.size(), static_cast<size_t>(2));
+    QVERIFY(ordered.begin()->first == "Подрядчик А");
+    QCOMPARE(ordered.rbegin()->second, 3);
+}
+
+void TestInternedString::testMetadataCopy() {
+    WellMetadata meta;
+    meta.customer = "Заказчик";
+    meta.contractor = "Подрядчик";
+
+    WellMetadata copy = meta;
+    QVERIFY(copy.customer.handle() == meta.customer.handle());
+
+    copy.customer = "Другой заказчик";
+    QVERIFY(meta.customer == "Заказчик");
+    QVERIFY(copy.customer == "Другой заказчик");
+}
+
+void TestInternedString::testConcurrentIntern() {
+    constexpr int kThreads = 8;
+    constexpr int kValues = 64;
+
+    std::vector<std::vector<const void*>> handles(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t, &handles] {
+            for (int i = 0; i < kValues; ++i) {
+                handles[t].push_back(InternedString("Прибор " + std::to_string(i)).handle());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Все потоки получили одни и те же экземпляры строк
+    for (int t = 1; t < kThreads; ++t) {
+        QVERIFY(handles[t] == handles[0]);
+    }
+    QVERIFY(StringPool::instance().size() >= static_cast<size_t>(kValues));
+    QVERIFY(StringPool::instance().memoryUsage() > 0);
+}
+
+QTEST_MAIN(TestInternedString)
+#include "test_interned_string.moc"
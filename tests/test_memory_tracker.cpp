@@ -0,0 +1,148 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "core/memory_tracker.h"
+#include "core/project_manager.h"
+
+using namespace incline3d::core;
+using namespace incline3d::models;
+
+class TestMemoryTracker : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPerWellAccounting();
+    void testCollectors();
+    void testBudgetTriggersEviction();
+    void testNoEvictionWithinBudget();
+    void testJsonDump();
+
+private:
+    static std::shared_ptr<WellData> makeWell(const std::string& name, int points);
+};
+
+std::shared_ptr<WellData> TestMemoryTracker::makeWell(const std::string& name, int points) {
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = name;
+    for (int i = 0; i < points; ++i) {
+        MeasuredPoint pt;
+        pt.measured_depth_m = i;
+        well->measurements.push_back(pt);
+
+        ProcessedPoint result;
+        result.measured_depth_m = i;
+        well->results.push_back(result);
+    }
+    return well;
+}
+
+void TestMemoryTracker::testPerWellAccounting() {
+    ProjectManager manager;
+    manager.newProject();
+    auto small = makeWell("Малая", 10);
+    auto large = makeWell("Большая", 5000);
+    manager.addWell(small);
+    manager.addWell(large);
+
+    MemoryTracker tracker(&manager);
+    auto report = tracker.collect();
+
+    QCOMPARE(report.wells.size(), static_cast<size_t>(2));
+    auto* large_usage = report.findWell(large->id);
+    QVERIFY(large_usage);
+    QCOMPARE(large_usage->name, QString("Большая"));
+    QVERIFY(large_usage->measurements_bytes >= 5000 * sizeof(MeasuredPoint));
+    QVERIFY(large_usage->results_bytes > 0);
+    QVERIFY(large_usage->totalBytes() > report.findWell(small->id)->totalBytes());
+    QCOMPARE(report.totalBytes(), report.wellsBytes());
+}
+
+void TestMemoryTracker::testCollectors() {
+    ProjectManager manager;
+    manager.newProject();
+    auto well = makeWell("Скважина", 100);
+    manager.addWell(well);
+
+    MemoryTracker tracker(&manager);
+    tracker.addCollector([&well](MemoryReport& report) {
+        report.subsystems.push_back({QStringLiteral("Кэш"), 1000, 3, false});
+        report.findWell(well->id)->render_bytes = 500;
+    });
+
+    auto report = tracker.collect();
+    QCOMPARE(report.subsystems.size(), static_cast<size_t>(1));
+    QCOMPARE(report.subsystems[0].item_count, 3);
+    QCOMPARE(report.findWell(well->id)->render_bytes, static_cast<size_t>(500));
+    QCOMPARE(report.totalBytes(), report.wellsBytes() + 1000);
+}
+
+void TestMemoryTracker::testBudgetTriggersEviction() {
+    MemoryTracker tracker(nullptr);
+    std::size_t cache_bytes = 10000;
+    tracker.addCollector([&cache_bytes](MemoryReport& report) {
+        report.subsystems.push_back({QStringLiteral("Сцена"), cache_bytes, 1, true});
+    });
+    tracker.addEvictor([&cache_bytes](std::size_t requested) {
+        const std::size_t freed = std::min(requested, cache_bytes);
+        cache_bytes -= freed;
+        return freed;
+    });
+    tracker.setSoftBudget(4000);
+
+    QSignalSpy exceeded(&tracker, &MemoryTracker::budgetExceeded);
+    QSignalSpy evicted(&tracker, &MemoryTracker::evicted);
+
+    auto report = tracker.enforceBudget();
+    QCOMPARE(exceeded.count(), 1);
+    QCOMPARE(evicted.count(), 1);
+    QCOMPARE(cache_bytes, static_cast<std::size_t>(4000));
+    QVERIFY(!report.overBudget());
+}
+
+void TestMemoryTracker::testNoEvictionWithinBudget() {
+    MemoryTracker tracker(nullptr);
+    int evictor_calls = 0;
+    tracker.addCollector([](MemoryReport& report) {
+        report.subsystems.push_back({QStringLiteral("Сцена"), 100, 1, true});
+    });
+    tracker.addEvictor([&evictor_calls](std::size_t) {
+        ++evictor_calls;
+        return std::size_t{0};
+    });
+
+    // Без бюджета вытеснение не выполняется
+    tracker.enforceBudget();
+    tracker.setSoftBudget(1000);
+    tracker.enforceBudget();
+    QCOMPARE(evictor_calls, 0);
+}
+
+void TestMemoryTracker::testJsonDump() {
+    ProjectManager manager;
+    manager.newProject();
+    manager.addWell(makeWell("Скважина", 50));
+
+    MemoryTracker tracker(&manager);
+    tracker.setSoftBudget(1 << 20);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("memory.json");
+    QVERIFY(tracker.dumpJson(path));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const auto root = QJsonDocument::fromJson(file.readAll()).object();
+    QCOMPARE(root["soft_budget_bytes"].toInteger(), static_cast<qint64>(1 << 20));
+    const auto wells = root["wells"].toArray();
+    QCOMPARE(wells.size(), 1);
+    QCOMPARE(wells[0].toObject()["name"].toString(), QString("Скважина"));
+    QVERIFY(wells[0].toObject()["measurements_bytes"].toInteger() > 0);
+}
+
+QTEST_MAIN(TestMemoryTracker)
+#include "test_memory_tracker.moc"
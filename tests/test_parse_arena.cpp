@@ -0,0 +1,120 @@
+#include <QtTest>
+#include <cmath>
+
+#include "utils/parse_arena.h"
+
+using namespace incline3d::utils;
+
+class TestParseArena : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSplitLine();
+    void testSplitLineSkipEmpty();
+    void testSplitLineAny();
+    void testParseNumber();
+    void testNoHeapForTypicalLines();
+    void testHugeLineFallsBackToHeap();
+};
+
+void TestParseArena::testSplitLine() {
+    ParseArena arena;
+    const QString line = "1000.0\t12.5\t\t270";
+    const auto tokens = split_line(line, u'\t', arena.resource());
+
+    QCOMPARE(tokens.size(), static_cast<size_t>(4));
+    QCOMPARE(tokens[0], QStringView(u"1000.0"));
+    QCOMPARE(tokens[1], QStringView(u"12.5"));
+    QVERIFY(tokens[2].isEmpty());
+    QCOMPARE(tokens[3], QStringView(u"270"));
+
+    // Поля указывают в исходную строку, текст не копируется
+    QCOMPARE(tokens[0].data(), line.constData());
+}
+
+void TestParseArena::testSplitLineSkipEmpty() {
+    ParseArena arena;
+    const auto tokens = split_line(u";;10;;20;", u';', arena.resource(), Qt::SkipEmptyParts);
+
+    QCOMPARE(tokens.size(), static_cast<size_t>(2));
+    QCOMPARE(tokens[0], QStringView(u"10"));
+    QCOMPARE(tokens[1], QStringView(u"20"));
+
+    const auto single = split_line(u"", u';', arena.resource());
+    QCOMPARE(single.size(), static_cast<size_t>(1));
+    QVERIFY(single[0].isEmpty());
+}
+
+void TestParseArena::testSplitLineAny() {
+    ParseArena arena;
+
+    // Пробел в наборе — любые пробельные символы подряд
+    const auto spaced = split_line_any(u"  100.5 \t 3.25   180 ", u" ", arena.resource());
+    QCOMPARE(spaced.size(), static_cast<size_t>(3));
+    QCOMPARE(spaced[0], QStringView(u"100.5"));
+    QCOMPARE(spaced[2], QStringView(u"180"));
+
+    const auto mixed = split_line_any(u"10;20,30\t40", u";,\t", arena.resource());
+    QCOMPARE(mixed.size(), static_cast<size_t>(4));
+    QCOMPARE(mixed[3], QStringView(u"40"));
+
+    const auto lines = split_line_any(u"a\r\n\r\nb\n", u"\r\n", arena.resource());
+    QCOMPARE(lines.size(), static_cast<size_t>(2));
+    QCOMPARE(lines[1], QStringView(u"b"));
+
+    QVERIFY(split_line_any(u"   ", u" ", arena.resource()).empty());
+}
+
+void TestParseArena::testParseNumber() {
+    bool ok = false;
+    QCOMPARE(parse_number(u" 12.5 ", &ok), 12.5);
+    QVERIFY(ok);
+
+    parse_number(u"12,5", &ok);
+    QVERIFY(!ok);
+
+    QCOMPARE(parse_number(u"12,5", &ok, true), 12.5);
+    QVERIFY(ok);
+
+    const QString source = "7,25";
+    parse_number(source, &ok, true);
+    QCOMPARE(source, QString("7,25"));  // Исходная строка не изменилась
+
+    parse_number(u"abc", &ok);
+    QVERIFY(!ok);
+}
+
+void TestParseArena::testNoHeapForTypicalLines() {
+    ParseArena arena;
+    const QString line = "1234.56\t12.34\t123.45\t124.56\t0.5\t1234.50\t-12.3\t45.6";
+
+    double sum = 0.0;
+    for (int i = 0; i < 10000; ++i) {
+        arena.reset();
+        const auto tokens = split_line(line, u'\t', arena.resource());
+        for (const auto token : tokens) {
+            sum += parse_number(token);
+        }
+    }
+
+    QVERIFY(std::isfinite(sum));
+    QCOMPARE(arena.heapAllocations(), static_cast<size_t>(0));
+    QCOMPARE(arena.heapBytes(), static_cast<size_t>(0));
+}
+
+void TestParseArena::testHugeLineFallsBackToHeap() {
+    ParseArena arena;
+    QString line;
+    for (int i = 0; i < 2000; ++i) {
+        line += QString::number(i) + ';';
+    }
+
+    const auto tokens = split_line(line, u';', arena.resource());
+    QCOMPARE(tokens.size(), static_cast<size_t>(2001));
+    QCOMPARE(tokens[1999], QStringView(u"1999"));
+    QVERIFY(arena.heapAllocations() > 0);
+    QVERIFY(arena.heapBytes() >= tokens.size() * sizeof(QStringView));
+}
+
+QTEST_MAIN(TestParseArena)
+#include "test_parse_arena.moc"
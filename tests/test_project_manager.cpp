@@ -20,6 +20,8 @@ private slots:
     void testNewProject();
     void testAddWell();
     void testRemoveWell();
+    void testReplaceWell();
+    void testWellSnapshots();
     void testDirtyState();
     void testProjectFileFilter();
     void testSignals();
@@ -82,6 +84,69 @@ void TestProjectManager::testRemoveWell() {
     QCOMPARE(manager_->wells().at(0)->metadata.well_name, std::string("Скважина 2"));
 }
 
+void TestProjectManager::testReplaceWell() {
+    manager_->newProject();
+
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = "Скважина 1";
+    well->display_color = Qt::red;
+    well->visible = false;
+    well->params.magnetic_declination_deg = 12.5;
+    manager_->addWell(well);
+
+    auto reloaded = std::make_shared<WellData>();
+    reloaded->metadata.well_name = "Скважина 1";
+    reloaded->measurements.push_back(MeasuredPoint{});
+
+    QSignalSpy replacedSpy(manager_, &ProjectManager::wellReplaced);
+    QSignalSpy wellsSpy(manager_, &ProjectManager::wellsChanged);
+
+    QVERIFY(manager_->replaceWell(0, reloaded));
+    QVERIFY(!manager_->replaceWell(5, reloaded));
+
+    QCOMPARE(replacedSpy.count(), 1);
+    QCOMPARE(replacedSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(wellsSpy.count(), 0);
+
+    // Данные заменены, пользовательские настройки сохранены
+    const auto& current = manager_->wells().at(0);
+    QCOMPARE(current.get(), reloaded.get());
+    QCOMPARE(current->measurements.size(), static_cast<size_t>(1));
+    QCOMPARE(current->display_color, QColor(Qt::red));
+    QVERIFY(!current->visible);
+    QCOMPARE(current->params.magnetic_declination_deg, 12.5);
+}
+
+void TestProjectManager::testWellSnapshots() {
+    manager_->newProject();
+
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = "Скважина";
+    manager_->addWell(well);
+
+    auto first = manager_->snapshot(well->id);
+    QVERIFY(first);
+    QCOMPARE(first->version, static_cast<std::uint64_t>(1));
+
+    well->metadata.well_name = "Переименована";
+    manager_->publishWell(well->id);
+
+    auto second = manager_->snapshot(well->id);
+    QCOMPARE(second->version, static_cast<std::uint64_t>(2));
+    QCOMPARE(second->data.metadata.well_name, std::string("Переименована"));
+    QCOMPARE(first->data.metadata.well_name, std::string("Скважина"));
+
+    // Удерживаемый читателем снимок переживает удаление скважины
+    manager_->removeWell(well->id);
+    QVERIFY(!manager_->snapshot(well->id));
+    QCOMPARE(second->version, static_cast<std::uint64_t>(2));
+
+    // Скважина, возвращённая с тем же идентификатором, не повторяет номера версий
+    manager_->insertWell(0, well, ProjectData::WellEntry{});
+    auto third = manager_->snapshot(well->id);
+    QCOMPARE(third->version, static_cast<std::uint64_t>(3));
+}
+
 void TestProjectManager::testDirtyState() {
     manager_->newProject();
     QVERIFY(!manager_->isDirty());
@@ -0,0 +1,110 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "utils/range_allocator.h"
+
+using namespace incline3d::utils;
+
+class TestRangeAllocator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSequential();
+    void testReuseAndSplit();
+    void testMergeAndShrink();
+    void testRandomNoOverlap();
+};
+
+void TestRangeAllocator::testSequential() {
+    RangeAllocator allocator;
+    QVERIFY(allocator.allocate(0).empty());
+
+    const auto a = allocator.allocate(10);
+    const auto b = allocator.allocate(5);
+    QCOMPARE(a.offset, static_cast<size_t>(0));
+    QCOMPARE(b.offset, static_cast<size_t>(10));
+    QCOMPARE(allocator.end(), static_cast<size_t>(15));
+    QCOMPARE(allocator.used(), static_cast<size_t>(15));
+}
+
+void TestRangeAllocator::testReuseAndSplit() {
+    RangeAllocator allocator;
+    const auto a = allocator.allocate(10);
+    allocator.allocate(10);
+
+    allocator.free(a);
+    QCOMPARE(allocator.end(), static_cast<size_t>(20));
+
+    // Освобождённое место занимается повторно, остаток остаётся свободным
+    const auto c = allocator.allocate(4);
+    const auto d = allocator.allocate(6);
+    QCOMPARE(c.offset, static_cast<size_t>(0));
+    QCOMPARE(d.offset, static_cast<size_t>(4));
+    QCOMPARE(allocator.end(), static_cast<size_t>(20));
+
+    // Не помещающийся диапазон уходит в конец
+    const auto e = allocator.allocate(11);
+    QCOMPARE(e.offset, static_cast<size_t>(20));
+}
+
+void TestRangeAllocator::testMergeAndShrink() {
+    RangeAllocator allocator;
+    const auto a = allocator.allocate(10);
+    const auto b = allocator.allocate(10);
+    const auto c = allocator.allocate(10);
+
+    allocator.free(a);
+    allocator.free(b);
+    // Слитые a и b вмещают диапазон в 20 элементов
+    const auto d = allocator.allocate(20);
+    QCOMPARE(d.offset, static_cast<size_t>(0));
+
+    // Освобождение хвоста сдвигает границу назад
+    allocator.free(c);
+    QCOMPARE(allocator.end(), static_cast<size_t>(20));
+    allocator.free(d);
+    QCOMPARE(allocator.end(), static_cast<size_t>(0));
+    QCOMPARE(allocator.used(), static_cast<size_t>(0));
+}
+
+void TestRangeAllocator::testRandomNoOverlap() {
+    RangeAllocator allocator;
+    std::mt19937 rng(42);
+    std::vector<RangeAllocator::Range> live;
+
+    for (int step = 0; step < 5000; ++step) {
+        if (!live.empty() && rng() % 3 == 0) {
+            const auto index = rng() % live.size();
+            allocator.free(live[index]);
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(index));
+        } else {
+            live.push_back(allocator.allocate(1 + rng() % 100));
+        }
+
+        if (step % 100 == 0) {
+            auto sorted = live;
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const auto& a, const auto& b) { return a.offset < b.offset; });
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < sorted.size(); ++i) {
+                total += sorted[i].size;
+                QVERIFY(sorted[i].end() <= allocator.end());
+                if (i > 0) {
+                    QVERIFY(sorted[i - 1].end() <= sorted[i].offset);
+                }
+            }
+            QCOMPARE(allocator.used(), total);
+        }
+    }
+
+    for (const auto& range : live) {
+        allocator.free(range);
+    }
+    QCOMPARE(allocator.end(), static_cast<size_t>(0));
+}
+
+QTEST_MAIN(TestRangeAllocator)
+#include "test_range_allocator.moc"
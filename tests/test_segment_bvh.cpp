@@ -0,0 +1,337 @@
+#include <QtTest>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "models/segment_bvh.h"
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+
+using namespace incline3d::models;
+
+class TestSegmentBvh : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptyAndShort();
+    void testMatchesBruteForce();
+    void testNearestHitWins();
+    void testToleranceGrowsAlongRay();
+    void testSampleStation();
+    void testCachedUntilChange();
+    void testTrajectoryBvhMatchesScan();
+
+private:
+    struct Trajectory {
+        std::vector<double> east;
+        std::vector<double> north;
+        std::vector<double> tvd;
+    };
+
+    /// Наклонно-направленная скважина с шагом 1 м: вертикальный участок, набор и спираль
+    static Trajectory makeTrajectory(int count);
+
+    /// Ближайшее попадание перебором всех сегментов
+    static std::optional<double> bruteForce(const Trajectory& t, const PickRay& ray);
+
+    /// Луч из точки from в точку to
+    static PickRay makeRay(const std::array<double, 3>& from, const std::array<double, 3>& to,
+                           double radius);
+};
+
+TestSegmentBvh::Trajectory TestSegmentBvh::makeTrajectory(int count) {
+    Trajectory t;
+    for (int i = 0; i < count; ++i) {
+        const double s = i;
+        const double bend = std::max(0.0, s - 300.0);
+        t.east.push_back(1000.0 + bend * 0.3 + 20.0 * std::sin(bend / 150.0));
+        t.north.push_back(-500.0 + bend * 0.1 + 20.0 * (1.0 - std::cos(bend / 150.0)));
+        t.tvd.push_back(s - bend * 0.2);
+    }
+    return t;
+}
+
+std::optional<double> TestSegmentBvh::bruteForce(const Trajectory& t, const PickRay& ray) {
+    std::optional<double> best;
+    const auto& o = ray.origin;
+    const auto& d = ray.direction;
+    for (std::size_t i = 0; i + 1 < t.east.size(); ++i) {
+        // Ближайшая к лучу точка сегмента перебором с мелким шагом
+        double segment_miss = std::numeric_limits<double>::infinity();
+        double segment_along = 0.0;
+        for (int k = 0; k <= 200; ++k) {
+            const double s = k / 200.0;
+            const double p[3] = {t.east[i] + s * (t.east[i + 1] - t.east[i]),
+                                 t.north[i] + s * (t.north[i + 1] - t.north[i]),
+                                 t.tvd[i] + s * (t.tvd[i + 1] - t.tvd[i])};
+            const double along = std::max(0.0, (p[0] - o[0]) * d[0] + (p[1] - o[1]) * d[1] +
+                                                   (p[2] - o[2]) * d[2]);
+            const double q[3] = {o[0] + along * d[0] - p[0], o[1] + along * d[1] - p[1],
+                                 o[2] + along * d[2] - p[2]};
+            const double miss = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2]);
+            if (miss < segment_miss) {
+                segment_miss = miss;
+                segment_along = along;
+            }
+        }
+        if (segment_miss <= ray.radiusAt(segment_along) && (!best || segment_along < *best)) {
+            best = segment_along;
+        }
+    }
+    return best;
+}
+
+PickRay TestSegmentBvh::makeRay(const std::array<double, 3>& from, const std::array<double, 3>& to,
+                                double radius) {
+    PickRay ray;
+    ray.origin = from;
+    const double d[3] = {to[0] - from[0], to[1] - from[1], to[2] - from[2]};
+    const double length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    ray.direction = {d[0] / length, d[1] / length, d[2] / length};
+    ray.radius_m = radius;
+    return ray;
+}
+
+void TestSegmentBvh::testEmptyAndShort() {
+    const auto empty = SegmentBvh::build({}, {}, {});
+    QVERIFY(empty.empty());
+    QVERIFY(!empty.pick(makeRay({0, 0, -10}, {0, 0, 0}, 1.0)));
+
+    const double e[] = {5.0};
+    const double n[] = {5.0};
+    const double z[] = {5.0};
+    QVERIFY(SegmentBvh::build(e, n, z).empty());
+
+    const double e2[] = {0.0, 0.0};
+    const double n2[] = {0.0, 0.0};
+    const double z2[] = {0.0, 100.0};
+    const auto single = SegmentBvh::build(e2, n2, z2);
+    QCOMPARE(single.segmentCount(), static_cast<size_t>(1));
+
+    // Горизонтальный луч с запада на глубине 40 м
+    const auto hit = single.pick(makeRay({-50, 0, 40}, {0, 0, 40}, 0.5));
+    QVERIFY(hit.has_value());
+    QCOMPARE(hit->segment, static_cast<std::uint32_t>(0));
+    QVERIFY(std::abs(hit->fraction - 0.4) < 1e-6);
+    QVERIFY(std::abs(hit->ray_distance - 50.0) < 1e-4);
+
+    // Ниже забоя — промах
+    QVERIFY(!single.pick(makeRay({-50, 0, 120}, {0, 0, 120}, 0.5)));
+}
+
+void TestSegmentBvh::testMatchesBruteForce() {
+    const auto t = makeTrajectory(1500);
+    const auto bvh = SegmentBvh::build(t.east, t.north, t.tvd);
+    QCOMPARE(bvh.segmentCount(), static_cast<size_t>(1499));
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> point(0, 1498);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    int hits = 0;
+    for (int i = 0; i < 200; ++i) {
+        // Половина лучей нацелена рядом с траекторией, половина — в случайную точку
+        const int p = point(rng);
+        std::array<double, 3> target = {t.east[p] + 3.0 * unit(rng), t.north[p] + 3.0 * unit(rng),
+                                        t.tvd[p] + 3.0 * unit(rng)};
+        if (i % 2 == 1) {
+            target = {1000.0 + 200.0 * unit(rng), -500.0 + 200.0 * unit(rng), 600.0 + 600.0 * unit(rng)};
+        }
+        const std::array<double, 3> from = {target[0] + 2000.0 * unit(rng), target[1] + 2000.0 * unit(rng),
+                                            target[2] - 2000.0};
+        auto ray = makeRay(from, target, 0.5);
+        ray.radius_per_m = 0.001;
+
+        const auto expected = bruteForce(t, ray);
+        const auto hit = bvh.pick(ray);
+        QCOMPARE(hit.has_value(), expected.has_value());
+        if (hit) {
+            ++hits;
+            QVERIFY(hit->miss_distance <= ray.radiusAt(hit->ray_distance) + 1e-6);
+            QVERIFY(std::abs(hit->ray_distance - *expected) < 0.05);
+        }
+    }
+    QVERIFY(hits > 50);
+}
+
+void TestSegmentBvh::testNearestHitWins() {
+    // Два вертикальных ствола на одной линии взгляда: ближний закрывает дальний
+    const double e[] = {0.0, 0.0, 0.0, 100.0, 100.0};
+    const double n[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    const double z[] = {0.0, 500.0, 1000.0, 1000.0, 0.0};
+    const auto bvh = SegmentBvh::build(e, n, z);
+
+    const auto from_west = bvh.pick(makeRay({-100, 0, 250}, {0, 0, 250}, 1.0));
+    QVERIFY(from_west.has_value());
+    QCOMPARE(from_west->segment, static_cast<std::uint32_t>(0));
+    QVERIFY(std::abs(from_west->ray_distance - 100.0) < 1e-3);
+
+    const auto from_east = bvh.pick(makeRay({200, 0, 250}, {100, 0, 250}, 1.0));
+    QVERIFY(from_east.has_value());
+    QCOMPARE(from_east->segment, static_cast<std::uint32_t>(3));
+    QVERIFY(std::abs(from_east->fraction - 0.75) < 1e-6);
+}
+
+void TestSegmentBvh::testToleranceGrowsAlongRay() {
+    const double e[] = {0.0, 0.0};
+    const double n[] = {0.0, 0.0};
+    const double z[] = {0.0, 100.0};
+    const auto bvh = SegmentBvh::build(e, n, z);
+
+    // Луч проходит в 5 м от ствола на расстоянии 1000 м от начала
+    auto ray = makeRay({-1000, 5, 50}, {0, 5, 50}, 1.0);
+    QVERIFY(!bvh.pick(ray));
+
+    ray.radius_per_m = 0.005;   // 1 + 5 = 6 м на расстоянии 1000 м
+    const auto hit = bvh.pick(ray);
+    QVERIFY(hit.has_value());
+    QVERIFY(std::abs(hit->miss_distance - 5.0) < 1e-4);
+}
+
+void TestSegmentBvh::testSampleStation() {
+    TrajectoryColumns columns;
+    ProcessedPoint a;
+    a.measured_depth_m = 1000.0;
+    a.inclination_deg = 10.0;
+    a.azimuth_deg = 350.0;
+    a.tvd_m = 990.0;
+    ProcessedPoint b = a;
+    b.measured_depth_m = 1010.0;
+    b.inclination_deg = 12.0;
+    b.azimuth_deg = 10.0;
+    b.tvd_m = 999.0;
+    b.east_m = 1.0;
+    columns.push_back(a);
+    columns.push_back(b);
+
+    SegmentHit hit;
+    hit.segment = 0;
+    hit.fraction = 0.25;
+    auto sample = sample_station(columns, hit);
+    QVERIFY(std::abs(sample.md_m - 1002.5) < 1e-9);
+    QVERIFY(std::abs(sample.inclination_deg - 10.5) < 1e-9);
+    QVERIFY(std::abs(sample.tvd_m - 992.25) < 1e-9);
+    QVERIFY(std::abs(sample.east_m - 0.25) < 1e-9);
+
+    // Азимут интерполируется через север, а не через юг
+    QVERIFY(sample.azimuth_deg.has_value());
+    QVERIFY(std::abs(*sample.azimuth_deg - 355.0) < 1e-9);
+    hit.fraction = 0.75;
+    QVERIFY(std::abs(*sample_station(columns, hit).azimuth_deg - 5.0) < 1e-9);
+
+    ProcessedPoint c = b;
+    c.azimuth_deg.reset();
+    columns.set(1, c);
+    QVERIFY(!sample_station(columns, hit).azimuth_deg.has_value());
+}
+
+void TestSegmentBvh::testCachedUntilChange() {
+    TrajectoryColumns columns;
+    QVERIFY(!columns.segmentBvh());
+
+    for (int i = 0; i < 100; ++i) {
+        ProcessedPoint pt;
+        pt.measured_depth_m = i * 10.0;
+        pt.tvd_m = i * 10.0;
+        columns.push_back(pt);
+    }
+
+    const auto first = columns.segmentBvh();
+    QVERIFY(first);
+    QCOMPARE(first->segmentCount(), static_cast<size_t>(99));
+    QCOMPARE(columns.segmentBvh(), first);
+
+    // Копия разделяет хранилище и кэш
+    const TrajectoryColumns copy = columns;
+    QCOMPARE(copy.segmentBvh(), first);
+
+    // Запись сбрасывает кэш только у изменённого объекта
+    ProcessedPoint pt;
+    pt.measured_depth_m = 1000.0;
+    pt.tvd_m = 1000.0;
+    columns.push_back(pt);
+    QVERIFY(columns.segmentBvh() != first);
+    QCOMPARE(columns.segmentBvh()->segmentCount(), static_cast<size_t>(100));
+    QCOMPARE(copy.segmentBvh(), first);
+}
+
+void TestSegmentBvh::testTrajectoryBvhMatchesScan() {
+    QVERIFY(TrajectoryBvh::build({}).empty());
+
+    // Куст 10 × 10 скважин с шагом 500 м
+    const auto base = makeTrajectory(600);
+    std::vector<SegmentBvh> wells;
+    std::vector<TrajectoryBvh::Bounds> bounds;
+    for (int row = 0; row < 10; ++row) {
+        for (int column = 0; column < 10; ++column) {
+            Trajectory t = base;
+            TrajectoryBvh::Bounds box;
+            box.min = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                       std::numeric_limits<double>::infinity()};
+            box.max = {-box.min[0], -box.min[1], -box.min[2]};
+            for (std::size_t i = 0; i < t.east.size(); ++i) {
+                t.east[i] += column * 500.0;
+                t.north[i] += row * 500.0;
+                const double p[3] = {t.east[i], t.north[i], t.tvd[i]};
+                for (int axis = 0; axis < 3; ++axis) {
+                    box.min[axis] = std::min(box.min[axis], p[axis]);
+                    box.max[axis] = std::max(box.max[axis], p[axis]);
+                }
+            }
+            wells.push_back(SegmentBvh::build(t.east, t.north, t.tvd));
+            bounds.push_back(box);
+        }
+    }
+    const auto bvh = TrajectoryBvh::build(bounds);
+    QCOMPARE(bvh.size(), wells.size());
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> well(0, 99);
+    std::uniform_int_distribution<int> point(0, 598);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+    int hits = 0;
+    for (int i = 0; i < 200; ++i) {
+        // Луч сверху-сбоку в точку рядом со случайной скважиной
+        const int w = well(rng);
+        const int p = point(rng);
+        const std::array<double, 3> target = {base.east[p] + (w % 10) * 500.0 + 3.0 * unit(rng),
+                                              base.north[p] + (w / 10) * 500.0 + 3.0 * unit(rng),
+                                              base.tvd[p] + 3.0 * unit(rng)};
+        const std::array<double, 3> from = {target[0] + 300.0 * unit(rng), target[1] + 300.0 * unit(rng),
+                                            target[2] - 3000.0};
+        auto ray = makeRay(from, target, 0.5);
+        ray.radius_per_m = 0.001;
+
+        std::optional<SegmentHit> expected;
+        std::size_t expected_well = 0;
+        for (std::size_t k = 0; k < wells.size(); ++k) {
+            const auto hit = wells[k].pick(ray);
+            if (hit && (!expected || hit->ray_distance < expected->ray_distance)) {
+                expected = hit;
+                expected_well = k;
+            }
+        }
+
+        int visited = 0;
+        const auto hit = bvh.pick(ray, [&wells, &ray, &visited](std::uint32_t item) {
+            ++visited;
+            return wells[item].pick(ray);
+        });
+        QCOMPARE(hit.has_value(), expected.has_value());
+        if (hit) {
+            ++hits;
+            QCOMPARE(static_cast<std::size_t>(hit->item), expected_well);
+            QCOMPARE(hit->hit.ray_distance, expected->ray_distance);
+        }
+        // Крутой луч задевает боксы лишь нескольких скважин
+        QVERIFY(visited < 20);
+    }
+    QVERIFY(hits > 50);
+}
+
+QTEST_MAIN(TestSegmentBvh)
+#include "test_segment_bvh.moc"
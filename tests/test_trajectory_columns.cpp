@@ -0,0 +1,297 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "models/well_data.h"
+
+using namespace incline3d::models;
+
+using Column = TrajectoryColumns::Column;
+
+class TestTrajectoryColumns : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testRoundTrip();
+    void testOptionalValidity();
+    void testSparseColumnsCreatedLazily();
+    void testCopySharesStorage();
+    void testRandomAccessIterator();
+    void testMemoryBelowRowStorage();
+    void testGeometrySummary();
+    void testGeometryInvalidatedOnWrite();
+    void testRevision();
+    void testReleaseDerivedCaches();
+
+private:
+    static ProcessedPoint makePoint(double depth);
+};
+
+ProcessedPoint TestTrajectoryColumns::makePoint(double depth) {
+    ProcessedPoint pt;
+    pt.measured_depth_m = depth;
+    pt.inclination_deg = depth / 100.0;
+    pt.azimuth_deg = 45.0;
+    pt.applied_azimuth_deg = 46.5;
+    pt.north_m = depth * 0.1;
+    pt.east_m = depth * 0.2;
+    pt.tvd_m = depth * 0.9;
+    pt.intensity_10m = 0.5;
+    return pt;
+}
+
+void TestTrajectoryColumns::testEmpty() {
+    TrajectoryColumns columns;
+
+    QVERIFY(columns.empty());
+    QCOMPARE(columns.size(), static_cast<size_t>(0));
+    QVERIFY(columns.begin() == columns.end());
+    QVERIFY(columns.column(Column::kEast).empty());
+    QCOMPARE(columns.memoryUsage(), static_cast<size_t>(0));
+}
+
+void TestTrajectoryColumns::testRoundTrip() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 10; ++i) {
+        columns.push_back(makePoint(i * 10.0));
+    }
+
+    QCOMPARE(columns.size(), static_cast<size_t>(10));
+    QCOMPARE(columns[3].east_m, 6.0);
+    QCOMPARE(columns.back().measured_depth_m, 90.0);
+    QVERIFY_EXCEPTION_THROWN(columns.at(10), std::out_of_range);
+
+    const auto tvd = columns.column(Column::kTvd);
+    QCOMPARE(tvd.size(), static_cast<size_t>(10));
+    QCOMPARE(tvd[5], 45.0);
+
+    int count = 0;
+    for (const auto& pt : columns) {
+        QCOMPARE(pt.measured_depth_m, count * 10.0);
+        ++count;
+    }
+    QCOMPARE(count, 10);
+
+    auto pt = columns[4];
+    pt.north_m = -1.0;
+    columns.set(4, pt);
+    QCOMPARE(columns.value(Column::kNorth, 4), -1.0);
+}
+
+void TestTrajectoryColumns::testOptionalValidity() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 100; ++i) {
+        auto pt = makePoint(i);
+        if (i % 3 == 0) {
+            pt.azimuth_deg.reset();
+        }
+        if (i == 70) {
+            pt.tvd_bgl_m = 0.0;   // Нулевое значение — тоже значение
+        }
+        columns.push_back(pt);
+    }
+
+    QVERIFY(!columns[0].azimuth_deg.has_value());
+    QCOMPARE(columns[1].azimuth_deg, std::optional<double>(45.0));
+    QVERIFY(!columns.hasValue(Column::kAzimuth, 99));
+    QVERIFY(columns.hasValue(Column::kAzimuth, 98));
+
+    QVERIFY(!columns[69].tvd_bgl_m.has_value());
+    QCOMPARE(columns[70].tvd_bgl_m, std::optional<double>(0.0));
+    QVERIFY(!columns[71].tvd_bgl_m.has_value());
+
+    auto pt = columns[1];
+    pt.azimuth_deg.reset();
+    columns.set(1, pt);
+    QVERIFY(!columns.optionalValue(Column::kAzimuth, 1).has_value());
+}
+
+void TestTrajectoryColumns::testSparseColumnsCreatedLazily() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 50; ++i) {
+        columns.push_back(makePoint(i));
+    }
+    QVERIFY(columns.column(Column::kMistakeX).empty());
+    QCOMPARE(columns.value(Column::kMistakeX, 10), 0.0);
+
+    auto pt = makePoint(50);
+    pt.mistake_x = 0.25;
+    columns.push_back(pt);
+
+    const auto mistakes = columns.column(Column::kMistakeX);
+    QCOMPARE(mistakes.size(), static_cast<size_t>(51));
+    QCOMPARE(mistakes[49], 0.0);
+    QCOMPARE(mistakes[50], 0.25);
+}
+
+void TestTrajectoryColumns::testCopySharesStorage() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 20; ++i) {
+        columns.push_back(makePoint(i));
+    }
+
+    TrajectoryColumns copy = columns;
+    QVERIFY(copy.sharesStorageWith(columns));
+
+    auto pt = columns[5];
+    pt.tvd_m = 999.0;
+    columns.set(5, pt);
+
+    QVERIFY(!copy.sharesStorageWith(columns));
+    QCOMPARE(copy[5].tvd_m, 4.5);
+    QCOMPARE(columns[5].tvd_m, 999.0);
+
+    // Отделяется только изменённая колонка, запись без изменений не копирует ничего
+    const int created = copy.sharedColumnCount(copy);
+    QCOMPARE(columns.sharedColumnCount(copy), created - 1);
+    columns.set(6, columns[6]);
+    QCOMPARE(columns.sharedColumnCount(copy), created - 1);
+}
+
+void TestTrajectoryColumns::testRandomAccessIterator() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 50; ++i) {
+        columns.push_back(makePoint(i * 10.0));
+    }
+
+    // Двоичный поиск по глубине
+    const auto it = std::lower_bound(columns.begin(), columns.end(), 235.0,
+                                     [](const ProcessedPoint& pt, double depth) {
+                                         return pt.measured_depth_m < depth;
+                                     });
+    QCOMPARE(it - columns.begin(), static_cast<std::ptrdiff_t>(24));
+    QCOMPARE(columns.begin()[24].measured_depth_m, 240.0);
+    QCOMPARE((*(3 + columns.begin())).measured_depth_m, 30.0);
+
+    auto back = columns.end();
+    back -= 1;
+    QVERIFY(columns.begin() < back);
+    QVERIFY(back > columns.begin());
+    QCOMPARE((*back).measured_depth_m, 490.0);
+}
+
+void TestTrajectoryColumns::testMemoryBelowRowStorage() {
+    constexpr size_t kCount = 10000;
+    TrajectoryColumns columns;
+    columns.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        columns.push_back(makePoint(static_cast<double>(i)));
+    }
+
+    // Без погрешностей и отметок колонки занимают менее половины построчного хранения
+    QVERIFY(columns.memoryUsage() < kCount * sizeof(ProcessedPoint) / 2);
+}
+
+void TestTrajectoryColumns::testGeometrySummary() {
+    TrajectoryColumns columns;
+    QVERIFY(!columns.geometry().valid);
+
+    for (int i = 0; i <= 10; ++i) {
+        auto pt = makePoint(i * 100.0);
+        pt.intensity_10m = (i == 7) ? 2.5 : 0.5;
+        columns.push_back(pt);
+    }
+
+    const auto geometry = columns.geometry();
+    QVERIFY(geometry.valid);
+    QCOMPARE(geometry.station_count, static_cast<size_t>(11));
+    QCOMPARE(geometry.md_start, 0.0);
+    QCOMPARE(geometry.md_end, 1000.0);
+    QCOMPARE(geometry.max_tvd, 900.0);
+    QCOMPARE(geometry.max_east, 200.0);
+    QCOMPARE(geometry.min_north, 0.0);
+    QCOMPARE(geometry.max_inclination_deg, 10.0);
+    QCOMPARE(geometry.max_inclination_depth, 1000.0);
+    QCOMPARE(geometry.max_intensity_10m, 2.5);
+    QCOMPARE(geometry.max_intensity_10m_depth, 700.0);
+    QCOMPARE(geometry.td_north, 100.0);
+    QCOMPARE(geometry.horizontalDisplacement(), std::sqrt(100.0 * 100.0 + 200.0 * 200.0));
+
+    // Профиль по азимуту 90° — проекция на восток
+    const auto [x0, x1] = geometry.profileRange(90.0);
+    QVERIFY(std::abs(x0) < 1e-9);
+    QVERIFY(std::abs(x1 - 200.0) < 1e-9);
+}
+
+void TestTrajectoryColumns::testGeometryInvalidatedOnWrite() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 5; ++i) {
+        columns.push_back(makePoint(i * 10.0));
+    }
+    QCOMPARE(columns.geometry().max_tvd, 36.0);
+
+    TrajectoryColumns copy = columns;
+    auto pt = columns[2];
+    pt.tvd_m = 500.0;
+    columns.set(2, pt);
+
+    QCOMPARE(columns.geometry().max_tvd, 500.0);
+    QCOMPARE(copy.geometry().max_tvd, 36.0);
+
+    columns.push_back(makePoint(1000.0));
+    QCOMPARE(columns.geometry().md_end, 1000.0);
+    QCOMPARE(columns.geometry().max_tvd, 900.0);
+}
+
+void TestTrajectoryColumns::testRevision() {
+    TrajectoryColumns columns;
+    QCOMPARE(columns.revision(), static_cast<std::uint64_t>(0));
+
+    columns.push_back(makePoint(0.0));
+    columns.push_back(makePoint(10.0));
+    const auto first = columns.revision();
+    QVERIFY(first != 0);
+    QCOMPARE(columns.revision(), first);
+
+    // Копия разделяет хранилище и номер
+    TrajectoryColumns copy = columns;
+    QCOMPARE(copy.revision(), first);
+
+    // Запись в единственного владельца меняет номер
+    columns.push_back(makePoint(20.0));
+    const auto second = columns.revision();
+    QVERIFY(second != first);
+
+    // Запись в разделяемое хранилище отделяет копию, номер оригинала прежний
+    copy = columns;
+    auto pt = copy[1];
+    pt.tvd_m = 100.0;
+    copy.set(1, pt);
+    QCOMPARE(columns.revision(), second);
+    QVERIFY(copy.revision() != second);
+    QVERIFY(copy.revision() != first);
+}
+
+void TestTrajectoryColumns::testReleaseDerivedCaches() {
+    TrajectoryColumns columns;
+    for (int i = 0; i < 500; ++i) {
+        columns.push_back(makePoint(i * 10.0));
+    }
+    const size_t data_bytes = columns.memoryUsage();
+    QCOMPARE(columns.cacheMemoryUsage(), static_cast<size_t>(0));
+
+    // Кэши учитываются отдельно от данных
+    const auto lod = columns.lod();
+    const auto bvh = columns.segmentBvh();
+    QVERIFY(lod && bvh);
+    QCOMPARE(columns.memoryUsage(), data_bytes);
+    QCOMPARE(columns.cacheMemoryUsage(), lod->memoryUsage() + bvh->memoryUsage());
+
+    // Освобождение не меняет данные и номер содержимого, кэш строится заново
+    const auto revision = columns.revision();
+    QCOMPARE(columns.releaseDerivedCaches(), lod->memoryUsage() + bvh->memoryUsage());
+    QCOMPARE(columns.cacheMemoryUsage(), static_cast<size_t>(0));
+    QCOMPARE(columns.releaseDerivedCaches(), static_cast<size_t>(0));
+    QCOMPARE(columns.revision(), revision);
+    QCOMPARE(columns.size(), static_cast<size_t>(500));
+
+    const auto rebuilt = columns.lod();
+    QVERIFY(rebuilt && rebuilt != lod);
+    QCOMPARE(rebuilt->levelCount(), lod->levelCount());
+}
+
+QTEST_MAIN(TestTrajectoryColumns)
+#include "test_trajectory_columns.moc"
@@ -0,0 +1,188 @@
+#include <QtTest>
+
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+#include "views/trajectory_layer_item.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestTrajectoryLayerItem : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testBounds();
+    void testWellAt();
+    void testVisibilityAndRemoval();
+    void testDetailFromTransform();
+    void testExposedRect();
+
+private:
+    /// Волнистая траектория на восток от (east, north): 1000 м, замеры через 10 м
+    static WellData makeWell(double east, double north);
+
+    /// Нарисовать слой в изображение 200×200 с заданным масштабом, пикселей на метр
+    static TrajectoryLayerItem::PaintStats paintLayer(TrajectoryLayerItem& layer, double scale,
+                                                      const QRectF& exposed);
+};
+
+WellData TestTrajectoryLayerItem::makeWell(double east, double north) {
+    WellData well;
+    well.id = WellId::generate();
+    well.metadata.well_name = "well";
+    for (int i = 0; i <= 100; ++i) {
+        ProcessedPoint pt;
+        pt.measured_depth_m = i * 10.0;
+        pt.east_m = east + i * 10.0;
+        pt.north_m = north + 20.0 * std::sin(i * 0.3);
+        well.results.push_back(pt);
+    }
+    return well;
+}
+
+TrajectoryLayerItem::PaintStats TestTrajectoryLayerItem::paintLayer(TrajectoryLayerItem& layer, double scale,
+                                                                    const QRectF& exposed) {
+    QImage image(200, 200, QImage::Format_RGB32);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    painter.scale(scale, -scale);
+
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = exposed;
+    layer.paint(&painter, &option, nullptr);
+    return layer.takePaintStats();
+}
+
+void TestTrajectoryLayerItem::testBounds() {
+    TrajectoryLayerItem layer;
+    QVERIFY(layer.boundingRect().isNull());
+
+    const WellData first = makeWell(0.0, 0.0);
+    const WellData second = makeWell(2000.0, 500.0);
+    layer.setWell(first);
+    layer.setWell(second);
+    QCOMPARE(layer.wellCount(), 2);
+    QVERIFY(layer.hasWell(first.id));
+
+    // Габариты — траектории и поле под устья
+    layer.setPixelSize(2.0);
+    const QRectF bounds = layer.boundingRect();
+    const double margin = TrajectoryLayerItem::kWellheadRadius * 2.0;
+    QVERIFY(std::abs(bounds.left() - (0.0 - margin)) < 1e-9);
+    QVERIFY(std::abs(bounds.right() - (3000.0 + margin)) < 1e-9);
+    QVERIFY(bounds.top() < -19.0 - margin);
+    QVERIFY(bounds.bottom() > 519.0 + margin);
+
+    // Скважина без результатов в слой не попадает
+    WellData empty;
+    empty.id = WellId::generate();
+    layer.setWell(empty);
+    QCOMPARE(layer.wellCount(), 2);
+}
+
+void TestTrajectoryLayerItem::testWellAt() {
+    TrajectoryLayerItem layer;
+    std::vector<WellData> wells;
+    for (int row = 0; row < 10; ++row) {
+        for (int column = 0; column < 5; ++column) {
+            wells.push_back(makeWell(column * 1500.0, row * 100.0));
+            layer.setWell(wells.back());
+        }
+    }
+
+    // Вершина траектории в строке 3, столбце 2
+    const QPointF on_line(2 * 1500.0 + 500.0, 3 * 100.0 + 20.0 * std::sin(50 * 0.3));
+    const auto hit = layer.wellAt(on_line + QPointF(0.0, 0.5), 2.0);
+    QVERIFY(hit.has_value());
+    QCOMPARE(hit->value, wells[3 * 5 + 2].id.value);
+
+    // Между столбцами и вдали от всех траекторий — промах
+    QVERIFY(!layer.wellAt(QPointF(1250.0, 300.0), 2.0).has_value());
+    QVERIFY(!layer.wellAt(QPointF(-500.0, -500.0), 2.0).has_value());
+
+    // Устье — конец ломаной
+    const auto head = layer.wellAt(QPointF(1500.0, 0.5), 1.0);
+    QVERIFY(head.has_value());
+    QCOMPARE(head->value, wells[1].id.value);
+}
+
+void TestTrajectoryLayerItem::testVisibilityAndRemoval() {
+    TrajectoryLayerItem layer;
+    const WellData first = makeWell(0.0, 0.0);
+    const WellData second = makeWell(0.0, 200.0);
+    const WellData third = makeWell(0.0, 400.0);
+    layer.setWell(first);
+    layer.setWell(second);
+    layer.setWell(third);
+
+    layer.setWellVisible(second.id, false);
+    QVERIFY(!layer.wellAt(QPointF(0.0, 200.0), 1.0).has_value());
+    QCOMPARE(paintLayer(layer, 0.1, QRectF(-100.0, -100.0, 2000.0, 700.0)).wells, static_cast<std::size_t>(2));
+
+    // setWell показывает скрытую скважину
+    layer.setWell(second);
+    QCOMPARE(layer.wellAt(QPointF(0.0, 200.0), 1.0).value_or(WellId{}).value, second.id.value);
+
+    // Удаление первой переставляет последнюю на её место: выбор не сбивается
+    layer.removeWell(first.id);
+    QCOMPARE(layer.wellCount(), 2);
+    QVERIFY(!layer.hasWell(first.id));
+    QVERIFY(!layer.wellAt(QPointF(0.0, 0.0), 1.0).has_value());
+    QCOMPARE(layer.wellAt(QPointF(0.0, 400.0), 1.0).value_or(WellId{}).value, third.id.value);
+    QCOMPARE(layer.wellAt(QPointF(0.0, 200.0), 1.0).value_or(WellId{}).value, second.id.value);
+
+    layer.clear();
+    QCOMPARE(layer.wellCount(), 0);
+    QVERIFY(layer.boundingRect().isNull());
+}
+
+void TestTrajectoryLayerItem::testDetailFromTransform() {
+    TrajectoryLayerItem layer;
+    layer.setWell(makeWell(0.0, 0.0));
+    const QRectF all(-100.0, -100.0, 1200.0, 200.0);
+
+    // Крупно — все точки; мелко — упрощённая ломаная
+    const auto fine = paintLayer(layer, 100.0, all);
+    const auto coarse = paintLayer(layer, 0.01, all);
+    QCOMPARE(fine.wells, static_cast<std::size_t>(1));
+    QCOMPARE(fine.vertices, static_cast<std::size_t>(101));
+    QCOMPARE(coarse.wells, static_cast<std::size_t>(1));
+    QVERIFY(coarse.vertices < fine.vertices);
+
+    // Во время взаимодействия — грубее при том же масштабе
+    const auto normal = paintLayer(layer, 0.2, all);
+    layer.setDetailScale(100.0);
+    const auto interacting = paintLayer(layer, 0.2, all);
+    QVERIFY(interacting.vertices < normal.vertices);
+
+    // Счётчики забираются один раз
+    QCOMPARE(layer.takePaintStats().wells, static_cast<std::size_t>(0));
+}
+
+void TestTrajectoryLayerItem::testExposedRect() {
+    TrajectoryLayerItem layer;
+    for (int i = 0; i < 20; ++i) {
+        WellData well = makeWell(0.0, i * 100.0);
+        well.display_color = i % 2 == 0 ? Qt::red : Qt::blue;
+        layer.setWell(well);
+    }
+
+    // Перерисовывается полоса одной траектории
+    const auto one = paintLayer(layer, 1.0, QRectF(0.0, 480.0, 1000.0, 40.0));
+    QCOMPARE(one.wells, static_cast<std::size_t>(1));
+    QCOMPARE(one.pen_changes, static_cast<std::size_t>(1));
+
+    // Все траектории: перо меняется при смене цвета
+    const auto all = paintLayer(layer, 0.1, QRectF(-100.0, -100.0, 1200.0, 2200.0));
+    QCOMPARE(all.wells, static_cast<std::size_t>(20));
+    QCOMPARE(all.pen_changes, static_cast<std::size_t>(20));
+}
+
+QTEST_MAIN(TestTrajectoryLayerItem)
+#include "test_trajectory_layer_item.moc"
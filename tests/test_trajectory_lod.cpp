@@ -0,0 +1,140 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "models/trajectory_lod.h"
+
+using namespace incline3d::models;
+
+class TestTrajectoryLod : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptyAndShort();
+    void testStraightLineCollapses();
+    void testErrorBound();
+    void testLevelsNested();
+    void testLevelSelection();
+
+private:
+    struct Trajectory {
+        std::vector<double> east;
+        std::vector<double> north;
+        std::vector<double> tvd;
+    };
+
+    /// Наклонно-направленная скважина с шагом 1 м: вертикальный участок, набор и спираль
+    static Trajectory makeTrajectory(int count);
+
+    /// Наибольшее отклонение исходных точек от упрощённой ломаной
+    static double maxDeviation(const Trajectory& t, const std::vector<std::uint32_t>& indices);
+};
+
+TestTrajectoryLod::Trajectory TestTrajectoryLod::makeTrajectory(int count) {
+    Trajectory t;
+    for (int i = 0; i < count; ++i) {
+        const double s = i;
+        const double bend = std::max(0.0, s - 300.0);
+        t.east.push_back(bend * 0.3 + 20.0 * std::sin(bend / 150.0));
+        t.north.push_back(bend * 0.1 + 20.0 * (1.0 - std::cos(bend / 150.0)));
+        t.tvd.push_back(s - bend * 0.2);
+    }
+    return t;
+}
+
+double TestTrajectoryLod::maxDeviation(const Trajectory& t, const std::vector<std::uint32_t>& indices) {
+    double result = 0.0;
+    for (std::size_t k = 0; k + 1 < indices.size(); ++k) {
+        const auto a = indices[k];
+        const auto b = indices[k + 1];
+        const double ab[3] = {t.east[b] - t.east[a], t.north[b] - t.north[a], t.tvd[b] - t.tvd[a]};
+        const double len2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+        for (auto i = a + 1; i < b; ++i) {
+            const double ap[3] = {t.east[i] - t.east[a], t.north[i] - t.north[a], t.tvd[i] - t.tvd[a]};
+            double u = len2 > 0.0 ? (ap[0] * ab[0] + ap[1] * ab[1] + ap[2] * ab[2]) / len2 : 0.0;
+            u = std::clamp(u, 0.0, 1.0);
+            const double d[3] = {ap[0] - u * ab[0], ap[1] - u * ab[1], ap[2] - u * ab[2]};
+            result = std::max(result, std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]));
+        }
+    }
+    return result;
+}
+
+void TestTrajectoryLod::testEmptyAndShort() {
+    const auto empty = TrajectoryLod::build({}, {}, {});
+    QVERIFY(empty.empty());
+
+    const std::vector<double> x = {0.0, 1.0};
+    const auto lod = TrajectoryLod::build(x, x, x);
+    QCOMPARE(lod.levelCount(), 1);
+    QCOMPARE(lod.levelFor(1000.0).indices.size(), static_cast<size_t>(2));
+}
+
+void TestTrajectoryLod::testStraightLineCollapses() {
+    std::vector<double> east;
+    std::vector<double> north;
+    std::vector<double> tvd;
+    for (int i = 0; i < 1000; ++i) {
+        east.push_back(0.0);
+        north.push_back(i * 0.5);
+        tvd.push_back(i);
+    }
+
+    const auto lod = TrajectoryLod::build(east, north, tvd);
+    QCOMPARE(lod.levelCount(), 2);
+    QCOMPARE(lod.level(0).indices.size(), static_cast<size_t>(1000));
+
+    const auto& coarse = lod.level(1).indices;
+    QCOMPARE(coarse.size(), static_cast<size_t>(2));
+    QCOMPARE(coarse.front(), 0u);
+    QCOMPARE(coarse.back(), 999u);
+}
+
+void TestTrajectoryLod::testErrorBound() {
+    const auto t = makeTrajectory(5000);
+    const auto lod = TrajectoryLod::build(t.east, t.north, t.tvd);
+
+    QVERIFY(lod.levelCount() > 3);
+    for (int l = 0; l < lod.levelCount(); ++l) {
+        const auto& level = lod.level(l);
+        QCOMPARE(level.indices.front(), 0u);
+        QCOMPARE(level.indices.back(), 4999u);
+        QVERIFY(maxDeviation(t, level.indices) <= level.tolerance_m + 1e-9);
+    }
+
+    // При допуске в 1 м от 5000 точек остаётся малая доля
+    QVERIFY(lod.levelFor(1.0).indices.size() < 200);
+}
+
+void TestTrajectoryLod::testLevelsNested() {
+    const auto t = makeTrajectory(2000);
+    const auto lod = TrajectoryLod::build(t.east, t.north, t.tvd);
+
+    for (int l = 1; l < lod.levelCount(); ++l) {
+        const auto& finer = lod.level(l - 1);
+        const auto& coarser = lod.level(l);
+        QVERIFY(coarser.indices.size() < finer.indices.size());
+        QVERIFY(coarser.tolerance_m > finer.tolerance_m);
+        QVERIFY(std::includes(finer.indices.begin(), finer.indices.end(),
+                              coarser.indices.begin(), coarser.indices.end()));
+    }
+}
+
+void TestTrajectoryLod::testLevelSelection() {
+    const auto t = makeTrajectory(2000);
+    const auto lod = TrajectoryLod::build(t.east, t.north, t.tvd);
+
+    QCOMPARE(lod.levelIndexFor(0.0), 0);
+    QCOMPARE(lod.levelIndexFor(1e9), lod.levelCount() - 1);
+
+    const int index = lod.levelIndexFor(0.5);
+    QVERIFY(lod.level(index).tolerance_m <= 0.5);
+    if (index + 1 < lod.levelCount()) {
+        QVERIFY(lod.level(index + 1).tolerance_m > 0.5);
+    }
+}
+
+QTEST_MAIN(TestTrajectoryLod)
+#include "test_trajectory_lod.moc"
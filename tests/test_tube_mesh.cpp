@@ -0,0 +1,169 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+#include "views/tube_mesh.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestTubeMesh : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptyAndShort();
+    void testLevels();
+    void testRingsAroundAxis();
+    void testNoTwistOnPlanarCurve();
+    void testColoringKeepsPeaks();
+    void testLevelForRadius();
+
+private:
+    /// Вертикальный участок 300 м, затем дуга радиусом 400 м в плоскости восток–TVD
+    static TrajectoryColumns makePlanarArc();
+};
+
+TrajectoryColumns TestTubeMesh::makePlanarArc() {
+    TrajectoryColumns columns;
+    for (int i = 0; i <= 900; ++i) {
+        ProcessedPoint pt;
+        pt.measured_depth_m = i;
+        if (i <= 300) {
+            pt.tvd_m = i;
+        } else {
+            const double angle = (i - 300) / 400.0;
+            pt.east_m = 400.0 * (1.0 - std::cos(angle));
+            pt.tvd_m = 300.0 + 400.0 * std::sin(angle);
+        }
+        pt.intensity_10m = i > 300 ? 1.43 : 0.0;
+        columns.push_back(pt);
+    }
+    return columns;
+}
+
+void TestTubeMesh::testEmptyAndShort() {
+    TrajectoryColumns columns;
+    QVERIFY(TubeMesh::build(columns, {}).empty());
+
+    ProcessedPoint pt;
+    columns.push_back(pt);
+    QVERIFY(TubeMesh::build(columns, {}).empty());
+
+    // Совпадающие точки сливаются
+    columns.push_back(pt);
+    QVERIFY(TubeMesh::build(columns, {}).empty());
+
+    pt.tvd_m = 10.0;
+    columns.push_back(pt);
+    QVERIFY(!TubeMesh::build(columns, {}).empty());
+}
+
+void TestTubeMesh::testLevels() {
+    const auto mesh = TubeMesh::build(makePlanarArc(), {5.0, TubeColoring::kIntensity10m});
+    QVERIFY(!mesh.empty());
+    QCOMPARE(mesh.levels().size(), TubeMesh::kSides.size());
+
+    std::uint32_t expected_first = 0;
+    for (std::size_t l = 0; l < mesh.levels().size(); ++l) {
+        const auto& level = mesh.levels()[l];
+        QCOMPARE(level.sides, TubeMesh::kSides[l]);
+        QCOMPARE(level.first_index, expected_first);
+        QCOMPARE(level.index_count % 3, 0u);
+        expected_first += level.index_count;
+    }
+    QCOMPARE(static_cast<std::size_t>(expected_first), mesh.indices().size());
+
+    // Грубые уровни дешевле подробных
+    QVERIFY(mesh.levels()[2].index_count < mesh.levels()[1].index_count);
+    QVERIFY(mesh.levels()[1].index_count < mesh.levels()[0].index_count);
+
+    const auto max_index = *std::max_element(mesh.indices().begin(), mesh.indices().end());
+    QVERIFY(max_index < mesh.vertices().size());
+
+    // Ось упрощена: колец меньше, чем исходных точек
+    QVERIFY(mesh.vertices().size() < 901u * 16u);
+}
+
+void TestTubeMesh::testRingsAroundAxis() {
+    const double radius = 5.0;
+    const auto mesh = TubeMesh::build(makePlanarArc(), {radius, TubeColoring::kIntensity10m});
+
+    // Кольца уровня 0 идут первыми: центр кольца на оси, вершины на радиусе
+    const int sides = TubeMesh::kSides[0];
+    const auto& v = mesh.vertices();
+    const std::size_t rings = (mesh.levels()[0].index_count / 3 - 2 * sides) / (2 * sides) + 1;
+    for (std::size_t r = 0; r < rings; ++r) {
+        double center[3] = {0.0, 0.0, 0.0};
+        for (int k = 0; k < sides; ++k) {
+            const auto& vertex = v[r * sides + k];
+            center[0] += vertex.x / sides;
+            center[1] += vertex.y / sides;
+            center[2] += vertex.z / sides;
+            const double length = std::sqrt(vertex.nx * vertex.nx + vertex.ny * vertex.ny + vertex.nz * vertex.nz);
+            QVERIFY(std::abs(length - 1.0) < 1e-4);
+        }
+        for (int k = 0; k < sides; ++k) {
+            const auto& vertex = v[r * sides + k];
+            const double d[3] = {vertex.x - center[0], vertex.y - center[1], vertex.z - center[2]};
+            QVERIFY(std::abs(std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) - radius) < 1e-3);
+        }
+        // Траектория лежит в плоскости север = 0
+        QVERIFY(std::abs(center[1]) < 1e-3);
+    }
+
+    // Габариты расширены на радиус
+    QVERIFY(mesh.boundsMin()[1] <= -radius + 1e-3);
+    QVERIFY(mesh.boundsMax()[1] >= radius - 1e-3);
+    QVERIFY(mesh.boundsMin()[2] < -700.0);
+}
+
+void TestTubeMesh::testNoTwistOnPlanarCurve() {
+    // Для плоской кривой кадр минимального вращения сохраняет угол с нормалью плоскости
+    const auto mesh = TubeMesh::build(makePlanarArc(), {5.0, TubeColoring::kIntensity10m});
+    const int sides = TubeMesh::kSides[0];
+    const auto& v = mesh.vertices();
+    const std::size_t rings = (mesh.levels()[0].index_count / 3 - 2 * sides) / (2 * sides) + 1;
+    QVERIFY(rings > 10);
+
+    const double reference = v[0].ny;
+    for (std::size_t r = 1; r < rings; ++r) {
+        QVERIFY(std::abs(v[r * sides].ny - reference) < 1e-4);
+    }
+}
+
+void TestTubeMesh::testColoringKeepsPeaks() {
+    // Прямой ствол упрощается до двух точек; всплеск на отброшенной точке сохраняется
+    TrajectoryColumns columns;
+    for (int i = 0; i <= 100; ++i) {
+        ProcessedPoint pt;
+        pt.tvd_m = i * 10.0;
+        pt.intensity_10m = 0.2;
+        pt.dogleg_angle_deg = i == 50 ? 4.0 : 0.1;
+        columns.push_back(pt);
+    }
+
+    const auto by_dogleg = TubeMesh::build(columns, {2.0, TubeColoring::kDogleg});
+    QVERIFY(!by_dogleg.empty());
+    float peak = 0.0f;
+    for (const auto& vertex : by_dogleg.vertices()) {
+        peak = std::max(peak, vertex.value);
+    }
+    QCOMPARE(peak, 4.0f);
+
+    const auto by_intensity = TubeMesh::build(columns, {2.0, TubeColoring::kIntensity10m});
+    for (const auto& vertex : by_intensity.vertices()) {
+        QVERIFY(std::abs(vertex.value - 0.2f) < 1e-6f);
+    }
+}
+
+void TestTubeMesh::testLevelForRadius() {
+    QCOMPARE(TubeMesh::levelForRadius(20.0), 0);
+    QCOMPARE(TubeMesh::levelForRadius(4.0), 1);
+    QCOMPARE(TubeMesh::levelForRadius(0.5), 2);
+}
+
+QTEST_MAIN(TestTubeMesh)
+#include "test_tube_mesh.moc"
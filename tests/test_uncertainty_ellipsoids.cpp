@@ -0,0 +1,149 @@
+#include <QtTest>
+
+#include <vector>
+
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+#include "views/uncertainty_ellipsoids.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestUncertaintyEllipsoids : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testNoErrors();
+    void testStations();
+    void testOffsetFallback();
+    void testStep();
+    void testLayerCaching();
+
+private:
+    /// Вертикальный ствол: замеры через 100 м, погрешности растут с глубиной
+    static TrajectoryColumns verticalWell(int stations);
+};
+
+TrajectoryColumns TestUncertaintyEllipsoids::verticalWell(int stations) {
+    TrajectoryColumns columns;
+    for (int i = 0; i < stations; ++i) {
+        ProcessedPoint pt;
+        pt.measured_depth_m = i * 100.0;
+        pt.tvd_m = i * 100.0;
+        pt.mistake_x = i * 1.0;
+        pt.mistake_y = i * 2.0;
+        pt.mistake_z = i * 0.5;
+        columns.push_back(pt);
+    }
+    return columns;
+}
+
+void TestUncertaintyEllipsoids::testNoErrors() {
+    TrajectoryColumns columns;
+    QVERIFY(computeUncertaintyEllipsoids(columns, 0.0, Qt::red).empty());
+
+    ProcessedPoint pt;
+    columns.push_back(pt);
+    pt.measured_depth_m = 100.0;
+    pt.tvd_m = 100.0;
+    columns.push_back(pt);
+    QVERIFY(computeUncertaintyEllipsoids(columns, 0.0, Qt::red).empty());
+    QVERIFY(computeUncertaintyEllipsoids(columns, 10.0, Qt::red).empty());
+}
+
+void TestUncertaintyEllipsoids::testStations() {
+    const auto columns = verticalWell(3);
+    const auto ellipsoids = computeUncertaintyEllipsoids(columns, 0.0, Qt::red);
+
+    // Устье без погрешности пропускается
+    QCOMPARE(ellipsoids.size(), static_cast<size_t>(2));
+    const auto& last = ellipsoids.back();
+    QCOMPARE(last.z, -200.0f);
+
+    // Полуоси — по осям сцены: восток (mistake_y), север (mistake_x), вертикаль
+    QCOMPARE(last.ux, 4.0f);
+    QCOMPARE(last.vy, 2.0f);
+    QCOMPARE(last.wz, 1.0f);
+    QCOMPARE(last.uy, 0.0f);
+    QCOMPARE(last.vx, 0.0f);
+    QCOMPARE(last.wx, 0.0f);
+    QCOMPARE(last.r, 1.0f);
+    QCOMPARE(last.a, 1.0f);
+}
+
+void TestUncertaintyEllipsoids::testOffsetFallback() {
+    TrajectoryColumns columns;
+    ProcessedPoint pt;
+    pt.measured_depth_m = 100.0;
+    pt.tvd_m = 100.0;
+    pt.mistake_absg = 3.0;
+    columns.push_back(pt);
+
+    // Плановых погрешностей нет — обе горизонтальные полуоси по смещению,
+    // нулевая вертикальная не даёт вырожденного эллипсоида
+    const auto ellipsoids = computeUncertaintyEllipsoids(columns, 0.0, Qt::red);
+    QCOMPARE(ellipsoids.size(), static_cast<size_t>(1));
+    QCOMPARE(ellipsoids.front().ux, 3.0f);
+    QCOMPARE(ellipsoids.front().vy, 3.0f);
+    QCOMPARE(ellipsoids.front().wz, static_cast<float>(kMinEllipsoidAxis));
+}
+
+void TestUncertaintyEllipsoids::testStep() {
+    const auto columns = verticalWell(3);
+    const auto ellipsoids = computeUncertaintyEllipsoids(columns, 25.0, Qt::red);
+
+    // Глубины 25, 50, ..., 200 м; на 0 м погрешности нет
+    QCOMPARE(ellipsoids.size(), static_cast<size_t>(8));
+    QCOMPARE(ellipsoids.front().z, -25.0f);
+    QCOMPARE(ellipsoids.front().ux, 0.5f);
+
+    // 150 м — между замерами 100 и 200 м
+    const auto& middle = ellipsoids[5];
+    QCOMPARE(middle.z, -150.0f);
+    QCOMPARE(middle.ux, 3.0f);
+    QCOMPARE(middle.vy, 1.5f);
+    QCOMPARE(middle.wz, 0.75f);
+}
+
+void TestUncertaintyEllipsoids::testLayerCaching() {
+    WellData first;
+    first.id = WellId::generate();
+    first.results = verticalWell(3);
+    WellData second;
+    second.id = WellId::generate();
+    second.results = verticalWell(5);
+
+    UncertaintyLayer layer;
+    std::vector<const WellData*> wells{&first, &second};
+    QVERIFY(layer.update(wells, 0.0));
+    QCOMPARE(layer.instances().size(), static_cast<size_t>(2 + 4));
+    QCOMPARE(layer.instances().front().a, UncertaintyLayer::kAlpha);
+
+    // Без изменений массив не пересобирается
+    QVERIFY(!layer.update(wells, 0.0));
+
+    // Новый шаг, новая версия результатов, скрытая скважина — пересборка
+    QVERIFY(layer.update(wells, 50.0));
+    QVERIFY(!layer.update(wells, 50.0));
+
+    first.results = verticalWell(4);
+    QVERIFY(layer.update(wells, 50.0));
+    QVERIFY(!layer.update(wells, 50.0));
+
+    wells.pop_back();
+    QVERIFY(layer.update(wells, 50.0));
+    QCOMPARE(layer.instances().size(), static_cast<size_t>(6));
+
+    // Смена цвета
+    first.display_color = Qt::red;
+    QVERIFY(layer.update(wells, 50.0));
+    QCOMPARE(layer.instances().front().r, 1.0f);
+    QCOMPARE(layer.instances().front().b, 0.0f);
+
+    layer.clear();
+    QVERIFY(layer.instances().empty());
+    QVERIFY(layer.update(wells, 50.0));
+}
+
+QTEST_MAIN(TestUncertaintyEllipsoids)
+#include "test_uncertainty_ellipsoids.moc"
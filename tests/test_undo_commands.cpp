@@ -0,0 +1,214 @@
+#include <QtTest>
+#include <QUndoStack>
+
+#include "core/project_manager.h"
+#include "core/well_list_commands.h"
+#include "models/edit_commands.h"
+#include "models/measurements_model.h"
+#include "models/project_points_model.h"
+
+using namespace incline3d::core;
+using namespace incline3d::models;
+
+class TestUndoCommands : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testWellEditUndoRedo();
+    void testLargePasteSharesChunks();
+    void testAddWellUndo();
+    void testRemoveWellUndoRestoresPosition();
+    void testRemoveWellUndoContinuesVersions();
+    void testProjectPointEditUndo();
+    void testMeasurementUndoReportsEditedWell();
+
+private:
+    /// Скважина с заданным числом замеров
+    static std::shared_ptr<WellData> makeWell(const std::string& name, int points);
+};
+
+std::shared_ptr<WellData> TestUndoCommands::makeWell(const std::string& name, int points) {
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = name;
+    for (int i = 0; i < points; ++i) {
+        MeasuredPoint pt;
+        pt.measured_depth_m = i * 10.0;
+        pt.inclination_deg = 1.0;
+        well->measurements.push_back(pt);
+    }
+    return well;
+}
+
+void TestUndoCommands::testWellEditUndoRedo() {
+    auto well = makeWell("Скважина", 10);
+    QUndoStack stack;
+    int applied = 0;
+
+    auto before = WellEditState::capture(*well);
+    well->measurements.mutableAt(3).inclination_deg = 45.0;
+    well->params.magnetic_declination_deg = 7.0;
+    well->modified = true;
+
+    stack.push(new WellEditCommand(well, before, WellEditState::capture(*well),
+                                   QStringLiteral("Правка"),
+                                   [&applied](const std::shared_ptr<WellData>&) { ++applied; }));
+
+    // Первый redo при push пропускается — правка уже выполнена
+    QCOMPARE(applied, 0);
+    QCOMPARE(well->measurements[3].inclination_deg, 45.0);
+
+    stack.undo();
+    QCOMPARE(applied, 1);
+    QCOMPARE(well->measurements[3].inclination_deg, 1.0);
+    QCOMPARE(well->params.magnetic_declination_deg, 0.0);
+    QVERIFY(!well->modified);
+
+    stack.redo();
+    QCOMPARE(applied, 2);
+    QCOMPARE(well->measurements[3].inclination_deg, 45.0);
+    QCOMPARE(well->params.magnetic_declination_deg, 7.0);
+}
+
+void TestUndoCommands::testLargePasteSharesChunks() {
+    auto well = makeWell("Большая", 100000);
+    auto before = WellEditState::capture(*well);
+
+    // Вставка в конец затрагивает только последние блоки
+    for (int i = 0; i < 1000; ++i) {
+        MeasuredPoint pt;
+        pt.measured_depth_m = 1000000.0 + i;
+        well->measurements.push_back(pt);
+    }
+    auto after = WellEditState::capture(*well);
+
+    const size_t old_chunks = before.measurements.chunkCount();
+    QVERIFY(after.measurements.sharedChunkCount(before.measurements) >= old_chunks - 1);
+
+    QUndoStack stack;
+    stack.push(new WellEditCommand(well, before, after, QStringLiteral("Вставка")));
+    stack.undo();
+    QCOMPARE(well->measurements.size(), static_cast<size_t>(100000));
+    stack.redo();
+    QCOMPARE(well->measurements.size(), static_cast<size_t>(101000));
+}
+
+void TestUndoCommands::testAddWellUndo() {
+    ProjectManager manager;
+    manager.newProject();
+    QUndoStack stack;
+
+    auto well = makeWell("Новая", 3);
+    well->source_file_path = "/data/new.ws";
+    stack.push(new AddWellCommand(&manager, well));
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(1));
+    QCOMPARE(manager.projectData().well_entries.size(), static_cast<size_t>(1));
+
+    stack.undo();
+    QVERIFY(manager.wells().empty());
+    QVERIFY(manager.projectData().well_entries.empty());
+
+    stack.redo();
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(1));
+    QCOMPARE(manager.wells().at(0).get(), well.get());
+    QCOMPARE(manager.projectData().well_entries.at(0).file_path, QString("/data/new.ws"));
+}
+
+void TestUndoCommands::testRemoveWellUndoRestoresPosition() {
+    ProjectManager manager;
+    manager.newProject();
+    auto well1 = makeWell("Скважина 1", 1);
+    auto well2 = makeWell("Скважина 2", 1);
+    auto well3 = makeWell("Скважина 3", 1);
+    manager.addWell(well1);
+    manager.addWell(well2);
+    manager.addWell(well3);
+
+    QUndoStack stack;
+    stack.push(new RemoveWellCommand(&manager, well2->id));
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(2));
+    QCOMPARE(manager.wells().at(1).get(), well3.get());
+
+    stack.undo();
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(3));
+    QCOMPARE(manager.wells().at(1).get(), well2.get());
+    QCOMPARE(manager.indexOf(well2->id), 1);
+    QCOMPARE(manager.projectData().well_entries.size(), static_cast<size_t>(3));
+}
+
+void TestUndoCommands::testRemoveWellUndoContinuesVersions() {
+    ProjectManager manager;
+    manager.newProject();
+    auto well = makeWell("Скважина", 1);
+    manager.addWell(well);
+    manager.publishWell(well->id);
+    const auto before = manager.snapshot(well->id);
+    QCOMPARE(before->version, static_cast<std::uint64_t>(2));
+
+    QUndoStack stack;
+    stack.push(new RemoveWellCommand(&manager, well->id));
+    QVERIFY(!manager.snapshot(well->id));
+
+    // Отмена удаления и следующая правка: пара (id, version) не повторяется
+    stack.undo();
+    QCOMPARE(manager.snapshot(well->id)->version, static_cast<std::uint64_t>(3));
+    well->metadata.well_name = "Переименована";
+    manager.publishWell(well->id);
+    const auto after = manager.snapshot(well->id);
+    QCOMPARE(after->version, static_cast<std::uint64_t>(4));
+    QCOMPARE(after->data.metadata.well_name, std::string("Переименована"));
+    QCOMPARE(before->data.metadata.well_name, std::string("Скважина"));
+}
+
+void TestUndoCommands::testProjectPointEditUndo() {
+    ProjectPointsModel model;
+    QUndoStack stack;
+    model.setUndoStack(&stack);
+
+    ProjectPoint pt;
+    pt.name = "Пласт";
+    pt.depth_m = 1500.0;
+    model.addPoint(pt);
+
+    QVERIFY(model.setData(model.index(0, ProjectPointsModel::kColumnDepth), 1750.0));
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(model.pointAt(0).depth_m, 1750.0);
+
+    stack.undo();
+    QCOMPARE(model.pointAt(0).depth_m, 1500.0);
+
+    stack.redo();
+    QCOMPARE(model.pointAt(0).depth_m, 1750.0);
+}
+
+void TestUndoCommands::testMeasurementUndoReportsEditedWell() {
+    QUndoStack stack;
+    MeasurementsModel model;
+    model.setUndoStack(&stack);
+
+    std::vector<std::shared_ptr<WellData>> applied;
+    model.setEditAppliedCallback([&applied](const std::shared_ptr<WellData>& well) {
+        applied.push_back(well);
+    });
+
+    auto edited = makeWell("X", 3);
+    auto other = makeWell("Y", 2);
+
+    model.setWell(edited);
+    QVERIFY(model.setData(model.index(0, MeasurementsModel::kColumnInclination), 5.0));
+    QCOMPARE(edited->measurements[0].inclination_deg, 5.0);
+
+    // Отмена после переключения на другую скважину обновляет изменённую
+    model.setWell(other);
+    stack.undo();
+    QCOMPARE(edited->measurements[0].inclination_deg, 1.0);
+    QCOMPARE(applied.size(), static_cast<size_t>(1));
+    QCOMPARE(applied.back(), edited);
+
+    stack.redo();
+    QCOMPARE(edited->measurements[0].inclination_deg, 5.0);
+    QCOMPARE(applied.back(), edited);
+    QCOMPARE(other->measurements[0].inclination_deg, 1.0);
+}
+
+QTEST_MAIN(TestUndoCommands)
+#include "test_undo_commands.moc"
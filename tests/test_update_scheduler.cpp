@@ -0,0 +1,131 @@
+#include <QtTest>
+#include <QSignalSpy>
+
+#include <vector>
+
+#include "views/update_scheduler.h"
+
+using namespace incline3d::views;
+
+class TestUpdateScheduler : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCoalescesChanges();
+    void testHiddenKeepsChanges();
+    void testTakePending();
+    void testInteraction();
+    void testInteractionWhileHidden();
+
+private:
+    /// Записывать каждую обработку изменений
+    static void record(UpdateScheduler& scheduler, std::vector<UpdateScheduler::Changes>& flushes);
+};
+
+void TestUpdateScheduler::record(UpdateScheduler& scheduler,
+                                 std::vector<UpdateScheduler::Changes>& flushes) {
+    connect(&scheduler, &UpdateScheduler::flushRequested, &scheduler,
+            [&flushes](UpdateScheduler::Changes changes) { flushes.push_back(changes); });
+}
+
+void TestUpdateScheduler::testCoalescesChanges() {
+    UpdateScheduler scheduler;
+    std::vector<UpdateScheduler::Changes> flushes;
+    record(scheduler, flushes);
+    scheduler.setActive(true);
+
+    scheduler.invalidate(UpdateScheduler::kCamera);
+    scheduler.invalidate(UpdateScheduler::kGeometry);
+    scheduler.invalidate(UpdateScheduler::kCamera);
+    scheduler.invalidate(UpdateScheduler::kNone);
+
+    // Обработка — не сразу, а одна на все изменения прохода цикла событий
+    QVERIFY(flushes.empty());
+    QTRY_COMPARE(flushes.size(), static_cast<size_t>(1));
+    QCOMPARE(flushes.front(), UpdateScheduler::kCamera | UpdateScheduler::kGeometry);
+    QVERIFY(!scheduler.pending());
+
+    QTest::qWait(20);
+    QCOMPARE(flushes.size(), static_cast<size_t>(1));
+}
+
+void TestUpdateScheduler::testHiddenKeepsChanges() {
+    UpdateScheduler scheduler;
+    std::vector<UpdateScheduler::Changes> flushes;
+    record(scheduler, flushes);
+
+    // Новый вид ещё не показан
+    QVERIFY(!scheduler.isActive());
+    scheduler.invalidate(UpdateScheduler::kStyle);
+    QTest::qWait(20);
+    QVERIFY(flushes.empty());
+    QCOMPARE(scheduler.pending(), UpdateScheduler::Changes(UpdateScheduler::kStyle));
+
+    scheduler.setActive(true);
+    QTRY_COMPARE(flushes.size(), static_cast<size_t>(1));
+    QCOMPARE(flushes.front(), UpdateScheduler::Changes(UpdateScheduler::kStyle));
+
+    // Скрыт до срабатывания — изменения ждут следующего показа
+    scheduler.invalidate(UpdateScheduler::kGeometry);
+    scheduler.setActive(false);
+    QTest::qWait(20);
+    QCOMPARE(flushes.size(), static_cast<size_t>(1));
+    scheduler.setActive(true);
+    QTRY_COMPARE(flushes.size(), static_cast<size_t>(2));
+    QCOMPARE(flushes.back(), UpdateScheduler::Changes(UpdateScheduler::kGeometry));
+}
+
+void TestUpdateScheduler::testTakePending() {
+    UpdateScheduler scheduler;
+    std::vector<UpdateScheduler::Changes> flushes;
+    record(scheduler, flushes);
+    scheduler.setActive(true);
+
+    scheduler.invalidate(UpdateScheduler::kGeometry | UpdateScheduler::kStyle);
+    QCOMPARE(scheduler.takePending(), UpdateScheduler::kGeometry | UpdateScheduler::kStyle);
+    QVERIFY(!scheduler.pending());
+
+    // Забранные изменения повторно не обрабатываются
+    QTest::qWait(20);
+    QVERIFY(flushes.empty());
+}
+
+void TestUpdateScheduler::testInteraction() {
+    UpdateScheduler scheduler;
+    scheduler.setActive(true);
+    QSignalSpy refine(&scheduler, &UpdateScheduler::refineRequested);
+
+    QVERIFY(!scheduler.isInteracting());
+    scheduler.interact();
+    QVERIFY(scheduler.isInteracting());
+
+    // Новое движение до паузы откладывает уточнение
+    QTest::qWait(UpdateScheduler::kRefineDelayMs / 2);
+    scheduler.interact();
+    QTest::qWait(UpdateScheduler::kRefineDelayMs / 2);
+    QCOMPARE(refine.count(), 0);
+    QVERIFY(scheduler.isInteracting());
+
+    QTRY_COMPARE(refine.count(), 1);
+    QVERIFY(!scheduler.isInteracting());
+}
+
+void TestUpdateScheduler::testInteractionWhileHidden() {
+    UpdateScheduler scheduler;
+    std::vector<UpdateScheduler::Changes> flushes;
+    record(scheduler, flushes);
+    QSignalSpy refine(&scheduler, &UpdateScheduler::refineRequested);
+
+    // Скрытый вид не уточняется, а перерисовывается при показе
+    scheduler.interact();
+    QTRY_VERIFY(!scheduler.isInteracting());
+    QCOMPARE(refine.count(), 0);
+    QCOMPARE(scheduler.pending(), UpdateScheduler::Changes(UpdateScheduler::kCamera));
+
+    scheduler.setActive(true);
+    QTRY_COMPARE(flushes.size(), static_cast<size_t>(1));
+    QCOMPARE(flushes.front(), UpdateScheduler::Changes(UpdateScheduler::kCamera));
+}
+
+QTEST_MAIN(TestUpdateScheduler)
+#include "test_update_scheduler.moc"
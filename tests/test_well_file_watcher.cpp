@@ -0,0 +1,186 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QFile>
+#include <QTextStream>
+#include <QUndoStack>
+
+#include "core/file_io.h"
+#include "core/project_manager.h"
+#include "core/well_file_watcher.h"
+#include "core/well_list_commands.h"
+
+using namespace incline3d::core;
+using namespace incline3d::models;
+
+class TestWellFileWatcher : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testWatchesProjectFiles();
+    void testCoalescedReload();
+    void testModifiedWellNotOverwritten();
+    void testReloadWellAddedThroughHistory();
+
+private:
+    /// Записать WS-файл с заданным числом замеров
+    void writeWs(const QString& path, int points);
+
+    /// Загрузить скважину из файла и добавить в проект
+    void addWellFromFile(ProjectManager& manager, const QString& path);
+
+    QTemporaryDir* temp_dir_{nullptr};
+};
+
+void TestWellFileWatcher::initTestCase() {
+    temp_dir_ = new QTemporaryDir();
+    QVERIFY(temp_dir_->isValid());
+}
+
+void TestWellFileWatcher::cleanupTestCase() {
+    delete temp_dir_;
+}
+
+void TestWellFileWatcher::writeWs(const QString& path, int points) {
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate));
+    QTextStream out(&file);
+    out << "[metadata]\n";
+    out << "key\tvalue\n";
+    out << "well_name\tНаблюдаемая\n\n";
+    out << "[intervals]\n";
+    out << "Глубина_м\tУгол_град\tАзимут_град\n";
+    for (int i = 0; i < points; ++i) {
+        out << i * 10.0 << "\t" << 1.5 << "\t" << 45.0 << "\t\n";
+    }
+}
+
+void TestWellFileWatcher::addWellFromFile(ProjectManager& manager, const QString& path) {
+    FileIO io;
+    auto result = io.loadWell(path, FileFormat::kWs);
+    QVERIFY(result.success);
+    manager.addWell(result.well);
+}
+
+void TestWellFileWatcher::testWatchesProjectFiles() {
+    QString path = temp_dir_->filePath("watched_a.ws");
+    writeWs(path, 3);
+
+    ProjectManager manager;
+    manager.newProject();
+    WellFileWatcher watcher(&manager);
+
+    addWellFromFile(manager, path);
+    QVERIFY(watcher.watchedFiles().contains(QFileInfo(path).absoluteFilePath()));
+
+    manager.removeWell(0);
+    QVERIFY(watcher.watchedFiles().isEmpty());
+}
+
+void TestWellFileWatcher::testCoalescedReload() {
+    QString path = temp_dir_->filePath("watched_b.ws");
+    writeWs(path, 3);
+
+    ProjectManager manager;
+    manager.newProject();
+    WellFileWatcher watcher(&manager);
+    watcher.setDebounceInterval(100);
+
+    addWellFromFile(manager, path);
+    auto original = manager.wells().at(0);
+    original->display_color = Qt::darkGreen;
+
+    QSignalSpy replacedSpy(&manager, &ProjectManager::wellReplaced);
+    QSignalSpy wellsSpy(&manager, &ProjectManager::wellsChanged);
+
+    // Серия записей подряд должна привести к одному перечитыванию
+    writeWs(path, 4);
+    writeWs(path, 5);
+    writeWs(path, 6);
+
+    QVERIFY(replacedSpy.wait(5000));
+    QTest::qWait(300);
+
+    QCOMPARE(replacedSpy.count(), 1);
+    QCOMPARE(wellsSpy.count(), 0);
+
+    const auto& reloaded = manager.wells().at(0);
+    QVERIFY(reloaded.get() != original.get());
+    QCOMPARE(reloaded->measurements.size(), static_cast<size_t>(6));
+    QCOMPARE(reloaded->display_color, QColor(Qt::darkGreen));
+}
+
+void TestWellFileWatcher::testModifiedWellNotOverwritten() {
+    QString path = temp_dir_->filePath("watched_c.ws");
+    writeWs(path, 3);
+
+    ProjectManager manager;
+    manager.newProject();
+    WellFileWatcher watcher(&manager);
+    watcher.setDebounceInterval(50);
+
+    addWellFromFile(manager, path);
+    manager.wells().at(0)->modified = true;
+
+    QSignalSpy failedSpy(&watcher, &WellFileWatcher::reloadFailed);
+    QSignalSpy replacedSpy(&manager, &ProjectManager::wellReplaced);
+
+    writeWs(path, 8);
+
+    QVERIFY(failedSpy.wait(5000));
+    QCOMPARE(replacedSpy.count(), 0);
+    QCOMPARE(manager.wells().at(0)->measurements.size(), static_cast<size_t>(3));
+}
+
+void TestWellFileWatcher::testReloadWellAddedThroughHistory() {
+    QString path = temp_dir_->filePath("watched_d.ws");
+    writeWs(path, 3);
+
+    ProjectManager manager;
+    manager.newProject();
+    WellFileWatcher watcher(&manager);
+    watcher.setDebounceInterval(50);
+
+    QUndoStack stack;
+    watcher.setReplaceHandler([&](int row, std::shared_ptr<WellData> well) {
+        const WellId id = manager.registry().idAt(row);
+        const auto* reloaded = well.get();
+        stack.push(new ReplaceWellCommand(&manager, id, std::move(well)));
+        return manager.well(id).get() == reloaded;
+    });
+
+    // Скважина, добавленная через историю, всё равно перечитывается
+    FileIO io;
+    auto result = io.loadWell(path, FileFormat::kWs);
+    QVERIFY(result.success);
+    auto original = result.well;
+    stack.push(new AddWellCommand(&manager, original));
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(1));
+
+    QSignalSpy reloadedSpy(&watcher, &WellFileWatcher::wellReloaded);
+    writeWs(path, 8);
+
+    QVERIFY(reloadedSpy.wait(5000));
+    QCOMPARE(stack.count(), 2);
+    QVERIFY(manager.wells().at(0).get() != original.get());
+    QCOMPARE(manager.wells().at(0)->measurements.size(), static_cast<size_t>(8));
+
+    // Отмена перечитывания возвращает прежний объект, затем отменяется добавление
+    stack.undo();
+    QCOMPARE(manager.wells().at(0).get(), original.get());
+    QCOMPARE(manager.wells().at(0)->measurements.size(), static_cast<size_t>(3));
+
+    stack.undo();
+    QVERIFY(manager.wells().empty());
+
+    stack.redo();
+    stack.redo();
+    QCOMPARE(manager.wells().size(), static_cast<size_t>(1));
+    QCOMPARE(manager.wells().at(0)->measurements.size(), static_cast<size_t>(8));
+}
+
+QTEST_MAIN(TestWellFileWatcher)
+#include "test_well_file_watcher.moc"
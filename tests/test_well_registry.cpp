@@ -0,0 +1,147 @@
+#include <QtTest>
+
+#include "models/well_registry.h"
+
+using namespace incline3d::models;
+
+class TestWellRegistry : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAppendAssignsIds();
+    void testDuplicateIdIsReassigned();
+    void testRowsAfterInsertRemove();
+    void testRowsAfterManyEarlyEdits();
+    void testFindByNameAndUwi();
+    void testRefreshKeys();
+    void testReplaceKeepsId();
+
+private:
+    static std::shared_ptr<WellData> makeWell(const std::string& name,
+                                              const std::string& uwi = {});
+};
+
+std::shared_ptr<WellData> TestWellRegistry::makeWell(const std::string& name,
+                                                     const std::string& uwi) {
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = name;
+    well->metadata.uwi = uwi;
+    return well;
+}
+
+void TestWellRegistry::testAppendAssignsIds() {
+    WellRegistry registry;
+    WellId id1 = registry.append(makeWell("Скважина 1"));
+    WellId id2 = registry.append(makeWell("Скважина 2"));
+
+    QVERIFY(id1.isValid());
+    QVERIFY(id2.isValid());
+    QVERIFY(id1 != id2);
+    QCOMPARE(registry.size(), 2);
+    QCOMPARE(registry.idAt(1), id2);
+    QCOMPARE(registry.find(id1)->metadata.well_name, std::string("Скважина 1"));
+}
+
+void TestWellRegistry::testDuplicateIdIsReassigned() {
+    WellRegistry registry;
+    auto original = makeWell("Оригинал");
+    WellId id = registry.append(original);
+
+    // Копия несёт идентификатор оригинала
+    auto copy = std::make_shared<WellData>(*original);
+    WellId copy_id = registry.append(copy);
+
+    QVERIFY(copy_id != id);
+    QCOMPARE(copy->id, copy_id);
+    QCOMPARE(registry.find(id).get(), original.get());
+}
+
+void TestWellRegistry::testRowsAfterInsertRemove() {
+    WellRegistry registry;
+    std::vector<WellId> ids;
+    for (int i = 0; i < 5; ++i) {
+        ids.push_back(registry.append(makeWell("Скважина " + std::to_string(i))));
+    }
+
+    WellId inserted = registry.insert(1, makeWell("Вставленная"));
+    QCOMPARE(registry.rowOf(inserted), 1);
+    QCOMPARE(registry.rowOf(ids[0]), 0);
+    QCOMPARE(registry.rowOf(ids[1]), 2);
+    QCOMPARE(registry.rowOf(ids[4]), 5);
+
+    QVERIFY(registry.remove(ids[0]));
+    QVERIFY(!registry.contains(ids[0]));
+    QCOMPARE(registry.rowOf(ids[0]), -1);
+    QCOMPARE(registry.rowOf(inserted), 0);
+    QCOMPARE(registry.rowOf(ids[4]), 4);
+
+    auto removed = registry.removeAt(registry.rowOf(ids[2]));
+    QCOMPARE(removed->id, ids[2]);
+    QCOMPARE(registry.size(), 4);
+    QCOMPARE(registry.rowOf(ids[3]), 2);
+}
+
+void TestWellRegistry::testRowsAfterManyEarlyEdits() {
+    WellRegistry registry;
+    const WellId last = registry.append(makeWell("Последняя"));
+
+    // Вставки и удаления в начале чередуются с запросами; журнал сдвигов
+    // несколько раз переполняется и сворачивается
+    for (int i = 0; i < static_cast<int>(WellRegistry::kMaxPendingShifts) * 3; ++i) {
+        registry.insert(0, makeWell("Вставленная"));
+        if (i % 5 == 4) {
+            registry.removeAt(1);
+        }
+        QCOMPARE(registry.rowOf(last), registry.size() - 1);
+    }
+    for (int row = 0; row < registry.size(); ++row) {
+        QCOMPARE(registry.rowOf(registry.idAt(row)), row);
+    }
+}
+
+void TestWellRegistry::testFindByNameAndUwi() {
+    WellRegistry registry;
+    registry.append(makeWell("Первая", "UWI-1"));
+    WellId second = registry.append(makeWell("Двойник", "UWI-2"));
+    WellId third = registry.append(makeWell("Двойник"));
+
+    QCOMPARE(registry.findByName("Двойник"), second);
+    QCOMPARE(registry.findAllByName("Двойник"), (std::vector<WellId>{second, third}));
+    QCOMPARE(registry.findByUwi("UWI-2"), second);
+    QVERIFY(!registry.findByUwi("").isValid());
+    QVERIFY(!registry.findByName("Нет такой").isValid());
+
+    // После удаления первой по позиции находится следующая
+    registry.remove(second);
+    QCOMPARE(registry.findByName("Двойник"), third);
+    QVERIFY(!registry.findByUwi("UWI-2").isValid());
+}
+
+void TestWellRegistry::testRefreshKeys() {
+    WellRegistry registry;
+    auto well = makeWell("Старое имя");
+    WellId id = registry.append(well);
+
+    well->metadata.well_name = "Новое имя";
+    registry.refreshKeys(0);
+
+    QVERIFY(!registry.findByName("Старое имя").isValid());
+    QCOMPARE(registry.findByName("Новое имя"), id);
+}
+
+void TestWellRegistry::testReplaceKeepsId() {
+    WellRegistry registry;
+    registry.append(makeWell("Соседняя"));
+    WellId id = registry.append(makeWell("Скважина", "UWI-7"));
+
+    auto reloaded = makeWell("Скважина", "UWI-8");
+    QVERIFY(registry.replace(1, reloaded));
+
+    QCOMPARE(reloaded->id, id);
+    QCOMPARE(registry.find(id).get(), reloaded.get());
+    QCOMPARE(registry.findByUwi("UWI-8"), id);
+    QVERIFY(!registry.findByUwi("UWI-7").isValid());
+}
+
+QTEST_MAIN(TestWellRegistry)
+#include "test_well_registry.moc"
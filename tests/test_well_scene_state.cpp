@@ -0,0 +1,107 @@
+#include <QtTest>
+
+#include "models/trajectory_columns.h"
+#include "models/well_data.h"
+#include "views/well_scene_state.h"
+
+using namespace incline3d::models;
+using namespace incline3d::views;
+
+class TestWellSceneState : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testVisibility();
+    void testNoChanges();
+    void testStyle();
+    void testLabels();
+    void testGeometry();
+
+private:
+    /// Скважина с двумя замерами
+    static WellData makeWell();
+};
+
+WellData TestWellSceneState::makeWell() {
+    WellData well;
+    well.metadata.well_name = "101";
+    ProcessedPoint pt;
+    well.results.push_back(pt);
+    pt.measured_depth_m = 100.0;
+    pt.tvd_m = 100.0;
+    well.results.push_back(pt);
+    return well;
+}
+
+void TestWellSceneState::testVisibility() {
+    WellData well = makeWell();
+    QVERIFY(WellSceneState::of(well, false).visible);
+
+    well.visible = false;
+    QVERIFY(!WellSceneState::of(well, false).visible);
+
+    // Скважина без результатов не рисуется, даже если видима
+    WellData empty;
+    QVERIFY(!WellSceneState::of(empty, false).visible);
+
+    well.visible = true;
+    const auto shown = WellSceneState::of(well, false);
+    well.visible = false;
+    const auto hidden = WellSceneState::of(well, false);
+    QCOMPARE(diffWellState(shown, hidden), WellChanges(WellChange::kVisibility));
+    QCOMPARE(diffWellState(hidden, shown), WellChanges(WellChange::kVisibility));
+}
+
+void TestWellSceneState::testNoChanges() {
+    const WellData well = makeWell();
+    const auto built = WellSceneState::of(well, true);
+
+    // Копия скважины разделяет результаты — версия та же
+    const WellData copy = well;
+    const auto current = WellSceneState::of(copy, true);
+    QCOMPARE(current.revision, built.revision);
+    QVERIFY(!diffWellState(built, current));
+    QVERIFY(built == current);
+}
+
+void TestWellSceneState::testStyle() {
+    WellData well = makeWell();
+    const auto built = WellSceneState::of(well, false);
+
+    well.display_color = Qt::red;
+    QCOMPARE(diffWellState(built, WellSceneState::of(well, false)), WellChanges(WellChange::kStyle));
+
+    well = makeWell();
+    const auto built_width = WellSceneState::of(well, false);
+    well.line_width = 4;
+    QCOMPARE(diffWellState(built_width, WellSceneState::of(well, false)), WellChanges(WellChange::kStyle));
+
+    const auto built_name = WellSceneState::of(well, false);
+    well.metadata.well_name = "102";
+    QCOMPARE(diffWellState(built_name, WellSceneState::of(well, false)), WellChanges(WellChange::kStyle));
+}
+
+void TestWellSceneState::testLabels() {
+    const WellData well = makeWell();
+    const auto changes = diffWellState(WellSceneState::of(well, false), WellSceneState::of(well, true));
+    QCOMPARE(changes, WellChanges(WellChange::kLabels));
+}
+
+void TestWellSceneState::testGeometry() {
+    WellData well = makeWell();
+    const auto built = WellSceneState::of(well, false);
+
+    ProcessedPoint pt;
+    pt.measured_depth_m = 200.0;
+    pt.tvd_m = 190.0;
+    well.results.push_back(pt);
+    well.display_color = Qt::green;
+
+    const auto changes = diffWellState(built, WellSceneState::of(well, false));
+    QVERIFY(changes.testFlag(WellChange::kGeometry));
+    QVERIFY(changes.testFlag(WellChange::kStyle));
+    QVERIFY(!changes.testFlag(WellChange::kVisibility));
+}
+
+QTEST_MAIN(TestWellSceneState)
+#include "test_well_scene_state.moc"
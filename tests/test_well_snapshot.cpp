@@ -0,0 +1,118 @@
+#include <QtTest>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "models/well_snapshot.h"
+
+using namespace incline3d::models;
+
+class TestWellSnapshot : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptySlot();
+    void testPublishIncrementsVersion();
+    void testSnapshotIsIsolatedFromEdits();
+    void testSnapshotSharesChunks();
+    void testConcurrentReaders();
+};
+
+void TestWellSnapshot::testEmptySlot() {
+    WellSnapshotSlot slot;
+    QVERIFY(!slot.load());
+    QCOMPARE(slot.version(), static_cast<std::uint64_t>(0));
+}
+
+void TestWellSnapshot::testPublishIncrementsVersion() {
+    WellData well;
+    well.id = WellId::generate();
+    WellSnapshotSlot slot;
+
+    auto first = slot.publish(well);
+    auto second = slot.publish(well);
+
+    QCOMPARE(first->version, static_cast<std::uint64_t>(1));
+    QCOMPARE(second->version, static_cast<std::uint64_t>(2));
+    QCOMPARE(second->id, well.id);
+    QCOMPARE(slot.load().get(), second.get());
+
+    // Ячейка возвращённой скважины продолжает нумерацию
+    WellSnapshotSlot restored(2);
+    QCOMPARE(restored.version(), static_cast<std::uint64_t>(2));
+    QCOMPARE(restored.publish(well)->version, static_cast<std::uint64_t>(3));
+}
+
+void TestWellSnapshot::testSnapshotIsIsolatedFromEdits() {
+    WellData well;
+    well.metadata.well_name = "Скважина";
+    MeasuredPoint pt;
+    pt.inclination_deg = 10.0;
+    well.measurements.push_back(pt);
+
+    WellSnapshotSlot slot;
+    auto snapshot = slot.publish(well);
+
+    well.metadata.well_name = "Переименована";
+    well.measurements.mutableAt(0).inclination_deg = 20.0;
+
+    QCOMPARE(snapshot->data.metadata.well_name, std::string("Скважина"));
+    QCOMPARE(snapshot->data.measurements[0].inclination_deg, 10.0);
+}
+
+void TestWellSnapshot::testSnapshotSharesChunks() {
+    WellData well;
+    for (int i = 0; i < 2000; ++i) {
+        MeasuredPoint pt;
+        pt.measured_depth_m = i;
+        well.measurements.push_back(pt);
+    }
+
+    WellSnapshotSlot slot;
+    auto snapshot = slot.publish(well);
+    QCOMPARE(snapshot->data.measurements.sharedChunkCount(well.measurements),
+             well.measurements.chunkCount());
+}
+
+void TestWellSnapshot::testConcurrentReaders() {
+    WellData well;
+    well.id = WellId::generate();
+    WellSnapshotSlot slot;
+    slot.publish(well);
+
+    constexpr int kPublishCount = 500;
+    std::atomic<bool> done{false};
+    std::atomic<bool> monotonic{true};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            while (!done.load()) {
+                auto snapshot = slot.load();
+                // Номер версии совпадает с числом замеров в снимке
+                if (snapshot->version < last ||
+                    snapshot->data.measurements.size() + 1 != snapshot->version) {
+                    monotonic = false;
+                }
+                last = snapshot->version;
+            }
+        });
+    }
+
+    for (int i = 0; i < kPublishCount; ++i) {
+        well.measurements.push_back(MeasuredPoint{});
+        slot.publish(well);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    QVERIFY(monotonic.load());
+    QCOMPARE(slot.version(), static_cast<std::uint64_t>(kPublishCount + 1));
+}
+
+QTEST_MAIN(TestWellSnapshot)
+#include "test_well_snapshot.moc"
@@ -1,6 +1,7 @@
 #include <QtTest>
 #include <QSignalSpy>
 
+#include "core/project_manager.h"
 #include "models/well_table_model.h"
 
 using namespace incline3d::models;
@@ -22,6 +23,7 @@ private slots:
     void testHeaderData();
     void testFindWellByName();
     void testVisibilityChange();
+    void testRenameUpdatesProjectRegistry();
 
 private:
     WellTableModel* model_{nullptr};
@@ -190,5 +192,32 @@ void TestWellTableModel::testVisibilityChange() {
     QVERIFY(well->visible);
 }
 
+void TestWellTableModel::testRenameUpdatesProjectRegistry() {
+    incline3d::core::ProjectManager manager;
+    manager.newProject();
+
+    WellTableModel model;
+    model.setRegistry(&manager.registry());
+    QObject::connect(&manager, &incline3d::core::ProjectManager::wellInserted,
+                     &model, [&](int index) { model.insertWell(index, manager.wells().at(index)); });
+    QObject::connect(&manager, &incline3d::core::ProjectManager::wellRemoved,
+                     &model, [&](int index, WellId) { model.removeWell(index); });
+
+    auto well = std::make_shared<WellData>();
+    well->metadata.well_name = "Старое имя";
+    manager.addWell(well);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.wellAt(0), well);
+
+    // Переименование через таблицу видно в реестре проекта — он общий
+    QVERIFY(model.setData(model.index(0, WellTableModel::kColumnName), "Новое имя"));
+    QCOMPARE(manager.registry().findByName("Новое имя").value, well->id.value);
+    QVERIFY(!manager.registry().findByName("Старое имя").isValid());
+
+    manager.removeWell(0);
+    QCOMPARE(model.rowCount(), 0);
+    QVERIFY(model.wells().empty());
+}
+
 QTEST_MAIN(TestWellTableModel)
 #include "test_well_table_model.moc"